@@ -0,0 +1,57 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/external/libascon/src/ascon.c" "CMakeFiles/hzl_client_desktop_shared.dir/external/libascon/src/ascon.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/external/libascon/src/ascon.c.o.d"
+  "/root/repo/src/client/hzl_ClientBuildRequest.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientBuildRequest.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientBuildRequest.c.o.d"
+  "/root/repo/src/client/hzl_ClientBuildSecuredFd.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientBuildSecuredFd.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientBuildSecuredFd.c.o.d"
+  "/root/repo/src/client/hzl_ClientBuildSecuredTp.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientBuildSecuredTp.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientBuildSecuredTp.c.o.d"
+  "/root/repo/src/client/hzl_ClientBuildUnsecured.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientBuildUnsecured.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientBuildUnsecured.c.o.d"
+  "/root/repo/src/client/hzl_ClientCurrentTimeCoarse.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientCurrentTimeCoarse.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientCurrentTimeCoarse.c.o.d"
+  "/root/repo/src/client/hzl_ClientDeinit.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientDeinit.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientDeinit.c.o.d"
+  "/root/repo/src/client/hzl_ClientFree.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientFree.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientFree.c.o.d"
+  "/root/repo/src/client/hzl_ClientGroup.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientGroup.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientGroup.c.o.d"
+  "/root/repo/src/client/hzl_ClientInit.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientInit.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientInit.c.o.d"
+  "/root/repo/src/client/hzl_ClientNew.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientNew.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientNew.c.o.d"
+  "/root/repo/src/client/hzl_ClientNewMsg.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientNewMsg.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientNewMsg.c.o.d"
+  "/root/repo/src/client/hzl_ClientProcessReceived.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientProcessReceived.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientProcessReceived.c.o.d"
+  "/root/repo/src/client/hzl_ClientProcessReceivedInPlace.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientProcessReceivedInPlace.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientProcessReceivedInPlace.c.o.d"
+  "/root/repo/src/client/hzl_ClientProcessReceivedRenewal.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientProcessReceivedRenewal.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientProcessReceivedRenewal.c.o.d"
+  "/root/repo/src/client/hzl_ClientProcessReceivedResponse.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientProcessReceivedResponse.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientProcessReceivedResponse.c.o.d"
+  "/root/repo/src/client/hzl_ClientProcessReceivedSecuredFd.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientProcessReceivedSecuredFd.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientProcessReceivedSecuredFd.c.o.d"
+  "/root/repo/src/client/hzl_ClientProcessReceivedSecuredTp.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientProcessReceivedSecuredTp.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientProcessReceivedSecuredTp.c.o.d"
+  "/root/repo/src/client/hzl_ClientUnpackHeader.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientUnpackHeader.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientUnpackHeader.c.o.d"
+  "/root/repo/src/common/hzl_CommonBuildRequest.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonBuildRequest.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonBuildRequest.c.o.d"
+  "/root/repo/src/common/hzl_CommonBuildResponse.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonBuildResponse.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonBuildResponse.c.o.d"
+  "/root/repo/src/common/hzl_CommonBuildSecuredFd.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonBuildSecuredFd.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonBuildSecuredFd.c.o.d"
+  "/root/repo/src/common/hzl_CommonBuildUnsecured.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonBuildUnsecured.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonBuildUnsecured.c.o.d"
+  "/root/repo/src/common/hzl_CommonCtrDelay.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonCtrDelay.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonCtrDelay.c.o.d"
+  "/root/repo/src/common/hzl_CommonCtrNonce.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonCtrNonce.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonCtrNonce.c.o.d"
+  "/root/repo/src/common/hzl_CommonEndian.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonEndian.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonEndian.c.o.d"
+  "/root/repo/src/common/hzl_CommonHeader.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonHeader.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonHeader.c.o.d"
+  "/root/repo/src/common/hzl_CommonOsNewMsg.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonOsNewMsg.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonOsNewMsg.c.o.d"
+  "/root/repo/src/common/hzl_CommonOsTime.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonOsTime.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonOsTime.c.o.d"
+  "/root/repo/src/common/hzl_CommonOsTrng.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonOsTrng.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonOsTrng.c.o.d"
+  "/root/repo/src/common/hzl_CommonPacking.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonPacking.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonPacking.c.o.d"
+  "/root/repo/src/common/hzl_CommonProcessReceivedInPlace.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonProcessReceivedInPlace.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonProcessReceivedInPlace.c.o.d"
+  "/root/repo/src/common/hzl_CommonProcessReceivedUnsecured.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonProcessReceivedUnsecured.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonProcessReceivedUnsecured.c.o.d"
+  "/root/repo/src/common/hzl_CommonSecuredTp.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonSecuredTp.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonSecuredTp.c.o.d"
+  "/root/repo/src/common/hzl_CommonTimeDelta.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonTimeDelta.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonTimeDelta.c.o.d"
+  "/root/repo/src/common/hzl_CommonUtils.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonUtils.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonUtils.c.o.d"
+  "/root/repo/src/crypto/generic/hzl_CryptoGenericAeadShort.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/crypto/generic/hzl_CryptoGenericAeadShort.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/crypto/generic/hzl_CryptoGenericAeadShort.c.o.d"
+  "/root/repo/src/crypto/libascon/hzl_CryptoLibasconAead.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/crypto/libascon/hzl_CryptoLibasconAead.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/crypto/libascon/hzl_CryptoLibasconAead.c.o.d"
+  "/root/repo/src/crypto/libascon/hzl_CryptoLibasconHash.c" "CMakeFiles/hzl_client_desktop_shared.dir/src/crypto/libascon/hzl_CryptoLibasconHash.c.o" "gcc" "CMakeFiles/hzl_client_desktop_shared.dir/src/crypto/libascon/hzl_CryptoLibasconHash.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
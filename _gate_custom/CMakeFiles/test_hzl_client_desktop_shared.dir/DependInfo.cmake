@@ -0,0 +1,44 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/external/atto/src/atto.c" "CMakeFiles/test_hzl_client_desktop_shared.dir/external/atto/src/atto.c.o" "gcc" "CMakeFiles/test_hzl_client_desktop_shared.dir/external/atto/src/atto.c.o.d"
+  "/root/repo/tst/client/hzlClientTest_BuildRequest.c" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_BuildRequest.c.o" "gcc" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_BuildRequest.c.o.d"
+  "/root/repo/tst/client/hzlClientTest_BuildSecuredFd.c" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_BuildSecuredFd.c.o" "gcc" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_BuildSecuredFd.c.o.d"
+  "/root/repo/tst/client/hzlClientTest_BuildSecuredFdBatch.c" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_BuildSecuredFdBatch.c.o" "gcc" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_BuildSecuredFdBatch.c.o.d"
+  "/root/repo/tst/client/hzlClientTest_BuildSecuredFdInto.c" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_BuildSecuredFdInto.c.o" "gcc" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_BuildSecuredFdInto.c.o.d"
+  "/root/repo/tst/client/hzlClientTest_BuildSecuredTp.c" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_BuildSecuredTp.c.o" "gcc" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_BuildSecuredTp.c.o.d"
+  "/root/repo/tst/client/hzlClientTest_BuildUnsecured.c" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_BuildUnsecured.c.o" "gcc" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_BuildUnsecured.c.o.d"
+  "/root/repo/tst/client/hzlClientTest_Constants.c" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_Constants.c.o" "gcc" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_Constants.c.o.d"
+  "/root/repo/tst/client/hzlClientTest_DeInit.c" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_DeInit.c.o" "gcc" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_DeInit.c.o.d"
+  "/root/repo/tst/client/hzlClientTest_Init.c" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_Init.c.o" "gcc" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_Init.c.o.d"
+  "/root/repo/tst/client/hzlClientTest_InitCheckClientConfig.c" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_InitCheckClientConfig.c.o" "gcc" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_InitCheckClientConfig.c.o.d"
+  "/root/repo/tst/client/hzlClientTest_InitCheckGroupConfigs.c" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_InitCheckGroupConfigs.c.o" "gcc" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_InitCheckGroupConfigs.c.o.d"
+  "/root/repo/tst/client/hzlClientTest_InitCheckIo.c" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_InitCheckIo.c.o" "gcc" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_InitCheckIo.c.o.d"
+  "/root/repo/tst/client/hzlClientTest_Main.c" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_Main.c.o" "gcc" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_Main.c.o.d"
+  "/root/repo/tst/client/hzlClientTest_New.c" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_New.c.o" "gcc" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_New.c.o.d"
+  "/root/repo/tst/client/hzlClientTest_NewMsg.c" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_NewMsg.c.o" "gcc" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_NewMsg.c.o.d"
+  "/root/repo/tst/client/hzlClientTest_ProcessReceived.c" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_ProcessReceived.c.o" "gcc" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_ProcessReceived.c.o.d"
+  "/root/repo/tst/client/hzlClientTest_ProcessReceivedInPlace.c" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_ProcessReceivedInPlace.c.o" "gcc" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_ProcessReceivedInPlace.c.o.d"
+  "/root/repo/tst/client/hzlClientTest_ProcessReceivedRenewal.c" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_ProcessReceivedRenewal.c.o" "gcc" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_ProcessReceivedRenewal.c.o.d"
+  "/root/repo/tst/client/hzlClientTest_ProcessReceivedRequest.c" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_ProcessReceivedRequest.c.o" "gcc" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_ProcessReceivedRequest.c.o.d"
+  "/root/repo/tst/client/hzlClientTest_ProcessReceivedResponse.c" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_ProcessReceivedResponse.c.o" "gcc" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_ProcessReceivedResponse.c.o.d"
+  "/root/repo/tst/client/hzlClientTest_ProcessReceivedSecuredFd.c" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_ProcessReceivedSecuredFd.c.o" "gcc" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_ProcessReceivedSecuredFd.c.o.d"
+  "/root/repo/tst/client/hzlClientTest_ProcessReceivedUnsecured.c" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_ProcessReceivedUnsecured.c.o" "gcc" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_ProcessReceivedUnsecured.c.o.d"
+  "/root/repo/tst/client/hzlClientTest_UnpackHeader.c" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_UnpackHeader.c.o" "gcc" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/client/hzlClientTest_UnpackHeader.c.o.d"
+  "/root/repo/tst/hzlTest_IoMockup.c" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/hzlTest_IoMockup.c.o" "gcc" "CMakeFiles/test_hzl_client_desktop_shared.dir/tst/hzlTest_IoMockup.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_custom/CMakeFiles/hzl_client_desktop_shared.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,21 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_hzl_common_desktop.dir/external/atto/src/atto.c.o"
+  "CMakeFiles/test_hzl_common_desktop.dir/external/atto/src/atto.c.o.d"
+  "CMakeFiles/test_hzl_common_desktop.dir/tst/common/hzlCommonTest_Aead.c.o"
+  "CMakeFiles/test_hzl_common_desktop.dir/tst/common/hzlCommonTest_Aead.c.o.d"
+  "CMakeFiles/test_hzl_common_desktop.dir/tst/common/hzlCommonTest_CtrDelay.c.o"
+  "CMakeFiles/test_hzl_common_desktop.dir/tst/common/hzlCommonTest_CtrDelay.c.o.d"
+  "CMakeFiles/test_hzl_common_desktop.dir/tst/common/hzlCommonTest_CtrNonce.c.o"
+  "CMakeFiles/test_hzl_common_desktop.dir/tst/common/hzlCommonTest_CtrNonce.c.o.d"
+  "CMakeFiles/test_hzl_common_desktop.dir/tst/common/hzlCommonTest_Main.c.o"
+  "CMakeFiles/test_hzl_common_desktop.dir/tst/common/hzlCommonTest_Main.c.o.d"
+  "CMakeFiles/test_hzl_common_desktop.dir/tst/hzlTest_IoMockup.c.o"
+  "CMakeFiles/test_hzl_common_desktop.dir/tst/hzlTest_IoMockup.c.o.d"
+  "test_hzl_common_desktop"
+  "test_hzl_common_desktop.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test_hzl_common_desktop.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,23 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/external/atto/src/atto.c" "CMakeFiles/test_hzl_interop_desktop_shared.dir/external/atto/src/atto.c.o" "gcc" "CMakeFiles/test_hzl_interop_desktop_shared.dir/external/atto/src/atto.c.o.d"
+  "/root/repo/tst/hzlTest_IoMockup.c" "CMakeFiles/test_hzl_interop_desktop_shared.dir/tst/hzlTest_IoMockup.c.o" "gcc" "CMakeFiles/test_hzl_interop_desktop_shared.dir/tst/hzlTest_IoMockup.c.o.d"
+  "/root/repo/tst/interop/hzlInteropTest_Main.c" "CMakeFiles/test_hzl_interop_desktop_shared.dir/tst/interop/hzlInteropTest_Main.c.o" "gcc" "CMakeFiles/test_hzl_interop_desktop_shared.dir/tst/interop/hzlInteropTest_Main.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_custom/CMakeFiles/hzl_client_desktop_shared.dir/DependInfo.cmake"
+  "/root/repo/_gate_custom/CMakeFiles/hzl_server_desktop_shared.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,22 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_gate_custom
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(test_hzl_client_desktop "/root/repo/_gate_custom/test_hzl_client_desktop")
+set_tests_properties(test_hzl_client_desktop PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;500;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_hzl_client_desktop_shared "/root/repo/_gate_custom/test_hzl_client_desktop_shared")
+set_tests_properties(test_hzl_client_desktop_shared PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;502;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_hzl_server_desktop "/root/repo/_gate_custom/test_hzl_server_desktop")
+set_tests_properties(test_hzl_server_desktop PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;592;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_hzl_server_desktop_shared "/root/repo/_gate_custom/test_hzl_server_desktop_shared")
+set_tests_properties(test_hzl_server_desktop_shared PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;594;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_hzl_interop_desktop "/root/repo/_gate_custom/test_hzl_interop_desktop")
+set_tests_properties(test_hzl_interop_desktop PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;650;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_hzl_interop_desktop_shared "/root/repo/_gate_custom/test_hzl_interop_desktop_shared")
+set_tests_properties(test_hzl_interop_desktop_shared PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;652;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_hzl_common_desktop "/root/repo/_gate_custom/test_hzl_common_desktop")
+set_tests_properties(test_hzl_common_desktop PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;691;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_hzl_fixed_header_type "/usr/bin/ctest" "--build-and-test" "/root/repo" "/root/repo/_gate_custom/fixed_header_type" "--build-generator" "Unix Makefiles" "--build-options" "-DHZL_FIXED_HEADER_TYPE=0" "-DCMAKE_BUILD_TYPE=Debug" "-DCMAKE_C_COMPILER=/usr/bin/cc" "-DHZL_THREAD_SAFE=OFF" "--test-command" "/usr/bin/ctest" "--output-on-failure")
+set_tests_properties(test_hzl_fixed_header_type PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;704;add_test;/root/repo/CMakeLists.txt;0;")
@@ -0,0 +1,50 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/client/hzl_ClientBuildRequest.c" "CMakeFiles/hzl_client_any.dir/src/client/hzl_ClientBuildRequest.c.o" "gcc" "CMakeFiles/hzl_client_any.dir/src/client/hzl_ClientBuildRequest.c.o.d"
+  "/root/repo/src/client/hzl_ClientBuildSecuredFd.c" "CMakeFiles/hzl_client_any.dir/src/client/hzl_ClientBuildSecuredFd.c.o" "gcc" "CMakeFiles/hzl_client_any.dir/src/client/hzl_ClientBuildSecuredFd.c.o.d"
+  "/root/repo/src/client/hzl_ClientBuildSecuredTp.c" "CMakeFiles/hzl_client_any.dir/src/client/hzl_ClientBuildSecuredTp.c.o" "gcc" "CMakeFiles/hzl_client_any.dir/src/client/hzl_ClientBuildSecuredTp.c.o.d"
+  "/root/repo/src/client/hzl_ClientBuildUnsecured.c" "CMakeFiles/hzl_client_any.dir/src/client/hzl_ClientBuildUnsecured.c.o" "gcc" "CMakeFiles/hzl_client_any.dir/src/client/hzl_ClientBuildUnsecured.c.o.d"
+  "/root/repo/src/client/hzl_ClientDeinit.c" "CMakeFiles/hzl_client_any.dir/src/client/hzl_ClientDeinit.c.o" "gcc" "CMakeFiles/hzl_client_any.dir/src/client/hzl_ClientDeinit.c.o.d"
+  "/root/repo/src/client/hzl_ClientGroup.c" "CMakeFiles/hzl_client_any.dir/src/client/hzl_ClientGroup.c.o" "gcc" "CMakeFiles/hzl_client_any.dir/src/client/hzl_ClientGroup.c.o.d"
+  "/root/repo/src/client/hzl_ClientInit.c" "CMakeFiles/hzl_client_any.dir/src/client/hzl_ClientInit.c.o" "gcc" "CMakeFiles/hzl_client_any.dir/src/client/hzl_ClientInit.c.o.d"
+  "/root/repo/src/client/hzl_ClientProcessReceived.c" "CMakeFiles/hzl_client_any.dir/src/client/hzl_ClientProcessReceived.c.o" "gcc" "CMakeFiles/hzl_client_any.dir/src/client/hzl_ClientProcessReceived.c.o.d"
+  "/root/repo/src/client/hzl_ClientProcessReceivedInPlace.c" "CMakeFiles/hzl_client_any.dir/src/client/hzl_ClientProcessReceivedInPlace.c.o" "gcc" "CMakeFiles/hzl_client_any.dir/src/client/hzl_ClientProcessReceivedInPlace.c.o.d"
+  "/root/repo/src/client/hzl_ClientProcessReceivedRenewal.c" "CMakeFiles/hzl_client_any.dir/src/client/hzl_ClientProcessReceivedRenewal.c.o" "gcc" "CMakeFiles/hzl_client_any.dir/src/client/hzl_ClientProcessReceivedRenewal.c.o.d"
+  "/root/repo/src/client/hzl_ClientProcessReceivedResponse.c" "CMakeFiles/hzl_client_any.dir/src/client/hzl_ClientProcessReceivedResponse.c.o" "gcc" "CMakeFiles/hzl_client_any.dir/src/client/hzl_ClientProcessReceivedResponse.c.o.d"
+  "/root/repo/src/client/hzl_ClientProcessReceivedSecuredFd.c" "CMakeFiles/hzl_client_any.dir/src/client/hzl_ClientProcessReceivedSecuredFd.c.o" "gcc" "CMakeFiles/hzl_client_any.dir/src/client/hzl_ClientProcessReceivedSecuredFd.c.o.d"
+  "/root/repo/src/client/hzl_ClientProcessReceivedSecuredTp.c" "CMakeFiles/hzl_client_any.dir/src/client/hzl_ClientProcessReceivedSecuredTp.c.o" "gcc" "CMakeFiles/hzl_client_any.dir/src/client/hzl_ClientProcessReceivedSecuredTp.c.o.d"
+  "/root/repo/src/client/hzl_ClientUnpackHeader.c" "CMakeFiles/hzl_client_any.dir/src/client/hzl_ClientUnpackHeader.c.o" "gcc" "CMakeFiles/hzl_client_any.dir/src/client/hzl_ClientUnpackHeader.c.o.d"
+  "/root/repo/src/common/hzl_CommonBuildRequest.c" "CMakeFiles/hzl_client_any.dir/src/common/hzl_CommonBuildRequest.c.o" "gcc" "CMakeFiles/hzl_client_any.dir/src/common/hzl_CommonBuildRequest.c.o.d"
+  "/root/repo/src/common/hzl_CommonBuildResponse.c" "CMakeFiles/hzl_client_any.dir/src/common/hzl_CommonBuildResponse.c.o" "gcc" "CMakeFiles/hzl_client_any.dir/src/common/hzl_CommonBuildResponse.c.o.d"
+  "/root/repo/src/common/hzl_CommonBuildSecuredFd.c" "CMakeFiles/hzl_client_any.dir/src/common/hzl_CommonBuildSecuredFd.c.o" "gcc" "CMakeFiles/hzl_client_any.dir/src/common/hzl_CommonBuildSecuredFd.c.o.d"
+  "/root/repo/src/common/hzl_CommonBuildUnsecured.c" "CMakeFiles/hzl_client_any.dir/src/common/hzl_CommonBuildUnsecured.c.o" "gcc" "CMakeFiles/hzl_client_any.dir/src/common/hzl_CommonBuildUnsecured.c.o.d"
+  "/root/repo/src/common/hzl_CommonCtrDelay.c" "CMakeFiles/hzl_client_any.dir/src/common/hzl_CommonCtrDelay.c.o" "gcc" "CMakeFiles/hzl_client_any.dir/src/common/hzl_CommonCtrDelay.c.o.d"
+  "/root/repo/src/common/hzl_CommonCtrNonce.c" "CMakeFiles/hzl_client_any.dir/src/common/hzl_CommonCtrNonce.c.o" "gcc" "CMakeFiles/hzl_client_any.dir/src/common/hzl_CommonCtrNonce.c.o.d"
+  "/root/repo/src/common/hzl_CommonEndian.c" "CMakeFiles/hzl_client_any.dir/src/common/hzl_CommonEndian.c.o" "gcc" "CMakeFiles/hzl_client_any.dir/src/common/hzl_CommonEndian.c.o.d"
+  "/root/repo/src/common/hzl_CommonHeader.c" "CMakeFiles/hzl_client_any.dir/src/common/hzl_CommonHeader.c.o" "gcc" "CMakeFiles/hzl_client_any.dir/src/common/hzl_CommonHeader.c.o.d"
+  "/root/repo/src/common/hzl_CommonPacking.c" "CMakeFiles/hzl_client_any.dir/src/common/hzl_CommonPacking.c.o" "gcc" "CMakeFiles/hzl_client_any.dir/src/common/hzl_CommonPacking.c.o.d"
+  "/root/repo/src/common/hzl_CommonProcessReceivedInPlace.c" "CMakeFiles/hzl_client_any.dir/src/common/hzl_CommonProcessReceivedInPlace.c.o" "gcc" "CMakeFiles/hzl_client_any.dir/src/common/hzl_CommonProcessReceivedInPlace.c.o.d"
+  "/root/repo/src/common/hzl_CommonProcessReceivedUnsecured.c" "CMakeFiles/hzl_client_any.dir/src/common/hzl_CommonProcessReceivedUnsecured.c.o" "gcc" "CMakeFiles/hzl_client_any.dir/src/common/hzl_CommonProcessReceivedUnsecured.c.o.d"
+  "/root/repo/src/common/hzl_CommonSecuredTp.c" "CMakeFiles/hzl_client_any.dir/src/common/hzl_CommonSecuredTp.c.o" "gcc" "CMakeFiles/hzl_client_any.dir/src/common/hzl_CommonSecuredTp.c.o.d"
+  "/root/repo/src/common/hzl_CommonTimeDelta.c" "CMakeFiles/hzl_client_any.dir/src/common/hzl_CommonTimeDelta.c.o" "gcc" "CMakeFiles/hzl_client_any.dir/src/common/hzl_CommonTimeDelta.c.o.d"
+  "/root/repo/src/common/hzl_CommonUtils.c" "CMakeFiles/hzl_client_any.dir/src/common/hzl_CommonUtils.c.o" "gcc" "CMakeFiles/hzl_client_any.dir/src/common/hzl_CommonUtils.c.o.d"
+  "/root/repo/src/crypto/libascon/hzl_CryptoLibasconAead.c" "CMakeFiles/hzl_client_any.dir/src/crypto/libascon/hzl_CryptoLibasconAead.c.o" "gcc" "CMakeFiles/hzl_client_any.dir/src/crypto/libascon/hzl_CryptoLibasconAead.c.o.d"
+  "/root/repo/src/crypto/libascon/hzl_CryptoLibasconAeadShort.c" "CMakeFiles/hzl_client_any.dir/src/crypto/libascon/hzl_CryptoLibasconAeadShort.c.o" "gcc" "CMakeFiles/hzl_client_any.dir/src/crypto/libascon/hzl_CryptoLibasconAeadShort.c.o.d"
+  "/root/repo/src/crypto/libascon/hzl_CryptoLibasconHash.c" "CMakeFiles/hzl_client_any.dir/src/crypto/libascon/hzl_CryptoLibasconHash.c.o" "gcc" "CMakeFiles/hzl_client_any.dir/src/crypto/libascon/hzl_CryptoLibasconHash.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_custom/fixed_header_type/external/libascon/CMakeFiles/ascon128hash.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,62 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/common/hzl_CommonBuildRequest.c" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonBuildRequest.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonBuildRequest.c.o.d"
+  "/root/repo/src/common/hzl_CommonBuildResponse.c" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonBuildResponse.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonBuildResponse.c.o.d"
+  "/root/repo/src/common/hzl_CommonBuildSecuredFd.c" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonBuildSecuredFd.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonBuildSecuredFd.c.o.d"
+  "/root/repo/src/common/hzl_CommonBuildUnsecured.c" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonBuildUnsecured.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonBuildUnsecured.c.o.d"
+  "/root/repo/src/common/hzl_CommonCtrDelay.c" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonCtrDelay.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonCtrDelay.c.o.d"
+  "/root/repo/src/common/hzl_CommonCtrNonce.c" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonCtrNonce.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonCtrNonce.c.o.d"
+  "/root/repo/src/common/hzl_CommonEndian.c" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonEndian.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonEndian.c.o.d"
+  "/root/repo/src/common/hzl_CommonHeader.c" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonHeader.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonHeader.c.o.d"
+  "/root/repo/src/common/hzl_CommonOsNewMsg.c" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonOsNewMsg.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonOsNewMsg.c.o.d"
+  "/root/repo/src/common/hzl_CommonOsTime.c" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonOsTime.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonOsTime.c.o.d"
+  "/root/repo/src/common/hzl_CommonOsTrng.c" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonOsTrng.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonOsTrng.c.o.d"
+  "/root/repo/src/common/hzl_CommonPacking.c" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonPacking.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonPacking.c.o.d"
+  "/root/repo/src/common/hzl_CommonProcessReceivedInPlace.c" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonProcessReceivedInPlace.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonProcessReceivedInPlace.c.o.d"
+  "/root/repo/src/common/hzl_CommonProcessReceivedUnsecured.c" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonProcessReceivedUnsecured.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonProcessReceivedUnsecured.c.o.d"
+  "/root/repo/src/common/hzl_CommonSecuredTp.c" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonSecuredTp.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonSecuredTp.c.o.d"
+  "/root/repo/src/common/hzl_CommonTimeDelta.c" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonTimeDelta.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonTimeDelta.c.o.d"
+  "/root/repo/src/common/hzl_CommonUtils.c" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonUtils.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/common/hzl_CommonUtils.c.o.d"
+  "/root/repo/src/crypto/libascon/hzl_CryptoLibasconAead.c" "CMakeFiles/hzl_server_desktop.dir/src/crypto/libascon/hzl_CryptoLibasconAead.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/crypto/libascon/hzl_CryptoLibasconAead.c.o.d"
+  "/root/repo/src/crypto/libascon/hzl_CryptoLibasconAeadShort.c" "CMakeFiles/hzl_server_desktop.dir/src/crypto/libascon/hzl_CryptoLibasconAeadShort.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/crypto/libascon/hzl_CryptoLibasconAeadShort.c.o.d"
+  "/root/repo/src/crypto/libascon/hzl_CryptoLibasconHash.c" "CMakeFiles/hzl_server_desktop.dir/src/crypto/libascon/hzl_CryptoLibasconHash.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/crypto/libascon/hzl_CryptoLibasconHash.c.o.d"
+  "/root/repo/src/server/hzl_ServerBuildSecuredFd.c" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerBuildSecuredFd.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerBuildSecuredFd.c.o.d"
+  "/root/repo/src/server/hzl_ServerBuildSecuredTp.c" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerBuildSecuredTp.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerBuildSecuredTp.c.o.d"
+  "/root/repo/src/server/hzl_ServerBuildUnsecured.c" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerBuildUnsecured.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerBuildUnsecured.c.o.d"
+  "/root/repo/src/server/hzl_ServerCurrentTimeCoarse.c" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerCurrentTimeCoarse.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerCurrentTimeCoarse.c.o.d"
+  "/root/repo/src/server/hzl_ServerDeInit.c" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerDeInit.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerDeInit.c.o.d"
+  "/root/repo/src/server/hzl_ServerForceSessionRenewal.c" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerForceSessionRenewal.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerForceSessionRenewal.c.o.d"
+  "/root/repo/src/server/hzl_ServerFree.c" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerFree.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerFree.c.o.d"
+  "/root/repo/src/server/hzl_ServerGroup.c" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerGroup.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerGroup.c.o.d"
+  "/root/repo/src/server/hzl_ServerInit.c" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerInit.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerInit.c.o.d"
+  "/root/repo/src/server/hzl_ServerNew.c" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerNew.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerNew.c.o.d"
+  "/root/repo/src/server/hzl_ServerNewMsg.c" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerNewMsg.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerNewMsg.c.o.d"
+  "/root/repo/src/server/hzl_ServerPrepareNextSessions.c" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerPrepareNextSessions.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerPrepareNextSessions.c.o.d"
+  "/root/repo/src/server/hzl_ServerProcessReceived.c" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerProcessReceived.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerProcessReceived.c.o.d"
+  "/root/repo/src/server/hzl_ServerProcessReceivedBatch.c" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerProcessReceivedBatch.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerProcessReceivedBatch.c.o.d"
+  "/root/repo/src/server/hzl_ServerProcessReceivedInPlace.c" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerProcessReceivedInPlace.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerProcessReceivedInPlace.c.o.d"
+  "/root/repo/src/server/hzl_ServerProcessReceivedRequest.c" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerProcessReceivedRequest.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerProcessReceivedRequest.c.o.d"
+  "/root/repo/src/server/hzl_ServerProcessReceivedSecuredFd.c" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerProcessReceivedSecuredFd.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerProcessReceivedSecuredFd.c.o.d"
+  "/root/repo/src/server/hzl_ServerProcessReceivedSecuredTp.c" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerProcessReceivedSecuredTp.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerProcessReceivedSecuredTp.c.o.d"
+  "/root/repo/src/server/hzl_ServerRenewalPhase.c" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerRenewalPhase.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerRenewalPhase.c.o.d"
+  "/root/repo/src/server/hzl_ServerShards.c" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerShards.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerShards.c.o.d"
+  "/root/repo/src/server/hzl_ServerTick.c" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerTick.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerTick.c.o.d"
+  "/root/repo/src/server/hzl_ServerTimerWheel.c" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerTimerWheel.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerTimerWheel.c.o.d"
+  "/root/repo/src/server/hzl_ServerUnpackHeader.c" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerUnpackHeader.c.o" "gcc" "CMakeFiles/hzl_server_desktop.dir/src/server/hzl_ServerUnpackHeader.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_custom/fixed_header_type/external/libascon/CMakeFiles/ascon128hash.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
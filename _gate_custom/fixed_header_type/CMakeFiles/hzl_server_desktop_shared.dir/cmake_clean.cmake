@@ -0,0 +1,95 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonBuildRequest.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonBuildRequest.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonBuildResponse.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonBuildResponse.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonBuildSecuredFd.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonBuildSecuredFd.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonBuildUnsecured.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonBuildUnsecured.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonCtrDelay.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonCtrDelay.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonCtrNonce.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonCtrNonce.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonEndian.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonEndian.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonHeader.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonHeader.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonOsNewMsg.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonOsNewMsg.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonOsTime.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonOsTime.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonOsTrng.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonOsTrng.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonPacking.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonPacking.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonProcessReceivedInPlace.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonProcessReceivedInPlace.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonProcessReceivedUnsecured.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonProcessReceivedUnsecured.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonSecuredTp.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonSecuredTp.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonTimeDelta.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonTimeDelta.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonUtils.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/common/hzl_CommonUtils.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/crypto/libascon/hzl_CryptoLibasconAead.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/crypto/libascon/hzl_CryptoLibasconAead.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/crypto/libascon/hzl_CryptoLibasconAeadShort.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/crypto/libascon/hzl_CryptoLibasconAeadShort.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/crypto/libascon/hzl_CryptoLibasconHash.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/crypto/libascon/hzl_CryptoLibasconHash.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerBuildSecuredFd.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerBuildSecuredFd.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerBuildSecuredTp.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerBuildSecuredTp.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerBuildUnsecured.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerBuildUnsecured.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerCurrentTimeCoarse.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerCurrentTimeCoarse.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerDeInit.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerDeInit.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerForceSessionRenewal.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerForceSessionRenewal.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerFree.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerFree.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerGroup.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerGroup.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerInit.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerInit.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerNew.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerNew.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerNewMsg.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerNewMsg.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerPrepareNextSessions.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerPrepareNextSessions.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerProcessReceived.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerProcessReceived.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerProcessReceivedBatch.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerProcessReceivedBatch.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerProcessReceivedInPlace.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerProcessReceivedInPlace.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerProcessReceivedRequest.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerProcessReceivedRequest.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerProcessReceivedSecuredFd.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerProcessReceivedSecuredFd.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerProcessReceivedSecuredTp.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerProcessReceivedSecuredTp.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerRenewalPhase.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerRenewalPhase.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerShards.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerShards.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerTick.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerTick.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerTimerWheel.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerTimerWheel.c.o.d"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerUnpackHeader.c.o"
+  "CMakeFiles/hzl_server_desktop_shared.dir/src/server/hzl_ServerUnpackHeader.c.o.d"
+  "libhzl_server.pdb"
+  "libhzl_server.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/hzl_server_desktop_shared.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
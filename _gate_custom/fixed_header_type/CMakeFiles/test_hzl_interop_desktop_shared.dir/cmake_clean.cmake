@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_hzl_interop_desktop_shared.dir/external/atto/src/atto.c.o"
+  "CMakeFiles/test_hzl_interop_desktop_shared.dir/external/atto/src/atto.c.o.d"
+  "CMakeFiles/test_hzl_interop_desktop_shared.dir/tst/hzlTest_IoMockup.c.o"
+  "CMakeFiles/test_hzl_interop_desktop_shared.dir/tst/hzlTest_IoMockup.c.o.d"
+  "CMakeFiles/test_hzl_interop_desktop_shared.dir/tst/interop/hzlInteropTest_Main.c.o"
+  "CMakeFiles/test_hzl_interop_desktop_shared.dir/tst/interop/hzlInteropTest_Main.c.o.d"
+  "test_hzl_interop_desktop_shared"
+  "test_hzl_interop_desktop_shared.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test_hzl_interop_desktop_shared.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
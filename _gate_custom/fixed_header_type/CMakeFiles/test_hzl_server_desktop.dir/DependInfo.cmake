@@ -0,0 +1,50 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/external/atto/src/atto.c" "CMakeFiles/test_hzl_server_desktop.dir/external/atto/src/atto.c.o" "gcc" "CMakeFiles/test_hzl_server_desktop.dir/external/atto/src/atto.c.o.d"
+  "/root/repo/tst/hzlTest_IoMockup.c" "CMakeFiles/test_hzl_server_desktop.dir/tst/hzlTest_IoMockup.c.o" "gcc" "CMakeFiles/test_hzl_server_desktop.dir/tst/hzlTest_IoMockup.c.o.d"
+  "/root/repo/tst/server/hzlServerTest_BuildSecuredFd.c" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_BuildSecuredFd.c.o" "gcc" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_BuildSecuredFd.c.o.d"
+  "/root/repo/tst/server/hzlServerTest_BuildSecuredFdBatch.c" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_BuildSecuredFdBatch.c.o" "gcc" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_BuildSecuredFdBatch.c.o.d"
+  "/root/repo/tst/server/hzlServerTest_BuildSecuredFdInto.c" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_BuildSecuredFdInto.c.o" "gcc" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_BuildSecuredFdInto.c.o.d"
+  "/root/repo/tst/server/hzlServerTest_BuildSecuredTp.c" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_BuildSecuredTp.c.o" "gcc" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_BuildSecuredTp.c.o.d"
+  "/root/repo/tst/server/hzlServerTest_BuildUnsecured.c" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_BuildUnsecured.c.o" "gcc" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_BuildUnsecured.c.o.d"
+  "/root/repo/tst/server/hzlServerTest_Constants.c" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_Constants.c.o" "gcc" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_Constants.c.o.d"
+  "/root/repo/tst/server/hzlServerTest_DeInit.c" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_DeInit.c.o" "gcc" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_DeInit.c.o.d"
+  "/root/repo/tst/server/hzlServerTest_ForceSessionRenewal.c" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ForceSessionRenewal.c.o" "gcc" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ForceSessionRenewal.c.o.d"
+  "/root/repo/tst/server/hzlServerTest_Init.c" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_Init.c.o" "gcc" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_Init.c.o.d"
+  "/root/repo/tst/server/hzlServerTest_InitCheckClientConfig.c" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_InitCheckClientConfig.c.o" "gcc" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_InitCheckClientConfig.c.o.d"
+  "/root/repo/tst/server/hzlServerTest_InitCheckGroupConfigs.c" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_InitCheckGroupConfigs.c.o" "gcc" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_InitCheckGroupConfigs.c.o.d"
+  "/root/repo/tst/server/hzlServerTest_InitCheckIo.c" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_InitCheckIo.c.o" "gcc" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_InitCheckIo.c.o.d"
+  "/root/repo/tst/server/hzlServerTest_InitCheckServerConfig.c" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_InitCheckServerConfig.c.o" "gcc" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_InitCheckServerConfig.c.o.d"
+  "/root/repo/tst/server/hzlServerTest_Main.c" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_Main.c.o" "gcc" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_Main.c.o.d"
+  "/root/repo/tst/server/hzlServerTest_New.c" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_New.c.o" "gcc" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_New.c.o.d"
+  "/root/repo/tst/server/hzlServerTest_PrepareNextSessions.c" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_PrepareNextSessions.c.o" "gcc" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_PrepareNextSessions.c.o.d"
+  "/root/repo/tst/server/hzlServerTest_ProcessReceived.c" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ProcessReceived.c.o" "gcc" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ProcessReceived.c.o.d"
+  "/root/repo/tst/server/hzlServerTest_ProcessReceivedBatch.c" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ProcessReceivedBatch.c.o" "gcc" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ProcessReceivedBatch.c.o.d"
+  "/root/repo/tst/server/hzlServerTest_ProcessReceivedInPlace.c" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ProcessReceivedInPlace.c.o" "gcc" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ProcessReceivedInPlace.c.o.d"
+  "/root/repo/tst/server/hzlServerTest_ProcessReceivedRequest.c" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ProcessReceivedRequest.c.o" "gcc" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ProcessReceivedRequest.c.o.d"
+  "/root/repo/tst/server/hzlServerTest_ProcessReceivedSecuredFd.c" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ProcessReceivedSecuredFd.c.o" "gcc" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ProcessReceivedSecuredFd.c.o.d"
+  "/root/repo/tst/server/hzlServerTest_ProcessReceivedServerOnlyMsg.c" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ProcessReceivedServerOnlyMsg.c.o" "gcc" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ProcessReceivedServerOnlyMsg.c.o.d"
+  "/root/repo/tst/server/hzlServerTest_ProcessReceivedUnsecured.c" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ProcessReceivedUnsecured.c.o" "gcc" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ProcessReceivedUnsecured.c.o.d"
+  "/root/repo/tst/server/hzlServerTest_ShardsNew.c" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ShardsNew.c.o" "gcc" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ShardsNew.c.o.d"
+  "/root/repo/tst/server/hzlServerTest_ShardsSubmitReceived.c" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ShardsSubmitReceived.c.o" "gcc" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ShardsSubmitReceived.c.o.d"
+  "/root/repo/tst/server/hzlServerTest_ShardsSubmitSecuredFd.c" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ShardsSubmitSecuredFd.c.o" "gcc" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ShardsSubmitSecuredFd.c.o.d"
+  "/root/repo/tst/server/hzlServerTest_Tick.c" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_Tick.c.o" "gcc" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_Tick.c.o.d"
+  "/root/repo/tst/server/hzlServerTest_UnpackHeader.c" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_UnpackHeader.c.o" "gcc" "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_UnpackHeader.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_custom/fixed_header_type/CMakeFiles/hzl_server_desktop.dir/DependInfo.cmake"
+  "/root/repo/_gate_custom/fixed_header_type/external/libascon/CMakeFiles/ascon128hash.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
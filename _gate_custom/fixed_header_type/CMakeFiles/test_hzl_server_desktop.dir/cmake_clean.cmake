@@ -0,0 +1,69 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_hzl_server_desktop.dir/external/atto/src/atto.c.o"
+  "CMakeFiles/test_hzl_server_desktop.dir/external/atto/src/atto.c.o.d"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/hzlTest_IoMockup.c.o"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/hzlTest_IoMockup.c.o.d"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_BuildSecuredFd.c.o"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_BuildSecuredFd.c.o.d"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_BuildSecuredFdBatch.c.o"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_BuildSecuredFdBatch.c.o.d"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_BuildSecuredFdInto.c.o"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_BuildSecuredFdInto.c.o.d"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_BuildSecuredTp.c.o"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_BuildSecuredTp.c.o.d"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_BuildUnsecured.c.o"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_BuildUnsecured.c.o.d"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_Constants.c.o"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_Constants.c.o.d"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_DeInit.c.o"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_DeInit.c.o.d"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ForceSessionRenewal.c.o"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ForceSessionRenewal.c.o.d"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_Init.c.o"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_Init.c.o.d"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_InitCheckClientConfig.c.o"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_InitCheckClientConfig.c.o.d"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_InitCheckGroupConfigs.c.o"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_InitCheckGroupConfigs.c.o.d"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_InitCheckIo.c.o"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_InitCheckIo.c.o.d"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_InitCheckServerConfig.c.o"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_InitCheckServerConfig.c.o.d"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_Main.c.o"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_Main.c.o.d"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_New.c.o"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_New.c.o.d"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_PrepareNextSessions.c.o"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_PrepareNextSessions.c.o.d"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ProcessReceived.c.o"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ProcessReceived.c.o.d"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ProcessReceivedBatch.c.o"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ProcessReceivedBatch.c.o.d"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ProcessReceivedInPlace.c.o"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ProcessReceivedInPlace.c.o.d"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ProcessReceivedRequest.c.o"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ProcessReceivedRequest.c.o.d"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ProcessReceivedSecuredFd.c.o"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ProcessReceivedSecuredFd.c.o.d"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ProcessReceivedServerOnlyMsg.c.o"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ProcessReceivedServerOnlyMsg.c.o.d"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ProcessReceivedUnsecured.c.o"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ProcessReceivedUnsecured.c.o.d"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ShardsNew.c.o"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ShardsNew.c.o.d"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ShardsSubmitReceived.c.o"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ShardsSubmitReceived.c.o.d"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ShardsSubmitSecuredFd.c.o"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_ShardsSubmitSecuredFd.c.o.d"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_Tick.c.o"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_Tick.c.o.d"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_UnpackHeader.c.o"
+  "CMakeFiles/test_hzl_server_desktop.dir/tst/server/hzlServerTest_UnpackHeader.c.o.d"
+  "test_hzl_server_desktop"
+  "test_hzl_server_desktop.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test_hzl_server_desktop.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,21 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_gate_custom/fixed_header_type
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(test_hzl_client_desktop "/root/repo/_gate_custom/fixed_header_type/test_hzl_client_desktop")
+set_tests_properties(test_hzl_client_desktop PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;500;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_hzl_client_desktop_shared "/root/repo/_gate_custom/fixed_header_type/test_hzl_client_desktop_shared")
+set_tests_properties(test_hzl_client_desktop_shared PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;502;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_hzl_server_desktop "/root/repo/_gate_custom/fixed_header_type/test_hzl_server_desktop")
+set_tests_properties(test_hzl_server_desktop PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;592;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_hzl_server_desktop_shared "/root/repo/_gate_custom/fixed_header_type/test_hzl_server_desktop_shared")
+set_tests_properties(test_hzl_server_desktop_shared PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;594;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_hzl_interop_desktop "/root/repo/_gate_custom/fixed_header_type/test_hzl_interop_desktop")
+set_tests_properties(test_hzl_interop_desktop PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;650;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_hzl_interop_desktop_shared "/root/repo/_gate_custom/fixed_header_type/test_hzl_interop_desktop_shared")
+set_tests_properties(test_hzl_interop_desktop_shared PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;652;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_hzl_common_desktop "/root/repo/_gate_custom/fixed_header_type/test_hzl_common_desktop")
+set_tests_properties(test_hzl_common_desktop PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;690;add_test;/root/repo/CMakeLists.txt;0;")
+subdirs("external/libascon")
@@ -0,0 +1,253 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Hazelnet Server public API, addon for multi-threaded Servers on a Unix-like OS.
+ *
+ * Hazelnet implements the CAN Bus Security (CBS) protocol, which secures the CAN FD
+ * traffic providing encryption, authenticity and freshness of the messages.
+ *
+ * This header adds to the hzl_Server.h header, providing a sharded Server runtime: the Groups
+ * are partitioned across worker threads (shards), each one the only owner of the state of its
+ * Groups. Messages to process or to build are routed to the shard owning their Group through
+ * a lock-free single-producer single-consumer ring, so the throughput scales with the cores
+ * without any lock between the shards.
+ *
+ * The shards share the configuration and the arrays of the Server context, each one touching
+ * only the Group states of its Groups. The Group with GID `gid` is owned by the shard
+ * `gid % amountOfShards`.
+ */
+
+#ifndef HZL_SERVER_SHARDS_H_
+#define HZL_SERVER_SHARDS_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "hzl.h"
+#include "hzl_Server.h"
+
+#if HZL_OS_AVAILABLE_NIX
+
+/** Maximum amount of shards, i.e. of worker threads, of a sharded Server. */
+#define HZL_SERVER_MAX_AMOUNT_OF_SHARDS 64U
+
+/**
+ * Function called by a shard's worker thread with the outcome of each received message
+ * submitted with hzl_ServerShardsSubmitReceived().
+ *
+ * Called concurrently by the different shards, in the submission order within each shard.
+ * The pointed data is valid only during the call: copy out what is needed later.
+ *
+ * @param [in] userData as in #hzl_ServerShardsConfig_t.userData
+ * @param [in] shardIndex index of the shard processing the message, in
+ *        [0, #hzl_ServerShardsConfig_t.amountOfShards[
+ * @param [in] result same value hzl_ServerProcessReceived() returns for the message
+ * @param [in] receivedHeader header of the message, as unpacked when submitted, telling
+ *        its Group, source and type even when it carries no user data
+ * @param [in] reactionPdu automatic reaction to transmit, if its
+ *        #hzl_CbsPduMsg_t.dataLen is non-zero, even if \p result is non-OK
+ * @param [in] receivedUserData user data extracted out of the message, as in
+ *        hzl_ServerProcessReceived()
+ */
+typedef void (* hzl_ServerShardsProcessedFunc)(void* userData,
+                                               size_t shardIndex,
+                                               hzl_Err_t result,
+                                               const hzl_Header_t* receivedHeader,
+                                               const hzl_CbsPduMsg_t* reactionPdu,
+                                               const hzl_RxSduMsg_t* receivedUserData);
+
+/**
+ * Function called by a shard's worker thread with each SADFD message built upon
+ * hzl_ServerShardsSubmitSecuredFd().
+ *
+ * Called concurrently by the different shards, in the submission order within each shard.
+ * The pointed data is valid only during the call: copy out what is needed later.
+ *
+ * @param [in] userData as in #hzl_ServerShardsConfig_t.userData
+ * @param [in] shardIndex index of the shard building the message, in
+ *        [0, #hzl_ServerShardsConfig_t.amountOfShards[
+ * @param [in] result same value hzl_ServerBuildSecuredFd() returns for the message
+ * @param [in] securedPdu message to transmit if \p result is #HZL_OK
+ */
+typedef void (* hzl_ServerShardsBuiltFunc)(void* userData,
+                                           size_t shardIndex,
+                                           hzl_Err_t result,
+                                           const hzl_CbsPduMsg_t* securedPdu);
+
+/** Configuration of a sharded Server. */
+typedef struct hzl_ServerShardsConfig
+{
+    /**
+     * Amount of shards, each with its own worker thread.
+     *
+     * Must be in [1, #HZL_SERVER_MAX_AMOUNT_OF_SHARDS]. Shards beyond the amount of Groups
+     * own no Group and stay idle.
+     */
+    HZL_SET_BY_USER size_t amountOfShards;
+    /**
+     * Amount of messages each ring can queue before the submissions fail with
+     * #HZL_ERR_SHARD_RING_FULL.
+     *
+     * Must be a power of 2 of at least 2. Each shard has one ring for the received
+     * messages and one for the messages to build.
+     */
+    HZL_SET_BY_USER size_t ringCapacity;
+    /** Handler of the processed received messages. Must not be NULL. */
+    HZL_SET_BY_USER hzl_ServerShardsProcessedFunc onProcessed;
+    /** Handler of the built messages. May be NULL if no message is submitted for building. */
+    HZL_SET_BY_USER hzl_ServerShardsBuiltFunc onBuilt;
+    /** Passed as-is to the handlers. May be NULL. */
+    HZL_SET_BY_USER void* userData;
+} hzl_ServerShardsConfig_t;
+
+/** Sharded Server runtime, opaque to the user. */
+typedef struct hzl_ServerShards hzl_ServerShards_t;
+
+/**
+ * Allocates a sharded Server on the heap, running the given initialised Server context on
+ * #hzl_ServerShardsConfig_t.amountOfShards worker threads.
+ *
+ * The SADTP reception buffers of the context, if any, are split among the shards in
+ * contiguous slices of equal size.
+ *
+ * @warning
+ * The context must not be used directly until hzl_ServerShardsFree() returns, as the
+ * worker threads update its Group states. The #hzl_Io_t functions of the context are called
+ * concurrently by the worker threads and thus must be thread safe, as the OS ones set by
+ * hzl_ServerNew() are.
+ *
+ * It's up to the user to free the sharded Server with hzl_ServerShardsFree().
+ *
+ * @param [out] pShards where to load the new sharded Server. Must not be NULL.
+ * @param [in, out] ctx Server context initialised with hzl_ServerInit() or hzl_ServerNew().
+ *        Must not be NULL and must outlive the sharded Server.
+ * @param [in] config configuration of the sharded Server, copied. Must not be NULL.
+ *
+ * @retval #HZL_OK on success.
+ * @retval #HZL_ERR_NULL_CTX if \p pShards or \p ctx is NULL.
+ * @retval #HZL_ERR_NULL_CONFIG_SERVER if \p config is NULL.
+ * @retval #HZL_ERR_CTX_NOT_INITIALISED if \p ctx was not initialised.
+ * @retval #HZL_ERR_INVALID_AMOUNT_OF_SHARDS if the amount of shards is zero or too large.
+ * @retval #HZL_ERR_INVALID_RING_CAPACITY if the ring capacity is not a power of 2 of
+ *         at least 2.
+ * @retval #HZL_ERR_NULL_SHARDS_CALLBACK if #hzl_ServerShardsConfig_t.onProcessed is NULL.
+ * @retval #HZL_ERR_MALLOC_FAILED if the heap-allocation fails (out of memory).
+ * @retval #HZL_ERR_CANNOT_START_THREAD if a worker thread cannot be started.
+ */
+HZL_API hzl_Err_t
+hzl_ServerShardsNew(hzl_ServerShards_t** pShards,
+                    hzl_ServerCtx_t* ctx,
+                    const hzl_ServerShardsConfig_t* config);
+
+/**
+ * Processes all the messages submitted so far, stops the worker threads, frees the sharded
+ * Server and sets the pointer to it to NULL, to avoid use-after-free and double-free.
+ *
+ * The Server context can be used directly again once this function returns.
+ *
+ * @param [in] pShards address of the pointer to the sharded Server. If NULL or if \p *pShards
+ *        is NULL, the function does nothing.
+ */
+HZL_API void
+hzl_ServerShardsFree(hzl_ServerShards_t** pShards);
+
+/**
+ * Routes a received message to the shard owning its Group, which processes it as
+ * hzl_ServerProcessReceived() and passes the outcome to
+ * #hzl_ServerShardsConfig_t.onProcessed.
+ *
+ * The message is copied, so \p receivedPdu can be reused right away. Only the header is
+ * unpacked here and the reception timestamp is taken, everything else is done by the shard.
+ *
+ * @warning
+ * This function must always be called from the same thread (the single producer of the
+ * rings of received messages), which can be a different one than the one calling
+ * hzl_ServerShardsSubmitSecuredFd().
+ *
+ * @param [in, out] shards sharded Server. Must not be NULL.
+ * @param [in] receivedPdu packed CBS message as received from the underlying layer.
+ *        Not NULL.
+ * @param [in] receivedPduLen length of \p receivedPdu in bytes, at most
+ *        #HZL_MAX_CAN_FD_DATA_LEN.
+ * @param [in] receivedCanId identifier of the underlying layer's PDU.
+ *
+ * @retval #HZL_OK when the message is queued to its shard.
+ * @retval #HZL_ERR_NULL_CTX if \p shards is NULL.
+ * @retval Same values as hzl_ServerUnpackHeader() for a message without a valid header.
+ * @retval #HZL_ERR_TOO_LONG_CIPHERTEXT if \p receivedPduLen is larger than
+ *         #HZL_MAX_CAN_FD_DATA_LEN.
+ * @retval #HZL_ERR_CANNOT_GET_CURRENT_TIME if the reception timestamp cannot be obtained.
+ * @retval #HZL_ERR_SHARD_RING_FULL if the shard has no space left for the message.
+ */
+HZL_API hzl_Err_t
+hzl_ServerShardsSubmitReceived(hzl_ServerShards_t* shards,
+                               const uint8_t* receivedPdu,
+                               size_t receivedPduLen,
+                               hzl_CanId_t receivedCanId);
+
+/**
+ * Routes user data to the shard owning its Group, which builds a SADFD message out of it as
+ * hzl_ServerBuildSecuredFd() and passes it to #hzl_ServerShardsConfig_t.onBuilt.
+ *
+ * The user data is copied, so \p userData can be reused right away.
+ *
+ * @warning
+ * This function must always be called from the same thread (the single producer of the
+ * rings of messages to build), which can be a different one than the one calling
+ * hzl_ServerShardsSubmitReceived().
+ *
+ * @param [in, out] shards sharded Server. Must not be NULL.
+ * @param [in] userData plaintext to encrypt. May be NULL only if \p userDataLen is zero.
+ * @param [in] userDataLen length of \p userData in bytes, at most #HZL_MAX_CAN_FD_DATA_LEN.
+ * @param [in] groupId Group to send the message to.
+ *
+ * @retval #HZL_OK when the user data is queued to its shard.
+ * @retval #HZL_ERR_NULL_CTX if \p shards is NULL.
+ * @retval #HZL_ERR_NULL_SHARDS_CALLBACK if #hzl_ServerShardsConfig_t.onBuilt is NULL.
+ * @retval #HZL_ERR_NULL_SDU if \p userData is NULL and \p userDataLen is not zero.
+ * @retval #HZL_ERR_TOO_LONG_SDU if \p userDataLen is larger than
+ *         #HZL_MAX_CAN_FD_DATA_LEN.
+ * @retval #HZL_ERR_SHARD_RING_FULL if the shard has no space left for the user data.
+ */
+HZL_API hzl_Err_t
+hzl_ServerShardsSubmitSecuredFd(hzl_ServerShards_t* shards,
+                                const uint8_t* userData,
+                                size_t userDataLen,
+                                hzl_Gid_t groupId);
+
+#endif  /* HZL_OS_AVAILABLE_NIX */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* HZL_SERVER_SHARDS_H_ */
@@ -0,0 +1,29 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/bench/hzlBench_Common.c" "CMakeFiles/bench_hzl.dir/bench/hzlBench_Common.c.o" "gcc" "CMakeFiles/bench_hzl.dir/bench/hzlBench_Common.c.o.d"
+  "/root/repo/bench/hzlBench_Contention.c" "CMakeFiles/bench_hzl.dir/bench/hzlBench_Contention.c.o" "gcc" "CMakeFiles/bench_hzl.dir/bench/hzlBench_Contention.c.o.d"
+  "/root/repo/bench/hzlBench_Crypto.c" "CMakeFiles/bench_hzl.dir/bench/hzlBench_Crypto.c.o" "gcc" "CMakeFiles/bench_hzl.dir/bench/hzlBench_Crypto.c.o.d"
+  "/root/repo/bench/hzlBench_Io.c" "CMakeFiles/bench_hzl.dir/bench/hzlBench_Io.c.o" "gcc" "CMakeFiles/bench_hzl.dir/bench/hzlBench_Io.c.o.d"
+  "/root/repo/bench/hzlBench_Main.c" "CMakeFiles/bench_hzl.dir/bench/hzlBench_Main.c.o" "gcc" "CMakeFiles/bench_hzl.dir/bench/hzlBench_Main.c.o.d"
+  "/root/repo/bench/hzlBench_Paths.c" "CMakeFiles/bench_hzl.dir/bench/hzlBench_Paths.c.o" "gcc" "CMakeFiles/bench_hzl.dir/bench/hzlBench_Paths.c.o.d"
+  "/root/repo/bench/hzlBench_Time.c" "CMakeFiles/bench_hzl.dir/bench/hzlBench_Time.c.o" "gcc" "CMakeFiles/bench_hzl.dir/bench/hzlBench_Time.c.o.d"
+  "/root/repo/bench/hzlBench_Trng.c" "CMakeFiles/bench_hzl.dir/bench/hzlBench_Trng.c.o" "gcc" "CMakeFiles/bench_hzl.dir/bench/hzlBench_Trng.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_fh0/CMakeFiles/hzl_client_desktop.dir/DependInfo.cmake"
+  "/root/repo/_gate_fh0/CMakeFiles/hzl_server_desktop.dir/DependInfo.cmake"
+  "/root/repo/_gate_fh0/external/libascon/CMakeFiles/ascon128hash.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,85 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientBuildRequest.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientBuildRequest.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientBuildSecuredFd.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientBuildSecuredFd.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientBuildSecuredTp.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientBuildSecuredTp.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientBuildUnsecured.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientBuildUnsecured.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientCurrentTimeCoarse.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientCurrentTimeCoarse.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientDeinit.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientDeinit.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientFree.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientFree.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientGroup.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientGroup.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientInit.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientInit.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientNew.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientNew.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientNewMsg.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientNewMsg.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientProcessReceived.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientProcessReceived.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientProcessReceivedInPlace.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientProcessReceivedInPlace.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientProcessReceivedRenewal.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientProcessReceivedRenewal.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientProcessReceivedResponse.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientProcessReceivedResponse.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientProcessReceivedSecuredFd.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientProcessReceivedSecuredFd.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientProcessReceivedSecuredTp.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientProcessReceivedSecuredTp.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientUnpackHeader.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/client/hzl_ClientUnpackHeader.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonAeadAscon.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonAeadAscon.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonBuildRequest.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonBuildRequest.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonBuildResponse.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonBuildResponse.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonBuildSecuredFd.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonBuildSecuredFd.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonBuildUnsecured.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonBuildUnsecured.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonCtrDelay.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonCtrDelay.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonCtrNonce.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonCtrNonce.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonEndian.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonEndian.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonHeader.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonHeader.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonOsNewMsg.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonOsNewMsg.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonOsTime.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonOsTime.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonOsTrng.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonOsTrng.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonPacking.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonPacking.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonProcessReceivedInPlace.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonProcessReceivedInPlace.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonProcessReceivedUnsecured.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonProcessReceivedUnsecured.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonSecuredTp.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonSecuredTp.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonTimeDelta.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonTimeDelta.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonUtils.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/common/hzl_CommonUtils.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/crypto/libascon/hzl_CryptoLibasconAead.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/crypto/libascon/hzl_CryptoLibasconAead.c.o.d"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/crypto/libascon/hzl_CryptoLibasconHash.c.o"
+  "CMakeFiles/hzl_client_desktop_shared.dir/src/crypto/libascon/hzl_CryptoLibasconHash.c.o.d"
+  "libhzl_client.pdb"
+  "libhzl_client.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/hzl_client_desktop_shared.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_hzl_interop_desktop.dir/external/atto/src/atto.c.o"
+  "CMakeFiles/test_hzl_interop_desktop.dir/external/atto/src/atto.c.o.d"
+  "CMakeFiles/test_hzl_interop_desktop.dir/tst/hzlTest_IoMockup.c.o"
+  "CMakeFiles/test_hzl_interop_desktop.dir/tst/hzlTest_IoMockup.c.o.d"
+  "CMakeFiles/test_hzl_interop_desktop.dir/tst/interop/hzlInteropTest_Main.c.o"
+  "CMakeFiles/test_hzl_interop_desktop.dir/tst/interop/hzlInteropTest_Main.c.o.d"
+  "test_hzl_interop_desktop"
+  "test_hzl_interop_desktop.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test_hzl_interop_desktop.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "libhzl_server_desktop.a"
+)
@@ -0,0 +1,26 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/external/atto/src/atto.c" "CMakeFiles/test_hzl_common_desktop.dir/external/atto/src/atto.c.o" "gcc" "CMakeFiles/test_hzl_common_desktop.dir/external/atto/src/atto.c.o.d"
+  "/root/repo/tst/common/hzlCommonTest_Aead.c" "CMakeFiles/test_hzl_common_desktop.dir/tst/common/hzlCommonTest_Aead.c.o" "gcc" "CMakeFiles/test_hzl_common_desktop.dir/tst/common/hzlCommonTest_Aead.c.o.d"
+  "/root/repo/tst/common/hzlCommonTest_CtrDelay.c" "CMakeFiles/test_hzl_common_desktop.dir/tst/common/hzlCommonTest_CtrDelay.c.o" "gcc" "CMakeFiles/test_hzl_common_desktop.dir/tst/common/hzlCommonTest_CtrDelay.c.o.d"
+  "/root/repo/tst/common/hzlCommonTest_CtrNonce.c" "CMakeFiles/test_hzl_common_desktop.dir/tst/common/hzlCommonTest_CtrNonce.c.o" "gcc" "CMakeFiles/test_hzl_common_desktop.dir/tst/common/hzlCommonTest_CtrNonce.c.o.d"
+  "/root/repo/tst/common/hzlCommonTest_Main.c" "CMakeFiles/test_hzl_common_desktop.dir/tst/common/hzlCommonTest_Main.c.o" "gcc" "CMakeFiles/test_hzl_common_desktop.dir/tst/common/hzlCommonTest_Main.c.o.d"
+  "/root/repo/tst/hzlTest_IoMockup.c" "CMakeFiles/test_hzl_common_desktop.dir/tst/hzlTest_IoMockup.c.o" "gcc" "CMakeFiles/test_hzl_common_desktop.dir/tst/hzlTest_IoMockup.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_fh3/CMakeFiles/hzl_client_desktop.dir/DependInfo.cmake"
+  "/root/repo/_gate_fh3/external/libascon/CMakeFiles/ascon128hash.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
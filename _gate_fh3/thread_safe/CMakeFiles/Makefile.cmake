@@ -0,0 +1,76 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/external/libascon/CMakeLists.txt"
+  "/root/repo/toolsupport/cmake/compiler_flags.cmake"
+  "/root/repo/toolsupport/cmake/doxygen.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCheckCompilerFlagCommonPatterns.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCCompilerFlag.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindDoxygen.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckCompilerFlag.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckFlagCommonConfig.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "external/libascon/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/hzl_copy_header_files.dir/DependInfo.cmake"
+  "CMakeFiles/hzl_client_any.dir/DependInfo.cmake"
+  "CMakeFiles/hzl_client_desktop.dir/DependInfo.cmake"
+  "CMakeFiles/hzl_client_desktop_shared.dir/DependInfo.cmake"
+  "CMakeFiles/hzl_server_any.dir/DependInfo.cmake"
+  "CMakeFiles/hzl_server_desktop.dir/DependInfo.cmake"
+  "CMakeFiles/hzl_server_desktop_shared.dir/DependInfo.cmake"
+  "CMakeFiles/hzl_copy_client_config_files.dir/DependInfo.cmake"
+  "CMakeFiles/test_hzl_client_desktop.dir/DependInfo.cmake"
+  "CMakeFiles/test_hzl_client_desktop_shared.dir/DependInfo.cmake"
+  "CMakeFiles/hzl_copy_server_config_files.dir/DependInfo.cmake"
+  "CMakeFiles/test_hzl_server_desktop.dir/DependInfo.cmake"
+  "CMakeFiles/test_hzl_server_desktop_shared.dir/DependInfo.cmake"
+  "CMakeFiles/test_hzl_interop_desktop.dir/DependInfo.cmake"
+  "CMakeFiles/test_hzl_interop_desktop_shared.dir/DependInfo.cmake"
+  "CMakeFiles/test_hzl_common_desktop.dir/DependInfo.cmake"
+  "CMakeFiles/bench_hzl.dir/DependInfo.cmake"
+  "external/libascon/CMakeFiles/ascon128hash.dir/DependInfo.cmake"
+  )
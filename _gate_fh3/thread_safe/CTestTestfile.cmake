@@ -0,0 +1,21 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_gate_fh3/thread_safe
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(test_hzl_client_desktop "/root/repo/_gate_fh3/thread_safe/test_hzl_client_desktop")
+set_tests_properties(test_hzl_client_desktop PROPERTIES  SKIP_RETURN_CODE "77" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;500;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_hzl_client_desktop_shared "/root/repo/_gate_fh3/thread_safe/test_hzl_client_desktop_shared")
+set_tests_properties(test_hzl_client_desktop_shared PROPERTIES  SKIP_RETURN_CODE "77" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;502;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_hzl_server_desktop "/root/repo/_gate_fh3/thread_safe/test_hzl_server_desktop")
+set_tests_properties(test_hzl_server_desktop PROPERTIES  SKIP_RETURN_CODE "77" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;595;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_hzl_server_desktop_shared "/root/repo/_gate_fh3/thread_safe/test_hzl_server_desktop_shared")
+set_tests_properties(test_hzl_server_desktop_shared PROPERTIES  SKIP_RETURN_CODE "77" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;597;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_hzl_interop_desktop "/root/repo/_gate_fh3/thread_safe/test_hzl_interop_desktop")
+set_tests_properties(test_hzl_interop_desktop PROPERTIES  SKIP_RETURN_CODE "77" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;656;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_hzl_interop_desktop_shared "/root/repo/_gate_fh3/thread_safe/test_hzl_interop_desktop_shared")
+set_tests_properties(test_hzl_interop_desktop_shared PROPERTIES  SKIP_RETURN_CODE "77" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;658;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_hzl_common_desktop "/root/repo/_gate_fh3/thread_safe/test_hzl_common_desktop")
+set_tests_properties(test_hzl_common_desktop PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;700;add_test;/root/repo/CMakeLists.txt;0;")
+subdirs("external/libascon")
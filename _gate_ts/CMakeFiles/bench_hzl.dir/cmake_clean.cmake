@@ -0,0 +1,25 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_hzl.dir/bench/hzlBench_Common.c.o"
+  "CMakeFiles/bench_hzl.dir/bench/hzlBench_Common.c.o.d"
+  "CMakeFiles/bench_hzl.dir/bench/hzlBench_Contention.c.o"
+  "CMakeFiles/bench_hzl.dir/bench/hzlBench_Contention.c.o.d"
+  "CMakeFiles/bench_hzl.dir/bench/hzlBench_Crypto.c.o"
+  "CMakeFiles/bench_hzl.dir/bench/hzlBench_Crypto.c.o.d"
+  "CMakeFiles/bench_hzl.dir/bench/hzlBench_Io.c.o"
+  "CMakeFiles/bench_hzl.dir/bench/hzlBench_Io.c.o.d"
+  "CMakeFiles/bench_hzl.dir/bench/hzlBench_Main.c.o"
+  "CMakeFiles/bench_hzl.dir/bench/hzlBench_Main.c.o.d"
+  "CMakeFiles/bench_hzl.dir/bench/hzlBench_Paths.c.o"
+  "CMakeFiles/bench_hzl.dir/bench/hzlBench_Paths.c.o.d"
+  "CMakeFiles/bench_hzl.dir/bench/hzlBench_Time.c.o"
+  "CMakeFiles/bench_hzl.dir/bench/hzlBench_Time.c.o.d"
+  "CMakeFiles/bench_hzl.dir/bench/hzlBench_Trng.c.o"
+  "CMakeFiles/bench_hzl.dir/bench/hzlBench_Trng.c.o.d"
+  "bench_hzl"
+  "bench_hzl.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/bench_hzl.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
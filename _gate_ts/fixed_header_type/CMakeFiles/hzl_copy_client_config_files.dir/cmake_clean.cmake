@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "clientconfigfiles"
+  "CMakeFiles/hzl_copy_client_config_files"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/hzl_copy_client_config_files.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "inc"
+  "CMakeFiles/hzl_copy_header_files"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/hzl_copy_header_files.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
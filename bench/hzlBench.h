@@ -0,0 +1,170 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Common includes and definitions used across the benchmark suite.
+ *
+ * The benchmarks are not unit tests: they do not check the results in detail,
+ * they only measure how long the library calls take. Run them on an otherwise
+ * idle machine with a Release build to compare releases.
+ */
+
+#ifndef HZL_BENCH_H_
+#define HZL_BENCH_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "hzl.h"
+#include "hzl_Client.h"
+#include "hzl_ClientOs.h"
+#include "hzl_Server.h"
+#include "hzl_ServerOs.h"
+#include <stdio.h>
+#include <stdbool.h>
+
+/** Amount of iterations of each benchmarked operation. */
+#define HZL_BENCH_ITERATIONS 100000UL
+
+/**
+ * Amount of iterations of each benchmarked operation for each combination of
+ * header type and plaintext length. Multiple of #HZL_BENCH_CHUNK.
+ */
+#define HZL_BENCH_SWEEP_ITERATIONS 1024UL
+
+/** Amount of message exchanges performed by each thread in the contention benchmark. */
+#define HZL_BENCH_CONTENTION_ITERATIONS 20000UL
+
+/** Amount of messages built before processing them all, to time each call in bulk. */
+#define HZL_BENCH_CHUNK 64U
+
+/** CAN ID used for all benchmarked messages. */
+#define HZL_BENCH_CAN_ID 0x123U
+
+/** Source Identifier of the Client loaded from the "Alice.hzl" config file. */
+#define HZL_BENCH_SID_ALICE 1U
+
+/** Group Identifier of the Group with Server, Alice and Bob in the config files. */
+#define HZL_BENCH_GID_SAB 3U
+
+/**
+ * Current time of a monotonic clock in nanoseconds.
+ *
+ * @return nanoseconds since an unspecified point in the past
+ */
+uint64_t
+hzlBench_NowNs(void);
+
+/**
+ * Prints the result of one benchmark in a single, grep-friendly line.
+ *
+ * @param [in] name of the benchmarked operation
+ * @param [in] iterations amount of times the operation was run
+ * @param [in] elapsedNs total time it took to run all iterations
+ * @param [in] failures amount of iterations that did not return #HZL_OK
+ */
+void
+hzlBench_Report(const char* name, unsigned long iterations, uint64_t elapsedNs,
+                unsigned long failures);
+
+/**
+ * Like hzlBench_Report(), also reporting the throughput of the operation.
+ *
+ * @param [in] name of the benchmarked operation
+ * @param [in] iterations amount of times the operation was run
+ * @param [in] bytesPerOp amount of bytes processed by each run
+ * @param [in] elapsedNs total time it took to run all iterations
+ * @param [in] failures amount of iterations that did not return #HZL_OK
+ */
+void
+hzlBench_ReportThroughput(const char* name, unsigned long iterations, size_t bytesPerOp,
+                          uint64_t elapsedNs, unsigned long failures);
+
+/**
+ * Deterministic TRNG, producing always the same non-zero sequence after
+ * hzlBench_IoReset().
+ *
+ * Compatible with #hzl_TrngFunc.
+ */
+hzl_Err_t
+hzlBench_IoTrng(uint8_t* bytes, size_t amount);
+
+/**
+ * Deterministic current time, advancing only with hzlBench_IoAdvanceTime().
+ *
+ * Compatible with #hzl_TimestampFunc.
+ */
+hzl_Err_t
+hzlBench_IoCurrentTime(hzl_Timestamp_t* timestamp);
+
+/**
+ * Moves the time returned by hzlBench_IoCurrentTime() forward.
+ *
+ * @param [in] millis how much time passes
+ */
+void
+hzlBench_IoAdvanceTime(hzl_Timestamp_t millis);
+
+/** Restarts the sequence of hzlBench_IoTrng() and the time of hzlBench_IoCurrentTime(). */
+void
+hzlBench_IoReset(void);
+
+/**
+ * Benchmarks the building and processing of each message type, for each header type
+ * and for each plaintext length that fits in a CAN FD frame, with deterministic IO.
+ *
+ * @param [in] verbose if true, also reports each plaintext length on its own line
+ */
+void hzlBench_Paths(bool verbose);
+
+/** Benchmarks the OS-provided TRNG and the full Session handshake. */
+void hzlBench_Trng(void);
+
+/** Benchmarks the OS-provided current-time functions. */
+void hzlBench_CurrentTime(void);
+
+/** Benchmarks the AEAD and hash functions of the selected crypto backend. */
+void hzlBench_Crypto(void);
+
+/**
+ * Benchmarks multiple threads transmitting and receiving SADFD messages with the same
+ * Server and Client contexts, each thread on its own Group or all on the same one.
+ *
+ * With a single thread, unless the library is built with #HZL_THREAD_SAFE.
+ */
+void hzlBench_Contention(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* HZL_BENCH_H_ */
@@ -0,0 +1,70 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Timing and reporting utilities shared by all benchmarks.
+ */
+
+#include "hzlBench.h"
+#include <time.h>
+
+uint64_t
+hzlBench_NowNs(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec;
+}
+
+void
+hzlBench_Report(const char* const name,
+                const unsigned long iterations,
+                const uint64_t elapsedNs,
+                const unsigned long failures)
+{
+    const double nsPerOp = (double) elapsedNs / (double) iterations;
+    printf("%-48s %10.1f ns/op %12.0f op/s", name, nsPerOp, 1e9 / nsPerOp);
+    if (failures != 0U) { printf("  (%lu failed)", failures); }
+    printf("\n");
+}
+
+void
+hzlBench_ReportThroughput(const char* const name,
+                          const unsigned long iterations,
+                          const size_t bytesPerOp,
+                          const uint64_t elapsedNs,
+                          const unsigned long failures)
+{
+    const double nsPerOp = (double) elapsedNs / (double) iterations;
+    printf("%-48s %10.1f ns/op %12.0f op/s %8.1f MB/s", name, nsPerOp, 1e9 / nsPerOp,
+           (double) bytesPerOp * 1e3 / nsPerOp);
+    if (failures != 0U) { printf("  (%lu failed)", failures); }
+    printf("\n");
+}
@@ -0,0 +1,244 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Benchmark of multiple threads using the same Server and Client contexts at once,
+ * either each on its own Group or all on the same one.
+ */
+
+#include "hzlBench.h"
+#include <pthread.h>
+#include <string.h>
+
+/** @internal Amount of Groups shared by the Server and the Client, one per thread at most. */
+#define HZL_BENCH_CONTENTION_GROUPS 8U
+
+/**
+ * @internal Counter Nonces a message may lag behind, as the threads overtake each other.
+ *
+ * A thread preempted between building and processing a message on the same GID as the others
+ * may still fall further behind: the message is then rightfully rejected as old.
+ */
+#define HZL_BENCH_CONTENTION_MAX_CTRNONCE_DELAY 1000U
+
+/** @internal Long Term Key shared by the Server and the Client. */
+static const uint8_t HZL_BENCH_CONTENTION_LTK[HZL_LTK_LEN] = {
+        1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U, 9U, 10U, 11U, 12U, 13U, 14U, 15U, 16U,
+};
+
+/** @internal Server and Client sharing all Groups, each with its configuration and state
+ * stored alongside, with a Session already established in every Group. */
+typedef struct hzlBench_Shared
+{
+    hzl_ServerConfig_t serverConfig;
+    hzl_ServerClientConfig_t serverClientConfig;
+    hzl_ServerGroupConfig_t serverGroupConfigs[HZL_BENCH_CONTENTION_GROUPS];
+    hzl_ServerGroupState_t serverGroupStates[HZL_BENCH_CONTENTION_GROUPS];
+    hzl_ServerClientState_t serverClientState;
+    hzl_ServerCtx_t server;
+    hzl_ClientConfig_t clientConfig;
+    hzl_ClientGroupConfig_t clientGroupConfigs[HZL_BENCH_CONTENTION_GROUPS];
+    hzl_ClientGroupState_t clientGroupStates[HZL_BENCH_CONTENTION_GROUPS];
+    hzl_ClientCtx_t client;
+} hzlBench_Shared_t;
+
+/** @internal One of the threads, transmitting and receiving on a single Group. */
+typedef struct hzlBench_Worker
+{
+    pthread_t thread;
+    hzlBench_Shared_t* shared;
+    hzl_Gid_t gid;
+    unsigned long failures;
+} hzlBench_Worker_t;
+
+/** @internal Configures and initialises both parties and runs the Session handshake
+ * in every Group. The structure must not be moved afterwards. */
+static hzl_Err_t
+hzlBench_SharedInit(hzlBench_Shared_t* const shared)
+{
+    memset(shared, 0, sizeof(hzlBench_Shared_t));
+    hzlBench_IoReset();
+    const hzl_Io_t io = {
+            .currentTime = hzlBench_IoCurrentTime,
+            .trng = hzlBench_IoTrng,
+    };
+    shared->serverConfig.amountOfGroups = HZL_BENCH_CONTENTION_GROUPS;
+    shared->serverConfig.amountOfClients = 1U;
+    shared->serverConfig.headerType = HZL_HEADER_0;
+    shared->serverClientConfig.sid = HZL_BENCH_SID_ALICE;
+    memcpy(shared->serverClientConfig.ltk, HZL_BENCH_CONTENTION_LTK, HZL_LTK_LEN);
+    shared->clientConfig.amountOfGroups = HZL_BENCH_CONTENTION_GROUPS;
+    shared->clientConfig.headerType = HZL_HEADER_0;
+    shared->clientConfig.sid = HZL_BENCH_SID_ALICE;
+    shared->clientConfig.timeoutReqToResMillis = 5000U;
+    memcpy(shared->clientConfig.ltk, HZL_BENCH_CONTENTION_LTK, HZL_LTK_LEN);
+    for (uint8_t g = 0U; g < HZL_BENCH_CONTENTION_GROUPS; g++)
+    {
+        hzl_ServerGroupConfig_t* const serverGroup = &shared->serverGroupConfigs[g];
+        serverGroup->gid = g;
+        serverGroup->maxCtrnonceDelayMsgs = HZL_BENCH_CONTENTION_MAX_CTRNONCE_DELAY;
+        serverGroup->ctrNonceUpperLimit = HZL_SERVER_MAX_COUNTER_NONCE_UPPER_LIMIT;
+        serverGroup->sessionDurationMillis = 36000000U;
+        serverGroup->delayBetweenRenNotificationsMillis = 1000U;
+        serverGroup->clientSidsInGroupBitmap.words[0] = 1U;
+        serverGroup->maxSilenceIntervalMillis = 5000U;
+        hzl_ClientGroupConfig_t* const clientGroup = &shared->clientGroupConfigs[g];
+        clientGroup->gid = g;
+        clientGroup->maxCtrnonceDelayMsgs = HZL_BENCH_CONTENTION_MAX_CTRNONCE_DELAY;
+        clientGroup->maxSilenceIntervalMillis = 5000U;
+        clientGroup->sessionRenewalDurationMillis = 6000U;
+    }
+    shared->server.serverConfig = &shared->serverConfig;
+    shared->server.clientConfigs = &shared->serverClientConfig;
+    shared->server.groupConfigs = shared->serverGroupConfigs;
+    shared->server.groupStates = shared->serverGroupStates;
+    shared->server.clientStates = &shared->serverClientState;
+    shared->server.io = io;
+    shared->client.clientConfig = &shared->clientConfig;
+    shared->client.groupConfigs = shared->clientGroupConfigs;
+    shared->client.groupStates = shared->clientGroupStates;
+    shared->client.io = io;
+    hzl_Err_t err = hzl_ServerInit(&shared->server);
+    if (err != HZL_OK) { return err; }
+    err = hzl_ClientInit(&shared->client);
+    if (err != HZL_OK) { return err; }
+    hzl_CbsPduMsg_t req;
+    hzl_CbsPduMsg_t res;
+    hzl_CbsPduMsg_t nothing;
+    hzl_RxSduMsg_t sdu;
+    for (uint8_t g = 0U; g < HZL_BENCH_CONTENTION_GROUPS; g++)
+    {
+        err = hzl_ClientBuildRequest(&req, &shared->client, g);
+        if (err != HZL_OK) { return err; }
+        err = hzl_ServerProcessReceived(&res, &sdu, &shared->server, req.data, req.dataLen,
+                                        HZL_BENCH_CAN_ID);
+        if (err != HZL_OK) { return err; }
+        err = hzl_ClientProcessReceived(&nothing, &sdu, &shared->client, res.data,
+                                        res.dataLen, HZL_BENCH_CAN_ID);
+        if (err != HZL_OK) { return err; }
+    }
+    return HZL_OK;
+}
+
+/** @internal Thread body: the Client transmits a SADFD message the Server receives,
+ * then the Server transmits one the Client receives, on the Group of the worker. */
+static void*
+hzlBench_WorkerRun(void* const arg)
+{
+    hzlBench_Worker_t* const worker = arg;
+    hzlBench_Shared_t* const shared = worker->shared;
+    const uint8_t userData[8] = {0};
+    hzl_CbsPduMsg_t pdu;
+    hzl_CbsPduMsg_t reaction;
+    hzl_RxSduMsg_t sdu;
+    for (unsigned long i = 0U; i < HZL_BENCH_CONTENTION_ITERATIONS; i++)
+    {
+        hzl_Err_t err = hzl_ClientBuildSecuredFd(
+                &pdu, &shared->client, userData, sizeof(userData), worker->gid);
+        if (err == HZL_OK)
+        {
+            err = hzl_ServerProcessReceived(&reaction, &sdu, &shared->server,
+                                            pdu.data, pdu.dataLen, HZL_BENCH_CAN_ID);
+        }
+        worker->failures += err != HZL_OK;
+        err = hzl_ServerBuildSecuredFd(
+                &pdu, &shared->server, userData, sizeof(userData), worker->gid);
+        if (err == HZL_OK)
+        {
+            err = hzl_ClientProcessReceived(&reaction, &sdu, &shared->client,
+                                            pdu.data, pdu.dataLen, HZL_BENCH_CAN_ID);
+        }
+        worker->failures += err != HZL_OK;
+    }
+    return NULL;
+}
+
+/** @internal Runs the threads to completion and reports the total rate of messages
+ * transmitted and received by all of them. */
+static void
+hzlBench_ContentionRun(hzlBench_Shared_t* const shared,
+                       const uint8_t amountOfThreads,
+                       const bool isSameGroup)
+{
+    hzlBench_Worker_t workers[HZL_BENCH_CONTENTION_GROUPS];
+    unsigned long failures = 0U;
+    const uint64_t start = hzlBench_NowNs();
+    for (uint8_t t = 0U; t < amountOfThreads; t++)
+    {
+        workers[t].shared = shared;
+        workers[t].gid = isSameGroup ? HZL_BROADCAST_GID : t;
+        workers[t].failures = 0U;
+        if (pthread_create(&workers[t].thread, NULL, hzlBench_WorkerRun, &workers[t]) != 0)
+        {
+            // Run it in this thread instead, the timing will be off
+            hzlBench_WorkerRun(&workers[t]);
+            workers[t].thread = pthread_self();
+        }
+    }
+    for (uint8_t t = 0U; t < amountOfThreads; t++)
+    {
+        if (!pthread_equal(workers[t].thread, pthread_self()))
+        {
+            pthread_join(workers[t].thread, NULL);
+        }
+        failures += workers[t].failures;
+    }
+    const uint64_t elapsedNs = hzlBench_NowNs() - start;
+    char line[64];
+    snprintf(line, sizeof(line), "SADFD both ways, %u threads, %s",
+             (unsigned) amountOfThreads, isSameGroup ? "same GID" : "disjoint GIDs");
+    // Each exchange is 2 messages, each built and processed
+    hzlBench_Report(line, 2U * HZL_BENCH_CONTENTION_ITERATIONS * amountOfThreads,
+                    elapsedNs, failures);
+}
+
+void
+hzlBench_Contention(void)
+{
+    static hzlBench_Shared_t shared;
+    const hzl_Err_t err = hzlBench_SharedInit(&shared);
+    if (err != HZL_OK)
+    {
+        printf("Cannot establish the Sessions: error %u.\n", (unsigned) err);
+        return;
+    }
+#ifdef HZL_THREAD_SAFE
+    for (uint8_t threads = 1U; threads <= HZL_BENCH_CONTENTION_GROUPS; threads *= 2U)
+    {
+        hzlBench_ContentionRun(&shared, threads, false);
+        hzlBench_ContentionRun(&shared, threads, true);
+    }
+#else
+    // Only a single thread may use the same context without the locks
+    hzlBench_ContentionRun(&shared, 1U, false);
+    printf("Build with HZL_THREAD_SAFE for the runs with multiple threads.\n");
+#endif
+    hzl_ServerDeInit(&shared.server);
+    hzl_ClientDeInit(&shared.client);
+}
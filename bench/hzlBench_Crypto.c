@@ -0,0 +1,201 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Throughput of the AEAD and hash functions of the crypto backend selected with
+ * the `HZL_CRYPTO_BACKEND` CMake option, to compare backends on the same platform.
+ *
+ * Calls the internal wrappers directly, the same ones the library calls for each
+ * message, with lengths typical of a CAN FD frame.
+ */
+
+#include "hzlBench.h"
+#include "hzl_CommonAead.h"
+#include "hzl_CommonHash.h"
+
+/** Length of the associated data of a SADFD message. */
+#define HZL_BENCH_AD_LEN 18U
+
+/** Length of the tag and of the digest. */
+#define HZL_BENCH_TAG_LEN 16U
+
+static void
+hzlBench_AeadEncrypt(const size_t len, const char* const name)
+{
+    static const uint8_t key[HZL_STK_LEN] = {1, 2, 3, 4};
+    static const uint8_t nonce[HZL_AEAD_NONCE_LEN] = {5, 6, 7, 8};
+    static const uint8_t assocData[HZL_BENCH_AD_LEN] = {9, 10, 11};
+    uint8_t data[HZL_MAX_CAN_FD_DATA_LEN] = {0};
+    uint8_t tag[HZL_BENCH_TAG_LEN];
+    hzl_Aead_t aead;
+    const uint64_t start = hzlBench_NowNs();
+    for (unsigned long i = 0U; i < HZL_BENCH_ITERATIONS; i++)
+    {
+        hzl_AeadInit(&aead, key, nonce);
+        hzl_AeadAssocDataUpdate(&aead, assocData, sizeof(assocData));
+        const size_t written = hzl_AeadEncryptUpdate(&aead, data, data, len);
+        hzl_AeadEncryptFinish(&aead, &data[written], tag, sizeof(tag));
+    }
+    hzlBench_ReportThroughput(name, HZL_BENCH_ITERATIONS, len, hzlBench_NowNs() - start, 0U);
+}
+
+static void
+hzlBench_AeadDecrypt(const size_t len, const char* const name)
+{
+    static const uint8_t key[HZL_STK_LEN] = {1, 2, 3, 4};
+    static const uint8_t nonce[HZL_AEAD_NONCE_LEN] = {5, 6, 7, 8};
+    static const uint8_t assocData[HZL_BENCH_AD_LEN] = {9, 10, 11};
+    uint8_t ciphertext[HZL_MAX_CAN_FD_DATA_LEN] = {0};
+    uint8_t plaintext[HZL_MAX_CAN_FD_DATA_LEN];
+    uint8_t tag[HZL_BENCH_TAG_LEN];
+    hzl_Aead_t aead;
+    hzl_AeadInit(&aead, key, nonce);
+    hzl_AeadAssocDataUpdate(&aead, assocData, sizeof(assocData));
+    size_t written = hzl_AeadEncryptUpdate(&aead, ciphertext, ciphertext, len);
+    hzl_AeadEncryptFinish(&aead, &ciphertext[written], tag, sizeof(tag));
+    unsigned long failures = 0U;
+    const uint64_t start = hzlBench_NowNs();
+    for (unsigned long i = 0U; i < HZL_BENCH_ITERATIONS; i++)
+    {
+        hzl_AeadInit(&aead, key, nonce);
+        hzl_AeadAssocDataUpdate(&aead, assocData, sizeof(assocData));
+        written = hzl_AeadDecryptUpdate(&aead, plaintext, ciphertext, len);
+        failures += hzl_AeadDecryptFinish(&aead, &plaintext[written], tag, sizeof(tag))
+                    != HZL_OK;
+    }
+    hzlBench_ReportThroughput(name, HZL_BENCH_ITERATIONS, len, hzlBench_NowNs() - start,
+                              failures);
+}
+
+static void
+hzlBench_AeadEncryptOneShot(const size_t len, const char* const name)
+{
+    static const uint8_t key[HZL_STK_LEN] = {1, 2, 3, 4};
+    static const uint8_t nonce[HZL_AEAD_NONCE_LEN] = {5, 6, 7, 8};
+    static const uint8_t assocData[HZL_BENCH_AD_LEN] = {9, 10, 11};
+    uint8_t data[HZL_MAX_CAN_FD_DATA_LEN] = {0};
+    uint8_t tag[HZL_BENCH_TAG_LEN];
+    const uint64_t start = hzlBench_NowNs();
+    for (unsigned long i = 0U; i < HZL_BENCH_ITERATIONS; i++)
+    {
+        hzl_AeadEncryptOneShot(data, tag, key, nonce, assocData, sizeof(assocData),
+                               data, len, sizeof(tag));
+    }
+    hzlBench_ReportThroughput(name, HZL_BENCH_ITERATIONS, len, hzlBench_NowNs() - start, 0U);
+}
+
+static void
+hzlBench_AeadDecryptOneShot(const size_t len, const char* const name)
+{
+    static const uint8_t key[HZL_STK_LEN] = {1, 2, 3, 4};
+    static const uint8_t nonce[HZL_AEAD_NONCE_LEN] = {5, 6, 7, 8};
+    static const uint8_t assocData[HZL_BENCH_AD_LEN] = {9, 10, 11};
+    uint8_t ciphertext[HZL_MAX_CAN_FD_DATA_LEN] = {0};
+    uint8_t plaintext[HZL_MAX_CAN_FD_DATA_LEN];
+    uint8_t tag[HZL_BENCH_TAG_LEN];
+    hzl_AeadEncryptOneShot(ciphertext, tag, key, nonce, assocData, sizeof(assocData),
+                           ciphertext, len, sizeof(tag));
+    unsigned long failures = 0U;
+    const uint64_t start = hzlBench_NowNs();
+    for (unsigned long i = 0U; i < HZL_BENCH_ITERATIONS; i++)
+    {
+        failures += hzl_AeadDecryptOneShot(plaintext, key, nonce, assocData,
+                                           sizeof(assocData), ciphertext, len,
+                                           tag, sizeof(tag)) != HZL_OK;
+    }
+    hzlBench_ReportThroughput(name, HZL_BENCH_ITERATIONS, len, hzlBench_NowNs() - start,
+                              failures);
+}
+
+static void
+hzlBench_AeadDecryptBatch(const size_t len, const char* const name)
+{
+    static const uint8_t key[HZL_STK_LEN] = {1, 2, 3, 4};
+    static const uint8_t nonce[HZL_AEAD_NONCE_LEN] = {5, 6, 7, 8};
+    static const uint8_t assocData[HZL_BENCH_AD_LEN] = {9, 10, 11};
+    uint8_t ciphertext[HZL_MAX_CAN_FD_DATA_LEN] = {0};
+    uint8_t plaintexts[HZL_AEAD_LANES][HZL_MAX_CAN_FD_DATA_LEN];
+    uint8_t tag[HZL_BENCH_TAG_LEN] = {0};
+    hzl_AeadJob_t jobs[HZL_AEAD_LANES];
+    for (size_t lane = 0U; lane < HZL_AEAD_LANES; lane++)
+    {
+        jobs[lane].key = key;
+        jobs[lane].nonce = nonce;
+        jobs[lane].assocData = assocData;
+        jobs[lane].assocDataLen = sizeof(assocData);
+        jobs[lane].ciphertext = ciphertext;
+        jobs[lane].ciphertextLen = len;
+        jobs[lane].plaintext = plaintexts[lane];
+        jobs[lane].tag = tag;
+        jobs[lane].tagLen = sizeof(tag);
+    }
+    // The tags are invalid, which does not change the amount of work done.
+    const uint64_t start = hzlBench_NowNs();
+    for (unsigned long i = 0U; i < HZL_BENCH_ITERATIONS; i += HZL_AEAD_LANES)
+    {
+        hzl_AeadDecryptBatch(jobs, HZL_AEAD_LANES);
+    }
+    hzlBench_ReportThroughput(name, HZL_BENCH_ITERATIONS, len, hzlBench_NowNs() - start, 0U);
+}
+
+static void
+hzlBench_Hash(const size_t len, const char* const name)
+{
+    static const uint8_t data[HZL_MAX_CAN_FD_DATA_LEN] = {1, 2, 3, 4};
+    uint8_t digest[HZL_BENCH_TAG_LEN];
+    hzl_Hash_t hash;
+    const uint64_t start = hzlBench_NowNs();
+    for (unsigned long i = 0U; i < HZL_BENCH_ITERATIONS; i++)
+    {
+        hzl_HashInit(&hash);
+        hzl_HashUpdate(&hash, data, len);
+        hzl_HashDigest(&hash, digest, sizeof(digest));
+    }
+    hzlBench_ReportThroughput(name, HZL_BENCH_ITERATIONS, len, hzlBench_NowNs() - start, 0U);
+}
+
+void
+hzlBench_Crypto(void)
+{
+    printf("Crypto backend %s, 18 B of associated data, 16 B tags and digests\n",
+           HZL_CRYPTO_BACKEND_NAME);
+    hzlBench_AeadEncrypt(8U, "AEAD encrypt, 8 B");
+    hzlBench_AeadEncrypt(HZL_MAX_CAN_FD_DATA_LEN, "AEAD encrypt, 64 B");
+    hzlBench_AeadDecrypt(8U, "AEAD decrypt, 8 B");
+    hzlBench_AeadDecrypt(HZL_MAX_CAN_FD_DATA_LEN, "AEAD decrypt, 64 B");
+    hzlBench_AeadEncryptOneShot(8U, "AEAD encrypt one-shot, 8 B");
+    hzlBench_AeadEncryptOneShot(HZL_MAX_CAN_FD_DATA_LEN, "AEAD encrypt one-shot, 64 B");
+    hzlBench_AeadDecryptOneShot(8U, "AEAD decrypt one-shot, 8 B");
+    hzlBench_AeadDecryptOneShot(HZL_MAX_CAN_FD_DATA_LEN, "AEAD decrypt one-shot, 64 B");
+    hzlBench_AeadDecryptBatch(8U, "AEAD decrypt batch, 8 B");
+    hzlBench_AeadDecryptBatch(HZL_MAX_CAN_FD_DATA_LEN, "AEAD decrypt batch, 64 B");
+    hzlBench_Hash(8U, "Hash, 8 B");
+    hzlBench_Hash(HZL_MAX_CAN_FD_DATA_LEN, "Hash, 64 B");
+}
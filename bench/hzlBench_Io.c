@@ -0,0 +1,79 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Deterministic IO functions, so that every run of the benchmarks processes
+ * exactly the same messages and does not measure the OS.
+ */
+
+#include "hzlBench.h"
+
+/** @internal Arbitrary non-zero time at which the benchmarks start. */
+#define HZL_BENCH_START_TIME_MILLIS 1000000U
+
+/** @internal Arbitrary non-zero seed of the TRNG sequence. */
+#define HZL_BENCH_TRNG_SEED 0x9E3779B97F4A7C15ULL
+
+static uint64_t trngState = HZL_BENCH_TRNG_SEED;
+static hzl_Timestamp_t fakeNow = HZL_BENCH_START_TIME_MILLIS;
+
+hzl_Err_t
+hzlBench_IoTrng(uint8_t* const bytes, const size_t amount)
+{
+    for (size_t i = 0U; i < amount; i++)
+    {
+        // Xorshift64: cheap, never zero for a non-zero seed.
+        trngState ^= trngState << 13U;
+        trngState ^= trngState >> 7U;
+        trngState ^= trngState << 17U;
+        bytes[i] = (uint8_t) trngState;
+    }
+    return HZL_OK;
+}
+
+hzl_Err_t
+hzlBench_IoCurrentTime(hzl_Timestamp_t* const timestamp)
+{
+    *timestamp = fakeNow;
+    return HZL_OK;
+}
+
+void
+hzlBench_IoAdvanceTime(const hzl_Timestamp_t millis)
+{
+    fakeNow += millis;
+}
+
+void
+hzlBench_IoReset(void)
+{
+    trngState = HZL_BENCH_TRNG_SEED;
+    fakeNow = HZL_BENCH_START_TIME_MILLIS;
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Main file and function, running all the benchmarks.
+ *
+ * Expects the Client and Server configuration files of the test suite
+ * in the working directory, as copied in the build directory by CMake.
+ */
+
+#include "hzlBench.h"
+#include <string.h>
+
+/**
+ * Main function, running all benchmarks.
+ *
+ * Pass `-v` to report each plaintext length of the message-path benchmarks
+ * on its own line, instead of just their average.
+ *
+ * @return 0 on completion.
+ */
+int main(const int argc, const char* const* const argv)
+{
+    const bool verbose = argc > 1 && strcmp(argv[1], "-v") == 0;
+    printf("Hazelnet %s benchmarks, %lu iterations each\n",
+           HZL_VERSION, HZL_BENCH_ITERATIONS);
+    hzlBench_Trng();
+    hzlBench_CurrentTime();
+    hzlBench_Crypto();
+    printf("Message paths, %lu iterations for each plaintext length\n",
+           HZL_BENCH_SWEEP_ITERATIONS);
+    hzlBench_Paths(verbose);
+    printf("Concurrent use of the same contexts, %lu exchanges per thread\n",
+           HZL_BENCH_CONTENTION_ITERATIONS);
+    hzlBench_Contention();
+    return 0;
+}
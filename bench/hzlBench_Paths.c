@@ -0,0 +1,389 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Benchmarks of each build and process path of the library, for each header type
+ * and plaintext length, between a Server and a single Client with deterministic IO.
+ *
+ * The calls that cannot be repeated without building a new message first
+ * (e.g. a RES for each REQ) are timed one by one, so their results include
+ * the overhead of reading the clock twice, which is small compared to the
+ * cryptographic operations.
+ */
+
+#include "hzlBench.h"
+#include <string.h>
+
+/** @internal Amount of standard CBS header types. */
+#define HZL_BENCH_AMOUNT_OF_HEADER_TYPES 7U
+
+/** @internal Bytes of a SADFD payload that are not the ciphertext:
+ * counter nonce, plaintext length and tag. */
+#define HZL_BENCH_SADFD_METADATA_LEN 12U
+
+/** @internal Time passing between Session renewals, longer than any renewal phase. */
+#define HZL_BENCH_RENEWAL_STEP_MILLIS 10000U
+
+/** @internal Packed length of each header type, as in the CBS specification. */
+static const uint8_t HZL_BENCH_HEADER_LEN[HZL_BENCH_AMOUNT_OF_HEADER_TYPES] = {
+        3U, 2U, 2U, 1U, 1U, 2U, 1U,
+};
+
+/** @internal Long Term Key shared by the Server and the Client. */
+static const uint8_t HZL_BENCH_LTK[HZL_LTK_LEN] = {
+        1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U, 9U, 10U, 11U, 12U, 13U, 14U, 15U, 16U,
+};
+
+/**
+ * @internal
+ * Clients known to the Server: Alice, the benchmarked one, and Bob, who never
+ * transmits. Bob is there so that Alice is not the Client with the largest SID,
+ * which the Server rejects as an unknown source.
+ */
+#define HZL_BENCH_SERVER_CLIENTS 2U
+
+/** @internal Server and Client sharing the broadcast Group, each with its
+ * configuration and state stored alongside, with a Session already established. */
+typedef struct hzlBench_Pair
+{
+    hzl_ServerConfig_t serverConfig;
+    hzl_ServerClientConfig_t serverClientConfigs[HZL_BENCH_SERVER_CLIENTS];
+    hzl_ServerGroupConfig_t serverGroupConfig;
+    hzl_ServerGroupState_t serverGroupState;
+    hzl_ServerClientState_t serverClientStates[HZL_BENCH_SERVER_CLIENTS];
+    hzl_ServerCtx_t server;
+    hzl_ClientConfig_t clientConfig;
+    hzl_ClientGroupConfig_t clientGroupConfig;
+    hzl_ClientGroupState_t clientGroupState;
+    hzl_ClientCtx_t client;
+} hzlBench_Pair_t;
+
+/** @internal Aggregated timing of one path over a sweep of plaintext lengths. */
+typedef struct hzlBench_Sweep
+{
+    uint64_t elapsedNs;
+    unsigned long iterations;
+    unsigned long failures;
+} hzlBench_Sweep_t;
+
+/** @internal Configures and initialises both parties for the given header type and
+ * runs the Session handshake. The structure must not be moved afterwards. */
+static hzl_Err_t
+hzlBench_PairInit(hzlBench_Pair_t* const pair, const hzl_HeaderType_t headerType)
+{
+    memset(pair, 0, sizeof(hzlBench_Pair_t));
+    hzlBench_IoReset();
+    const hzl_Io_t io = {
+            .currentTime = hzlBench_IoCurrentTime,
+            .trng = hzlBench_IoTrng,
+    };
+    pair->serverConfig.amountOfGroups = 1U;
+    pair->serverConfig.amountOfClients = HZL_BENCH_SERVER_CLIENTS;
+    pair->serverConfig.headerType = headerType;
+    for (uint8_t i = 0U; i < HZL_BENCH_SERVER_CLIENTS; i++)
+    {
+        pair->serverClientConfigs[i].sid = (hzl_Sid_t) (HZL_BENCH_SID_ALICE + i);
+        memcpy(pair->serverClientConfigs[i].ltk, HZL_BENCH_LTK, HZL_LTK_LEN);
+    }
+    pair->serverGroupConfig.gid = HZL_BROADCAST_GID;
+    pair->serverGroupConfig.maxCtrnonceDelayMsgs = 20U;
+    pair->serverGroupConfig.ctrNonceUpperLimit = HZL_SERVER_MAX_COUNTER_NONCE_UPPER_LIMIT;
+    pair->serverGroupConfig.sessionDurationMillis = 36000000U;
+    pair->serverGroupConfig.delayBetweenRenNotificationsMillis = 1000U;
+    pair->serverGroupConfig.clientSidsInGroupBitmap.words[0] = 0x3U;
+    pair->serverGroupConfig.maxSilenceIntervalMillis = 5000U;
+    pair->server.serverConfig = &pair->serverConfig;
+    pair->server.clientConfigs = pair->serverClientConfigs;
+    pair->server.groupConfigs = &pair->serverGroupConfig;
+    pair->server.groupStates = &pair->serverGroupState;
+    pair->server.clientStates = pair->serverClientStates;
+    pair->server.io = io;
+    pair->clientConfig.amountOfGroups = 1U;
+    pair->clientConfig.headerType = headerType;
+    pair->clientConfig.sid = HZL_BENCH_SID_ALICE;
+    pair->clientConfig.timeoutReqToResMillis = 5000U;
+    memcpy(pair->clientConfig.ltk, HZL_BENCH_LTK, HZL_LTK_LEN);
+    pair->clientGroupConfig.gid = HZL_BROADCAST_GID;
+    pair->clientGroupConfig.maxCtrnonceDelayMsgs = 20U;
+    pair->clientGroupConfig.maxSilenceIntervalMillis = 5000U;
+    pair->clientGroupConfig.sessionRenewalDurationMillis = 6000U;
+    pair->client.clientConfig = &pair->clientConfig;
+    pair->client.groupConfigs = &pair->clientGroupConfig;
+    pair->client.groupStates = &pair->clientGroupState;
+    pair->client.io = io;
+    hzl_Err_t err = hzl_ServerInit(&pair->server);
+    if (err != HZL_OK) { return err; }
+    err = hzl_ClientInit(&pair->client);
+    if (err != HZL_OK) { return err; }
+    hzl_CbsPduMsg_t req;
+    hzl_CbsPduMsg_t res;
+    hzl_CbsPduMsg_t nothing;
+    hzl_RxSduMsg_t sdu;
+    err = hzl_ClientBuildRequest(&req, &pair->client, HZL_BROADCAST_GID);
+    if (err != HZL_OK) { return err; }
+    err = hzl_ServerProcessReceived(&res, &sdu, &pair->server, req.data, req.dataLen,
+                                    HZL_BENCH_CAN_ID);
+    if (err != HZL_OK) { return err; }
+    return hzl_ClientProcessReceived(&nothing, &sdu, &pair->client, res.data, res.dataLen,
+                                     HZL_BENCH_CAN_ID);
+}
+
+/** @internal Adds the timing of one plaintext length to the sweep, reporting it
+ * on its own line if verbose. */
+static void
+hzlBench_SweepAdd(hzlBench_Sweep_t* const sweep,
+                  const char* const name,
+                  const hzl_HeaderType_t headerType,
+                  const size_t plaintextLen,
+                  const uint64_t elapsedNs,
+                  const unsigned long failures,
+                  const bool verbose)
+{
+    if (verbose)
+    {
+        char line[64];
+        snprintf(line, sizeof(line), "%s, hdr %u, %u B",
+                 name, (unsigned) headerType, (unsigned) plaintextLen);
+        hzlBench_Report(line, HZL_BENCH_SWEEP_ITERATIONS, elapsedNs, failures);
+    }
+    sweep->elapsedNs += elapsedNs;
+    sweep->iterations += HZL_BENCH_SWEEP_ITERATIONS;
+    sweep->failures += failures;
+}
+
+/** @internal Reports the average over all plaintext lengths of a sweep. */
+static void
+hzlBench_SweepReport(const hzlBench_Sweep_t* const sweep,
+                     const char* const name,
+                     const hzl_HeaderType_t headerType,
+                     const size_t maxPlaintextLen)
+{
+    char line[64];
+    snprintf(line, sizeof(line), "%s, hdr %u, 0..%u B",
+             name, (unsigned) headerType, (unsigned) maxPlaintextLen);
+    hzlBench_Report(line, sweep->iterations, sweep->elapsedNs, sweep->failures);
+}
+
+/** @internal Client builds SADFD messages, Server processes them,
+ * for each plaintext length fitting into a CAN FD frame. */
+static void
+hzlBench_SecuredFd(hzlBench_Pair_t* const pair,
+                   const hzl_HeaderType_t headerType,
+                   const bool verbose)
+{
+    const size_t maxLen = HZL_MAX_CAN_FD_DATA_LEN - HZL_BENCH_HEADER_LEN[headerType]
+                          - HZL_BENCH_SADFD_METADATA_LEN;
+    uint8_t userData[HZL_MAX_CAN_FD_DATA_LEN] = {0};
+    hzl_CbsPduMsg_t pdus[HZL_BENCH_CHUNK];
+    hzl_CbsPduMsg_t reaction;
+    hzl_RxSduMsg_t sdu;
+    hzlBench_Sweep_t build = {0};
+    hzlBench_Sweep_t process = {0};
+    for (size_t len = 0U; len <= maxLen; len++)
+    {
+        uint64_t buildNs = 0U;
+        uint64_t processNs = 0U;
+        unsigned long buildFailures = 0U;
+        unsigned long processFailures = 0U;
+        for (unsigned long i = 0U; i < HZL_BENCH_SWEEP_ITERATIONS; i += HZL_BENCH_CHUNK)
+        {
+            uint64_t start = hzlBench_NowNs();
+            for (size_t m = 0U; m < HZL_BENCH_CHUNK; m++)
+            {
+                buildFailures += hzl_ClientBuildSecuredFd(
+                        &pdus[m], &pair->client, userData, len, HZL_BROADCAST_GID) != HZL_OK;
+            }
+            buildNs += hzlBench_NowNs() - start;
+            start = hzlBench_NowNs();
+            for (size_t m = 0U; m < HZL_BENCH_CHUNK; m++)
+            {
+                processFailures += hzl_ServerProcessReceived(
+                        &reaction, &sdu, &pair->server, pdus[m].data, pdus[m].dataLen,
+                        HZL_BENCH_CAN_ID) != HZL_OK;
+            }
+            processNs += hzlBench_NowNs() - start;
+        }
+        hzlBench_SweepAdd(&build, "Client build SADFD", headerType, len,
+                          buildNs, buildFailures, verbose);
+        hzlBench_SweepAdd(&process, "Server process SADFD", headerType, len,
+                          processNs, processFailures, verbose);
+    }
+    hzlBench_SweepReport(&build, "Client build SADFD", headerType, maxLen);
+    hzlBench_SweepReport(&process, "Server process SADFD", headerType, maxLen);
+}
+
+/** @internal Server processes UAD messages,
+ * for each plaintext length fitting into a CAN FD frame. */
+static void
+hzlBench_Unsecured(hzlBench_Pair_t* const pair,
+                   const hzl_HeaderType_t headerType,
+                   const bool verbose)
+{
+    const size_t maxLen = HZL_MAX_CAN_FD_DATA_LEN - HZL_BENCH_HEADER_LEN[headerType];
+    uint8_t userData[HZL_MAX_CAN_FD_DATA_LEN] = {0};
+    hzl_CbsPduMsg_t pdu;
+    hzl_CbsPduMsg_t reaction;
+    hzl_RxSduMsg_t sdu;
+    hzlBench_Sweep_t process = {0};
+    for (size_t len = 0U; len <= maxLen; len++)
+    {
+        unsigned long failures = hzl_ClientBuildUnsecured(
+                &pdu, &pair->client, userData, len, HZL_BROADCAST_GID) != HZL_OK;
+        const uint64_t start = hzlBench_NowNs();
+        for (unsigned long i = 0U; i < HZL_BENCH_SWEEP_ITERATIONS; i++)
+        {
+            failures += hzl_ServerProcessReceived(
+                    &reaction, &sdu, &pair->server, pdu.data, pdu.dataLen,
+                    HZL_BENCH_CAN_ID) != HZL_OK;
+        }
+        hzlBench_SweepAdd(&process, "Server process UAD", headerType, len,
+                          hzlBench_NowNs() - start, failures, verbose);
+    }
+    hzlBench_SweepReport(&process, "Server process UAD", headerType, maxLen);
+}
+
+/** @internal Session handshake: Server processes REQ messages,
+ * Client processes the RES messages built in reaction. */
+static void
+hzlBench_Handshake(hzlBench_Pair_t* const pair, const hzl_HeaderType_t headerType)
+{
+    hzl_CbsPduMsg_t req;
+    hzl_CbsPduMsg_t res;
+    hzl_CbsPduMsg_t nothing;
+    hzl_RxSduMsg_t sdu;
+    hzlBench_Sweep_t processReq = {0};
+    hzlBench_Sweep_t processRes = {0};
+    for (unsigned long i = 0U; i < HZL_BENCH_SWEEP_ITERATIONS; i++)
+    {
+        processReq.failures += hzl_ClientBuildRequest(
+                &req, &pair->client, HZL_BROADCAST_GID) != HZL_OK;
+        uint64_t start = hzlBench_NowNs();
+        processReq.failures += hzl_ServerProcessReceived(
+                &res, &sdu, &pair->server, req.data, req.dataLen, HZL_BENCH_CAN_ID) != HZL_OK;
+        processReq.elapsedNs += hzlBench_NowNs() - start;
+        start = hzlBench_NowNs();
+        processRes.failures += hzl_ClientProcessReceived(
+                &nothing, &sdu, &pair->client, res.data, res.dataLen,
+                HZL_BENCH_CAN_ID) != HZL_OK;
+        processRes.elapsedNs += hzlBench_NowNs() - start;
+    }
+    processReq.iterations = HZL_BENCH_SWEEP_ITERATIONS;
+    processRes.iterations = HZL_BENCH_SWEEP_ITERATIONS;
+    char line[64];
+    snprintf(line, sizeof(line), "Server process REQ, hdr %u", (unsigned) headerType);
+    hzlBench_Report(line, processReq.iterations, processReq.elapsedNs, processReq.failures);
+    snprintf(line, sizeof(line), "Client process RES, hdr %u", (unsigned) headerType);
+    hzlBench_Report(line, processRes.iterations, processRes.elapsedNs, processRes.failures);
+}
+
+/** @internal Exchanges a SADFD message in both directions, so both parties
+ * notice that the previous Session renewal phase is over. */
+static unsigned long
+hzlBench_ExchangeSecuredFd(hzlBench_Pair_t* const pair)
+{
+    const uint8_t userData[1] = {0};
+    hzl_CbsPduMsg_t pdu;
+    hzl_CbsPduMsg_t reaction;
+    hzl_RxSduMsg_t sdu;
+    unsigned long failures = 0U;
+    failures += hzl_ServerBuildSecuredFd(
+            &pdu, &pair->server, userData, sizeof(userData), HZL_BROADCAST_GID) != HZL_OK;
+    failures += hzl_ClientProcessReceived(
+            &reaction, &sdu, &pair->client, pdu.data, pdu.dataLen, HZL_BENCH_CAN_ID) != HZL_OK;
+    failures += hzl_ClientBuildSecuredFd(
+            &pdu, &pair->client, userData, sizeof(userData), HZL_BROADCAST_GID) != HZL_OK;
+    failures += hzl_ServerProcessReceived(
+            &reaction, &sdu, &pair->server, pdu.data, pdu.dataLen, HZL_BENCH_CAN_ID) != HZL_OK;
+    return failures;
+}
+
+/** @internal Full Session renewal started by the Server: REN, REQ, RES.
+ * Also times the processing of the REN message by the Client on its own. */
+static void
+hzlBench_Renewal(hzlBench_Pair_t* const pair, const hzl_HeaderType_t headerType)
+{
+    hzl_CbsPduMsg_t ren;
+    hzl_CbsPduMsg_t req;
+    hzl_CbsPduMsg_t res;
+    hzl_CbsPduMsg_t nothing;
+    hzl_RxSduMsg_t sdu;
+    hzlBench_Sweep_t processRen = {0};
+    hzlBench_Sweep_t renewal = {0};
+    for (unsigned long i = 0U; i < HZL_BENCH_SWEEP_ITERATIONS; i++)
+    {
+        hzlBench_IoAdvanceTime(HZL_BENCH_RENEWAL_STEP_MILLIS);
+        renewal.failures += hzlBench_ExchangeSecuredFd(pair);
+        const uint64_t start = hzlBench_NowNs();
+        renewal.failures += hzl_ServerForceSessionRenewal(
+                &ren, &pair->server, HZL_BROADCAST_GID) != HZL_OK;
+        const uint64_t renStart = hzlBench_NowNs();
+        processRen.failures += hzl_ClientProcessReceived(
+                &req, &sdu, &pair->client, ren.data, ren.dataLen, HZL_BENCH_CAN_ID) != HZL_OK;
+        const uint64_t renEnd = hzlBench_NowNs();
+        renewal.failures += hzl_ServerProcessReceived(
+                &res, &sdu, &pair->server, req.data, req.dataLen, HZL_BENCH_CAN_ID) != HZL_OK;
+        renewal.failures += hzl_ClientProcessReceived(
+                &nothing, &sdu, &pair->client, res.data, res.dataLen,
+                HZL_BENCH_CAN_ID) != HZL_OK;
+        renewal.elapsedNs += hzlBench_NowNs() - start;
+        processRen.elapsedNs += renEnd - renStart;
+    }
+    processRen.iterations = HZL_BENCH_SWEEP_ITERATIONS;
+    renewal.iterations = HZL_BENCH_SWEEP_ITERATIONS;
+    renewal.failures += processRen.failures;
+    char line[64];
+    snprintf(line, sizeof(line), "Client process REN, hdr %u", (unsigned) headerType);
+    hzlBench_Report(line, processRen.iterations, processRen.elapsedNs, processRen.failures);
+    snprintf(line, sizeof(line), "Session renewal REN+REQ+RES, hdr %u", (unsigned) headerType);
+    hzlBench_Report(line, renewal.iterations, renewal.elapsedNs, renewal.failures);
+}
+
+void
+hzlBench_Paths(const bool verbose)
+{
+    static hzlBench_Pair_t pair;
+    for (uint8_t type = 0U; type < HZL_BENCH_AMOUNT_OF_HEADER_TYPES; type++)
+    {
+        const hzl_HeaderType_t headerType = (hzl_HeaderType_t) type;
+        const hzl_Err_t err = hzlBench_PairInit(&pair, headerType);
+        if (err != HZL_OK)
+        {
+            printf("Cannot establish a Session with header type %u: error %u.\n",
+                   (unsigned) type, (unsigned) err);
+            continue;
+        }
+        hzlBench_SecuredFd(&pair, headerType, verbose);
+        hzlBench_Unsecured(&pair, headerType, verbose);
+        hzlBench_Handshake(&pair, headerType);
+        hzlBench_Renewal(&pair, headerType);
+        hzl_ServerDeInit(&pair.server);
+        hzl_ClientDeInit(&pair.client);
+    }
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Benchmarks of the OS-provided current-time functions, called at least once
+ * for every received message.
+ */
+
+#include "hzlBench.h"
+
+static void
+hzlBench_TimestampFunc(const hzl_TimestampFunc currentTime, const char* const name)
+{
+    hzl_Timestamp_t now;
+    unsigned long failures = 0U;
+    const uint64_t start = hzlBench_NowNs();
+    for (unsigned long i = 0U; i < HZL_BENCH_ITERATIONS; i++)
+    {
+        failures += currentTime(&now) != HZL_OK;
+    }
+    hzlBench_Report(name, HZL_BENCH_ITERATIONS, hzlBench_NowNs() - start, failures);
+}
+
+void
+hzlBench_CurrentTime(void)
+{
+    hzl_ClientCtx_t* alice = NULL;
+    if (hzl_ClientNew(&alice, "clientconfigfiles/Alice.hzl") != HZL_OK)
+    {
+        printf("Cannot load the config files, run from the build directory.\n");
+    }
+    else
+    {
+        hzlBench_TimestampFunc(alice->io.currentTime, "OS current time");
+        hzlBench_TimestampFunc(hzl_ClientCurrentTimeCoarse, "OS current time, coarse");
+    }
+    hzl_ClientFree(&alice);
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Benchmarks of the OS-provided TRNG and of the handshake establishing a
+ * Session, which draws the Request nonce, the Response nonce and the STK
+ * from the TRNG.
+ */
+
+#include "hzlBench.h"
+
+/** Length of the Request nonce, drawn from the TRNG by the Client. */
+#define HZL_BENCH_REQNONCE_LEN 8U
+
+static void
+hzlBench_OsTrng(const hzl_TrngFunc trng, const size_t amount, const char* const name)
+{
+    uint8_t bytes[HZL_STK_LEN];
+    unsigned long failures = 0U;
+    const uint64_t start = hzlBench_NowNs();
+    for (unsigned long i = 0U; i < HZL_BENCH_ITERATIONS; i++)
+    {
+        failures += trng(bytes, amount) != HZL_OK;
+    }
+    hzlBench_Report(name, HZL_BENCH_ITERATIONS, hzlBench_NowNs() - start, failures);
+}
+
+static void
+hzlBench_Handshake(hzl_ServerCtx_t* const server, hzl_ClientCtx_t* const alice)
+{
+    hzl_CbsPduMsg_t req;
+    hzl_CbsPduMsg_t res;
+    hzl_CbsPduMsg_t nothing;
+    hzl_RxSduMsg_t sdu;
+    unsigned long failures = 0U;
+    const uint64_t start = hzlBench_NowNs();
+    for (unsigned long i = 0U; i < HZL_BENCH_ITERATIONS; i++)
+    {
+        hzl_Err_t err = hzl_ClientBuildRequest(&req, alice, HZL_BENCH_GID_SAB);
+        if (err == HZL_OK)
+        {
+            err = hzl_ServerProcessReceived(&res, &sdu, server, req.data, req.dataLen,
+                                            HZL_BENCH_CAN_ID);
+        }
+        if (err == HZL_OK)
+        {
+            err = hzl_ClientProcessReceived(&nothing, &sdu, alice, res.data, res.dataLen,
+                                            HZL_BENCH_CAN_ID);
+        }
+        failures += err != HZL_OK;
+    }
+    hzlBench_Report("Handshake REQ+RES", HZL_BENCH_ITERATIONS,
+                    hzlBench_NowNs() - start, failures);
+}
+
+void
+hzlBench_Trng(void)
+{
+    hzl_ServerCtx_t* server = NULL;
+    hzl_ClientCtx_t* alice = NULL;
+    if (hzl_ServerNew(&server, "serverconfigfiles/Server.hzl") != HZL_OK
+        || hzl_ClientNew(&alice, "clientconfigfiles/Alice.hzl") != HZL_OK)
+    {
+        printf("Cannot load the config files, run from the build directory.\n");
+    }
+    else
+    {
+        hzlBench_OsTrng(alice->io.trng, HZL_BENCH_REQNONCE_LEN, "OS TRNG, 8 B");
+        hzlBench_OsTrng(alice->io.trng, HZL_STK_LEN, "OS TRNG, 16 B");
+        hzlBench_Handshake(server, alice);
+    }
+    hzl_ServerFree(&server);
+    hzl_ClientFree(&alice);
+}
@@ -103,6 +103,7 @@ extern "C"
 #define HZL_OS_AVAILABLE_NIX 1
 
 #include <sys/time.h> /* For gettimeofday() */
+#include <time.h>     /* For clock_gettime() */
 #include <stdio.h>    /* For config file IO and TRNG with /dev/urandom */
 #include <stdlib.h>   /* For calloc(), free() */
 
@@ -133,6 +134,9 @@ extern "C"
 /** Group Identifier reserved for broadcasting, always zero. */
 #define HZL_BROADCAST_GID 0U
 
+/** Amount of distinct Group Identifiers, as #hzl_Gid_t is 8 bits wide. */
+#define HZL_AMOUNT_OF_GIDS 256U
+
 /** Length of the Long Term Key in bytes. */
 #define HZL_LTK_LEN 16U
 
@@ -146,6 +150,45 @@ extern "C"
 /** Maximum length of the CAN FD frame's payload in bytes. */
 #define HZL_MAX_CAN_FD_DATA_LEN 64U
 
+/** Length of the tag authenticating a whole SADTP message in bytes. */
+#define HZL_SADTP_TAG_LEN 16U
+
+/** Maximum amount of CAN FD frames (fragments) a single SADTP message can be split into. */
+#define HZL_SADTP_MAX_AMOUNT_OF_FRAGMENTS 256U
+
+/**
+ * Amount of #hzl_CbsPduMsg_t required to transmit \p dataLen bytes of user data
+ * as a Secured Application Data over Transport Protocol (SADTP) message with any header type.
+ *
+ * Use it to size the array of PDUs passed to hzl_ClientBuildSecuredTp() and
+ * hzl_ServerBuildSecuredTp(). Assumes the longest (3 B) packed header,
+ * so it may overestimate by one PDU for shorter header types.
+ * Every fragment carries 57 B of the `ciphertext || tag` stream, the first
+ * fragment 2 B less to also contain the plaintext length.
+ */
+#define HZL_SADTP_AMOUNT_OF_PDUS(dataLen) \
+    (((size_t) (dataLen) + HZL_SADTP_TAG_LEN + 2U + 56U) / 57U)
+
+/**
+ * Maximum length of the user data of a single SADTP message in bytes, with any header type
+ * and placement: what fits into #HZL_SADTP_MAX_AMOUNT_OF_FRAGMENTS fragments with the
+ * longest (3 B) packed header, 14574 B.
+ */
+#define HZL_SADTP_MAX_DATA_LEN \
+    (HZL_SADTP_MAX_AMOUNT_OF_FRAGMENTS * 57U - HZL_SADTP_TAG_LEN - 2U)
+
+/**
+ * Amount of 64-bit words used by #hzl_SadtpRxBuffer_t to store the state of
+ * the AEAD cipher between the fragments of an SADTP message.
+ */
+#define HZL_SADTP_AEAD_STATE_WORDS 12U
+
+/**
+ * Amount of 64-bit words used to store a precomputed state of the hash
+ * function, after the key and label of a message type are absorbed.
+ */
+#define HZL_HASH_STATE_WORDS 7U
+
 /**
  * Amount of consecutive TRNG invocations that must provide all-zero bytes to give up
  * the random number generation. The probability that this happens is quit low:
@@ -266,6 +309,8 @@ typedef enum hzl_Err
     HZL_ERR_ZERO_CLIENTS = 28U,
     /** The Server configuration contains more Clients that it can hold in
      * the bitmap of Clients in each Group.
+     * Not returned anymore, as the bitmap holds any amount of Clients the
+     * configuration can express; the value is kept reserved.
      * @see #HZL_SERVER_MAX_AMOUNT_OF_CLIENTS
      * @see #hzl_ServerConfig_t.amountOfClients */
     HZL_ERR_TOO_MANY_CLIENTS = 29U,
@@ -343,6 +388,33 @@ typedef enum hzl_Err
     /** The function pointer to the true-random number generating function is NULL.
      * @see #hzl_Io_t.trng */
     HZL_ERR_NULL_TRNG_FUNC = 45U,
+    /** The context contains a NULL pointer to the SADTP reception buffers array, but a non-zero
+     * amount of them, or one of the buffers has a NULL data pointer but non-zero capacity.
+     * @see #hzl_ClientCtx_t.sadtpRxBuffers, #hzl_ServerCtx_t.sadtpRxBuffers */
+    HZL_ERR_NULL_SADTP_RX_BUFFERS = 46U,
+    /** The context was not initialised, thus its fields that are not set by the user, such as
+     * the header packing, are not built yet.
+     * @see hzl_ClientInit(), hzl_ClientNew(), hzl_ServerInit(), hzl_ServerNew() */
+    HZL_ERR_CTX_NOT_INITIALISED = 47U,
+    /** The Party configuration contains an unknown placement of the CBS Header.
+     * @see #hzl_ClientConfig_t.headerPlacement
+     * @see #hzl_ServerConfig_t.headerPlacement */
+    HZL_ERR_INVALID_HEADER_PLACEMENT = 48U,
+    /** The amount of shards of the sharded Server is zero or larger than
+     * #HZL_SERVER_MAX_AMOUNT_OF_SHARDS, or leaves some shards owning Groups without
+     * any SADTP reception buffer.
+     * @see #hzl_ServerShardsConfig_t.amountOfShards */
+    HZL_ERR_INVALID_AMOUNT_OF_SHARDS = 49U,
+    /** The capacity of the rings of the sharded Server is not a power of 2 of at least 2.
+     * @see #hzl_ServerShardsConfig_t.ringCapacity */
+    HZL_ERR_INVALID_RING_CAPACITY = 50U,
+    /** The callback of the sharded Server handling the processed messages is NULL.
+     * @see #hzl_ServerShardsConfig_t.onProcessed */
+    HZL_ERR_NULL_SHARDS_CALLBACK = 51U,
+    /** The context contains a NULL pointer to the Group timers array, required by the
+     * timer-driven function.
+     * @see #hzl_ServerCtx_t.groupTimers, hzl_ServerTick() */
+    HZL_ERR_NULL_GROUP_TIMERS = 52U,
 
     // TX and RX function functions
     /** The pointer to the Protocol Data Unit (packed CBS message) to transmit or the just-received
@@ -362,6 +434,13 @@ typedef enum hzl_Err
      * The message cannot be transmitted securely (when the error occurs on TX)
      * or cannot be decrypted and validated (when on RX). */
     HZL_ERR_SESSION_NOT_ESTABLISHED = 64U,
+    /** The pointer to the array of per-message results of a batch operation is NULL.
+     * @see hzl_ServerProcessReceivedBatch(), hzl_ServerBuildSecuredFdBatch(),
+     * hzl_ClientBuildSecuredFdBatch() */
+    HZL_ERR_NULL_RESULTS = 65U,
+    /** The pointer to the unpacked CBS Header to write is NULL.
+     * @see hzl_ClientUnpackHeader(), hzl_ServerUnpackHeader() */
+    HZL_ERR_NULL_HEADER = 66U,
 
     // TX functions
     /** The user-provided data to be transmitted is too long to fit into the specified message
@@ -381,6 +460,13 @@ typedef enum hzl_Err
      * phase is ongoing. The user has to retry after is it completed.
      * @see hzl_ServerForceSessionRenewal() */
     HZL_ERR_RENEWAL_ONGOING = 73U,
+    /** The output buffer provided by the user is too small to contain the message to build.
+     * @see hzl_ClientBuildSecuredFdInto(), hzl_ServerBuildSecuredFdInto() */
+    HZL_ERR_TOO_SMALL_PDU_BUFFER = 74U,
+    /** The ring of the shard owning the Group is full, as its worker thread does not keep up
+     * with the submitted messages. Nothing was queued: submit the message again later or
+     * drop it. */
+    HZL_ERR_SHARD_RING_FULL = 75U,
 
     // RX functions
     /** The received message contains an unknown PTY field. Its data has an unknown structure. */
@@ -409,6 +495,19 @@ typedef enum hzl_Err
     HZL_ERR_MSG_IGNORED = 87U,
     /** The received Request message contained an all-zeros Request Nonce. */
     HZL_ERR_SECWARN_RECEIVED_ZERO_REQNONCE = 88U,
+    /** The received Secured Application Data over Transport Protocol (SADTP) fragment is too
+     * short to contain its metadata: Counter Nonce, fragment index and, for the first fragment,
+     * plaintext length. */
+    HZL_ERR_TOO_SHORT_PDU_TO_CONTAIN_SADTP = 89U,
+    /** The first fragment of a received SADTP message cannot be reassembled: there is no
+     * SADTP reception buffer free and large enough to hold its plaintext.
+     * @see #hzl_ClientCtx_t.sadtpRxBuffers, #hzl_ServerCtx_t.sadtpRxBuffers */
+    HZL_ERR_SADTP_NO_FREE_RX_BUFFER = 90U,
+    /** The received SADTP fragment does not continue any SADTP message being reassembled from
+     * the same Group and Source: it's either out of order, has a different Counter Nonce
+     * or its message was never started. Any reassembly in progress for the same Group and
+     * Source is discarded. */
+    HZL_ERR_SADTP_UNEXPECTED_FRAGMENT = 91U,
 
     // Failed IO operation
     /** The timestamping function failed to provide the current time.
@@ -443,6 +542,8 @@ typedef enum hzl_Err
     HZL_ERR_INVALID_FILE_MAGIC_NUMBER = 123U,
     /** Heap-memory allocation failure: out of memory. */
     HZL_ERR_MALLOC_FAILED = 124U,
+    /** The OS could not start a new thread. */
+    HZL_ERR_CANNOT_START_THREAD = 125U,
 } hzl_Err_t;
 
 /** Standard CBS header types. */
@@ -458,6 +559,31 @@ typedef enum hzl_HeaderType
 // Values [7, 32] are RFU.
 } hzl_HeaderType_t;
 
+/**
+ * Where the packed CBS Header is transmitted, to be configured equally on all nodes.
+ *
+ * Moving the header (partially) into the CAN ID leaves up to 3 more bytes of the CAN FD
+ * payload for the user data and allows the CAN controller to filter the messages by their
+ * header, but requires 29-bit (extended) CAN IDs. The bytes of the packed header carried
+ * in the CAN ID take its lowest bits, the first byte being the most significant one: e.g.
+ * Header Type 0 fully in the CAN ID takes bits [23, 0] as `gid << 16 | sid << 8 | pty`.
+ * The upper bits of the CAN ID are left to the user, for example for the arbitration
+ * priority.
+ *
+ * @see #hzl_HeaderCodec_t.canIdMask
+ */
+typedef enum hzl_HeaderPlacement
+{
+    /** The whole packed header at the start of the CAN FD payload. */
+    HZL_HEADER_IN_PAYLOAD = 0U,
+    /** The whole packed header in the lowest bits of the CAN ID. */
+    HZL_HEADER_IN_CAN_ID = 1U,
+    /** The first byte of the packed header in the lowest 8 bits of the CAN ID, the
+     * rest at the start of the CAN FD payload. For the 1-byte header types it's the
+     * same as #HZL_HEADER_IN_CAN_ID. */
+    HZL_HEADER_MIXED = 2U,
+} hzl_HeaderPlacement_t;
+
 /** Group Identifier data type. */
 typedef uint8_t hzl_Gid_t;
 
@@ -494,6 +620,60 @@ typedef uint32_t hzl_Timestamp_t;
 /** Counter Nonce data type. */
 typedef uint32_t hzl_CtrNonce_t;
 
+/**
+ * @def HZL_THREAD_SAFE
+ * Defined when the library is built with the CMake option of the same name, to allow
+ * concurrent calls of the Client and Server functions on the same context.
+ *
+ * Each Group state is then protected by its own #hzl_Lock_t, held only while a function
+ * works on that Group: threads working on different Groups never wait for each other.
+ * Transmissions do not take it at all: they reserve their Counter Nonces with an atomic
+ * addition, so threads transmitting in the same Group do not wait for each other either.
+ * The lock and the #hzl_SessionSeq_t take the place of the padding bytes,
+ * so the structs have the same layout either way.
+ */
+#ifdef HZL_THREAD_SAFE
+#include <stdatomic.h> /* For atomic_uchar, atomic_uint_least16_t */
+
+/**
+ * Spinlock protecting a Group state from concurrent access.
+ *
+ * Unlocked when zeroed. Managed fully by the library: the user MUST NOT touch it.
+ */
+typedef struct hzl_Lock
+{
+    /** Non-zero while held by a thread. */
+    atomic_uchar isLocked;
+} hzl_Lock_t;
+
+/** The lock replaces a single padding byte of the Group states. */
+_Static_assert(sizeof(hzl_Lock_t) == 1,
+               "The size of the Lock struct must be exactly 1 B");
+
+/**
+ * Sequence counter of the changes of the current Session of a Group.
+ *
+ * Lets the transmitting functions copy the STK and reserve Counter Nonces without taking
+ * the Group lock: they retry if a new Session was started meanwhile.
+ *
+ * Zeroed when no change ever happened. Managed fully by the library: the user MUST NOT touch it.
+ */
+typedef struct hzl_SessionSeq
+{
+    /** Incremented before and after each change, thus odd during a change. */
+    atomic_uint_least16_t changes;
+} hzl_SessionSeq_t;
+
+/** The sequence counter replaces the two remaining padding bytes of the Group states. */
+_Static_assert(sizeof(hzl_SessionSeq_t) == 2,
+               "The size of the Session Sequence struct must be exactly 2 B");
+
+/** Qualifier of the Group state fields also accessed without holding the Group lock. */
+#define HZL_ATOMIC _Atomic
+#else
+#define HZL_ATOMIC
+#endif
+
 /** Unpacked CBS Header. */
 typedef struct hzl_Header
 {
@@ -502,15 +682,41 @@ typedef struct hzl_Header
     hzl_Pty_t pty;  ///< Payload TYpe: content of the CBS message
 } hzl_Header_t;
 
-// TODO expose CBS header to allow the user to know which CAN ID to assign
-// TODO expose configuration/functions for packing the CBS header to allow the user to
-// choose where to pack the header (CAN ID, CAN payload or mixed)
+/**
+ * Packing of the CBS Header of one type, resolved from the configured header type and
+ * placement once by the initialisation functions to avoid doing it on every message.
+ *
+ * Must not be set by the user, but may be read, e.g. to configure the CAN ID filters.
+ */
+typedef struct hzl_HeaderCodec
+{
+    /** Encodes the header contiguously into the first #hzl_HeaderCodec_t.len bytes of
+     * the given binary buffer, before any split between CAN ID and payload. */
+    void (* pack)(uint8_t* binary, const hzl_Header_t* hdr);
+    /** Decodes the header from the first #hzl_HeaderCodec_t.len bytes of the given
+     * binary buffer, where the CAN ID and payload parts are joined back contiguously. */
+    void (* unpack)(hzl_Header_t* hdr, const uint8_t* binary);
+    /** Bits of the CAN ID carrying the header, zero if it's all in the payload.
+     * The other bits of the CAN ID are free for the user. */
+    hzl_CanId_t canIdMask;
+    uint8_t len;  ///< Length of the packed header in bytes, CAN ID and payload together.
+    uint8_t canIdLen;  ///< Amount of leading bytes of the packed header in the CAN ID.
+    hzl_Gid_t maxGid;  ///< Largest GID fitting in the packed header.
+} hzl_HeaderCodec_t;
+
 /**
  * Packed CBS PDU (Protocol Data Unit message) ready to be transmitted by the library user.
  */
 typedef struct hzl_CbsPduMsg
 {
     size_t dataLen;  ///< Length in bytes of the CBS-Payload.
+    /**
+     * Bits of the CAN ID carrying the part of the CBS Header that is not in the payload,
+     * according to the configured #hzl_HeaderPlacement_t, zero if it's all in the payload.
+     * The user combines them with its own bits outside of #hzl_HeaderCodec_t.canIdMask
+     * to obtain the CAN ID of the frame.
+     */
+    hzl_CanId_t canId;
     uint8_t data[HZL_MAX_CAN_FD_DATA_LEN];  ///< CBS-Payload.
 } hzl_CbsPduMsg_t;
 
@@ -523,9 +729,102 @@ typedef struct hzl_RxMsg
     hzl_Sid_t sid;  ///< Source IDentifier the message used (claimed sender).
     bool wasSecured;  ///< True if it was encrypted and authenticated during transmission.
     bool isForUser;  ///< True if the message contains useful data for the user, false if internal.
+    /**
+     * On the last fragment of a valid SADTP message: the reassembled user data in plaintext
+     * of \p dataLen bytes, located in the #hzl_SadtpRxBuffer_t.data of the buffer it was
+     * reassembled into; \p data is unused. It stays valid, with that buffer reserved for
+     * it, until the same thread calls a function processing received messages again:
+     * within a batch, every output keeps its own. NULL for any other message.
+     */
+    const uint8_t* reassembledData;
     uint8_t data[HZL_MAX_CAN_FD_DATA_LEN];  ///< User data in plaintext of \p dataLen bytes.
 } hzl_RxSduMsg_t;
 
+/**
+ * View of the user data of a received message, as obtained by the in-place processing
+ * functions: the plaintext is not copied into the struct, but left where it was decrypted.
+ */
+typedef struct hzl_RxSduView
+{
+    size_t dataLen;  ///< Length in bytes of the unpacked/decrypted user data.
+    hzl_CanId_t canId;  ///< CAN ID the underlying frame used.
+    hzl_Gid_t gid;  ///< Group IDentifier the message used (expected receivers).
+    hzl_Sid_t sid;  ///< Source IDentifier the message used (claimed sender).
+    bool wasSecured;  ///< True if it was encrypted and authenticated during transmission.
+    bool isForUser;  ///< True if the message contains useful data for the user, false if internal.
+    /**
+     * User data in plaintext of \p dataLen bytes, NULL when \p isForUser is false.
+     * Points into the received PDU for SADFD messages (decrypted in place over the
+     * ciphertext) and for UAD messages, into the #hzl_SadtpRxBuffer_t.data of the
+     * reception buffer for the last fragment of a SADTP message.
+     */
+    const uint8_t* data;
+} hzl_RxSduView_t;
+
+/**
+ * Reception buffer reassembling the fragments of a Secured Application Data over Transport
+ * Protocol (SADTP) message, decrypting them as they arrive.
+ *
+ * The user provides an array of them in the context, setting only the data and capacity
+ * fields: each buffer is dedicated to one message being received from one Group and Source
+ * at the time. The amount of buffers bounds how many SADTP messages can be reassembled
+ * concurrently, their capacity how long they can be.
+ * A buffer is freed when its message is discarded, or when it receives no fragment
+ * for longer than the Max Silence Interval of the Group of its message. A complete
+ * message keeps its buffer until the thread that received it calls a function processing
+ * received messages again, then the next first fragment needing a buffer erases it.
+ *
+ * Only the plaintext is written into the data, which is released to the user only after
+ * the tag of the whole message is validated, otherwise it's zeroed out.
+ */
+typedef struct hzl_SadtpRxBuffer
+{
+    /** Where to write the plaintext of the message. Set by the user. */
+    HZL_SET_BY_USER uint8_t* data;
+    /** Length of \p data in bytes: longer messages cannot use this buffer. Set by the user. */
+    HZL_SET_BY_USER size_t capacity;
+    /** State of the AEAD cipher between fragments. Internal, must not be set by the user. */
+    uint64_t aeadState[HZL_SADTP_AEAD_STATE_WORDS];
+    /** Amount of bytes of the `ciphertext || tag` stream received so far. Internal. */
+    size_t receivedLen;
+    /** Amount of plaintext bytes written into \p data so far. Internal. */
+    size_t decryptedLen;
+    /** When the last fragment was received. Internal. */
+    hzl_Timestamp_t lastFragmentInstant;
+    /** Thread that received the complete message in \p data, identified by a location
+     * private to it, NULL while none is held. Internal. */
+    const void* holder;
+    /** Counter Nonce of the message. Internal. */
+    hzl_CtrNonce_t ctrnonce;
+    /** Total length of the plaintext of the message. Internal. */
+    uint16_t dataLen;
+    /** Group the message is addressed to. Internal. */
+    hzl_Gid_t gid;
+    /** Source of the message. Internal. */
+    hzl_Sid_t sid;
+    /** Index the next fragment must have. Internal. */
+    uint16_t nextFragmentIdx;
+    /** Max Silence Interval of the Group of the message: the message is discarded when
+     * no fragment arrives for longer. Internal. */
+    uint16_t maxSilenceIntervalMillis;
+    /** Receiving call of the \p holder that returned the message. Internal. */
+    uint32_t holderCall;
+    /** True while reassembling a message. Internal. */
+    bool isInUse;
+    /** True if the message belongs to the previous Session during a renewal phase. Internal. */
+    bool isPreviousSession;
+    /** Tag of the message, which may be split across the last fragments. Internal. */
+    uint8_t tag[HZL_SADTP_TAG_LEN];
+} hzl_SadtpRxBuffer_t;
+
+/** SDU (Service Data Unit message) to be secured and packed by the batch-building functions. */
+typedef struct hzl_TxSduMsg
+{
+    const uint8_t* data;  ///< User data in plaintext. Can be NULL only if \p dataLen is zero.
+    size_t dataLen;  ///< Length in bytes of the user data.
+    hzl_Gid_t gid;  ///< Group IDentifier to send the message to (expected receivers).
+} hzl_TxSduMsg_t;
+
 /**
  * True-random number generator function.
  *
@@ -579,7 +878,8 @@ typedef struct
      *
      * If an OS is available, it can be set to NULL and the OS time function
      * will be selected automatically on initialisation, replacing the NULL
-     * pointer.
+     * pointer. Where available, the OS time function uses a monotonic clock,
+     * so it does not jump when the system wall-clock time is changed.
      */
     HZL_SET_BY_USER hzl_TimestampFunc currentTime;
 } hzl_Io_t;
@@ -69,12 +69,17 @@ extern "C"
  * The file must have the following format with all multi-byte integers encoded as
  * little Endian and without any paddings between any value or between any struct:
  *
- * 1. "HZL\0" as a magic number in ASCII encoding, used to double-check that the loaded file
- *    is the correct one. That is: [0x48, 0x5A, 0x4C, 0x00] in binary;
+ * 1. "HZLc" as a magic number in ASCII encoding, used to double-check that the loaded file
+ *    is the correct one, followed by the file format version byte.
+ *    That is: [0x48, 0x5A, 0x4C, 0x63, version] in binary;
  * 2. the whole #hzl_ClientConfig_t struct without any padding;
  * 3. an array of #hzl_ClientGroupConfig_t structs without any padding and with as many
  *    elements (structs) as specified in #hzl_ClientConfig_t.amountOfGroups.
  *
+ * The format versions differ only in the last byte of the #hzl_ClientConfig_t struct:
+ * - version 0: padding of any value, the header is implicitly #HZL_HEADER_IN_PAYLOAD;
+ * - version 1: the #hzl_ClientConfig_t.headerPlacement.
+ *
  * It's common to use the `.hzl` file extension to denote this file format.
  * To generate such binary file from a JSON file, the helper Python scripts in
  * `toolsupport/config` can be used.
@@ -143,6 +148,29 @@ hzl_ClientNewMsg(hzl_CbsPduMsg_t** pMsg);
 HZL_API void
 hzl_ClientFreeMsg(hzl_CbsPduMsg_t** pMsg);
 
+/**
+ * Provides the current time from the OS monotonic clock as last updated by the
+ * system timer tick, which is cheaper to read but has a resolution of a few
+ * milliseconds.
+ *
+ * hzl_ClientNew() sets #hzl_Io_t.currentTime to a precise monotonic clock of the OS,
+ * not affected by changes of the system wall-clock time.
+ * Select this coarser clock instead by assigning it to #hzl_Io_t.currentTime
+ * after hzl_ClientNew() or before hzl_ClientInit() when a tick of resolution is
+ * acceptable for the configured timeouts and the clock is read very frequently,
+ * e.g. on every received message of a busy bus.
+ * On systems without a coarse clock it provides the same time as the default one.
+ *
+ * @param [out] timestamp current time in milliseconds since an unspecified
+ *        point in time. Must not be NULL.
+ * @retval #HZL_OK on success.
+ * @retval #HZL_ERR_CANNOT_GET_CURRENT_TIME if the clock cannot be read or
+ *         \p timestamp is NULL.
+ * @see #hzl_TimestampFunc
+ */
+HZL_API hzl_Err_t
+hzl_ClientCurrentTimeCoarse(hzl_Timestamp_t* timestamp);
+
 #endif  /* HZL_OS_AVAILABLE */
 
 #ifdef __cplusplus
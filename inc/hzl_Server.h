@@ -58,16 +58,29 @@ extern "C"
  * may be any value <= this limit.
  *
  * The per-Group configuration #hzl_ServerGroupConfig_t contains a
- * static-sized bitmap of Clients in it which is limited to 32 bits to spare
- * memory. One bit is reserved for the Server.
+ * static-sized bitmap of Clients in it with a bit for each possible Client SID,
+ * i.e. all SIDs except the Server's one. Only header types with 8-bit SIDs can
+ * address all of them.
  */
-#define HZL_SERVER_MAX_AMOUNT_OF_CLIENTS 32U
+#define HZL_SERVER_MAX_AMOUNT_OF_CLIENTS 255U
+
+/** Amount of 64-bit words in the #hzl_ServerBitMap_t. */
+#define HZL_SERVER_BITMAP_WORDS 4U
 
 /**
- * Integer data type used for the bitmap of Clients that must support
- * #HZL_SERVER_MAX_AMOUNT_OF_CLIENTS bits.
+ * Bitmap of Clients that supports #HZL_SERVER_MAX_AMOUNT_OF_CLIENTS bits.
+ *
+ * Split into 64-bit words so the set operations handle 64 Clients at once and
+ * finding a single Client takes one word access.
  */
-typedef uint32_t hzl_ServerBitMap_t;
+typedef struct hzl_ServerBitMap
+{
+    /**
+     * The bit with index `i` (representing 2^i) of the word with index `w`
+     * indicates the Client with SID `64 * w + i + 1`.
+     */
+    uint64_t words[HZL_SERVER_BITMAP_WORDS];
+} hzl_ServerBitMap_t;
 
 /**
  * Largest Max-Counter-Nonce value allowed in the Server configuration.
@@ -83,6 +96,18 @@ typedef uint32_t hzl_ServerBitMap_t;
  */
 #define HZL_SERVER_MAX_COUNTER_NONCE_UPPER_LIMIT 0xFFFF80U
 
+/**
+ * Amount of levels of the timer wheel of hzl_ServerTick().
+ *
+ * Each level has #HZL_SERVER_TIMER_WHEEL_SLOTS slots, each one as long as all the slots of
+ * the level below: with 1 ms slots at the bottom, the wheel spans 2^24 ms (about 4.6 hours).
+ * Timers further away wait at the top level until they get closer.
+ */
+#define HZL_SERVER_TIMER_WHEEL_LEVELS 4U
+
+/** Amount of slots of each level of the timer wheel of hzl_ServerTick(). */
+#define HZL_SERVER_TIMER_WHEEL_SLOTS 64U
+
 /**
  * Hazelnet Server constant configuration.
  *
@@ -112,12 +137,19 @@ typedef struct hzl_ServerConfig
      * Must be one of #hzl_HeaderType_t enum fields.
      */
     HZL_SET_BY_USER uint8_t headerType;
+    /**
+     * Where the packed CBS Header is transmitted: CAN FD payload, CAN ID or both.
+     *
+     * Must be the same as all other nodes, like \p headerType.
+     * Must be one of #hzl_HeaderPlacement_t enum fields.
+     */
+    HZL_SET_BY_USER uint8_t headerPlacement;
 } hzl_ServerConfig_t;
 
 /** Double-checking the size of the hzl_ServerConfig_t struct to avoid
  * unexpected paddings. */
-_Static_assert(sizeof(hzl_ServerConfig_t) == 3,
-               "The size of the Server Config struct must be exactly 3 B");
+_Static_assert(sizeof(hzl_ServerConfig_t) == 4,
+               "The size of the Server Config struct must be exactly 4 B");
 
 /**
  * Hazelnet Server constant per-Client configuration.
@@ -199,8 +231,8 @@ typedef struct hzl_ServerGroupConfig
      * Bitmap of the Client SIDs included in this Group.
      *
      * If the bit is set (1), it's index is the SID of the included Client.
-     * The first bit (index 0, least significant) indicates the Client with SID == 1;
-     * the i-th bit (representing 2^i) indicates the Client with SID i.
+     * The first bit (index 0, least significant, of the first word) indicates the Client
+     * with SID == 1; the i-th bit (representing 2^i) indicates the Client with SID i+1.
      *
      * Constraints:
      * - Each Group must contain at least one Client, thus have at least one bit set.
@@ -234,14 +266,14 @@ typedef struct hzl_ServerGroupConfig
      * during debugging.
      */
     HZL_SET_BY_USER hzl_Gid_t gid;
-    /** Padding to the next struct. */
-    uint8_t unusedPadding[1];
+    /** Padding to the next struct, aligned to the 64-bit words of the bitmap. */
+    uint8_t unusedPadding[5];
 } hzl_ServerGroupConfig_t;
 
 /** Double-checking the size of the hzl_ServerGroupConfig_t struct to avoid
  *  unexpected paddings. */
-_Static_assert(sizeof(hzl_ServerGroupConfig_t) == 24,
-               "The size of the Server Group Config struct must be exactly 24 B");
+_Static_assert(sizeof(hzl_ServerGroupConfig_t) == 56,
+               "The size of the Server Group Config struct must be exactly 56 B");
 
 /**
  * Hazelnet Server variable State.
@@ -265,7 +297,7 @@ typedef struct hzl_ServerGroupState
      * Used to scale down the acceptable Counter Nonce interval and to known if at least
      * one Request was received from the Clients of this Group.
      */
-    hzl_Timestamp_t currentRxLastMessageInstant;
+    HZL_ATOMIC hzl_Timestamp_t currentRxLastMessageInstant;
     /**
      * Timestamp of when the last valid received secured message belonging to the previously
      * active Session was processed (m^{old}_G), currently about to expire.
@@ -276,7 +308,7 @@ typedef struct hzl_ServerGroupState
     /**
      * Counter Nonce of the the currently active Session (N^{ctr}_G).
      */
-    hzl_CtrNonce_t currentCtrNonce;
+    HZL_ATOMIC hzl_CtrNonce_t currentCtrNonce;
     /**
      * Counter Nonce of the the previously active Session (N^{ctr,old}_G), currently
      * about to expire.
@@ -291,12 +323,107 @@ typedef struct hzl_ServerGroupState
      * about to expire.
      */
     uint8_t previousStk[HZL_LTK_LEN];
+    /**
+     * True while the Session renewal phase is ongoing, i.e. while the previous Session
+     * information (`previousStk` etc.) is still valid.
+     */
+    bool isRenewalPhaseActive;
+#ifdef HZL_THREAD_SAFE
+    /** Protects this Group state when the context is used by multiple threads. */
+    hzl_Lock_t lock;
+    /** Changes of the current Session, for the threads not holding the lock. */
+    hzl_SessionSeq_t sessionSeq;
+#else
+    /** Padding to the next field. */
+    uint8_t unusedPadding[3];
+#endif
+    /**
+     * Precomputed hash state after absorbing `previousStk || label` of the REN messages,
+     * valid only while the renewal phase is active.
+     *
+     * Used to authenticate each REN notification without hashing the key again.
+     */
+    uint64_t renHashMidstate[HZL_HASH_STATE_WORDS];
 } hzl_ServerGroupState_t;
 
 /** Double-checking the size of the hzl_ServerGroupState_t struct to avoid
+ *  unexpected paddings. It was 52 B before the renewal phase flag was added
+ *  and 56 B before the REN hash midstate was added. */
+_Static_assert(sizeof(hzl_ServerGroupState_t) == 112,
+               "The size of the Server Group State struct must be exactly 112 B");
+
+/**
+ * Hazelnet Server variable State, precomputed from the Client's configuration.
+ *
+ * Single instance per Client, multiple instances per Server.
+ * Initialised, modified, managed and cleared fully by the Server:
+ * the user MUST NOT touch its contents.
+ */
+typedef struct hzl_ServerClientState
+{
+    /**
+     * Precomputed hash state after absorbing `LTK || label` of the REQ messages.
+     *
+     * Used to validate each REQ of the Client without hashing its LTK again.
+     */
+    uint64_t reqHashMidstate[HZL_HASH_STATE_WORDS];
+} hzl_ServerClientState_t;
+
+/**
+ * Hazelnet Server timer and next Session key of a Group, for hzl_ServerTick().
+ *
+ * Single instance per Group, multiple instances per Server.
+ * Initialised, modified, managed and cleared fully by the Server:
+ * the user MUST NOT touch its contents.
+ */
+typedef struct hzl_ServerGroupTimer
+{
+    /**
+     * Timestamp of the next time-driven event of the Group: the expiration of its Session
+     * or, during the Session renewal phase, the next REN notification or the end of the phase.
+     */
+    hzl_Timestamp_t deadline;
+    /** Slot of the timer wheel holding the Group, over all levels, or
+     * `UINT16_MAX` if the Group is not in the wheel. */
+    uint16_t slot;
+    /** Index + 1 of the next Group in the same slot, 0 if this is the last one. */
+    uint8_t next;
+    /** Index + 1 of the previous Group in the same slot, 0 if this is the first one. */
+    uint8_t previous;
+    /**
+     * Short Term Key of the next Session, generated in advance by
+     * hzl_ServerPrepareNextSessions(), so the Session renewal does not wait for the TRNG.
+     * All zeros when not available, as STKs are never all zeros: zeroed when taken by a
+     * renewal, telling hzl_ServerPrepareNextSessions() to generate it again.
+     * Protected by the lock of the Group state.
+     */
+    uint8_t nextStk[HZL_STK_LEN];
+} hzl_ServerGroupTimer_t;
+
+/** Double-checking the size of the hzl_ServerGroupTimer_t struct to avoid
  *  unexpected paddings. */
-_Static_assert(sizeof(hzl_ServerGroupState_t) == 52,
-               "The size of the Server Group State struct must be exactly 52 B");
+_Static_assert(sizeof(hzl_ServerGroupTimer_t) == 24,
+               "The size of the Server Group Timer struct must be exactly 24 B");
+
+/**
+ * Hierarchical timer wheel of the Group timers, advanced by hzl_ServerTick().
+ *
+ * Built by hzl_ServerInit() and hzl_ServerNew(): the user MUST NOT touch its contents.
+ */
+typedef struct hzl_ServerTimerWheel
+{
+    /** Instant up to which the wheel was advanced. */
+    hzl_Timestamp_t now;
+#ifdef HZL_THREAD_SAFE
+    /** Protects the wheel when the context is used by multiple threads.
+     * Taken after the lock of a Group state, never before. */
+    hzl_Lock_t lock;
+#endif
+    /** Bit `i` of element `l` is set when the slot `i` of the level `l` is not empty. */
+    uint64_t occupiedSlots[HZL_SERVER_TIMER_WHEEL_LEVELS];
+    /** Index + 1 of the first Group in each slot of each level, 0 if the slot is empty. */
+    uint8_t slotHeads[HZL_SERVER_TIMER_WHEEL_LEVELS * HZL_SERVER_TIMER_WHEEL_SLOTS];
+} hzl_ServerTimerWheel_t;
 
 /**
  * Configuration and status of the HazelNet Server library.
@@ -361,6 +488,62 @@ typedef struct hzl_ServerCtx
      * Including random number generation, timestamp generation and message transmission.
      */
     HZL_SET_BY_USER hzl_Io_t io;
+    /**
+     * Pointer to an **array** of buffers to reassemble the received SADTP messages.
+     *
+     * Optional: set by the user to point to #hzl_ServerCtx_t.amountOfSadtpRxBuffers
+     * buffers, each with its data and capacity set, to receive SADTP messages.
+     * May be NULL if the amount is zero, in which case any received SADTP message is
+     * discarded with #HZL_ERR_MSG_IGNORED.
+     * The Server handles their internal state, initialising it on init and clearing
+     * it (including the data) at deinit.
+     */
+    HZL_SET_BY_USER hzl_SadtpRxBuffer_t* sadtpRxBuffers;
+    /** Amount of elements in the #hzl_ServerCtx_t.sadtpRxBuffers array. Set by the user. */
+    HZL_SET_BY_USER size_t amountOfSadtpRxBuffers;
+    /**
+     * Pointer to an **array** of structs, each with the precomputed state of one Client.
+     *
+     * Optional: set by the user to point to a memory location of
+     * #hzl_ServerConfig_t.amountOfClients elements (structs), which does not have to be
+     * initialised. Indexed in the same way as the `clientConfigs` array.
+     * May be NULL, in which case the Server computes the same data for every
+     * received Request, which is slower.
+     * The Server handles the initialisation on init and clears it at deinit.
+     */
+    HZL_SET_BY_USER hzl_ServerClientState_t* clientStates;
+    /**
+     * Pointer to an **array** of structs, each with the timer of one Group.
+     *
+     * Optional: set by the user to point to a memory location of
+     * #hzl_ServerConfig_t.amountOfGroups elements (structs), which does not have to be
+     * initialised. Indexed in the same way as the `groupConfigs` array.
+     * May be NULL, in which case hzl_ServerTick() is not available and the Sessions
+     * are renewed only when a secured message is received after their expiration.
+     * The Server handles the initialisation on init and clears it at deinit.
+     */
+    HZL_SET_BY_USER hzl_ServerGroupTimer_t* groupTimers;
+    /**
+     * Packing of the CBS Header of the type in the Server configuration.
+     *
+     * Built by hzl_ServerInit() and hzl_ServerNew(), must not be set by the user.
+     */
+    hzl_HeaderCodec_t header;
+    /**
+     * Timer wheel of the `groupTimers`, if any.
+     *
+     * Built by hzl_ServerInit() and hzl_ServerNew(), must not be set by the user.
+     */
+    hzl_ServerTimerWheel_t timerWheel;
+#ifdef HZL_THREAD_SAFE
+    /**
+     * Protects the `sadtpRxBuffers`, shared by all Groups, when the context is used by
+     * multiple threads. Taken after the lock of the Group state, never before.
+     *
+     * Initialised by hzl_ServerInit() and hzl_ServerNew(), must not be set by the user.
+     */
+    hzl_Lock_t sadtpRxBuffersLock;
+#endif
 } hzl_ServerCtx_t;
 
 /**
@@ -385,6 +568,7 @@ typedef struct hzl_ServerCtx
  * @retval #HZL_ERR_NULL_CTX
  * @retval #HZL_ERR_NULL_CONFIG_SERVER
  * @retval #HZL_ERR_INVALID_HEADER_TYPE
+ * @retval #HZL_ERR_INVALID_HEADER_PLACEMENT
  * @retval #HZL_ERR_ZERO_GROUPS
  * @retval #HZL_ERR_TOO_MANY_GROUPS_FOR_CONFIGURED_HEADER_TYPE
  * @retval #HZL_ERR_ZERO_CLIENTS
@@ -407,6 +591,7 @@ typedef struct hzl_ServerCtx
  * @retval #HZL_ERR_NULL_STATES_GROUPS
  * @retval #HZL_ERR_NULL_CURRENT_TIME_FUNC
  * @retval #HZL_ERR_NULL_TRNG_FUNC
+ * @retval #HZL_ERR_NULL_SADTP_RX_BUFFERS
  * @retval #HZL_ERR_CANNOT_GET_CURRENT_TIME
  * @retval #HZL_ERR_CANNOT_GENERATE_RANDOM
  * @retval #HZL_ERR_CANNOT_GENERATE_NON_ZERO_RANDOM
@@ -508,6 +693,122 @@ hzl_ServerBuildSecuredFd(hzl_CbsPduMsg_t* securedPdu,
                          size_t userDataLen,
                          hzl_Gid_t groupId);
 
+/**
+ * Builds a secured message like hzl_ServerBuildSecuredFd(), but directly into a user-provided
+ * buffer, such as the payload of the frame structure of the CAN FD driver or its
+ * transmission mailbox, avoiding the copy out of a #hzl_CbsPduMsg_t.
+ *
+ * Produces exactly the same message and updates the state exactly as
+ * hzl_ServerBuildSecuredFd() does. The buffer is not altered in case of error.
+ *
+ * @param [out] securedPdu where to write the CBS message in packed format, ready to transmit.
+ *        Not NULL.
+ * @param [in] securedPduCapacity length of \p securedPdu in bytes. At most
+ *        #HZL_MAX_CAN_FD_DATA_LEN bytes are written.
+ * @param [out] securedPduLen length of the message written into \p securedPdu in bytes,
+ *        0 in case of error. Not NULL.
+ * @param [out] securedCanId CAN ID bits carrying the header, as #hzl_CbsPduMsg_t.canId,
+ *        0 in case of error. Not NULL.
+ * @param [in, out] ctx to access configurations and update the group states. Not NULL.
+ * @param [in] userData plaintext data (SDU) to pack encrypted and authenticated. Can be
+ *             NULL only if \p userDataLen is zero.
+ * @param [in] userDataLen length of \p userData in bytes.
+ * @param [in] groupId destination group identifier (the Parties that can decrypt).
+ *
+ * @retval Same values as hzl_ServerBuildSecuredFd().
+ * @retval #HZL_ERR_NULL_PDU if \p securedPdu, \p securedPduLen or \p securedCanId is NULL.
+ * @retval #HZL_ERR_TOO_SMALL_PDU_BUFFER if \p securedPduCapacity is too small for the
+ *         message. No Counter Nonce is consumed.
+ */
+HZL_API hzl_Err_t
+hzl_ServerBuildSecuredFdInto(uint8_t* securedPdu,
+                             size_t securedPduCapacity,
+                             size_t* securedPduLen,
+                             hzl_CanId_t* securedCanId,
+                             hzl_ServerCtx_t* ctx,
+                             const uint8_t* userData,
+                             size_t userDataLen,
+                             hzl_Gid_t groupId);
+
+/**
+ * Builds a batch of secured messages, encrypted, authenticated and timely, each one only for
+ * its given group to be able to read.
+ *
+ * Equivalent to calling hzl_ServerBuildSecuredFd() on each element of \p userData in order,
+ * producing exactly the same messages, but the context is checked only once for the whole
+ * batch and each run of consecutive messages for the same Group checks the Group once and
+ * reserves the Counter Nonces it needs up front.
+ * Sort the messages by GID to get the most out of it.
+ *
+ * An error in one message does not stop the building of the following ones: the error is
+ * reported in \p results at the message's index and the PDU at that index is left empty.
+ *
+ * @param [out] securedPdus array of \p amountOfMsgs CBS messages in packed format,
+ *        ready to transmit, one per element of \p userData. Not NULL.
+ * @param [out] results array of \p amountOfMsgs result codes, one per message, with the
+ *        same values hzl_ServerBuildSecuredFd() would return for that message. Not NULL.
+ * @param [in, out] ctx to access configurations and update the group states. Not NULL.
+ * @param [in] userData array of \p amountOfMsgs plaintext data (SDUs) with their destination
+ *        group identifier to pack encrypted and authenticated. Can be NULL only if
+ *        \p amountOfMsgs is zero.
+ * @param [in] amountOfMsgs length of all the arrays above. May be zero.
+ *
+ * @retval #HZL_OK when every message of the batch was handled: check \p results for the
+ *         outcome of each one of them.
+ * @retval Same values as hzl_ServerInit() in case the context has NULL pointers.
+ * @retval #HZL_ERR_NULL_PDU if \p securedPdus is NULL.
+ * @retval #HZL_ERR_NULL_RESULTS if \p results is NULL.
+ * @retval #HZL_ERR_NULL_SDU if \p userData is NULL and \p amountOfMsgs is > 0.
+ */
+HZL_API hzl_Err_t
+hzl_ServerBuildSecuredFdBatch(hzl_CbsPduMsg_t* securedPdus,
+                              hzl_Err_t* results,
+                              hzl_ServerCtx_t* ctx,
+                              const hzl_TxSduMsg_t* userData,
+                              size_t amountOfMsgs);
+
+/**
+ * Builds a secured message too long for a single CAN FD frame, encrypted, authenticated and
+ * timely, split into consecutive fragments only for the given group to be able to read:
+ * a Secured Application Data over Transport Protocol (SADTP) message.
+ *
+ * The user data is encrypted straight into the fragments as they are packed, and the whole
+ * message is authenticated by a single tag at the end of the last fragment. It uses a single
+ * Counter Nonce, as a Secured Application Data over CAN FD message does.
+ * Transmit the fragments in order with the same CAN ID, so the receivers get them in order.
+ * The receivers reassemble them into the buffers at \p ctx->sadtpRxBuffers.
+ *
+ * @param [out] securedPdus array of CBS messages in packed format, ready to transmit
+ *        in order. Size it with #HZL_SADTP_AMOUNT_OF_PDUS(). Not NULL.
+ * @param [in, out] amountOfPdus on input the length of the \p securedPdus array, on output
+ *        the amount of PDUs written into it, zero on error. Not NULL.
+ * @param [in, out] ctx to access configurations and update the group states. Not NULL.
+ * @param [in] userData plaintext data (SDU) to pack encrypted and authenticated. Can be
+ *             NULL only if \p userDataLen is zero.
+ * @param [in] userDataLen length of \p userData in bytes, at most #HZL_SADTP_MAX_DATA_LEN.
+ * @param [in] groupId destination group identifier (the Parties that can decrypt).
+ *
+ * @retval #HZL_OK on successful building of the whole message.
+ * @retval #HZL_ERR_NO_POTENTIAL_RECEIVER if no Request was received yet from any Client
+ *         in the Group, so no Client could decrypt the message.
+ * @retval Same values as hzl_ServerInit() in case the context has NULL pointers.
+ * @retval #HZL_ERR_NULL_PDU if \p securedPdus or \p amountOfPdus is NULL.
+ * @retval #HZL_ERR_NULL_SDU if \p userData is NULL and \p userDataLen is > 0.
+ * @retval #HZL_ERR_TOO_LONG_SDU if \p userDataLen is over #HZL_SADTP_MAX_DATA_LEN
+ *         or needs more PDUs than \p *amountOfPdus.
+ * @retval #HZL_ERR_GID_TOO_LARGE_FOR_CONFIGURED_HEADER_TYPE when \p groupId
+ *         would not fit in the packed CBS header.
+ * @retval #HZL_ERR_UNKNOWN_GROUP when \p group is not supported in the context's
+ *         configuration.
+ */
+HZL_API hzl_Err_t
+hzl_ServerBuildSecuredTp(hzl_CbsPduMsg_t* securedPdus,
+                         size_t* amountOfPdus,
+                         hzl_ServerCtx_t* ctx,
+                         const uint8_t* userData,
+                         size_t userDataLen,
+                         hzl_Gid_t groupId);
+
 /**
  * Validates, unpacks and decrypts (if necessary) any received message, preparing an automatic
  * response when required.
@@ -527,6 +828,10 @@ hzl_ServerBuildSecuredFd(hzl_CbsPduMsg_t* securedPdu,
  *        cleared (zeroed out) before anything else is attempted; thus it's full of zeros
  *        in case of errors. This is done to clear any lingering data if the buffer is reused,
  *        to avoid leaking information about previously-decrypted messages. Not NULL.
+ *        For a SADTP message, only its last fragment makes #hzl_RxSduMsg_t.isForUser true;
+ *        the user data is then at #hzl_RxSduMsg_t.reassembledData, within one of the
+ *        reception buffers of \p ctx, and stays valid until the calling thread processes
+ *        received messages again: that buffer stays reserved for it until then.
  * @param [in, out] ctx to access configurations and update the group states. Not NULL.
  * @param [in] receivedPdu packed CBS message as received from the underlying layer. Not NULL.
  * @param [in] receivedPduLen length of \p receivedPdu in bytes.
@@ -542,11 +847,16 @@ hzl_ServerBuildSecuredFd(hzl_CbsPduMsg_t* securedPdu,
  *         short to even contain a CBS message with the currently configured Header Type in the ctx.
  * @retval #HZL_ERR_INVALID_PAYLOAD_TYPE on unsupported PTY field in the CBS Header.
  * @retval #HZL_ERR_TOO_SHORT_PDU_TO_CONTAIN_SADFD,
+ *         #HZL_ERR_TOO_SHORT_PDU_TO_CONTAIN_SADTP,
  *         #HZL_ERR_TOO_SHORT_PDU_TO_CONTAIN_REQ when the received message is too short
  *         to contain the data is should as indicated in its header (or also in the payload length
  *         field in case of Secured Application Data messages).
  * @retval #HZL_ERR_TOO_LONG_CIPHERTEXT if the received Secured Application Data message
  *         claims to contain too much data to fit into the underlying layer's message.
+ * @retval #HZL_ERR_SADTP_NO_FREE_RX_BUFFER when the first fragment of a received SADTP
+ *         message finds no free reception buffer large enough for it.
+ * @retval #HZL_ERR_SADTP_UNEXPECTED_FRAGMENT when the received SADTP fragment is not the next
+ *         one of a message being reassembled. That message is discarded.
  * @retval #HZL_ERR_SESSION_NOT_ESTABLISHED when the current state indicates no
  *         session key and counter nonce have been established for this group yet.
  * @retval #HZL_ERR_SECWARN_MESSAGE_FROM_MYSELF when the received message seems to originate
@@ -570,6 +880,102 @@ hzl_ServerProcessReceived(hzl_CbsPduMsg_t* reactionPdu,
                           size_t receivedPduLen,
                           hzl_CanId_t receivedCanId);
 
+/**
+ * Like hzl_ServerProcessReceived(), but decrypts a SADFD message in place, over its ciphertext in
+ * \p receivedPdu, and provides a view of the user data instead of a copy of it.
+ *
+ * Avoids copying the user data into a #hzl_RxSduMsg_t and securely clearing its 64 bytes
+ * for every received message: useful in the high-rate reception path, when the caller
+ * copies the user data elsewhere anyway (e.g. a signal database) or uses it right away.
+ *
+ * @param [out] reactionPdu CBS message in packed format, ready to transmit, generated as
+ *        an automatic, internal reaction to the just received message.
+ *        No need to transmit if #hzl_CbsPduMsg_t.dataLen is zero. Not NULL.
+ *        **Transmit any data even if the return error code is non-OK.**
+ * @param [out] receivedUserData view of the plaintext user data of \p receivedPdu.
+ *        Cleared before anything else is attempted; thus it's full of zeros with a
+ *        NULL #hzl_RxSduView_t.data in case of errors. Not NULL.
+ *        The user data of SADFD and UAD messages stays within \p receivedPdu, thus it's valid
+ *        as long as that buffer is not reused; the one of a SADTP message is within one
+ *        of the reception buffers of \p ctx, as in hzl_ServerProcessReceived().
+ * @param [in, out] ctx to access configurations and update the group states. Not NULL.
+ * @param [in, out] receivedPdu packed CBS message as received from the underlying layer.
+ *        The ciphertext of a SADFD message is overwritten with the plaintext, or with
+ *        zeros if the message is not authentic. Not NULL.
+ * @param [in] receivedPduLen length of \p receivedPdu in bytes.
+ * @param [in] receivedCanId identifier of the underlying layer's PDU, passed as-is
+ *        to \p receivedUserData.
+ *
+ * @return same values as hzl_ServerProcessReceived().
+ */
+HZL_API hzl_Err_t
+hzl_ServerProcessReceivedInPlace(hzl_CbsPduMsg_t* reactionPdu,
+                                 hzl_RxSduView_t* receivedUserData,
+                                 hzl_ServerCtx_t* ctx,
+                                 uint8_t* receivedPdu,
+                                 size_t receivedPduLen,
+                                 hzl_CanId_t receivedCanId);
+
+/**
+ * Validates, unpacks and decrypts (if necessary) a batch of received messages, preparing an
+ * automatic response for each of them when required.
+ *
+ * Equivalent to calling hzl_ServerProcessReceived() on each received message in order, but
+ * the context is checked only once for the whole batch, all output locations are cleared in a
+ * single pass and, unless the caller provides the reception timestamps, the current time is
+ * obtained only once and used for every message in the batch. Useful when the underlying
+ * layer delivers many messages at once (e.g. one read from a CAN FD socket).
+ *
+ * The messages are processed in order, thus a message in the batch sees the state changes
+ * caused by the previous ones (e.g. a Request and a Secured message of the same Group).
+ * An error in one message does not stop the processing of the following ones: the
+ * error is reported in \p results at the message's index instead.
+ *
+ * @param [out] reactionPdus array of \p amountOfPdus CBS messages in packed format,
+ *        ready to transmit, generated as automatic reactions to the messages at the same index.
+ *        No need to transmit those with #hzl_CbsPduMsg_t.dataLen of zero. Not NULL.
+ *        **Transmit any data even if the result code at that index is non-OK.**
+ * @param [out] receivedUserData array of \p amountOfPdus plaintext user data extracted out of
+ *        the messages at the same index. Securely cleared (zeroed out) before anything else is
+ *        attempted, as in hzl_ServerProcessReceived(). Not NULL.
+ *        Each SADTP message completed within the batch keeps its own reception buffer,
+ *        so all of their #hzl_RxSduMsg_t.reassembledData stay valid until the calling
+ *        thread processes received messages again.
+ * @param [out] results array of \p amountOfPdus result codes, one per message, with the
+ *        same values hzl_ServerProcessReceived() would return for that message. Not NULL.
+ * @param [in, out] ctx to access configurations and update the group states. Not NULL.
+ * @param [in] receivedPdus array of \p amountOfPdus pointers to the packed CBS messages as
+ *        received from the underlying layer. Not NULL.
+ * @param [in] receivedPduLens array of \p amountOfPdus lengths of \p receivedPdus in bytes.
+ *        Not NULL.
+ * @param [in] receivedCanIds array of \p amountOfPdus identifiers of the underlying layer's
+ *        PDUs, passed as-is to \p receivedUserData. Not NULL.
+ * @param [in] rxTimestamps array of \p amountOfPdus reception timestamps, e.g. obtained from the
+ *        driver when the messages were received. If NULL, #hzl_Io_t.currentTime is called once
+ *        and its value is used for the whole batch.
+ * @param [in] amountOfPdus length of all the arrays above. May be zero.
+ *
+ * @retval #HZL_OK when every message of the batch was processed: check \p results for the
+ *         outcome of each one of them.
+ * @retval Same values as hzl_ServerInit() in case the context has NULL pointers.
+ * @retval #HZL_ERR_NULL_PDU if \p reactionPdus, \p receivedPdus, \p receivedPduLens or
+ *         \p receivedCanIds are NULL.
+ * @retval #HZL_ERR_NULL_SDU if \p receivedUserData is NULL.
+ * @retval #HZL_ERR_NULL_RESULTS if \p results is NULL.
+ * @retval #HZL_ERR_CANNOT_GET_CURRENT_TIME if \p rxTimestamps is NULL and the current time
+ *         cannot be obtained. No message is processed in this case.
+ */
+HZL_API hzl_Err_t
+hzl_ServerProcessReceivedBatch(hzl_CbsPduMsg_t* reactionPdus,
+                               hzl_RxSduMsg_t* receivedUserData,
+                               hzl_Err_t* results,
+                               hzl_ServerCtx_t* ctx,
+                               const uint8_t* const* receivedPdus,
+                               const size_t* receivedPduLens,
+                               const hzl_CanId_t* receivedCanIds,
+                               const hzl_Timestamp_t* rxTimestamps,
+                               size_t amountOfPdus);
+
 /**
  * Forcibly start a Session Renewal Phase, unless one is already ongoing or no Clients
  * are currently enabled (have Requested the STK) to process the REN message.
@@ -593,6 +999,101 @@ hzl_ServerForceSessionRenewal(hzl_CbsPduMsg_t* renewalPdu,
                               hzl_ServerCtx_t* ctx,
                               hzl_Gid_t groupId);
 
+/**
+ * Runs the time-driven events of all Groups that are due at \p now.
+ *
+ * To be called periodically, e.g. every few milliseconds, to renew the Sessions of the quiet
+ * Groups on time and to retransmit the REN notifications during the Session renewal phase:
+ * - a Group whose Session expired enters the Session renewal phase and a REN message is built,
+ *   unless no Client Requested the expired Session, in which case it is just replaced;
+ * - during the Session renewal phase, a REN message is built every
+ *   #hzl_ServerGroupConfig_t.delayBetweenRenNotificationsMillis, until the phase is over.
+ *
+ * The Groups are kept in a hierarchical timer wheel, so each call costs time proportional to
+ * the amount of due events, not to the amount of Groups. The events not fitting into
+ * \p renewalPdus stay due for the next call.
+ *
+ * Finally, like hzl_ServerPrepareNextSessions(), it generates the STKs of the next Sessions
+ * of the Groups that used theirs.
+ *
+ * @param [out] renewalPdus array of REN messages in packed format, ready to transmit. Not NULL.
+ * @param [in, out] amountOfPdus on input the length of the \p renewalPdus array, on output
+ *        the amount of PDUs written into it. Not NULL.
+ * @param [in, out] ctx to access configurations and update the group states and timers.
+ *        Its `groupTimers` must be not NULL. Not NULL.
+ * @param [in] now current timestamp, as from the #hzl_Io_t.currentTime function.
+ *
+ * @retval #HZL_OK on success.
+ * @retval Same values as hzl_ServerInit() in case the context has NULL pointers.
+ * @retval #HZL_ERR_NULL_PDU if \p renewalPdus or \p amountOfPdus is NULL.
+ * @retval #HZL_ERR_NULL_GROUP_TIMERS if \p ctx has no `groupTimers`.
+ * @retval #HZL_ERR_CANNOT_GET_CURRENT_TIME
+ * @retval #HZL_ERR_CANNOT_GENERATE_RANDOM
+ */
+HZL_API hzl_Err_t
+hzl_ServerTick(hzl_CbsPduMsg_t* renewalPdus,
+               size_t* amountOfPdus,
+               hzl_ServerCtx_t* ctx,
+               hzl_Timestamp_t now);
+
+/**
+ * Generates the STKs of the next Sessions of the Groups that used theirs.
+ *
+ * Each Group holds the STK of its next Session in its #hzl_ServerGroupTimer_t, generated
+ * on init. A Session renewal takes it instead of calling the TRNG, so the reception of the
+ * secured message triggering the renewal is not slowed down by the TRNG. Its replacement is
+ * generated by this function, costing one TRNG call per Session renewed since the last call.
+ * A used STK is left all zeros in the #hzl_ServerGroupTimer_t, shared by all copies of the
+ * context, so this also replaces the ones used by the shards of hzl_ServerShards.h.
+ * If no next STK is available, the renewal calls the TRNG as usual.
+ *
+ * Called by hzl_ServerTick(): to be called only when the TRNG should run somewhere else, e.g.
+ * on a low-priority background thread (requires the #HZL_THREAD_SAFE build).
+ *
+ * @param [in, out] ctx to access the TRNG and update the group timers.
+ *        Its `groupTimers` must be not NULL. Not NULL.
+ *
+ * @retval #HZL_OK on success.
+ * @retval Same values as hzl_ServerInit() in case the context has NULL pointers.
+ * @retval #HZL_ERR_NULL_GROUP_TIMERS if \p ctx has no `groupTimers`.
+ * @retval #HZL_ERR_CANNOT_GENERATE_RANDOM, in which case the remaining STKs are
+ *         generated at the next call.
+ */
+HZL_API hzl_Err_t
+hzl_ServerPrepareNextSessions(hzl_ServerCtx_t* ctx);
+
+
+/**
+ * Unpacks the CBS Header of a received message, from its payload and/or its CAN ID according
+ * to the configured #hzl_HeaderPlacement_t, without processing the message.
+ *
+ * Useful to inspect the Group, Source and Payload Type of a message before passing it to
+ * hzl_ServerProcessReceived(), e.g. to route it to a different context or queue.
+ * Nothing is validated besides the message being long enough to contain the header.
+ *
+ * @param [out] unpackedHdr where to write the decoded header. Not NULL.
+ * @param [in] ctx to access the header configuration, initialised by hzl_ServerInit() or hzl_ServerNew().
+ *        Not NULL.
+ * @param [in] receivedPdu packed CBS message as received from the underlying layer.
+ *        Can be NULL only if \p receivedPduLen is zero.
+ * @param [in] receivedPduLen length of \p receivedPdu in bytes.
+ * @param [in] receivedCanId identifier of the underlying layer's PDU, carrying the header
+ *        in the bits of #hzl_HeaderCodec_t.canIdMask.
+ *
+ * @retval #HZL_OK on success.
+ * @retval #HZL_ERR_NULL_HEADER if \p unpackedHdr is NULL.
+ * @retval #HZL_ERR_NULL_CTX if \p ctx is NULL.
+ * @retval #HZL_ERR_NULL_PDU if \p receivedPdu is NULL and \p receivedPduLen is > 0.
+ * @retval #HZL_ERR_CTX_NOT_INITIALISED if \p ctx was not initialised.
+ * @retval #HZL_ERR_TOO_SHORT_PDU_TO_CONTAIN_HEADER if \p receivedPduLen is shorter than the
+ *         part of the header in the payload.
+ */
+HZL_API hzl_Err_t
+hzl_ServerUnpackHeader(hzl_Header_t* unpackedHdr,
+                       const hzl_ServerCtx_t* ctx,
+                       const uint8_t* receivedPdu,
+                       size_t receivedPduLen,
+                       hzl_CanId_t receivedCanId);
 
 #ifdef __cplusplus
 }
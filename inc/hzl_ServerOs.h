@@ -69,12 +69,25 @@ extern "C"
  * The file must have the following format with all multi-byte integers encoded as
  * little Endian and without any paddings between any value or between any struct:
  *
- * 1. "HZL\0" as a magic number in ASCII encoding, used to double-check that the loaded file
- *    is the correct one. That is: [0x48, 0x5A, 0x4C, 0x00] in binary;
+ * 1. "HZLs" as a magic number in ASCII encoding, used to double-check that the loaded file
+ *    is the correct one, followed by the file format version byte.
+ *    That is: [0x48, 0x5A, 0x4C, 0x73, version] in binary;
  * 2. the whole #hzl_ServerConfig_t struct without any padding;
  * 3. an array of #hzl_ServerGroupConfig_t structs without any padding and with as many
  *    elements (structs) as specified in #hzl_ServerConfig_t.amountOfGroups.
  *
+ * The format versions differ in the #hzl_ServerGroupConfig_t.clientSidsInGroupBitmap
+ * field of each Group and in the #hzl_ServerConfig_t.headerPlacement field:
+ * - version 0: a 4-byte integer, thus supporting Clients with SIDs up to 32 only;
+ * - version 1: the whole 32-byte #hzl_ServerBitMap_t, supporting
+ *   #HZL_SERVER_MAX_AMOUNT_OF_CLIENTS Clients;
+ * - version 2: as version 1, but the #hzl_ServerConfig_t struct includes the
+ *   \p headerPlacement byte, which is absent and implicitly #HZL_HEADER_IN_PAYLOAD
+ *   in the older versions.
+ *
+ * In all versions the #hzl_ServerGroupConfig_t.unusedPadding field takes just 1 byte
+ * in the file.
+ *
  * It's common to use the `.hzl` file extension to denote this file format.
  * To generate such binary file from a JSON file, the helper Python scripts in
  * `toolsupport/config` can be used.
@@ -88,6 +101,8 @@ extern "C"
  * @retval #HZL_ERR_CANNOT_OPEN_CONFIG_FILE if the file cannot be opened (does not exists,
  *         or the permissions are not correct)
  * @retval #HZL_ERR_MALLOC_FAILED if the heap-allocation fails (out of memory).
+ * @retval #HZL_ERR_INVALID_FILE_MAGIC_NUMBER if the file does not start with the magic number
+ *         or has an unknown format version.
  * @retval #HZL_ERR_UNEXPECTED_EOF if the file is too short: more data was expected
  *         during parsing. Probably is has incorrect syntax or amount of groups.
  * @retval Same values as hzl_ServerInit() in case the context has incorrect data or pointers.
@@ -143,6 +158,29 @@ hzl_ServerNewMsg(hzl_CbsPduMsg_t** pMsg);
 HZL_API void
 hzl_ServerFreeMsg(hzl_CbsPduMsg_t** pMsg);
 
+/**
+ * Provides the current time from the OS monotonic clock as last updated by the
+ * system timer tick, which is cheaper to read but has a resolution of a few
+ * milliseconds.
+ *
+ * hzl_ServerNew() sets #hzl_Io_t.currentTime to a precise monotonic clock of the OS,
+ * not affected by changes of the system wall-clock time.
+ * Select this coarser clock instead by assigning it to #hzl_Io_t.currentTime
+ * after hzl_ServerNew() or before hzl_ServerInit() when a tick of resolution is
+ * acceptable for the configured timeouts and the clock is read very frequently,
+ * e.g. on every received message of a busy bus.
+ * On systems without a coarse clock it provides the same time as the default one.
+ *
+ * @param [out] timestamp current time in milliseconds since an unspecified
+ *        point in time. Must not be NULL.
+ * @retval #HZL_OK on success.
+ * @retval #HZL_ERR_CANNOT_GET_CURRENT_TIME if the clock cannot be read or
+ *         \p timestamp is NULL.
+ * @see #hzl_TimestampFunc
+ */
+HZL_API hzl_Err_t
+hzl_ServerCurrentTimeCoarse(hzl_Timestamp_t* timestamp);
+
 #endif  /* HZL_OS_AVAILABLE */
 
 #ifdef __cplusplus
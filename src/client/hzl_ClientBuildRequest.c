@@ -51,12 +51,10 @@ hzl_ClientBuildMsgReq(hzl_CbsPduMsg_t* msgToTx,
             .sid = ctx->clientConfig->sid,
             .pty = HZL_PTY_REQ,
     };
-    const uint8_t packedHdrLen = hzl_HeaderLen(ctx->clientConfig->headerType);
-    hzl_HeaderPackFunc const headerPackFunc =
-            hzl_HeaderPackFuncForType(ctx->clientConfig->headerType);
+    const uint8_t packedHdrLen = hzl_HeaderCodecPayloadLen(&ctx->header);
     // Prepare REQ Payload
     // Write the packed header at the beginning of the CAN FD frame's payload.
-    headerPackFunc(msgToTx->data, &unpackedReqHeader);
+    hzl_HeaderCodecPack(&ctx->header, &msgToTx->canId, msgToTx->data, &unpackedReqHeader);
     // Write request nonce after the header
     hzl_ReqNonce_t requestNonce = 0;
     err = hzl_NonZeroTrng((uint8_t*) &requestNonce, ctx->io.trng, sizeof(hzl_ReqNonce_t));
@@ -93,17 +91,19 @@ hzl_ClientBuildRequest(hzl_CbsPduMsg_t* requestPdu,
     hzl_ClientGroup_t group;
     err = hzl_ClientFindGroup(&group, ctx, groupId);
     HZL_ERR_CHECK(err);
+    hzl_ClientGroupLock(ctx, groupId);
     bool isAHandshakeOngoing = false;
     err = hzl_ClientIsAHandShakeOngoing(&isAHandshakeOngoing, ctx, &group);
-    HZL_ERR_CHECK(err);
-    if (isAHandshakeOngoing)
+    if (err == HZL_OK && isAHandshakeOngoing)
     {
         // Do nothing until the previous handshake expired or completed.
-        return HZL_ERR_HANDSHAKE_ONGOING;
+        err = HZL_ERR_HANDSHAKE_ONGOING;
     }
-    else
+    else if (err == HZL_OK)
     {
         // Start a new handshake
-        return hzl_ClientBuildMsgReq(requestPdu, ctx, &group);
+        err = hzl_ClientBuildMsgReq(requestPdu, ctx, &group);
     }
+    hzl_ClientGroupUnlock(ctx, groupId);
+    return err;
 }
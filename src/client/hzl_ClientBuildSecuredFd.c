@@ -29,7 +29,8 @@
 /**
  * @file
  * @internal
- * Implementation of hzl_ClientBuildSecuredFd().
+ * Implementation of hzl_ClientBuildSecuredFd(), hzl_ClientBuildSecuredFdInto() and
+ * hzl_ClientBuildSecuredFdBatch().
  */
 
 #include "hzl_ClientInternal.h"
@@ -39,12 +40,15 @@
 #include "hzl_CommonEndian.h"
 #include "hzl_CommonInternal.h"
 
-inline static hzl_Err_t
-hzl_ClientBuildMsgSadfd(hzl_CbsPduMsg_t* const msgToTx,
-                        hzl_ClientCtx_t* const ctx,
+inline static size_t
+hzl_ClientBuildMsgSadfd(uint8_t* const pdu,
+                        hzl_CanId_t* const canId,
+                        const hzl_ClientCtx_t* const ctx,
                         const uint8_t* const userData,
                         const size_t userDataLen,
-                        const hzl_ClientGroup_t* const group)
+                        const hzl_ClientGroup_t* const group,
+                        const uint8_t* const stk,
+                        const hzl_CtrNonce_t ctrnonce)
 {
     // Prepare SADFD Header
     const hzl_Header_t unpackedSadfdHeader = {
@@ -52,39 +56,23 @@ hzl_ClientBuildMsgSadfd(hzl_CbsPduMsg_t* const msgToTx,
             .sid = ctx->clientConfig->sid,
             .pty = HZL_PTY_SADFD,
     };
-    const uint8_t packedHdrLen = hzl_HeaderLen(ctx->clientConfig->headerType);
-    hzl_HeaderPackFunc const headerPackFunc =
-            hzl_HeaderPackFuncForType(ctx->clientConfig->headerType);
+    const uint8_t packedHdrLen = hzl_HeaderCodecPayloadLen(&ctx->header);
     // Prepare SADFD payload
-    // Write the packed header at the beginning of the CAN FD frame's payload.
-    headerPackFunc(msgToTx->data, &unpackedSadfdHeader);
+    // Write the packed header into the CAN ID and/or at the beginning of the CAN FD payload.
+    hzl_HeaderCodecPack(&ctx->header, canId, pdu, &unpackedSadfdHeader);
     // Write counter nonce after the header
-    hzl_EncodeLe24(&msgToTx->data[packedHdrLen + HZL_SADFD_CTRNONCE_IDX],
-                   group->state->currentCtrNonce);
-    msgToTx->data[packedHdrLen + HZL_SADFD_PTLEN_IDX] = (uint8_t) userDataLen;
+    hzl_EncodeLe24(&pdu[packedHdrLen + HZL_SADFD_CTRNONCE_IDX], ctrnonce);
+    pdu[packedHdrLen + HZL_SADFD_PTLEN_IDX] = (uint8_t) userDataLen;
     // Encrypt the plaintext (user-data a.k.a. SDU) into the ctext field of the SADFD message
-    hzl_Aead_t aead;
-    hzl_CommonAeadInitSadfd(&aead,
-                            group->state->currentStk,
-                            &unpackedSadfdHeader,
-                            group->state->currentCtrNonce,
-                            (uint8_t) userDataLen);
-    const size_t processedPtLen = hzl_AeadEncryptUpdate(
-            &aead,
-            &msgToTx->data[packedHdrLen + HZL_SADFD_CTEXT_IDX],  // Output: ciphertext
-            userData,  // Input: plaintext
-            userDataLen);
-    // Finish authenticated encryption and write tag
-    hzl_AeadEncryptFinish(
-            &aead,
-            &msgToTx->data[packedHdrLen + HZL_SADFD_CTEXT_IDX + processedPtLen],
-            &msgToTx->data[packedHdrLen + HZL_SADFD_TAG_IDX(userDataLen)],
-            HZL_SADFD_TAG_LEN);
+    hzl_CommonSadfdEncrypt(&pdu[packedHdrLen + HZL_SADFD_CTEXT_IDX],  // Output
+                           &pdu[packedHdrLen + HZL_SADFD_TAG_IDX(userDataLen)],
+                           stk,
+                           &unpackedSadfdHeader,
+                           ctrnonce,
+                           userData,  // Input: plaintext
+                           (uint8_t) userDataLen);
     // Message is packed in binary format, ready to transmit
-    msgToTx->dataLen = packedHdrLen + HZL_SADFD_PAYLOAD_LEN(userDataLen);
-    // Increment the counter nonce, regardless of transmission success
-    hzl_ClientGroupIncrCurrentCtrnonce(group);
-    return HZL_OK;
+    return packedHdrLen + HZL_SADFD_PAYLOAD_LEN(userDataLen);
 }
 
 HZL_API hzl_Err_t
@@ -95,20 +83,120 @@ hzl_ClientBuildSecuredFd(hzl_CbsPduMsg_t* securedPdu,
                          hzl_Gid_t groupId)
 {
     if (securedPdu == NULL) { return HZL_ERR_NULL_PDU; }
-    securedPdu->dataLen = 0; // Make output message empty in case of later error.
+    return hzl_ClientBuildSecuredFdInto(securedPdu->data, HZL_MAX_CAN_FD_DATA_LEN,
+                                        &securedPdu->dataLen, &securedPdu->canId,
+                                        ctx, userData, userDataLen, groupId);
+}
+
+HZL_API hzl_Err_t
+hzl_ClientBuildSecuredFdInto(uint8_t* const securedPdu,
+                             const size_t securedPduCapacity,
+                             size_t* const securedPduLen,
+                             hzl_CanId_t* const securedCanId,
+                             hzl_ClientCtx_t* const ctx,
+                             const uint8_t* const userData,
+                             const size_t userDataLen,
+                             const hzl_Gid_t groupId)
+{
+    if (securedPdu == NULL || securedPduLen == NULL || securedCanId == NULL)
+    {
+        return HZL_ERR_NULL_PDU;
+    }
+    *securedPduLen = 0; // Make output message empty in case of later error.
+    *securedCanId = 0;
     HZL_ERR_DECLARE(err);
     err = hzl_ClientCheckCtxPointers(ctx);
     HZL_ERR_CHECK(err);
     err = hzl_CommonCheckMsgBeforePacking(
             userData, userDataLen, groupId,
-            HZL_SADFD_METADATA_IN_PAYLOAD_LEN, ctx->clientConfig->headerType);
+            HZL_SADFD_METADATA_IN_PAYLOAD_LEN, &ctx->header);
     HZL_ERR_CHECK(err);
+    const uint8_t packedHdrLen = hzl_HeaderCodecPayloadLen(&ctx->header);
+    if (securedPduCapacity < packedHdrLen + HZL_SADFD_PAYLOAD_LEN(userDataLen))
+    {
+        return HZL_ERR_TOO_SMALL_PDU_BUFFER;
+    }
     hzl_ClientGroup_t group;
     err = hzl_ClientFindGroup(&group, ctx, groupId);
     HZL_ERR_CHECK(err);
-    if (!hzl_ClientIsSessionEstablishedAndValid(&group))
+    // Take the Counter Nonce, regardless of transmission success, and a copy of its STK
+    // together, then encrypt with them.
+    uint8_t stk[HZL_STK_LEN];
+    hzl_CtrNonce_t ctrnonce = 0;
+    if (!hzl_ClientGroupReserveCurrentCtrnonces(stk, &ctrnonce, &group, 1U))
     {
         return HZL_ERR_SESSION_NOT_ESTABLISHED;
     }
-    return hzl_ClientBuildMsgSadfd(securedPdu, ctx, userData, userDataLen, &group);
+    *securedPduLen = hzl_ClientBuildMsgSadfd(
+            securedPdu, securedCanId, ctx, userData, userDataLen, &group, stk, ctrnonce);
+    hzl_ZeroOut(stk, HZL_STK_LEN);
+    return HZL_OK;
+}
+
+HZL_API hzl_Err_t
+hzl_ClientBuildSecuredFdBatch(hzl_CbsPduMsg_t* const securedPdus,
+                              hzl_Err_t* const results,
+                              hzl_ClientCtx_t* const ctx,
+                              const hzl_TxSduMsg_t* const userData,
+                              const size_t amountOfMsgs)
+{
+    if (securedPdus == NULL) { return HZL_ERR_NULL_PDU; }
+    if (results == NULL) { return HZL_ERR_NULL_RESULTS; }
+    if (userData == NULL && amountOfMsgs != 0) { return HZL_ERR_NULL_SDU; }
+    for (size_t i = 0; i < amountOfMsgs; i++)
+    {
+        securedPdus[i].dataLen = 0; // Make output messages empty in case of later error.
+    }
+    HZL_ERR_DECLARE(err);
+    err = hzl_ClientCheckCtxPointers(ctx);
+    HZL_ERR_CHECK(err);
+    size_t runStart = 0;
+    while (runStart < amountOfMsgs)
+    {
+        // Handle each run of consecutive messages for the same Group at once:
+        // lookup the Group once and reserve the Counter Nonces for the whole run.
+        const hzl_Gid_t groupId = userData[runStart].gid;
+        size_t runEnd = runStart;
+        while (runEnd < amountOfMsgs && userData[runEnd].gid == groupId) { runEnd++; }
+        size_t amountToBuild = 0;
+        for (size_t i = runStart; i < runEnd; i++)
+        {
+            results[i] = hzl_CommonCheckMsgBeforePacking(
+                    userData[i].data, userData[i].dataLen, groupId,
+                    HZL_SADFD_METADATA_IN_PAYLOAD_LEN, &ctx->header);
+            if (results[i] == HZL_OK) { amountToBuild++; }
+        }
+        hzl_ClientGroup_t group;
+        hzl_Err_t groupErr = hzl_ClientFindGroup(&group, ctx, groupId);
+        uint8_t stk[HZL_STK_LEN];
+        hzl_CtrNonce_t ctrnonce = 0;
+        if (groupErr == HZL_OK)
+        {
+            // Take the Counter Nonces and a copy of their STK together, then encrypt
+            // with them.
+            if (!hzl_ClientGroupReserveCurrentCtrnonces(stk, &ctrnonce, &group, amountToBuild))
+            {
+                groupErr = HZL_ERR_SESSION_NOT_ESTABLISHED;
+            }
+        }
+        for (size_t i = runStart; i < runEnd; i++)
+        {
+            if (results[i] == HZL_OK) { results[i] = groupErr; }
+            if (results[i] != HZL_OK) { continue; }
+            if (HZL_IS_CTRNONCE_EXPIRED(ctrnonce))
+            {
+                // Same as hzl_ClientBuildSecuredFd() once the Counter Nonce is exhausted
+                results[i] = HZL_ERR_SESSION_NOT_ESTABLISHED;
+                continue;
+            }
+            securedPdus[i].dataLen = hzl_ClientBuildMsgSadfd(
+                    securedPdus[i].data, &securedPdus[i].canId, ctx,
+                    userData[i].data, userData[i].dataLen,
+                    &group, stk, ctrnonce);
+            ctrnonce++;
+        }
+        hzl_ZeroOut(stk, HZL_STK_LEN);
+        runStart = runEnd;
+    }
+    return HZL_OK;
 }
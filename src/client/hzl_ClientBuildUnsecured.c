@@ -50,5 +50,5 @@ hzl_ClientBuildUnsecured(hzl_CbsPduMsg_t* const unsecuredPdu,
                                     userDataLen,
                                     groupId,
                                     ctx->clientConfig->sid,
-                                    ctx->clientConfig->headerType);
+                                    &ctx->header);
 }
@@ -38,23 +38,55 @@
 static bool
 hzl_ClientSessionRenewalPhaseIsActive(const hzl_ClientGroup_t* group);
 
+void
+hzl_ClientBuildGroupLookupTableUnchecked(hzl_ClientCtx_t* const ctx)
+{
+    memset(ctx->groupSlotOfGid, HZL_CLIENT_GID_NOT_IN_CONFIG, HZL_AMOUNT_OF_GIDS);
+    for (size_t i = 0; i < ctx->clientConfig->amountOfGroups; i++)
+    {
+        // Index + 1 always fits, as there are at most 255 Groups (amountOfGroups is uint8_t).
+        ctx->groupSlotOfGid[ctx->groupConfigs[i].gid] = (uint8_t) (i + 1U);
+    }
+}
+
 hzl_Err_t
 hzl_ClientFindGroup(hzl_ClientGroup_t* const group,
                     const hzl_ClientCtx_t* const ctx,
                     const hzl_Gid_t groupId)
 {
-    for (size_t i = 0; i < ctx->clientConfig->amountOfGroups; i++)
+    const uint8_t slot = ctx->groupSlotOfGid[groupId];
+    if (slot == HZL_CLIENT_GID_NOT_IN_CONFIG) { return HZL_ERR_UNKNOWN_GROUP; }
+    group->config = &ctx->groupConfigs[slot - 1U];
+    group->state = &ctx->groupStates[slot - 1U];
+    return HZL_OK;
+}
+
+#ifdef HZL_THREAD_SAFE
+
+void
+hzl_ClientGroupLock(const hzl_ClientCtx_t* const ctx,
+                    const hzl_Gid_t gid)
+{
+    const uint8_t slot = ctx->groupSlotOfGid[gid];
+    if (slot != HZL_CLIENT_GID_NOT_IN_CONFIG)
     {
-        if (ctx->groupConfigs[i].gid == groupId)
-        {
-            group->config = &ctx->groupConfigs[i];
-            group->state = &ctx->groupStates[i];
-            return HZL_OK;
-        }
+        hzl_LockAcquire(&ctx->groupStates[slot - 1U].lock);
+    }
+}
+
+void
+hzl_ClientGroupUnlock(const hzl_ClientCtx_t* const ctx,
+                      const hzl_Gid_t gid)
+{
+    const uint8_t slot = ctx->groupSlotOfGid[gid];
+    if (slot != HZL_CLIENT_GID_NOT_IN_CONFIG)
+    {
+        hzl_LockRelease(&ctx->groupStates[slot - 1U].lock);
     }
-    return HZL_ERR_UNKNOWN_GROUP;
 }
 
+#endif  /* HZL_THREAD_SAFE */
+
 bool
 hzl_ClientIsSessionEstablishedAndValid(const hzl_ClientGroup_t* const group)
 {
@@ -123,13 +155,33 @@ hzl_ClientSetRequestTxTimeToNow(const hzl_ClientCtx_t* const ctx,
     return err;
 }
 
-void
-hzl_ClientGroupIncrCurrentCtrnonce(const hzl_ClientGroup_t* const group)
+bool
+hzl_ClientGroupReserveCurrentCtrnonces(uint8_t* const stk,
+                                       hzl_CtrNonce_t* const firstCtrnonce,
+                                       const hzl_ClientGroup_t* const group,
+                                       const size_t amount)
 {
-    if (!HZL_IS_CTRNONCE_EXPIRED(group->state->currentCtrNonce))
+    bool isEstablished;
+#ifdef HZL_THREAD_SAFE
+    // Lock-free: the STK and the Counter Nonces must just belong to the same Session.
+    uint_least16_t seq;
+    do
     {
-        group->state->currentCtrNonce++;
-    }
+        seq = hzl_SessionSeqReadBegin(&group->state->sessionSeq);
+#endif
+        isEstablished = hzl_ClientIsSessionEstablishedAndValid(group);
+        if (isEstablished)
+        {
+            memcpy(stk, group->state->currentStk, HZL_STK_LEN);
+            *firstCtrnonce = hzl_CommonCtrNonceReserve(&group->state->currentCtrNonce, amount);
+            // Other threads may have used up the last ones meanwhile
+            isEstablished = !HZL_IS_CTRNONCE_EXPIRED(*firstCtrnonce);
+        }
+#ifdef HZL_THREAD_SAFE
+    } while (hzl_SessionSeqReadRetry(&group->state->sessionSeq, seq));
+#endif
+    if (!isEstablished) { hzl_ZeroOut(stk, HZL_STK_LEN); }
+    return isEstablished;
 }
 
 inline static void
@@ -158,11 +210,7 @@ hzl_ClientGroupUpdateCtrnonceAndRxTimestamp(const hzl_ClientGroup_t* const group
     }
     else
     {
-        if (receivedCtrnonce > group->state->currentCtrNonce)
-        {
-            group->state->currentCtrNonce = receivedCtrnonce;
-        }
-        hzl_ClientGroupIncrCurrentCtrnonce(group);
+        hzl_CommonCtrNonceAdvancePast(&group->state->currentCtrNonce, receivedCtrnonce);
         group->state->currentRxLastMessageInstant = receptionTimestamp;
     }
 }
@@ -171,6 +219,7 @@ void
 hzl_ClientSessionRenewalPhaseEnter(const hzl_ClientGroup_t* const group)
 {
     memcpy(group->state->previousStk, group->state->currentStk, HZL_STK_LEN);
+    group->state->isRenewalPhaseActive = true;
     group->state->previousRxLastMessageInstant = group->state->currentRxLastMessageInstant;
     group->state->previousCtrNonce = group->state->currentCtrNonce;
 }
@@ -178,13 +227,14 @@ hzl_ClientSessionRenewalPhaseEnter(const hzl_ClientGroup_t* const group)
 inline static bool
 hzl_ClientSessionRenewalPhaseIsActive(const hzl_ClientGroup_t* const group)
 {
-    return !hzl_IsAllZeros(group->state->previousStk, HZL_STK_LEN);
+    return group->state->isRenewalPhaseActive;
 }
 
 inline static void
 hzl_ClientSessionRenewalPhaseExit(const hzl_ClientGroup_t* const group)
 {
     hzl_ZeroOut(group->state->previousStk, HZL_STK_LEN);
+    group->state->isRenewalPhaseActive = false;
     group->state->previousRxLastMessageInstant = 0;
     group->state->previousCtrNonce = 0;
 }
@@ -37,6 +37,7 @@
 #include "hzl_ClientInternal.h"
 #include "hzl_CommonHeader.h"
 #include "hzl_CommonInternal.h"
+#include "hzl_CommonMessage.h"
 
 /** @internal Verifies the content of the Client Configuration structure. */
 static hzl_Err_t
@@ -50,6 +51,8 @@ hzl_ClientInitCheckClientConfig(const hzl_ClientConfig_t* const config)
     if (config->sid == HZL_SERVER_SID) { return HZL_ERR_SERVER_SID_ASSIGNED_TO_CLIENT; }
     err = hzl_HeaderTypeCheck(config->headerType);
     HZL_ERR_CHECK(err);
+    err = hzl_HeaderPlacementCheck(config->headerPlacement);
+    HZL_ERR_CHECK(err);
     const hzl_Sid_t maxSid = hzl_HeaderTypeMaxSid(config->headerType);
     if (config->sid > maxSid) { return HZL_ERR_SID_TOO_LARGE_FOR_CONFIGURED_HEADER_TYPE; }
     if (config->amountOfGroups == 0) { return HZL_ERR_ZERO_GROUPS; }
@@ -101,6 +104,10 @@ hzl_ClientCheckCtxPointers(const hzl_ClientCtx_t* const ctx)
     if (ctx->groupStates == NULL) { return HZL_ERR_NULL_STATES_GROUPS; }
     if (ctx->io.currentTime == NULL) { return HZL_ERR_NULL_CURRENT_TIME_FUNC; }
     if (ctx->io.trng == NULL) { return HZL_ERR_NULL_TRNG_FUNC; }
+    if (ctx->sadtpRxBuffers == NULL && ctx->amountOfSadtpRxBuffers != 0U)
+    {
+        return HZL_ERR_NULL_SADTP_RX_BUFFERS;
+    }
     return HZL_OK;
 }
 
@@ -113,6 +120,8 @@ hzl_ClientCheckCtx(const hzl_ClientCtx_t* const ctx)
     err = hzl_ClientInitCheckClientConfig(ctx->clientConfig);
     HZL_ERR_CHECK(err);
     err = hzl_ClientInitCheckGroupConfigs(ctx->clientConfig, ctx->groupConfigs);
+    HZL_ERR_CHECK(err);
+    err = hzl_CommonSadtpCheckRxBuffers(ctx->sadtpRxBuffers, ctx->amountOfSadtpRxBuffers);
     return err;
 }
 
@@ -121,6 +130,7 @@ hzl_ClientClearStateUnchecked(hzl_ClientCtx_t* const ctx)
 {
     hzl_ZeroOut(ctx->groupStates,
                 ctx->clientConfig->amountOfGroups * sizeof(hzl_ClientGroupState_t));
+    hzl_CommonSadtpRxClearAll(ctx->sadtpRxBuffers, ctx->amountOfSadtpRxBuffers);
 }
 
 HZL_API hzl_Err_t
@@ -129,6 +139,11 @@ hzl_ClientInit(hzl_ClientCtx_t* const ctx)
     HZL_ERR_DECLARE(err);
     err = hzl_ClientCheckCtx(ctx);
     HZL_ERR_CHECK(err);
+    // Also unlocks all Group states, which are zeroed
     hzl_ClientClearStateUnchecked(ctx);
+    HZL_LOCK_INIT(&ctx->sadtpRxBuffersLock);
+    hzl_ClientBuildGroupLookupTableUnchecked(ctx);
+    hzl_HeaderCodecInit(&ctx->header, ctx->clientConfig->headerType,
+                        ctx->clientConfig->headerPlacement);
     return err;
 }
@@ -83,9 +83,22 @@ hzl_ClientCheckCtxPointers(const hzl_ClientCtx_t* ctx);
 void
 hzl_ClientClearStateUnchecked(hzl_ClientCtx_t* ctx);
 
+/** @internal Value of #hzl_ClientCtx_t.groupSlotOfGid for GIDs not in the configuration. */
+#define HZL_CLIENT_GID_NOT_IN_CONFIG 0U
+
 /**
  * @internal
- * Linear search through the Groups, providing a handle to their state and config from the GID.
+ * Fills the GID lookup table #hzl_ClientCtx_t.groupSlotOfGid from the Group configurations.
+ * Does not perform any memory safety checks, the context must be already checked.
+ *
+ * @param [in, out] ctx context with the table to build
+ */
+void
+hzl_ClientBuildGroupLookupTableUnchecked(hzl_ClientCtx_t* ctx);
+
+/**
+ * @internal
+ * Constant-time lookup of the Groups, providing a handle to their state and config from the GID.
  *
  * @param [out] group pointers to the Group state and config
  * @param [in] ctx to search through the Group configs for the GID
@@ -220,13 +233,26 @@ hzl_ClientSetRequestTxTimeToNow(const hzl_ClientCtx_t* ctx,
 
 /**
  * @internal
- * Increments the Group's Counter Nonce by 1, unless its upper limit was reached and the Nonce
- * is already expired.
+ * Reserves a range of consecutive Counter Nonces of the Group's current Session at once,
+ * together with a copy of the STK of the same Session, to encrypt with them.
+ *
+ * The Counter Nonce saturates at its upper limit, so fewer values than \p amount may be
+ * available: only the reserved values below #HZL_MAX_CTRNONCE may be used.
+ * When built with #HZL_THREAD_SAFE it does not take the Group lock: it reads the Session
+ * again if a new one was started meanwhile, skipping the Counter Nonces reserved the first time.
  *
- * @param [in, out] group to increment the Counter Nonce of.
+ * @param [out] stk where to copy the STK. Zeroed if the Session is not established.
+ * @param [out] firstCtrnonce first reserved Counter Nonce
+ * @param [in, out] group to reserve the Counter Nonces of.
+ * @param [in] amount of Counter Nonces to reserve.
+ * @return true if the Session is established and at least one Counter Nonce was reserved,
+ *         false otherwise.
  */
-void
-hzl_ClientGroupIncrCurrentCtrnonce(const hzl_ClientGroup_t* group);
+bool
+hzl_ClientGroupReserveCurrentCtrnonces(uint8_t* stk,
+                                       hzl_CtrNonce_t* firstCtrnonce,
+                                       const hzl_ClientGroup_t* group,
+                                       size_t amount);
 
 /**
  * @internal
@@ -270,6 +296,29 @@ void
 hzl_ClientSessionRenewalPhaseExitIfNeeded(const hzl_ClientGroup_t* group,
                                           hzl_Timestamp_t now);
 
+#ifdef HZL_THREAD_SAFE
+
+/**
+ * @internal
+ * Takes the lock of the Group state, to work on it without other threads altering it.
+ * Does nothing for GIDs outside of the configuration, which have no state.
+ */
+void
+hzl_ClientGroupLock(const hzl_ClientCtx_t* ctx,
+                    hzl_Gid_t gid);
+
+/** @internal Releases the lock taken with hzl_ClientGroupLock() with the same GID. */
+void
+hzl_ClientGroupUnlock(const hzl_ClientCtx_t* ctx,
+                      hzl_Gid_t gid);
+
+#else
+
+#define hzl_ClientGroupLock(ctx, gid)
+#define hzl_ClientGroupUnlock(ctx, gid)
+
+#endif  /* HZL_THREAD_SAFE */
+
 #ifdef __cplusplus
 }
 #endif
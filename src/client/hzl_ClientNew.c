@@ -34,6 +34,7 @@
 
 #include "hzl_ClientOs.h"
 #include "hzl_ClientInternal.h"
+#include "hzl_CommonHeader.h"
 #include "hzl_CommonEndian.h"
 #include "hzl_CommonInternal.h"
 
@@ -49,10 +50,18 @@ hzl_LoadBytes(uint8_t* const bytes, FILE* const fileStream, const size_t amount)
     return HZL_OK;
 }
 
-/** @internal Verifies the file starts with `"HZLc\0" = {0x68, 0x7A, 0x6C, 0x63, 0x00}`
- * to double check the correct binary file was selected. */
+/** @internal Format of the original configuration files, where the byte following the
+ * #hzl_ClientConfig_t.amountOfGroups is just padding. */
+#define HZL_CLIENT_FILE_FORMAT_ORIGINAL 0U
+/** @internal Format of the configuration files where the byte following the
+ * #hzl_ClientConfig_t.amountOfGroups is the #hzl_ClientConfig_t.headerPlacement. */
+#define HZL_CLIENT_FILE_FORMAT_HEADER_PLACEMENT 1U
+
+/** @internal Verifies the file starts with `"HZLc" = {0x68, 0x7A, 0x6C, 0x63}`
+ * to double check the correct binary file was selected, followed by a byte with a
+ * known file format version. */
 static hzl_Err_t
-hzl_CheckMagicNumber(FILE* const fileStream)
+hzl_CheckMagicNumber(uint8_t* const formatVersion, FILE* const fileStream)
 {
     HZL_ERR_DECLARE(err);
     uint8_t magicNumber[5U] = {0};
@@ -62,10 +71,11 @@ hzl_CheckMagicNumber(FILE* const fileStream)
         || magicNumber[1] != 'Z'
         || magicNumber[2] != 'L'
         || magicNumber[3] != 'c'
-        || magicNumber[4] != '\0')
+        || magicNumber[4] > HZL_CLIENT_FILE_FORMAT_HEADER_PLACEMENT)
     {
         return HZL_ERR_INVALID_FILE_MAGIC_NUMBER;
     }
+    *formatVersion = magicNumber[4];
     return err;
 }
 
@@ -100,7 +110,9 @@ hzl_LoadUint8(uint8_t* const value, FILE* const fileStream)
 
 /** @internal Loads the Client Configuration structure from the file. */
 inline static hzl_Err_t
-hzl_LoadClientConfig(hzl_ClientConfig_t* const config, FILE* const fileStream)
+hzl_LoadClientConfig(hzl_ClientConfig_t* const config,
+                     FILE* const fileStream,
+                     const uint8_t formatVersion)
 {
     HZL_ERR_DECLARE(err);
     err = hzl_LoadUint16Le(&config->timeoutReqToResMillis, fileStream);
@@ -113,7 +125,11 @@ hzl_LoadClientConfig(hzl_ClientConfig_t* const config, FILE* const fileStream)
     HZL_ERR_CHECK(err);
     err = hzl_LoadUint8(&config->amountOfGroups, fileStream);
     HZL_ERR_CHECK(err);
-    err = hzl_LoadBytes(config->unusedPadding, fileStream, 1U);
+    err = hzl_LoadUint8(&config->headerPlacement, fileStream);
+    if (formatVersion == HZL_CLIENT_FILE_FORMAT_ORIGINAL)
+    {
+        config->headerPlacement = HZL_HEADER_IN_PAYLOAD;  // Was padding of any value
+    }
     return err;
 }
 
@@ -146,7 +162,8 @@ hzl_ClientNew(hzl_ClientCtx_t** const pCtx,
     if (fileName == NULL) { return HZL_ERR_NULL_FILENAME; }
     fileStream = fopen(fileName, "r");
     if (fileStream == NULL) { return HZL_ERR_CANNOT_OPEN_CONFIG_FILE; }
-    err = hzl_CheckMagicNumber(fileStream);
+    uint8_t formatVersion = HZL_CLIENT_FILE_FORMAT_ORIGINAL;
+    err = hzl_CheckMagicNumber(&formatVersion, fileStream);
     HZL_ERR_CLEANUP(err);
     // At this point, the file was successfully opened and seems to be of the correct format.
     ctx = calloc(1U, sizeof(hzl_ClientCtx_t));
@@ -163,7 +180,8 @@ hzl_ClientNew(hzl_ClientCtx_t** const pCtx,
     }
     // Here we force the pointer to the constant configuration to be writable just once
     // because we have to fill the configuration in the first place.
-    err = hzl_LoadClientConfig((hzl_ClientConfig_t*) ctx->clientConfig, fileStream);
+    err = hzl_LoadClientConfig((hzl_ClientConfig_t*) ctx->clientConfig, fileStream,
+                               formatVersion);
     HZL_ERR_CLEANUP(err);
     ctx->groupConfigs = calloc(ctx->clientConfig->amountOfGroups,
                                sizeof(hzl_ClientGroupConfig_t));
@@ -191,6 +209,12 @@ hzl_ClientNew(hzl_ClientCtx_t** const pCtx,
     ctx->io.currentTime = hzl_OsCurrentTime;
     ctx->io.trng = hzl_OsTrng;
     err = hzl_ClientCheckCtx(ctx);
+    if (err == HZL_OK)
+    {
+        hzl_ClientBuildGroupLookupTableUnchecked(ctx);
+        hzl_HeaderCodecInit(&ctx->header, ctx->clientConfig->headerType,
+                            ctx->clientConfig->headerPlacement);
+    }
     *pCtx = ctx;
     ctx = NULL;
     cleanup:
@@ -53,6 +53,8 @@ hzl_ClientProcessReceived(hzl_CbsPduMsg_t* const reactionPdu,
     HZL_ERR_DECLARE(err);
     err = hzl_ClientCheckCtxPointers(ctx);
     HZL_ERR_CHECK(err);
+    // The SADTP messages returned by the earlier calls of this thread are not read anymore
+    hzl_CommonSadtpRxCallBegin();
     // Get the RX timestamp ASAP to reduce the delays
     hzl_Timestamp_t rxTimestamp = 0;
     err = ctx->io.currentTime(&rxTimestamp);
@@ -62,39 +64,72 @@ hzl_ClientProcessReceived(hzl_CbsPduMsg_t* const reactionPdu,
     hzl_ZeroOut(receivedUserData, sizeof(hzl_RxSduMsg_t));
     hzl_ZeroOut(reactionPdu, sizeof(hzl_CbsPduMsg_t));
     HZL_ERR_CHECK(err); // Return from any error of currentTime() only after the cleanups
-    hzl_Header_t unpackedHdr;
-    err = hzl_CommonCheckReceivedGenericMsg(
-            &unpackedHdr, receivedPdu, receivedPduLen,
-            ctx->clientConfig->sid, ctx->clientConfig->headerType);
-    HZL_ERR_CHECK(err);
-    receivedUserData->canId = receivedCanId;
-    switch (unpackedHdr.pty)
+    return hzl_ClientProcessReceivedDispatch(
+            reactionPdu, receivedUserData, ctx,
+            receivedPdu, receivedPduLen, receivedCanId, rxTimestamp);
+}
+
+/** @internal Handles the received message according to its payload type. */
+inline static hzl_Err_t
+hzl_ClientProcessReceivedByType(hzl_CbsPduMsg_t* const reactionPdu,
+                                hzl_RxSduMsg_t* const receivedUserData,
+                                hzl_ClientCtx_t* const ctx,
+                                const uint8_t* const receivedPdu,
+                                const size_t receivedPduLen,
+                                const hzl_Header_t* const unpackedHdr,
+                                const hzl_Timestamp_t rxTimestamp)
+{
+    switch (unpackedHdr->pty)
     {
         case HZL_PTY_REQ:return HZL_ERR_MSG_IGNORED;
 
         case HZL_PTY_RES:
             return hzl_ClientProcessReceivedResponse(
-                    ctx, receivedPdu, receivedPduLen, &unpackedHdr, rxTimestamp);
+                    ctx, receivedPdu, receivedPduLen, unpackedHdr, rxTimestamp);
 
         case HZL_PTY_REN:
             return hzl_ClientProcessReceivedRenewal(
-                    reactionPdu, ctx, receivedPdu, receivedPduLen, &unpackedHdr, rxTimestamp);
+                    reactionPdu, ctx, receivedPdu, receivedPduLen, unpackedHdr, rxTimestamp);
 
         case HZL_PTY_SADTP:
             return hzl_ClientProcessReceivedSecuredTp(
-                    receivedUserData, ctx, receivedPdu, receivedPduLen, &unpackedHdr, rxTimestamp);
+                    receivedUserData, ctx, receivedPdu, receivedPduLen, unpackedHdr, rxTimestamp);
 
         case HZL_PTY_SADFD:
             return hzl_ClientProcessReceivedSecuredFd(
-                    receivedUserData, ctx, receivedPdu, receivedPduLen, &unpackedHdr, rxTimestamp);
+                    receivedUserData, receivedUserData->data, ctx, receivedPdu, receivedPduLen, unpackedHdr, rxTimestamp);
 
         case HZL_PTY_UAD:
             return hzl_CommonProcessReceivedUnsecured(
                     receivedUserData, receivedPdu, receivedPduLen,
-                    &unpackedHdr, ctx->clientConfig->headerType);
+                    unpackedHdr, &ctx->header);
 
         case HZL_PTY_RFU1:  // Fall-through to default
         case HZL_PTY_RFU2:  // Fall-through to default
         default:return HZL_ERR_INVALID_PAYLOAD_TYPE;
     }
 }
+
+hzl_Err_t
+hzl_ClientProcessReceivedDispatch(hzl_CbsPduMsg_t* const reactionPdu,
+                                  hzl_RxSduMsg_t* const receivedUserData,
+                                  hzl_ClientCtx_t* const ctx,
+                                  const uint8_t* const receivedPdu,
+                                  const size_t receivedPduLen,
+                                  const hzl_CanId_t receivedCanId,
+                                  const hzl_Timestamp_t rxTimestamp)
+{
+    HZL_ERR_DECLARE(err);
+    hzl_Header_t unpackedHdr;
+    err = hzl_CommonCheckReceivedGenericMsg(
+            &unpackedHdr, receivedPdu, receivedPduLen, receivedCanId,
+            ctx->clientConfig->sid, &ctx->header);
+    HZL_ERR_CHECK(err);
+    receivedUserData->canId = receivedCanId;
+    hzl_ClientGroupLock(ctx, unpackedHdr.gid);
+    err = hzl_ClientProcessReceivedByType(
+            reactionPdu, receivedUserData, ctx,
+            receivedPdu, receivedPduLen, &unpackedHdr, rxTimestamp);
+    hzl_ClientGroupUnlock(ctx, unpackedHdr.gid);
+    return err;
+}
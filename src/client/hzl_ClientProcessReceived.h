@@ -43,6 +43,34 @@ extern "C"
 #include "hzl_CommonInternal.h"
 #include "hzl_CommonHeader.h"
 
+/**
+ * @internal
+ * Validates the header of a received message and processes it according to its payload type.
+ *
+ * Does not check the context, nor clears the output locations: the caller must have done it
+ * already. Shared by hzl_ClientProcessReceived() and hzl_ClientProcessReceivedInPlace().
+ * Holds the lock of the Group of the message while handling it.
+ *
+ * @param [out] reactionPdu generated reaction message, if any. Already cleared.
+ * @param [out] receivedUserData unpacked data of the received message. Already cleared.
+ * @param [in, out] ctx to access the configurations and alter the Group states. Already checked.
+ * @param [in] receivedPdu received raw CBS message
+ * @param [in] receivedPduLen length of \p receivedPdu in bytes
+ * @param [in] receivedCanId identifier of the underlying layer's PDU
+ * @param [in] rxTimestamp timestamp of reception of the message
+ *
+ * @return #HZL_OK on success or the proper error code if something is incorrect with the
+ *        message or with the local state
+ */
+hzl_Err_t
+hzl_ClientProcessReceivedDispatch(hzl_CbsPduMsg_t* reactionPdu,
+                                  hzl_RxSduMsg_t* receivedUserData,
+                                  hzl_ClientCtx_t* ctx,
+                                  const uint8_t* receivedPdu,
+                                  size_t receivedPduLen,
+                                  hzl_CanId_t receivedCanId,
+                                  hzl_Timestamp_t rxTimestamp);
+
 /**
  * @internal
  * Validates, decrypts and handles a received RES message, setting the Session information for
@@ -92,7 +120,9 @@ hzl_ClientProcessReceivedRenewal(hzl_CbsPduMsg_t* reactionPdu,
  * @internal
  * Validates, decrypts and handles a received SADFD message, updating the local Counter Nonce.
  *
- * @param [out] unpackedMsg decrypted, validated and unpacked data contained in the SADFD message
+ * @param [out] unpackedMsg validated and unpacked metadata of the SADFD message
+ * @param [out] plaintext where to decrypt the user data, either unpackedMsg->data or the
+ *        ciphertext field of \p rxPdu itself to decrypt in place
  * @param [in, out] ctx to access the Group configuration and alter its state
  * @param [in] rxPdu received raw SADFD message
  * @param [in] rxPduLen length of \p rxPdu in bytes
@@ -104,6 +134,7 @@ hzl_ClientProcessReceivedRenewal(hzl_CbsPduMsg_t* reactionPdu,
  */
 hzl_Err_t
 hzl_ClientProcessReceivedSecuredFd(hzl_RxSduMsg_t* unpackedMsg,
+                                   uint8_t* plaintext,
                                    const hzl_ClientCtx_t* ctx,
                                    const uint8_t* rxPdu,
                                    size_t rxPduLen,
@@ -112,11 +143,13 @@ hzl_ClientProcessReceivedSecuredFd(hzl_RxSduMsg_t* unpackedMsg,
 
 /**
  * @internal
- * Validates, decrypts and handles a received SADTP message, updating the local Counter Nonce.
+ * Validates, decrypts and reassembles a received SADTP fragment, updating the local Counter
+ * Nonce once the whole message is received and valid.
  *
- * @param [out] unpackedMsg decrypted, validated and unpacked data contained in the SADFD message
+ * @param [out] unpackedMsg metadata of the reassembled message, pointing to its data
+ *        in the reception buffer. Not for the user until the last fragment.
  * @param [in, out] ctx to access the Group configuration and alter its state
- * @param [in] rxPdu received raw SADTP message
+ * @param [in] rxPdu received raw SADTP fragment
  * @param [in] rxPduLen length of \p rxPdu in bytes
  * @param [in] unpackedSadtpHeader metadata of the CBS message in unpacked format
  * @param [in] rxTimestamp timestamp of reception
@@ -126,7 +159,7 @@ hzl_ClientProcessReceivedSecuredFd(hzl_RxSduMsg_t* unpackedMsg,
  */
 hzl_Err_t
 hzl_ClientProcessReceivedSecuredTp(hzl_RxSduMsg_t* unpackedMsg,
-                                   const hzl_ClientCtx_t* ctx,
+                                   hzl_ClientCtx_t* ctx,
                                    const uint8_t* rxPdu,
                                    size_t rxPduLen,
                                    const hzl_Header_t* unpackedSadtpHeader,
@@ -0,0 +1,105 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Implementation of the hzl_ClientProcessReceivedInPlace() function.
+ */
+
+#include "hzl.h"
+#include "hzl_Client.h"
+#include "hzl_ClientInternal.h"
+#include "hzl_CommonHeader.h"
+#include "hzl_ClientProcessReceived.h"
+#include "hzl_CommonMessage.h"
+#include "hzl_CommonPayload.h"
+#include "hzl_CommonInternal.h"
+
+HZL_API hzl_Err_t
+hzl_ClientProcessReceivedInPlace(hzl_CbsPduMsg_t* const reactionPdu,
+                                 hzl_RxSduView_t* const receivedUserData,
+                                 hzl_ClientCtx_t* const ctx,
+                                 uint8_t* const receivedPdu,
+                                 const size_t receivedPduLen,
+                                 const hzl_CanId_t receivedCanId)
+{
+    if (reactionPdu == NULL) { return HZL_ERR_NULL_PDU; }
+    if (receivedUserData == NULL) { return HZL_ERR_NULL_SDU; }
+    HZL_ERR_DECLARE(err);
+    err = hzl_ClientCheckCtxPointers(ctx);
+    HZL_ERR_CHECK(err);
+    // The SADTP messages returned by the earlier calls of this thread are not read anymore
+    hzl_CommonSadtpRxCallBegin();
+    // Get the RX timestamp ASAP to reduce the delays
+    hzl_Timestamp_t rxTimestamp = 0;
+    err = ctx->io.currentTime(&rxTimestamp);
+    // The view contains no user data, only a pointer to it: no need to clear it securely.
+    memset(receivedUserData, 0, sizeof(hzl_RxSduView_t));
+    hzl_ZeroOut(reactionPdu, sizeof(hzl_CbsPduMsg_t));
+    HZL_ERR_CHECK(err); // Return from any error of currentTime() only after the cleanups
+    hzl_Header_t unpackedHdr;
+    err = hzl_CommonCheckReceivedGenericMsg(
+            &unpackedHdr, receivedPdu, receivedPduLen, receivedCanId,
+            ctx->clientConfig->sid, &ctx->header);
+    HZL_ERR_CHECK(err);
+    receivedUserData->canId = receivedCanId;
+    const uint8_t packedHdrLen = hzl_HeaderCodecPayloadLen(&ctx->header);
+    if (unpackedHdr.pty == HZL_PTY_SADFD)
+    {
+        // Only the metadata is written into this struct, the plaintext goes over the
+        // ciphertext. PDUs too short to contain the ciphertext are rejected before decrypting.
+        hzl_RxSduMsg_t metadata;
+        metadata.isForUser = false;
+        const size_t ctextIdx = packedHdrLen + HZL_SADFD_CTEXT_IDX;
+        uint8_t* const plaintext =
+                receivedPduLen >= ctextIdx ? &receivedPdu[ctextIdx] : receivedPdu;
+        hzl_ClientGroupLock(ctx, unpackedHdr.gid);
+        err = hzl_ClientProcessReceivedSecuredFd(
+                &metadata, plaintext,
+                ctx, receivedPdu, receivedPduLen, &unpackedHdr, rxTimestamp);
+        hzl_ClientGroupUnlock(ctx, unpackedHdr.gid);
+        hzl_CommonRxViewOfMsg(receivedUserData, &metadata, plaintext);
+        return err;
+    }
+    if (unpackedHdr.pty == HZL_PTY_UAD)
+    {
+        return hzl_CommonProcessReceivedUnsecuredInPlace(
+                receivedUserData, receivedPdu, receivedPduLen,
+                &unpackedHdr, &ctx->header);
+    }
+    // Any other message carries either no user data or, for SADTP, points to its reception
+    // buffer: process it as usual.
+    hzl_RxSduMsg_t unpackedMsg;
+    hzl_ZeroOut(&unpackedMsg, sizeof(hzl_RxSduMsg_t));
+    err = hzl_ClientProcessReceivedDispatch(
+            reactionPdu, &unpackedMsg, ctx,
+            receivedPdu, receivedPduLen, receivedCanId, rxTimestamp);
+    hzl_CommonRxViewOfMsg(receivedUserData, &unpackedMsg, unpackedMsg.reassembledData);
+    return err;
+}
@@ -72,7 +72,7 @@ hzl_ClientProcessReceivedRenewal(hzl_CbsPduMsg_t* reactionPdu,
         return HZL_ERR_MSG_IGNORED;
     }
     // REN msg must be long enough to contain the required fields
-    const uint8_t packedHdrLen = hzl_HeaderLen(ctx->clientConfig->headerType);
+    const uint8_t packedHdrLen = hzl_HeaderCodecPayloadLen(&ctx->header);
     if (rxPduLen < packedHdrLen + HZL_REN_PAYLOAD_LEN)
     {
         // We would overflow valid memory.
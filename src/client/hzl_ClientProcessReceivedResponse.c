@@ -53,7 +53,7 @@ hzl_ClientProcessReceivedResponse(const hzl_ClientCtx_t* ctx,
         return HZL_ERR_SECWARN_SERVER_ONLY_MESSAGE;
     }
     // RES msg must be long enough to contain the required fields
-    const uint8_t packedHdrLen = hzl_HeaderLen(ctx->clientConfig->headerType);
+    const uint8_t packedHdrLen = hzl_HeaderCodecPayloadLen(&ctx->header);
     if (rxPduLen < packedHdrLen + HZL_RES_PAYLOAD_LEN)
     {
         // We would overflow valid memory.
@@ -113,8 +113,10 @@ hzl_ClientProcessReceivedResponse(const hzl_ClientCtx_t* ctx,
     // Clear the request nonce to state that no Response is being expected anymore
     group.state->requestNonce = HZL_REQNONCE_NOT_EXPECTING_A_RESPONSE;
     // Save the received STK, counter nonce as current Session information
+    HZL_SESSION_CHANGE_BEGIN(&group.state->sessionSeq);
     memcpy(group.state->currentStk, plaintextStk, HZL_STK_LEN);
     group.state->currentCtrNonce = receivedCtrnonce;
+    HZL_SESSION_CHANGE_END(&group.state->sessionSeq);
     // Update the timestamps to indicate this is a valid reception and conclusion of the handshake
     group.state->currentRxLastMessageInstant = rxTimestamp;
     group.state->lastHandshakeEventInstant = rxTimestamp;
@@ -53,6 +53,7 @@ hzl_ClientChoosePreviusOrCurrentStk(const hzl_ClientGroup_t* const group,
 
 hzl_Err_t
 hzl_ClientProcessReceivedSecuredFd(hzl_RxSduMsg_t* unpackedMsg,
+                                   uint8_t* plaintext,
                                    const hzl_ClientCtx_t* ctx,
                                    const uint8_t* rxPdu,
                                    size_t rxPduLen,
@@ -73,7 +74,7 @@ hzl_ClientProcessReceivedSecuredFd(hzl_RxSduMsg_t* unpackedMsg,
         return HZL_ERR_SESSION_NOT_ESTABLISHED;
     }
     // SADFD msg must be long enough to contain at least the metadata (case of empty SDU)
-    const uint8_t packedHdrLen = hzl_HeaderLen(ctx->clientConfig->headerType);
+    const uint8_t packedHdrLen = hzl_HeaderCodecPayloadLen(&ctx->header);
     if (rxPduLen < packedHdrLen + HZL_SADFD_METADATA_IN_PAYLOAD_LEN)
     {
         // Cannot even read the metadata of the message, including the ciphertext length.
@@ -102,34 +103,18 @@ hzl_ClientProcessReceivedSecuredFd(hzl_RxSduMsg_t* unpackedMsg,
         // PDU lays is much longer than the PDU itself, as long as it's long-enough to hold it.
         return HZL_ERR_TOO_LONG_CIPHERTEXT;
     }
-    hzl_Aead_t aead;
-    hzl_CommonAeadInitSadfd(
-            &aead,
+    // The plaintext is securely cleared in case of an invalid tag. Some of the decrypted
+    // data may be correct, as potential errors could be injected later on in the ciphertext
+    // or even in the tag, but the user must not read data not validated with the tag.
+    err = hzl_CommonSadfdDecrypt(
+            plaintext,  // Output
             hzl_ClientChoosePreviusOrCurrentStk(&group, isPreviousSession),
             unpackedSadfdHeader,
             receivedCtrnonce,
-            ptlen);
-    const size_t processedPtLen = hzl_AeadDecryptUpdate(
-            &aead,
-            unpackedMsg->data,  // Output: plaintext
             &rxPdu[packedHdrLen + HZL_SADFD_CTEXT_IDX],  // Input: ciphertext
-            ctlen);
-
-    // Finish authenticated decryption and validate tag
-    err = hzl_AeadDecryptFinish(
-            &aead,
-            &unpackedMsg->data[processedPtLen],
-            &rxPdu[packedHdrLen + HZL_SADFD_TAG_IDX(ctlen)],
-            HZL_SADFD_TAG_LEN);
-    if (err != HZL_OK)
-    {
-        // Securely clear the decrypted data before returning. Some of the decrypted data may
-        // be correct, as potential errors could be injected later on in the ciphertext or even
-        // in the tag. Just to avoid any leakage of information or the user reading data that may
-        // not be correct, as it is not validated with the tag, erase everything written so far.
-        hzl_ZeroOut(unpackedMsg->data, ptlen);
-        return err;
-    }
+            ptlen,
+            &rxPdu[packedHdrLen + HZL_SADFD_TAG_IDX(ctlen)]);
+    HZL_ERR_CHECK(err);
     // Save the received counter nonce as local one and the reception timestamp.
     hzl_ClientGroupUpdateCtrnonceAndRxTimestamp(
             &group, receivedCtrnonce, rxTimestamp, isPreviousSession);
@@ -32,23 +32,99 @@
  */
 
 #include "hzl_ClientInternal.h"
+#include "hzl_CommonMessage.h"
 #include "hzl_CommonHeader.h"
 #include "hzl_CommonPayload.h"
 #include "hzl_ClientProcessReceived.h"
+#include "hzl_CommonInternal.h"
 
 hzl_Err_t
 hzl_ClientProcessReceivedSecuredTp(hzl_RxSduMsg_t* unpackedMsg,
-                                   const hzl_ClientCtx_t* ctx,
+                                   hzl_ClientCtx_t* ctx,
                                    const uint8_t* rxPdu,
                                    size_t rxPduLen,
                                    const hzl_Header_t* unpackedSadtpHeader,
                                    hzl_Timestamp_t rxTimestamp)
 {
-    (void) unpackedMsg;
-    (void) ctx;
-    (void) rxPdu;
-    (void) rxPduLen;
-    (void) unpackedSadtpHeader;
-    (void) rxTimestamp;
-    return HZL_ERR_PROGRAMMING;  // TODO to be implemented
+    HZL_ERR_DECLARE(err);
+    if (ctx->amountOfSadtpRxBuffers == 0U)
+    {
+        // The user did not provide any location to reassemble the messages into.
+        return HZL_ERR_MSG_IGNORED;
+    }
+    hzl_ClientGroup_t group;
+    err = hzl_ClientFindGroup(&group, ctx, unpackedSadtpHeader->gid);
+    if (err == HZL_ERR_UNKNOWN_GROUP)
+    {
+        return HZL_ERR_MSG_IGNORED;
+    }
+    hzl_ClientSessionRenewalPhaseExitIfNeeded(&group, rxTimestamp);
+    // Check current state for validity
+    if (!hzl_ClientIsSessionEstablishedAndValid(&group))
+    {
+        return HZL_ERR_SESSION_NOT_ESTABLISHED;
+    }
+    hzl_SadtpFragment_t fragment;
+    err = hzl_CommonSadtpParseFragment(
+            &fragment, rxPdu, rxPduLen, hzl_HeaderCodecPayloadLen(&ctx->header));
+    HZL_ERR_CHECK(err);
+    // Only the first fragment is checked for freshness, the following ones are bound
+    // to it by the same ctrnonce and by the tag of the whole message.
+    bool isPreviousSession = false;
+    if (fragment.idx == 0U)
+    {
+        err = hzl_ClientCheckRxCtrnonce(
+                &isPreviousSession, &group, fragment.ctrnonce, rxTimestamp);
+        HZL_ERR_CHECK(err);
+    }
+    // The reception buffers are shared by all Groups and threads. Once complete, the buffer
+    // stays reserved for the message until this thread's next receiving call, so only the
+    // pointer to it is taken out of the locked section: no other thread can reuse it.
+    hzl_SadtpRxBuffer_t* buffer;
+    bool isComplete = false;
+    hzl_CtrNonce_t rxCtrnonce = 0;
+    HZL_LOCK_ACQUIRE(&ctx->sadtpRxBuffersLock);
+    if (fragment.idx == 0U)
+    {
+        const uint8_t* const stk = isPreviousSession
+                                   ? group.state->previousStk
+                                   : group.state->currentStk;
+        err = hzl_CommonSadtpRxStart(
+                &buffer, ctx->sadtpRxBuffers, ctx->amountOfSadtpRxBuffers,
+                unpackedSadtpHeader, &fragment, stk, isPreviousSession,
+                rxTimestamp, group.config->maxSilenceIntervalMillis);
+    }
+    else
+    {
+        err = hzl_CommonSadtpRxContinue(
+                &buffer, ctx->sadtpRxBuffers, ctx->amountOfSadtpRxBuffers,
+                unpackedSadtpHeader, &fragment, rxTimestamp);
+    }
+    if (err == HZL_OK)
+    {
+        err = hzl_CommonSadtpRxAppend(&isComplete, buffer, &fragment, rxTimestamp);
+    }
+    if (err == HZL_OK && isComplete)
+    {
+        rxCtrnonce = buffer->ctrnonce;
+        isPreviousSession = buffer->isPreviousSession;
+        unpackedMsg->dataLen = buffer->dataLen;
+        unpackedMsg->reassembledData = buffer->data;
+    }
+    HZL_LOCK_RELEASE(&ctx->sadtpRxBuffersLock);
+    HZL_ERR_CHECK(err);
+    if (!isComplete)
+    {
+        // Wait for the next fragment, nothing for the user yet.
+        return HZL_OK;
+    }
+    // Save the received counter nonce as local one and the reception timestamp.
+    hzl_ClientGroupUpdateCtrnonceAndRxTimestamp(
+            &group, rxCtrnonce, rxTimestamp, isPreviousSession);
+    // The plaintext stays in the user-provided buffer: too large for the SDU struct.
+    unpackedMsg->wasSecured = true;
+    unpackedMsg->isForUser = true;
+    unpackedMsg->gid = unpackedSadtpHeader->gid;
+    unpackedMsg->sid = unpackedSadtpHeader->sid;
+    return HZL_OK;
 }
@@ -34,9 +34,10 @@
  *
  * The idea of this wrapper is to provide a stable interface in case the
  * implementation of the AEAD function is changed from one cipher to another.
- * Changing the AEAD cipher means updating the define #HZL_AEAD_NONCE_LEN
- * and typedef #hzl_Aead_t in this file
- * and updating the functions in the hzl_Aead.c file.
+ * The defines #HZL_AEAD_NONCE_LEN and #HZL_AEAD_LANES, the typedef #hzl_Aead_t
+ * and all the functions, including the short-message ones, are provided by the
+ * crypto backend selected with the `HZL_CRYPTO_BACKEND` CMake option,
+ * e.g. `src/crypto/libascon/`.
  */
 
 #ifndef HZL_AEAD_H_
@@ -48,7 +49,7 @@ extern "C"
 #endif
 
 #include "hzl_CommonInternal.h"
-#include "ascon.h"
+#include "hzl_CryptoBackend.h"
 
 /**
  * @internal
@@ -60,15 +61,6 @@ extern "C"
  */
 #define HZL_AEAD_PTLEN_TO_CTLEN(ptlen) (ptlen)
 
-/** @internal Length of the nonce passed to the AEAD cipher in bytes. */
-#define HZL_AEAD_NONCE_LEN ASCON_AEAD_NONCE_LEN
-
-/**
- * @internal
- * AEAD-function state.
- */
-typedef ascon_aead_ctx_t hzl_Aead_t;
-
 /**
  * @internal
  * Initialises the AEAD context for encryption or decryption.
@@ -175,6 +167,112 @@ hzl_AeadDecryptFinish(hzl_Aead_t* ctx,
                       const uint8_t* tag,
                       uint8_t tagLen);
 
+/**
+ * @internal
+ * Authenticated encryption of a short message in a single call, equivalent to
+ * hzl_AeadInit(), hzl_AeadAssocDataUpdate(), hzl_AeadEncryptUpdate() and
+ * hzl_AeadEncryptFinish(), but reading and writing the buffers directly,
+ * without the buffering of the partial blocks in the context.
+ * Meant for short messages like the ones fitting into a CAN FD frame.
+ * The encryption may also occur in-place (\p ciphertext == \p plaintext).
+ *
+ * @param [out] ciphertext encrypted plaintext, same length as \p plaintext
+ * @param [out] tag message authentication code
+ * @param [in] key secret AEAD key of 16 bytes
+ * @param [in] nonce public unique value of #HZL_AEAD_NONCE_LEN bytes
+ * @param [in] assocData data to authenticate, but not encrypt
+ * @param [in] assocDataLen length of \p assocData in bytes
+ * @param [in] plaintext data to be authenticated and encrypted
+ * @param [in] plaintextLen length of \p plaintext in bytes
+ * @param [in] tagLen length of the desired tag in bytes, at most 16
+ */
+void
+hzl_AeadEncryptOneShot(uint8_t* ciphertext,
+                       uint8_t* tag,
+                       const uint8_t* key,
+                       const uint8_t* nonce,
+                       const uint8_t* assocData,
+                       size_t assocDataLen,
+                       const uint8_t* plaintext,
+                       size_t plaintextLen,
+                       uint8_t tagLen);
+
+/**
+ * @internal
+ * Authenticated decryption of a short message in a single call, equivalent to
+ * hzl_AeadInit(), hzl_AeadAssocDataUpdate(), hzl_AeadDecryptUpdate() and
+ * hzl_AeadDecryptFinish(), but reading and writing the buffers directly,
+ * without the buffering of the partial blocks in the context.
+ * The decryption may also occur in-place (\p plaintext == \p ciphertext).
+ *
+ * @param [out] plaintext decrypted data, same length as \p ciphertext; zeroed out
+ *        if the tag is not valid
+ * @param [in] key secret AEAD key of 16 bytes
+ * @param [in] nonce public unique value of #HZL_AEAD_NONCE_LEN bytes
+ * @param [in] assocData data to authenticate, but not decrypt
+ * @param [in] assocDataLen length of \p assocData in bytes
+ * @param [in] ciphertext data to validate and decrypt
+ * @param [in] ciphertextLen length of \p ciphertext in bytes
+ * @param [in] tag message authentication code that came with the ciphertext
+ * @param [in] tagLen length of \p tag in bytes, at most 16
+ *
+ * @retval #HZL_OK if the tag is valid
+ * @retval #HZL_ERR_SECWARN_INVALID_TAG if the tag is not valid
+ */
+hzl_Err_t
+hzl_AeadDecryptOneShot(uint8_t* plaintext,
+                       const uint8_t* key,
+                       const uint8_t* nonce,
+                       const uint8_t* assocData,
+                       size_t assocDataLen,
+                       const uint8_t* ciphertext,
+                       size_t ciphertextLen,
+                       const uint8_t* tag,
+                       uint8_t tagLen);
+
+/**
+ * @internal
+ * One authenticated decryption of a short message, independent of the others in
+ * the same hzl_AeadDecryptBatch() call.
+ */
+typedef struct hzl_AeadJob
+{
+    /** Secret AEAD key of 16 bytes. */
+    const uint8_t* key;
+    /** Public unique value of #HZL_AEAD_NONCE_LEN bytes. */
+    const uint8_t* nonce;
+    /** Data to authenticate, but not decrypt. */
+    const uint8_t* assocData;
+    /** Length of \p assocData in bytes. */
+    size_t assocDataLen;
+    /** Data to validate and decrypt. */
+    const uint8_t* ciphertext;
+    /** Length of \p ciphertext in bytes. */
+    size_t ciphertextLen;
+    /** Where to write the decrypted data, same length as \p ciphertext. */
+    uint8_t* plaintext;
+    /** Message authentication code that came with the ciphertext. */
+    const uint8_t* tag;
+    /** Length of \p tag in bytes, at most 16. */
+    uint8_t tagLen;
+    /** Output: true if the tag is valid, otherwise the plaintext is zeroed out. */
+    bool isTagValid;
+} hzl_AeadJob_t;
+
+/**
+ * @internal
+ * Decrypts and validates many independent messages, equivalent to calling
+ * hzl_AeadInit(), hzl_AeadAssocDataUpdate(), hzl_AeadDecryptUpdate() and
+ * hzl_AeadDecryptFinish() on each of them, but processing up to #HZL_AEAD_LANES
+ * messages at a time. Meant for short messages like the ones fitting into a CAN FD frame.
+ *
+ * @param [in, out] jobs array of messages to decrypt, each updated with the tag validity
+ * @param [in] amountOfJobs amount of elements in \p jobs
+ */
+void
+hzl_AeadDecryptBatch(hzl_AeadJob_t* jobs,
+                     size_t amountOfJobs);
+
 #ifdef __cplusplus
 }
 #endif
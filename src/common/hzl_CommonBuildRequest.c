@@ -38,18 +38,33 @@
 #include "hzl_CommonPayload.h"
 
 void
-hzl_ReqHashInit(hzl_Hash_t* const hash,
-                const uint8_t* const ltk,
-                const hzl_Header_t* const unpackedReqHeader,
-                const uint8_t* const reqNonce)
+hzl_ReqHashInitKeyed(hzl_Hash_t* const hash,
+                     const uint8_t* const ltk)
 {
-    // Authentication/validation of the msg with
-    // tag = hash(LTK || label || GID || SID || PTY || reqnonce)
     hzl_HashInit(hash);
     hzl_HashUpdate(hash, ltk, HZL_LTK_LEN);
     hzl_HashUpdate(hash, (uint8_t*) HZL_REQ_LABEL, HZL_REQ_LABEL_LEN);
+}
+
+void
+hzl_ReqHashUpdateFields(hzl_Hash_t* const hash,
+                        const hzl_Header_t* const unpackedReqHeader,
+                        const uint8_t* const reqNonce)
+{
     hzl_HashUpdate(hash, &unpackedReqHeader->gid, HZL_GID_LEN);
     hzl_HashUpdate(hash, &unpackedReqHeader->sid, HZL_SID_LEN);
     hzl_HashUpdate(hash, &unpackedReqHeader->pty, HZL_PTY_LEN);
     hzl_HashUpdate(hash, reqNonce, HZL_REQ_REQNONCE_LEN);
 }
+
+void
+hzl_ReqHashInit(hzl_Hash_t* const hash,
+                const uint8_t* const ltk,
+                const hzl_Header_t* const unpackedReqHeader,
+                const uint8_t* const reqNonce)
+{
+    // Authentication/validation of the msg with
+    // tag = hash(LTK || label || GID || SID || PTY || reqnonce)
+    hzl_ReqHashInitKeyed(hash, ltk);
+    hzl_ReqHashUpdateFields(hash, unpackedReqHeader, reqNonce);
+}
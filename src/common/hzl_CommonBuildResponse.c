@@ -55,10 +55,13 @@ hzl_CommonAeadInitRes(hzl_Aead_t* const aead,
     hzl_AeadInit(aead, ltk, aeadNonce);
 
     // Associated data = label || GID || SID || PTY || clientSid || receivedCtrnonce
-    hzl_AeadAssocDataUpdate(aead, (uint8_t*) HZL_RES_LABEL, HZL_RES_LABEL_LEN);
-    hzl_AeadAssocDataUpdate(aead, &unpackedResHeader->gid, HZL_GID_LEN);
-    hzl_AeadAssocDataUpdate(aead, &unpackedResHeader->sid, HZL_SID_LEN);
-    hzl_AeadAssocDataUpdate(aead, &unpackedResHeader->pty, HZL_PTY_LEN);
-    hzl_AeadAssocDataUpdate(aead, &clientSid, HZL_RES_CLIENT_LEN);
-    hzl_AeadAssocDataUpdate(aead, encodedCtrNonce, HZL_RES_CTRNONCE_LEN);
+    // packed contiguously to be absorbed with a single update.
+    uint8_t assocData[HZL_RES_AD_LEN];
+    memcpy(assocData, HZL_RES_LABEL, HZL_RES_LABEL_LEN);
+    assocData[HZL_RES_AD_GID_IDX] = unpackedResHeader->gid;
+    assocData[HZL_RES_AD_SID_IDX] = unpackedResHeader->sid;
+    assocData[HZL_RES_AD_PTY_IDX] = unpackedResHeader->pty;
+    assocData[HZL_RES_AD_CLIENT_IDX] = clientSid;
+    memcpy(&assocData[HZL_RES_AD_CTRNONCE_IDX], encodedCtrNonce, HZL_RES_CTRNONCE_LEN);
+    hzl_AeadAssocDataUpdate(aead, assocData, HZL_RES_AD_LEN);
 }
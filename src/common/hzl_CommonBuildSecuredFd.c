@@ -38,25 +38,59 @@
 #include "hzl_CommonPayload.h"
 
 void
-hzl_CommonAeadInitSadfd(hzl_Aead_t* const aead,
-                        const uint8_t* const stk,
-                        const hzl_Header_t* const unpackedSadfdHeader,
-                        const hzl_CtrNonce_t ctrnonce,
-                        const uint8_t plaintextLen)
+hzl_CommonSadfdAeadNonceAndAssocData(uint8_t* const aeadNonce,
+                                     uint8_t* const assocData,
+                                     const hzl_Header_t* const unpackedSadfdHeader,
+                                     const hzl_CtrNonce_t ctrnonce,
+                                     const uint8_t plaintextLen)
 {
-    // Authenticated en/decryption initialisation with:
-    // aeadKey = currentStk
     // aeadNonce = ctrnonce || GID || SID || 0...0 (the zero-padding IS required)
-    uint8_t aeadNonce[HZL_AEAD_NONCE_LEN] = {0};
+    memset(aeadNonce, 0, HZL_AEAD_NONCE_LEN);
     hzl_EncodeLe24(&aeadNonce[HZL_SADFD_AEADNONCE_CTR_IDX], ctrnonce);
     aeadNonce[HZL_SADFD_AEADNONCE_GID_IDX] = unpackedSadfdHeader->gid;
     aeadNonce[HZL_SADFD_AEADNONCE_SID_IDX] = unpackedSadfdHeader->sid;
-    hzl_AeadInit(aead, stk, aeadNonce);
-
     // Associated data = label || GID || SID || PTY || ptlen
-    hzl_AeadAssocDataUpdate(aead, (uint8_t*) HZL_SADFD_LABEL, HZL_SADFD_LABEL_LEN);
-    hzl_AeadAssocDataUpdate(aead, &unpackedSadfdHeader->gid, HZL_GID_LEN);
-    hzl_AeadAssocDataUpdate(aead, &unpackedSadfdHeader->sid, HZL_SID_LEN);
-    hzl_AeadAssocDataUpdate(aead, &unpackedSadfdHeader->pty, HZL_PTY_LEN);
-    hzl_AeadAssocDataUpdate(aead, &plaintextLen, HZL_SADFD_PTLEN_LEN);
+    // packed contiguously to be absorbed with a single update.
+    memcpy(assocData, HZL_SADFD_LABEL, HZL_SADFD_LABEL_LEN);
+    assocData[HZL_SADFD_AD_GID_IDX] = unpackedSadfdHeader->gid;
+    assocData[HZL_SADFD_AD_SID_IDX] = unpackedSadfdHeader->sid;
+    assocData[HZL_SADFD_AD_PTY_IDX] = unpackedSadfdHeader->pty;
+    assocData[HZL_SADFD_AD_PTLEN_IDX] = plaintextLen;
+}
+
+void
+hzl_CommonSadfdEncrypt(uint8_t* const ciphertext,
+                       uint8_t* const tag,
+                       const uint8_t* const stk,
+                       const hzl_Header_t* const unpackedSadfdHeader,
+                       const hzl_CtrNonce_t ctrnonce,
+                       const uint8_t* const plaintext,
+                       const uint8_t plaintextLen)
+{
+    // Authenticated encryption with aeadKey = currentStk
+    uint8_t aeadNonce[HZL_AEAD_NONCE_LEN];
+    uint8_t assocData[HZL_SADFD_AD_LEN];
+    hzl_CommonSadfdAeadNonceAndAssocData(aeadNonce, assocData, unpackedSadfdHeader,
+                                         ctrnonce, plaintextLen);
+    hzl_AeadEncryptOneShot(ciphertext, tag, stk, aeadNonce, assocData, HZL_SADFD_AD_LEN,
+                           plaintext, plaintextLen, HZL_SADFD_TAG_LEN);
+}
+
+hzl_Err_t
+hzl_CommonSadfdDecrypt(uint8_t* const plaintext,
+                       const uint8_t* const stk,
+                       const hzl_Header_t* const unpackedSadfdHeader,
+                       const hzl_CtrNonce_t ctrnonce,
+                       const uint8_t* const ciphertext,
+                       const uint8_t plaintextLen,
+                       const uint8_t* const tag)
+{
+    // Authenticated decryption with aeadKey = previous or current STK
+    uint8_t aeadNonce[HZL_AEAD_NONCE_LEN];
+    uint8_t assocData[HZL_SADFD_AD_LEN];
+    hzl_CommonSadfdAeadNonceAndAssocData(aeadNonce, assocData, unpackedSadfdHeader,
+                                         ctrnonce, plaintextLen);
+    return hzl_AeadDecryptOneShot(plaintext, stk, aeadNonce, assocData, HZL_SADFD_AD_LEN,
+                                  ciphertext, HZL_AEAD_PTLEN_TO_CTLEN(plaintextLen),
+                                  tag, HZL_SADFD_TAG_LEN);
 }
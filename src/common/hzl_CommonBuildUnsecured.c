@@ -43,14 +43,14 @@ hzl_CommonBuildUnsecured(hzl_CbsPduMsg_t* const unsecuredPdu,
                          const size_t userDataLen,
                          const hzl_Gid_t groupId,
                          const hzl_Sid_t sourceId,
-                         const uint8_t headerType)
+                         const hzl_HeaderCodec_t* const header)
 {
     if (unsecuredPdu == NULL) { return HZL_ERR_NULL_PDU; }
     unsecuredPdu->dataLen = 0; // Make output message empty in case of later error.
     HZL_ERR_DECLARE(err);
     err = hzl_CommonCheckMsgBeforePacking(
             userData, userDataLen, groupId,
-            HZL_UAD_METADATA_IN_PAYLOAD_LEN, headerType);
+            HZL_UAD_METADATA_IN_PAYLOAD_LEN, header);
     HZL_ERR_CHECK(err);
     // Prepare UAD Header
     const hzl_Header_t unpackedUadHeader = {
@@ -58,12 +58,10 @@ hzl_CommonBuildUnsecured(hzl_CbsPduMsg_t* const unsecuredPdu,
             .sid = sourceId,
             .pty = HZL_PTY_UAD,
     };
-    const uint8_t packedHdrLen = hzl_HeaderLen(headerType);
-    hzl_HeaderPackFunc const headerPackFunc =
-            hzl_HeaderPackFuncForType(headerType);
+    const uint8_t packedHdrLen = hzl_HeaderCodecPayloadLen(header);
     // Prepare UAD payload
     // Write the packed header at the beginning of the CAN FD frame's payload.
-    headerPackFunc(unsecuredPdu->data, &unpackedUadHeader);
+    hzl_HeaderCodecPack(header, &unsecuredPdu->canId, unsecuredPdu->data, &unpackedUadHeader);
     // Copy user-data (SDU) to the right of the packed header.
     memcpy(unsecuredPdu->data + packedHdrLen, userData, userDataLen);
     // Message is packed in binary format, ready to transmit
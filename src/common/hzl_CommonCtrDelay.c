@@ -34,24 +34,6 @@
 #include "hzl_CommonInternal.h"
 #include "hzl_CommonMessage.h"
 
-/**
- * @internal
- * Computes the ceiling of the given float in [0, 2^32-2].
- *
- * Equivalent to a simplified `ceilf()` from `math.h`, but implemented here to avoid including
- * `math.h` as a library dependency, as it would be the only used function from it.
- *
- * @param [in] x value in [0, 2^32-2] to round up
- * @return \p x rounded up to the nearest larger integer. If \p x is already an integer, the
- *        value is unchanged.
- */
-inline static uint32_t
-hzl_CeilUint32(const float x)
-{
-    const uint32_t xFloored = (uint32_t) x;
-    return xFloored + ((float) xFloored < x);
-}
-
 hzl_CtrNonce_t
 hzl_CommonCtrDelay(const hzl_Timestamp_t lastValidRxMsgInstant,
                    const hzl_Timestamp_t evaluationInstant,
@@ -68,8 +50,15 @@ hzl_CommonCtrDelay(const hzl_Timestamp_t lastValidRxMsgInstant,
         // counter nonce. It must be equal or newer than the local one.
         return 0;
     }
-    // Due to the sinceLastMsg >= maxSilenceInterval condition, this fraction is always in [0, 1].
-    const float elapsedAsMaxSilenceFraction = (float) sinceLastMsg / (float) maxSilenceInterval;
-    const float delay = (float) maxCtrNonceDelay * (1.0f - elapsedAsMaxSilenceFraction);
-    return (hzl_CtrNonce_t) hzl_CeilUint32(delay);
+    // ceil(D * (1 - t/S)) == ceil(D * R / S) with the remaining silence time R = S - t in [1, S].
+    // Computed exactly with integers only, as FPU-less targets would call a soft-float library.
+    // D * R may exceed 32 bits, so D is split into D = q*S + r with r < S, giving
+    // ceil(D * R / S) = q*R + ceil(r * R / S). Both terms fit into 32 bits: the first is
+    // at most D and the numerator of the second r*R + S-1 is below S^2, with S of 16 bits.
+    const hzl_TimeDeltaMillis_t remaining = maxSilenceInterval - sinceLastMsg;
+    const uint32_t quotient = maxCtrNonceDelay / maxSilenceInterval;
+    const uint32_t remainder = maxCtrNonceDelay % maxSilenceInterval;
+    return (hzl_CtrNonce_t) (quotient * remaining
+                             + (remainder * remaining + maxSilenceInterval - 1U)
+                               / maxSilenceInterval);
 }
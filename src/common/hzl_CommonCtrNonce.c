@@ -0,0 +1,105 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal Reservation and advancement of the Counter Nonce of the current Session.
+ */
+
+#include "hzl_CommonInternal.h"
+#include "hzl_CommonMessage.h"
+
+#ifdef HZL_THREAD_SAFE
+
+hzl_CtrNonce_t
+hzl_CommonCtrNonceReserve(HZL_ATOMIC hzl_CtrNonce_t* const ctrnonce,
+                          const size_t amount)
+{
+    const hzl_CtrNonce_t current = atomic_load_explicit(ctrnonce, memory_order_relaxed);
+    if (HZL_IS_CTRNONCE_EXPIRED(current)) { return HZL_MAX_CTRNONCE; }
+    const hzl_CtrNonce_t available = HZL_MAX_CTRNONCE - current;
+    const hzl_CtrNonce_t increment = (amount < available) ? (hzl_CtrNonce_t) amount : available;
+    const hzl_CtrNonce_t first = atomic_fetch_add_explicit(
+            ctrnonce, increment, memory_order_relaxed);
+    if (first > HZL_MAX_CTRNONCE - increment)
+    {
+        // Other threads reserved meanwhile, so this addition went past the limit: bring
+        // the counter back to it, unless someone else did already. Each addition is at most
+        // HZL_MAX_CTRNONCE, so the 32-bit counter cannot wrap around before that.
+        hzl_CtrNonce_t seen = first + increment;
+        while (seen > HZL_MAX_CTRNONCE
+               && !atomic_compare_exchange_weak_explicit(
+                ctrnonce, &seen, HZL_MAX_CTRNONCE, memory_order_relaxed, memory_order_relaxed))
+        {
+        }
+    }
+    return (first < HZL_MAX_CTRNONCE) ? first : HZL_MAX_CTRNONCE;
+}
+
+void
+hzl_CommonCtrNonceAdvancePast(HZL_ATOMIC hzl_CtrNonce_t* const ctrnonce,
+                              const hzl_CtrNonce_t receivedCtrnonce)
+{
+    hzl_CtrNonce_t seen = atomic_load_explicit(ctrnonce, memory_order_relaxed);
+    hzl_CtrNonce_t next;
+    do
+    {
+        next = (receivedCtrnonce > seen) ? receivedCtrnonce : seen;
+        next = HZL_IS_CTRNONCE_EXPIRED(next) ? HZL_MAX_CTRNONCE : next + 1U;
+    } while (!atomic_compare_exchange_weak_explicit(
+            ctrnonce, &seen, next, memory_order_relaxed, memory_order_relaxed));
+}
+
+#else
+
+hzl_CtrNonce_t
+hzl_CommonCtrNonceReserve(hzl_CtrNonce_t* const ctrnonce,
+                          const size_t amount)
+{
+    const hzl_CtrNonce_t first = *ctrnonce;
+    const hzl_CtrNonce_t available =
+            HZL_IS_CTRNONCE_EXPIRED(first) ? 0U : HZL_MAX_CTRNONCE - first;
+    *ctrnonce += (amount < available) ? (hzl_CtrNonce_t) amount : available;
+    return first;
+}
+
+void
+hzl_CommonCtrNonceAdvancePast(hzl_CtrNonce_t* const ctrnonce,
+                              const hzl_CtrNonce_t receivedCtrnonce)
+{
+    if (receivedCtrnonce > *ctrnonce)
+    {
+        *ctrnonce = receivedCtrnonce;
+    }
+    if (!HZL_IS_CTRNONCE_EXPIRED(*ctrnonce))
+    {
+        (*ctrnonce)++;
+    }
+}
+
+#endif  /* HZL_THREAD_SAFE */
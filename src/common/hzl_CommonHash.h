@@ -33,8 +33,8 @@
  *
  * The idea of this wrapper is to provide a stable interface in case the
  * implementation of the hash function is swapped with another.
- * Changing the Hash function means updating the typedef hzl_Hash_t in this file
- * and updating the functions in the hzl_Hash.c file.
+ * The typedef #hzl_Hash_t and the functions are provided by the crypto backend
+ * selected with the `HZL_CRYPTO_BACKEND` CMake option, e.g. `src/crypto/libascon/`.
  */
 
 #ifndef HZL_HASH_H_
@@ -46,12 +46,7 @@ extern "C"
 #endif
 
 #include "hzl_CommonInternal.h"
-#include "ascon.h"
-
-/**
- * State of the hash function.
- */
-typedef ascon_hash_ctx_t hzl_Hash_t;
+#include "hzl_CryptoBackend.h"
 
 /**
  * Initialises the hash function to process data.
@@ -106,6 +101,29 @@ hzl_HashDigestCheck(hzl_Hash_t* ctx,
                     const uint8_t* expectedDigest,
                     size_t digestLen);
 
+/**
+ * Stores a copy of the hash state, typically after absorbing a constant prefix
+ * such as `key || label`, so the hashing can later resume from this point.
+ *
+ * @param [out] midstate location where to copy the state, of
+ *        #HZL_HASH_STATE_WORDS words.
+ * @param [in] ctx context with the prefix already processed.
+ */
+void
+hzl_HashSaveMidstate(uint64_t* midstate,
+                     const hzl_Hash_t* ctx);
+
+/**
+ * Restores a hash state previously stored with hzl_HashSaveMidstate(), as an
+ * alternative to hzl_HashInit() followed by the updates of the prefix.
+ *
+ * @param [out] ctx context to overwrite.
+ * @param [in] midstate state to copy, of #HZL_HASH_STATE_WORDS words.
+ */
+void
+hzl_HashLoadMidstate(hzl_Hash_t* ctx,
+                     const uint64_t* midstate);
+
 #ifdef __cplusplus
 }
 #endif
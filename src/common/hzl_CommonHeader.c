@@ -29,11 +29,7 @@
 /**
  * @file
  * @internal
- * Functions that pack/unpack all standard CBS Headers and check the Header Type.
- *
- * In the comments of the static packer/unpacker functions, the bits of each
- * field are indicated with:
- * `g` = GID bits, `s` = SID bits, `p` = PTY bits, `.` = unused bits
+ * Functions that provide the packing of all standard CBS Headers and check the Header Type.
  */
 
 #include "hzl_CommonHeader.h"
@@ -45,144 +41,22 @@
  */
 #define HZL_MAX_UINTx(bits) ((1U << (bits)) - 1U)
 
-/** @internal `| gggg gggg | ssss ssss | pppp pppp |` */
-static void
-hzl_Header0Pack(uint8_t* binary, const hzl_Header_t* hdr)
-{
-    binary[0] = hdr->gid;
-    binary[1] = hdr->sid;
-    binary[2] = hdr->pty;
-}
-
-/** @internal `| gggg gggg | ssss sppp |` */
-static void
-hzl_Header1Pack(uint8_t* binary, const hzl_Header_t* hdr)
-{
-    binary[0] = hdr->gid;
-    binary[1] = (uint8_t) (
-            ((hdr->sid & 0x1FU) << 5U)
-            | (hdr->pty & 0x07U)
-    );
-}
-
-/** @internal `| ssss ssss | gggg gppp |` */
-static void
-hzl_Header2Pack(uint8_t* binary, const hzl_Header_t* hdr)
-{
-    binary[0] = hdr->sid;
-    binary[1] = (uint8_t) (
-            ((hdr->gid & 0x1FU) << 5U)
-            | (hdr->pty & 0x07U)
-    );
-}
-
-/** @internal `| gggs sppp |` */
-static void
-hzl_Header3Pack(uint8_t* binary, const hzl_Header_t* hdr)
-{
-    binary[0] = (uint8_t) (
-            ((hdr->gid & 0x07U) << 5U)
-            | ((hdr->sid & 0x03U) << 3U)
-            | (hdr->pty & 0x07U)
-    );
-}
-
-/** @internal `| sssg gppp |` */
-static void
-hzl_Header4Pack(uint8_t* binary, const hzl_Header_t* hdr)
-{
-    binary[0] = (uint8_t) (
-            ((hdr->sid & 0x07U) << 5U)
-            | ((hdr->gid & 0x03U) << 3U)
-            | (hdr->pty & 0x07U)
-    );
-}
-
-/** @internal `| ssss ssss | .... .ppp |` */
-static void
-hzl_Header5Pack(uint8_t* binary, const hzl_Header_t* hdr)
-{
-    binary[0] = hdr->sid;
-    binary[1] = (uint8_t) (hdr->pty & 0x07U);
-}
-
-/** @internal `| ssss sppp |` */
-static void
-hzl_Header6Pack(uint8_t* binary, const hzl_Header_t* hdr)
-{
-    binary[0] = (uint8_t) (
-            ((hdr->sid & 0x1FU) << 3U)
-            | (hdr->pty & 0x07U)
-    );
-}
-
-/** @internal `| gggg gggg | ssss ssss | pppp pppp |` */
-static void
-hzl_Header0Unpack(hzl_Header_t* hdr, const uint8_t* binary)
-{
-    hdr->gid = binary[0];
-    hdr->sid = binary[1];
-    hdr->pty = binary[2];
-}
-
-/** @internal `| gggg gggg | ssss sppp |` */
-static void
-hzl_Header1Unpack(hzl_Header_t* hdr, const uint8_t* binary)
-{
-    hdr->gid = binary[0];
-    hdr->sid = binary[1] >> 3U;
-    hdr->pty = (uint8_t) (binary[1] & 0x07U);
-}
-
-/** @internal `| ssss ssss | gggg gppp |` */
-static void
-hzl_Header2Unpack(hzl_Header_t* hdr, const uint8_t* binary)
-{
-    hdr->gid = binary[1] >> 3U;
-    hdr->sid = binary[0];
-    hdr->pty = (uint8_t) (binary[1] & 0x07U);
-}
-
-/** @internal `| gggs sppp |` */
-static void
-hzl_Header3Unpack(hzl_Header_t* hdr, const uint8_t* binary)
-{
-    hdr->gid = binary[0] >> 5U;
-    hdr->sid = (uint8_t) ((binary[0] >> 3U) & 0x03U);
-    hdr->pty = (uint8_t) (binary[0] & 0x07U);
-}
-
-/** @internal `| sssg gppp |` */
-static void
-hzl_Header4Unpack(hzl_Header_t* hdr, const uint8_t* binary)
-{
-    hdr->gid = (binary[0] >> 3U) & 0x03U;
-    hdr->sid = binary[0] >> 5U;
-    hdr->pty = (uint8_t) (binary[0] & 0x07U);
-}
-
-/** @internal `| ssss ssss | .... .ppp |` */
-static void
-hzl_Header5Unpack(hzl_Header_t* hdr, const uint8_t* binary)
-{
-    hdr->gid = HZL_BROADCAST_GID;
-    hdr->sid = binary[0];
-    hdr->pty = (uint8_t) (binary[1] & 0x07U);
-}
-
-/** @internal `| ssss sppp |` */
-static void
-hzl_Header6Unpack(hzl_Header_t* hdr, const uint8_t* binary)
+hzl_Err_t
+hzl_HeaderTypeCheck(const uint8_t type)
 {
-    hdr->gid = HZL_BROADCAST_GID;
-    hdr->sid = binary[0] >> 3U;
-    hdr->pty = (uint8_t) (binary[0] & 0x07U);
+#ifdef HZL_FIXED_HEADER_TYPE
+    const bool isSupported = type == HZL_FIXED_HEADER_TYPE;
+#else
+    const bool isSupported = type <= HZL_HEADER_6;
+#endif
+    if (!isSupported) { return HZL_ERR_INVALID_HEADER_TYPE; }
+    else { return HZL_OK; }
 }
 
 hzl_Err_t
-hzl_HeaderTypeCheck(const uint8_t type)
+hzl_HeaderPlacementCheck(const uint8_t placement)
 {
-    if (type > HZL_HEADER_6) { return HZL_ERR_INVALID_HEADER_TYPE; }
+    if (placement > HZL_HEADER_MIXED) { return HZL_ERR_INVALID_HEADER_PLACEMENT; }
     else { return HZL_OK; }
 }
 
@@ -265,3 +139,24 @@ hzl_HeaderUnpackFuncForType(const uint8_t type)
         default:return NULL;
     }
 }
+
+void
+hzl_HeaderCodecInit(hzl_HeaderCodec_t* const codec,
+                    const uint8_t type,
+                    const uint8_t placement)
+{
+    codec->pack = hzl_HeaderPackFuncForType(type);
+    codec->unpack = hzl_HeaderUnpackFuncForType(type);
+    codec->len = hzl_HeaderLen(type);
+    codec->maxGid = hzl_HeaderTypeMaxGid(type);
+    switch (placement)
+    {
+        case HZL_HEADER_IN_CAN_ID:codec->canIdLen = codec->len;
+            break;
+        case HZL_HEADER_MIXED:codec->canIdLen = 1U;
+            break;
+        default:codec->canIdLen = 0U;
+            break;
+    }
+    codec->canIdMask = (hzl_CanId_t) ((1ULL << (8U * codec->canIdLen)) - 1U);
+}
@@ -29,7 +29,8 @@
 /**
  * @file
  * @internal
- * Functions that pack/unpack all standard CBS Headers and check the Header Type.
+ * Functions that pack/unpack all standard CBS Headers and check the Header Type
+ * and placement.
  */
 
 #ifndef HZL_HEADER_H_
@@ -60,6 +61,9 @@ typedef enum hzl_PayloadType
     HZL_PTY_RFU2 = 7U,  ///< Reserved for future use
 } hzl_PayloadType_t;
 
+/** @internal Length of the longest packed CBS Header, Header Type 0, in bytes. */
+#define HZL_HEADER_MAX_LEN 3U
+
 /**
  * @internal
  * Signature of a packer function that encodes the #hzl_Header_t structure into
@@ -82,6 +86,338 @@ typedef void (* hzl_HeaderPackFunc)(uint8_t* binary,
 typedef void (* hzl_HeaderUnpackFunc)(hzl_Header_t* hdr,
                                       const uint8_t* binary);
 
+/**
+ * @def HZL_FIXED_HEADER_TYPE
+ * When defined, the only CBS Header Type supported by the library, for buses where all
+ * Parties use the same one. Set it with the CMake option of the same name.
+ *
+ * The header length and packing become compile-time constants, inlined in every message
+ * handler, instead of being read from the #hzl_HeaderCodec_t of the context.
+ * Initialising a context configured with any other header type fails with
+ * #HZL_ERR_INVALID_HEADER_TYPE.
+ */
+#ifdef HZL_FIXED_HEADER_TYPE
+#if HZL_FIXED_HEADER_TYPE == 0
+#define HZL_FIXED_HEADER_LEN 3U
+#define HZL_FIXED_HEADER_MAX_GID 255U
+#elif HZL_FIXED_HEADER_TYPE == 1
+#define HZL_FIXED_HEADER_LEN 2U
+#define HZL_FIXED_HEADER_MAX_GID 255U
+#elif HZL_FIXED_HEADER_TYPE == 2
+#define HZL_FIXED_HEADER_LEN 2U
+#define HZL_FIXED_HEADER_MAX_GID 31U
+#elif HZL_FIXED_HEADER_TYPE == 3
+#define HZL_FIXED_HEADER_LEN 1U
+#define HZL_FIXED_HEADER_MAX_GID 7U
+#elif HZL_FIXED_HEADER_TYPE == 4
+#define HZL_FIXED_HEADER_LEN 1U
+#define HZL_FIXED_HEADER_MAX_GID 3U
+#elif HZL_FIXED_HEADER_TYPE == 5
+#define HZL_FIXED_HEADER_LEN 2U
+#define HZL_FIXED_HEADER_MAX_GID 0U
+#elif HZL_FIXED_HEADER_TYPE == 6
+#define HZL_FIXED_HEADER_LEN 1U
+#define HZL_FIXED_HEADER_MAX_GID 0U
+#else
+#error "HZL_FIXED_HEADER_TYPE must be a standard CBS Header Type, from 0 to 6"
+#endif
+/** @internal Name of the packer or unpacker function of a header type. */
+#define HZL_HEADER_FUNC_NAME(type, operation) HZL_HEADER_FUNC_NAME_(type, operation)
+#define HZL_HEADER_FUNC_NAME_(type, operation) hzl_Header ## type ## operation
+#define HZL_FIXED_HEADER_PACK HZL_HEADER_FUNC_NAME(HZL_FIXED_HEADER_TYPE, Pack)
+#define HZL_FIXED_HEADER_UNPACK HZL_HEADER_FUNC_NAME(HZL_FIXED_HEADER_TYPE, Unpack)
+#endif
+
+/*
+ * Packer/unpacker functions of each standard CBS Header. In their comments the bits of each
+ * field are indicated with:
+ * `g` = GID bits, `s` = SID bits, `p` = PTY bits, `.` = unused bits
+ */
+
+/** @internal `| gggg gggg | ssss ssss | pppp pppp |` */
+static inline void
+hzl_Header0Pack(uint8_t* binary, const hzl_Header_t* hdr)
+{
+    binary[0] = hdr->gid;
+    binary[1] = hdr->sid;
+    binary[2] = hdr->pty;
+}
+
+/** @internal `| gggg gggg | ssss sppp |` */
+static inline void
+hzl_Header1Pack(uint8_t* binary, const hzl_Header_t* hdr)
+{
+    binary[0] = hdr->gid;
+    binary[1] = (uint8_t) (
+            ((hdr->sid & 0x1FU) << 5U)
+            | (hdr->pty & 0x07U)
+    );
+}
+
+/** @internal `| ssss ssss | gggg gppp |` */
+static inline void
+hzl_Header2Pack(uint8_t* binary, const hzl_Header_t* hdr)
+{
+    binary[0] = hdr->sid;
+    binary[1] = (uint8_t) (
+            ((hdr->gid & 0x1FU) << 5U)
+            | (hdr->pty & 0x07U)
+    );
+}
+
+/** @internal `| gggs sppp |` */
+static inline void
+hzl_Header3Pack(uint8_t* binary, const hzl_Header_t* hdr)
+{
+    binary[0] = (uint8_t) (
+            ((hdr->gid & 0x07U) << 5U)
+            | ((hdr->sid & 0x03U) << 3U)
+            | (hdr->pty & 0x07U)
+    );
+}
+
+/** @internal `| sssg gppp |` */
+static inline void
+hzl_Header4Pack(uint8_t* binary, const hzl_Header_t* hdr)
+{
+    binary[0] = (uint8_t) (
+            ((hdr->sid & 0x07U) << 5U)
+            | ((hdr->gid & 0x03U) << 3U)
+            | (hdr->pty & 0x07U)
+    );
+}
+
+/** @internal `| ssss ssss | .... .ppp |` */
+static inline void
+hzl_Header5Pack(uint8_t* binary, const hzl_Header_t* hdr)
+{
+    binary[0] = hdr->sid;
+    binary[1] = (uint8_t) (hdr->pty & 0x07U);
+}
+
+/** @internal `| ssss sppp |` */
+static inline void
+hzl_Header6Pack(uint8_t* binary, const hzl_Header_t* hdr)
+{
+    binary[0] = (uint8_t) (
+            ((hdr->sid & 0x1FU) << 3U)
+            | (hdr->pty & 0x07U)
+    );
+}
+
+/** @internal `| gggg gggg | ssss ssss | pppp pppp |` */
+static inline void
+hzl_Header0Unpack(hzl_Header_t* hdr, const uint8_t* binary)
+{
+    hdr->gid = binary[0];
+    hdr->sid = binary[1];
+    hdr->pty = binary[2];
+}
+
+/** @internal `| gggg gggg | ssss sppp |` */
+static inline void
+hzl_Header1Unpack(hzl_Header_t* hdr, const uint8_t* binary)
+{
+    hdr->gid = binary[0];
+    hdr->sid = binary[1] >> 3U;
+    hdr->pty = (uint8_t) (binary[1] & 0x07U);
+}
+
+/** @internal `| ssss ssss | gggg gppp |` */
+static inline void
+hzl_Header2Unpack(hzl_Header_t* hdr, const uint8_t* binary)
+{
+    hdr->gid = binary[1] >> 3U;
+    hdr->sid = binary[0];
+    hdr->pty = (uint8_t) (binary[1] & 0x07U);
+}
+
+/** @internal `| gggs sppp |` */
+static inline void
+hzl_Header3Unpack(hzl_Header_t* hdr, const uint8_t* binary)
+{
+    hdr->gid = binary[0] >> 5U;
+    hdr->sid = (uint8_t) ((binary[0] >> 3U) & 0x03U);
+    hdr->pty = (uint8_t) (binary[0] & 0x07U);
+}
+
+/** @internal `| sssg gppp |` */
+static inline void
+hzl_Header4Unpack(hzl_Header_t* hdr, const uint8_t* binary)
+{
+    hdr->gid = (binary[0] >> 3U) & 0x03U;
+    hdr->sid = binary[0] >> 5U;
+    hdr->pty = (uint8_t) (binary[0] & 0x07U);
+}
+
+/** @internal `| ssss ssss | .... .ppp |` */
+static inline void
+hzl_Header5Unpack(hzl_Header_t* hdr, const uint8_t* binary)
+{
+    hdr->gid = HZL_BROADCAST_GID;
+    hdr->sid = binary[0];
+    hdr->pty = (uint8_t) (binary[1] & 0x07U);
+}
+
+/** @internal `| ssss sppp |` */
+static inline void
+hzl_Header6Unpack(hzl_Header_t* hdr, const uint8_t* binary)
+{
+    hdr->gid = HZL_BROADCAST_GID;
+    hdr->sid = binary[0] >> 3U;
+    hdr->pty = (uint8_t) (binary[0] & 0x07U);
+}
+
+/**
+ * @internal
+ * Checks whether the codec was filled with hzl_HeaderCodecInit(), as a codec that was
+ * zero-initialised along with the rest of the context is not usable.
+ *
+ * @param [in] codec of the configured header type
+ */
+static inline bool
+hzl_HeaderCodecIsInitialised(const hzl_HeaderCodec_t* const codec)
+{
+    return codec->len != 0U;
+}
+
+/**
+ * @internal
+ * Length in bytes of the part of the packed header at the start of the payload,
+ * i.e. the offset of the rest of the payload, as cached in the codec.
+ *
+ * @param [in] codec of the configured header type and placement
+ */
+static inline uint8_t
+hzl_HeaderCodecPayloadLen(const hzl_HeaderCodec_t* const codec)
+{
+#ifdef HZL_FIXED_HEADER_TYPE
+    return (uint8_t) (HZL_FIXED_HEADER_LEN - codec->canIdLen);
+#else
+    return (uint8_t) (codec->len - codec->canIdLen);
+#endif
+}
+
+/**
+ * @internal
+ * Largest GID fitting in the packed header, as cached in the codec.
+ *
+ * @param [in] codec of the configured header type
+ */
+static inline hzl_Gid_t
+hzl_HeaderCodecMaxGid(const hzl_HeaderCodec_t* const codec)
+{
+#ifdef HZL_FIXED_HEADER_TYPE
+    (void) codec;
+    return HZL_FIXED_HEADER_MAX_GID;
+#else
+    return codec->maxGid;
+#endif
+}
+
+/** @internal Encodes the header with the packer function cached in the codec. */
+static inline void
+hzl_HeaderCodecPackContiguous(const hzl_HeaderCodec_t* const codec,
+                              uint8_t* const binary,
+                              const hzl_Header_t* const hdr)
+{
+#ifdef HZL_FIXED_HEADER_TYPE
+    (void) codec;
+    HZL_FIXED_HEADER_PACK(binary, hdr);
+#else
+    codec->pack(binary, hdr);
+#endif
+}
+
+/** @internal Decodes the header with the unpacker function cached in the codec. */
+static inline void
+hzl_HeaderCodecUnpackContiguous(const hzl_HeaderCodec_t* const codec,
+                                hzl_Header_t* const hdr,
+                                const uint8_t* const binary)
+{
+#ifdef HZL_FIXED_HEADER_TYPE
+    (void) codec;
+    HZL_FIXED_HEADER_UNPACK(hdr, binary);
+#else
+    codec->unpack(hdr, binary);
+#endif
+}
+
+/**
+ * @internal
+ * Encodes the header with the packer function cached in the codec, splitting the packed
+ * bytes between the CAN ID and the payload according to the configured placement.
+ *
+ * @param [in] codec of the configured header type and placement
+ * @param [out] canId where to write the CAN ID bits carrying the header, zero if the
+ *        header is all in the payload
+ * @param [out] payload buffer where to write the part of the header in the payload,
+ *        of hzl_HeaderCodecPayloadLen() bytes
+ * @param [in] hdr data structure to encode
+ */
+static inline void
+hzl_HeaderCodecPack(const hzl_HeaderCodec_t* const codec,
+                    hzl_CanId_t* const canId,
+                    uint8_t* const payload,
+                    const hzl_Header_t* const hdr)
+{
+    if (codec->canIdLen == 0U)
+    {
+        *canId = 0U;
+        hzl_HeaderCodecPackContiguous(codec, payload, hdr);
+        return;
+    }
+    uint8_t packed[HZL_HEADER_MAX_LEN];
+    hzl_HeaderCodecPackContiguous(codec, packed, hdr);
+    hzl_CanId_t canIdBits = 0U;
+    for (uint8_t i = 0U; i < codec->canIdLen; i++)
+    {
+        canIdBits = (canIdBits << 8U) | packed[i];
+    }
+    *canId = canIdBits;
+    const uint8_t payloadLen = hzl_HeaderCodecPayloadLen(codec);
+    for (uint8_t i = 0U; i < payloadLen; i++)
+    {
+        payload[i] = packed[codec->canIdLen + i];
+    }
+}
+
+/**
+ * @internal
+ * Decodes the header with the unpacker function cached in the codec, collecting the
+ * packed bytes from the CAN ID and the payload according to the configured placement.
+ *
+ * @param [in] codec of the configured header type and placement
+ * @param [out] hdr data structure where to write the decoded data
+ * @param [in] canId CAN ID of the received frame; bits outside of the codec's
+ *        \p canIdMask are ignored
+ * @param [in] payload received payload, starting with hzl_HeaderCodecPayloadLen() bytes
+ *        of the header
+ */
+static inline void
+hzl_HeaderCodecUnpack(const hzl_HeaderCodec_t* const codec,
+                      hzl_Header_t* const hdr,
+                      const hzl_CanId_t canId,
+                      const uint8_t* const payload)
+{
+    if (codec->canIdLen == 0U)
+    {
+        hzl_HeaderCodecUnpackContiguous(codec, hdr, payload);
+        return;
+    }
+    uint8_t packed[HZL_HEADER_MAX_LEN];
+    for (uint8_t i = 0U; i < codec->canIdLen; i++)
+    {
+        packed[i] = (uint8_t) (canId >> (8U * (codec->canIdLen - 1U - i)));
+    }
+    const uint8_t payloadLen = hzl_HeaderCodecPayloadLen(codec);
+    for (uint8_t i = 0U; i < payloadLen; i++)
+    {
+        packed[codec->canIdLen + i] = payload[i];
+    }
+    hzl_HeaderCodecUnpackContiguous(codec, hdr, packed);
+}
+
 /**
  * @internal
  * Validates if the value represents an actual standard CBS header type.
@@ -93,6 +429,17 @@ typedef void (* hzl_HeaderUnpackFunc)(hzl_Header_t* hdr,
 hzl_Err_t
 hzl_HeaderTypeCheck(uint8_t type);
 
+/**
+ * @internal
+ * Validates if the value represents a known placement of the CBS header.
+ *
+ * @param [in] placement header placement value to check
+ * @retval #HZL_OK on success
+ * @retval #HZL_ERR_INVALID_HEADER_PLACEMENT in case of illegal header placement value
+ */
+hzl_Err_t
+hzl_HeaderPlacementCheck(uint8_t placement);
+
 /**
  * @internal
  * Provides the largest SID that still fits in the given CBS Header Type.
@@ -143,6 +490,21 @@ hzl_HeaderPackFuncForType(uint8_t type);
 hzl_HeaderUnpackFunc
 hzl_HeaderUnpackFuncForType(uint8_t type);
 
+/**
+ * @internal
+ * Fills the codec with the length, maximum GID, packer/unpacker functions and the CAN ID
+ * bits of the header of a given type and placement, to be cached in the context during
+ * its initialisation.
+ *
+ * @param [out] codec to fill
+ * @param [in] type header type, already checked with hzl_HeaderTypeCheck()
+ * @param [in] placement header placement, already checked with hzl_HeaderPlacementCheck()
+ */
+void
+hzl_HeaderCodecInit(hzl_HeaderCodec_t* codec,
+                    uint8_t type,
+                    uint8_t placement);
+
 #ifdef __cplusplus
 }
 #endif
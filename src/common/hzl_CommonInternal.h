@@ -88,6 +88,8 @@ typedef uint32_t hzl_TimeDeltaMillis_t;
  * Zeroes-out the memory section.
  *
  * Wrapper of memset to guarantee the compiler does not optimise it away.
+ * With GCC and Clang it's a plain memset followed by a compiler barrier,
+ * otherwise it falls back to volatile byte-wise writes.
  *
  * @param [in] buffer memory section to set to all-zeros
  * @param [in] amountOfBytes length of \p buffer in bytes
@@ -99,6 +101,9 @@ hzl_ZeroOut(void* buffer, size_t amountOfBytes);
  * @internal
  * Checks if all bytes are set to zero.
  *
+ * Constant-time: always reads all bytes, word-wise where possible, without
+ * branching on their values.
+ *
  * @param [in] bytes to check
  * @param [in] amount number of bytes
  *
@@ -149,6 +154,99 @@ hzl_NonZeroTrng(uint8_t* bytes,
                 hzl_TrngFunc trng,
                 size_t amount);
 
+#ifdef HZL_THREAD_SAFE
+
+/** @internal Sets the lock to unlocked. Not thread-safe: only on initialisation. */
+void
+hzl_LockInit(hzl_Lock_t* lock);
+
+/**
+ * @internal
+ * Takes the lock, spinning until it is released by its current holder.
+ *
+ * Yields the CPU to other threads now and then while spinning, in case the holder
+ * was preempted.
+ *
+ * @param [in, out] lock to take
+ */
+void
+hzl_LockAcquire(hzl_Lock_t* lock);
+
+/** @internal Releases the lock taken with hzl_LockAcquire() by the same thread. */
+void
+hzl_LockRelease(hzl_Lock_t* lock);
+
+/** @internal Sets the sequence counter to no changes. Not thread-safe: only on initialisation. */
+void
+hzl_SessionSeqInit(hzl_SessionSeq_t* seq);
+
+/**
+ * @internal
+ * Marks the start of a change of the current Session of a Group (STK, Counter Nonce,
+ * start instant), making the concurrent readers retry.
+ *
+ * To be called only while holding the lock of the Group, before the first write.
+ *
+ * @param [in, out] seq sequence counter of the Group
+ */
+void
+hzl_SessionSeqChangeBegin(hzl_SessionSeq_t* seq);
+
+/** @internal Marks the end of the change started with hzl_SessionSeqChangeBegin(). */
+void
+hzl_SessionSeqChangeEnd(hzl_SessionSeq_t* seq);
+
+/**
+ * @internal
+ * Starts reading the current Session of a Group without holding its lock.
+ *
+ * Waits for any ongoing change to finish, yielding the CPU now and then as
+ * hzl_LockAcquire() does.
+ *
+ * @param [in] seq sequence counter of the Group
+ * @return the counter value to pass to hzl_SessionSeqReadRetry()
+ */
+uint_least16_t
+hzl_SessionSeqReadBegin(hzl_SessionSeq_t* seq);
+
+/**
+ * @internal
+ * Checks whether the current Session changed since hzl_SessionSeqReadBegin().
+ *
+ * @param [in] seq sequence counter of the Group
+ * @param [in] begin value returned by hzl_SessionSeqReadBegin()
+ * @return true if the values read in the meantime may be torn and must be read again
+ */
+bool
+hzl_SessionSeqReadRetry(hzl_SessionSeq_t* seq,
+                        uint_least16_t begin);
+
+/** @internal Initialises the lock when built with #HZL_THREAD_SAFE, nothing otherwise. */
+#define HZL_LOCK_INIT(lock) hzl_LockInit(lock)
+/** @internal Takes the lock when built with #HZL_THREAD_SAFE, nothing otherwise. */
+#define HZL_LOCK_ACQUIRE(lock) hzl_LockAcquire(lock)
+/** @internal Releases the lock when built with #HZL_THREAD_SAFE, nothing otherwise. */
+#define HZL_LOCK_RELEASE(lock) hzl_LockRelease(lock)
+/** @internal Initialises the sequence counter when built with #HZL_THREAD_SAFE,
+ * nothing otherwise. */
+#define HZL_SESSION_SEQ_INIT(seq) hzl_SessionSeqInit(seq)
+/** @internal Starts a Session change when built with #HZL_THREAD_SAFE, nothing otherwise. */
+#define HZL_SESSION_CHANGE_BEGIN(seq) hzl_SessionSeqChangeBegin(seq)
+/** @internal Ends a Session change when built with #HZL_THREAD_SAFE, nothing otherwise. */
+#define HZL_SESSION_CHANGE_END(seq) hzl_SessionSeqChangeEnd(seq)
+
+#else
+
+// The locks do not even exist in the structs: discard the argument without evaluating it.
+#define HZL_LOCK_INIT(lock)
+#define HZL_LOCK_ACQUIRE(lock)
+#define HZL_LOCK_RELEASE(lock)
+#define HZL_SESSION_SEQ_INIT(seq)
+#define HZL_SESSION_CHANGE_BEGIN(seq)
+#define HZL_SESSION_CHANGE_END(seq)
+
+#endif  /* HZL_THREAD_SAFE */
+
 #if HZL_OS_AVAILABLE
 
 /** @internal Implementation of the hzl_ClientNewMsg() and hzl_ServerNewMsg()/ */
@@ -188,6 +286,23 @@ hzl_OsTrng(uint8_t* buffer, size_t amount);
 hzl_Err_t
 hzl_OsCurrentTime(hzl_Timestamp_t* timestamp);
 
+/**
+ * @internal
+ * Like hzl_OsCurrentTime(), but cheaper and with a resolution of a few milliseconds.
+ *
+ * Reads the OS monotonic clock as last updated by the system timer tick,
+ * where available, otherwise it's the same as hzl_OsCurrentTime().
+ *
+ * @param [out] timestamp current time
+
+ * @retval #HZL_OK on success
+ * @retval #HZL_ERR_CANNOT_GET_CURRENT_TIME is the timestamp generation fails
+ *
+ * @see #hzl_TimestampFunc
+ */
+hzl_Err_t
+hzl_OsCurrentTimeCoarse(hzl_Timestamp_t* timestamp);
+
 /**
  * @internal
  * Zeros-out the memory region, frees it and sets the pointer to it to NULL, to avoid
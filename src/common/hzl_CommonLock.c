@@ -0,0 +1,145 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Implementation of the spinlock protecting the Group states and of the sequence counter
+ * of their Session changes, when the library is built with #HZL_THREAD_SAFE.
+ */
+
+#include "hzl_CommonInternal.h"
+
+#ifdef HZL_THREAD_SAFE
+
+#if HZL_OS_AVAILABLE_NIX
+#include <sched.h>  /* For sched_yield() */
+#endif
+
+/**
+ * @internal
+ * Amount of reads of a taken lock before yielding the CPU.
+ *
+ * The Group states are held for a few microseconds at most, so spinning is cheaper than
+ * sleeping, unless the holder was preempted, in which case it needs the CPU to finish.
+ */
+#define HZL_LOCK_SPINS_BEFORE_YIELD 128U
+
+/** @internal Lets the other threads run, if there is an OS to ask it to. */
+inline static void
+hzl_LockYield(void)
+{
+#if HZL_OS_AVAILABLE_NIX
+    sched_yield();
+#elif HZL_OS_AVAILABLE_WIN
+    SwitchToThread();
+#endif
+}
+
+void
+hzl_LockInit(hzl_Lock_t* const lock)
+{
+    atomic_init(&lock->isLocked, 0U);
+}
+
+void
+hzl_LockAcquire(hzl_Lock_t* const lock)
+{
+    uint32_t spins = 0;
+    while (atomic_exchange_explicit(&lock->isLocked, 1U, memory_order_acquire) != 0U)
+    {
+        // Wait with plain reads, which do not take the cache line away from the holder,
+        // and try again only once the lock looks released.
+        while (atomic_load_explicit(&lock->isLocked, memory_order_relaxed) != 0U)
+        {
+            if (++spins == HZL_LOCK_SPINS_BEFORE_YIELD)
+            {
+                spins = 0;
+                hzl_LockYield();
+            }
+        }
+    }
+}
+
+void
+hzl_LockRelease(hzl_Lock_t* const lock)
+{
+    atomic_store_explicit(&lock->isLocked, 0U, memory_order_release);
+}
+
+void
+hzl_SessionSeqInit(hzl_SessionSeq_t* const seq)
+{
+    atomic_init(&seq->changes, 0U);
+}
+
+void
+hzl_SessionSeqChangeBegin(hzl_SessionSeq_t* const seq)
+{
+    // The holder of the Group lock is the only writer
+    const uint_least16_t changes = atomic_load_explicit(&seq->changes, memory_order_relaxed);
+    atomic_store_explicit(&seq->changes, (uint_least16_t) (changes + 1U), memory_order_relaxed);
+    // Any reader seeing one of the following writes also sees the counter being odd
+    atomic_thread_fence(memory_order_release);
+}
+
+void
+hzl_SessionSeqChangeEnd(hzl_SessionSeq_t* const seq)
+{
+    const uint_least16_t changes = atomic_load_explicit(&seq->changes, memory_order_relaxed);
+    atomic_store_explicit(&seq->changes, (uint_least16_t) (changes + 1U), memory_order_release);
+}
+
+uint_least16_t
+hzl_SessionSeqReadBegin(hzl_SessionSeq_t* const seq)
+{
+    uint32_t spins = 0;
+    uint_least16_t changes = atomic_load_explicit(&seq->changes, memory_order_acquire);
+    while ((changes & 1U) != 0U)
+    {
+        if (++spins == HZL_LOCK_SPINS_BEFORE_YIELD)
+        {
+            spins = 0;
+            hzl_LockYield();
+        }
+        changes = atomic_load_explicit(&seq->changes, memory_order_acquire);
+    }
+    return changes;
+}
+
+bool
+hzl_SessionSeqReadRetry(hzl_SessionSeq_t* const seq,
+                        const uint_least16_t begin)
+{
+    // Orders the reads done since hzl_SessionSeqReadBegin() before the check
+    atomic_thread_fence(memory_order_acquire);
+    // A wrap-around would require 32768 whole changes during a single read
+    return atomic_load_explicit(&seq->changes, memory_order_relaxed) != begin;
+}
+
+#endif  /* HZL_THREAD_SAFE */
@@ -57,7 +57,7 @@ hzl_CommonBuildUnsecured(hzl_CbsPduMsg_t* unsecuredPdu,
                          size_t userDataLen,
                          hzl_Gid_t groupId,
                          hzl_Sid_t sourceId,
-                         uint8_t headerType);
+                         const hzl_HeaderCodec_t* header);
 
 /**
  * @internal
@@ -71,7 +71,7 @@ hzl_CommonBuildUnsecured(hzl_CbsPduMsg_t* unsecuredPdu,
  * @param [in] group GID of the destination group.
  * @param [in] metadataInPayloadLen length in bytes of the metadata surrounding the user data
  * within the CBS Payload, excluding the packed CBS Header.
- * @param [in] headerType to access the maximum GID and SID etc.
+ * @param [in] header codec of the configured header type, to access the maximum GID etc.
  *
  * @retval #HZL_OK on a valid message, the specific error code if something is incorrect
  */
@@ -80,17 +80,42 @@ hzl_CommonCheckMsgBeforePacking(const uint8_t* userData,
                                 size_t userDataLen,
                                 hzl_Gid_t group,
                                 size_t metadataInPayloadLen,
-                                uint8_t headerType);
+                                const hzl_HeaderCodec_t* header);
+
+/**
+ * @internal
+ * Unpacks the header of a received message from its payload and/or CAN ID, checking
+ * the message is long enough to contain it.
+ *
+ * @param [out] unpackedHdr where to write the decoded header
+ * @param [in] receivedPdu received payload. Can be NULL only if \p receivedPduLen is zero.
+ * @param [in] receivedPduLen length of \p receivedPdu in bytes
+ * @param [in] receivedCanId CAN ID of the received message
+ * @param [in] header codec of the configured header type and placement
+ *
+ * @retval #HZL_OK on success
+ * @retval #HZL_ERR_NULL_PDU if \p receivedPdu is NULL with a positive length
+ * @retval #HZL_ERR_CTX_NOT_INITIALISED if the codec was not filled yet
+ * @retval #HZL_ERR_TOO_SHORT_PDU_TO_CONTAIN_HEADER if \p receivedPduLen is too short
+ */
+hzl_Err_t
+hzl_CommonUnpackHeader(hzl_Header_t* unpackedHdr,
+                       const uint8_t* receivedPdu,
+                       size_t receivedPduLen,
+                       hzl_CanId_t receivedCanId,
+                       const hzl_HeaderCodec_t* header);
 
 /** @internal
  * Verifies the basic integrity of the message data structure (NULL pointers,
- * minimum and maximum sizes). */
+ * minimum and maximum sizes) and unpacks its header from the payload and/or
+ * \p receivedCanId. */
 hzl_Err_t
 hzl_CommonCheckReceivedGenericMsg(hzl_Header_t* unpackedHdr,
                                   const uint8_t* receivedPdu,
                                   size_t receivedPduLen,
+                                  hzl_CanId_t receivedCanId,
                                   hzl_Sid_t receiverSid,
-                                  uint8_t headerType);
+                                  const hzl_HeaderCodec_t* header);
 
 /**
  * @internal
@@ -101,7 +126,7 @@ hzl_CommonCheckReceivedGenericMsg(hzl_Header_t* unpackedHdr,
  * @param [in] rxPdu received raw UAD message
  * @param [in] rxPduLen length of \p rxPdu in bytes
  * @param [in] unpackedUadHeader metadata of the CBS message in unpacked format
- * @param [in] headerType
+ * @param [in] header codec of the configured header type
  *
  * @return #HZL_OK always as there is no validation
  */
@@ -110,19 +135,253 @@ hzl_CommonProcessReceivedUnsecured(hzl_RxSduMsg_t* unpackedMsg,
                                    const uint8_t* rxPdu,
                                    size_t rxPduLen,
                                    const hzl_Header_t* unpackedUadHeader,
-                                   uint8_t headerType);
+                                   const hzl_HeaderCodec_t* header);
+
+/**
+ * @internal
+ * Like hzl_CommonProcessReceivedUnsecured(), but providing a view of the user data
+ * within \p rxPdu instead of a copy.
+ *
+ * @return #HZL_OK always as there is no validation
+ */
+hzl_Err_t
+hzl_CommonProcessReceivedUnsecuredInPlace(hzl_RxSduView_t* view,
+                                          const uint8_t* rxPdu,
+                                          size_t rxPduLen,
+                                          const hzl_Header_t* unpackedUadHeader,
+                                          const hzl_HeaderCodec_t* header);
+
+/**
+ * @internal
+ * Fills the view with the metadata of an unpacked message and the location of its user data,
+ * unless the message contains no data for the user, leaving the view cleared.
+ *
+ * @param [out] view to fill, already cleared
+ * @param [in] metadata of the unpacked message; its data array is ignored
+ * @param [in] data location of the user data
+ */
+void
+hzl_CommonRxViewOfMsg(hzl_RxSduView_t* view,
+                      const hzl_RxSduMsg_t* metadata,
+                      const uint8_t* data);
+
+/**
+ * @internal
+ * Writes the AEAD-nonce of #HZL_AEAD_NONCE_LEN bytes and the associated data of
+ * #HZL_SADFD_AD_LEN bytes as used to secure a SADFD message.
+ */
+void
+hzl_CommonSadfdAeadNonceAndAssocData(uint8_t* aeadNonce,
+                                     uint8_t* assocData,
+                                     const hzl_Header_t* unpackedSadfdHeader,
+                                     hzl_CtrNonce_t ctrnonce,
+                                     uint8_t plaintextLen);
+
+/**
+ * @internal
+ * Encrypts the plaintext of a SADFD message with the proper AEAD-nonce, label, key etc.
+ * in a single call, writing the ciphertext and the tag of #HZL_SADFD_TAG_LEN bytes
+ * directly into the PDU.
+ */
+void
+hzl_CommonSadfdEncrypt(uint8_t* ciphertext,
+                       uint8_t* tag,
+                       const uint8_t* stk,
+                       const hzl_Header_t* unpackedSadfdHeader,
+                       hzl_CtrNonce_t ctrnonce,
+                       const uint8_t* plaintext,
+                       uint8_t plaintextLen);
+
+/**
+ * @internal
+ * Validates and decrypts the ciphertext of a SADFD message read directly from the PDU
+ * in a single call, the counterpart of hzl_CommonSadfdEncrypt().
+ *
+ * @retval #HZL_OK if the tag is valid
+ * @retval #HZL_ERR_SECWARN_INVALID_TAG if the tag is not valid, with \p plaintext
+ *         zeroed out
+ */
+hzl_Err_t
+hzl_CommonSadfdDecrypt(uint8_t* plaintext,
+                       const uint8_t* stk,
+                       const hzl_Header_t* unpackedSadfdHeader,
+                       hzl_CtrNonce_t ctrnonce,
+                       const uint8_t* ciphertext,
+                       uint8_t plaintextLen,
+                       const uint8_t* tag);
 
 /**
  * @internal
  * Initialised AEAD cipher with the proper AEAD-nonce, label, key etc. as used to
- * secure a SADFD message.
+ * secure a SADTP message.
  */
 void
-hzl_CommonAeadInitSadfd(hzl_Aead_t* aead,
+hzl_CommonAeadInitSadtp(hzl_Aead_t* aead,
                         const uint8_t* stk,
-                        const hzl_Header_t* unpackedSadfdHeader,
+                        const hzl_Header_t* unpackedSadtpHeader,
                         hzl_CtrNonce_t ctrnonce,
-                        uint8_t plaintextLen);
+                        uint16_t plaintextLen);
+
+/**
+ * @internal
+ * Validates an SADTP message to-be-transmitted provided by the user through the public API,
+ * as hzl_CommonCheckMsgBeforePacking() does for single-frame messages.
+ *
+ * @param [out] requiredPdus amount of fragments the message is split into
+ * @param [in] userData SDU as provided to the public API.
+ * @param [in] userDataLen length of \p userData in bytes as provided to the public API.
+ * @param [in] group GID of the destination group.
+ * @param [in] availablePdus amount of fragments the user provided space for
+ * @param [in] header codec of the configured header type, to access the maximum GID and
+ *        header length
+ *
+ * @retval #HZL_OK on a valid message, the specific error code if something is incorrect
+ */
+hzl_Err_t
+hzl_CommonSadtpCheckMsgBeforePacking(size_t* requiredPdus,
+                                     const uint8_t* userData,
+                                     size_t userDataLen,
+                                     hzl_Gid_t group,
+                                     size_t availablePdus,
+                                     const hzl_HeaderCodec_t* header);
+
+/**
+ * @internal
+ * Builds all fragments of an **SADTP** message for both the Server and Client.
+ * Implements the main behaviour of hzl_ClientBuildSecuredTp() and hzl_ServerBuildSecuredTp().
+ * The caller has to check the context and the message with
+ * hzl_CommonSadtpCheckMsgBeforePacking().
+ */
+void
+hzl_CommonBuildSecuredTp(hzl_CbsPduMsg_t* securedPdus,
+                         const uint8_t* userData,
+                         size_t userDataLen,
+                         const uint8_t* stk,
+                         const hzl_Header_t* unpackedSadtpHeader,
+                         hzl_CtrNonce_t ctrnonce,
+                         const hzl_HeaderCodec_t* header);
+
+/** @internal Payload of a received SADTP fragment, after the CBS Header. */
+typedef struct hzl_SadtpFragment
+{
+    const uint8_t* chunk;  ///< Piece of the `ciphertext || tag` stream in the fragment.
+    size_t chunkLen;  ///< Length of \p chunk in bytes.
+    hzl_CtrNonce_t ctrnonce;  ///< Counter Nonce of the whole message.
+    uint16_t plaintextLen;  ///< Length of the whole plaintext, only in the first fragment.
+    uint8_t idx;  ///< Position of the fragment within the message, starting from 0.
+} hzl_SadtpFragment_t;
+
+/**
+ * @internal
+ * Verifies the reception buffers provided by the user in the Client or Server context.
+ *
+ * @retval #HZL_OK if \p buffers is NULL with \p amountOfBuffers being 0 or
+ *         if every buffer with a non-zero capacity has its data
+ * @retval #HZL_ERR_NULL_SADTP_RX_BUFFERS otherwise
+ */
+hzl_Err_t
+hzl_CommonSadtpCheckRxBuffers(const hzl_SadtpRxBuffer_t* buffers,
+                              size_t amountOfBuffers);
+
+/**
+ * @internal
+ * Securely erases the content and state of all reception buffers, marking them free.
+ * The data location and capacity set by the user are kept.
+ */
+void
+hzl_CommonSadtpRxClearAll(hzl_SadtpRxBuffer_t* buffers,
+                          size_t amountOfBuffers);
+
+/**
+ * @internal
+ * Marks the start of a receiving call of the API by the calling thread.
+ *
+ * Must be called once at the start of each public function processing received messages,
+ * once per batch: the buffers of the SADTP messages completed by this thread in its
+ * earlier calls become free again, while the ones completed in the current call are kept,
+ * as the user may still read them from the earlier outputs of the same batch.
+ */
+void
+hzl_CommonSadtpRxCallBegin(void);
+
+/**
+ * @internal
+ * Splits the payload of a received SADTP fragment into its fields.
+ *
+ * @retval #HZL_OK on success
+ * @retval #HZL_ERR_TOO_SHORT_PDU_TO_CONTAIN_SADTP if the metadata does not fit
+ * @retval #HZL_ERR_TOO_LONG_CIPHERTEXT if the PDU is longer than any CAN FD frame
+ */
+hzl_Err_t
+hzl_CommonSadtpParseFragment(hzl_SadtpFragment_t* fragment,
+                             const uint8_t* rxPdu,
+                             size_t rxPduLen,
+                             uint8_t packedHdrLen);
+
+/**
+ * @internal
+ * Reserves a reception buffer for the message started by the given first fragment,
+ * initialising its decryption.
+ *
+ * Any unfinished message of the same Source and Group is discarded, as are the ones that
+ * did not receive any fragment within the Max Silence Interval of their own Group.
+ *
+ * @param [out] selected the reserved buffer
+ * @param [in] isPreviousSession true if \p stk is the one of the previous Session
+ * @param [in] maxSilenceIntervalMillis of the Group of the new message, stored in the buffer
+ *
+ * @retval #HZL_OK on success
+ * @retval #HZL_ERR_SADTP_NO_FREE_RX_BUFFER if no buffer is free and large enough
+ */
+hzl_Err_t
+hzl_CommonSadtpRxStart(hzl_SadtpRxBuffer_t** selected,
+                       hzl_SadtpRxBuffer_t* buffers,
+                       size_t amountOfBuffers,
+                       const hzl_Header_t* unpackedSadtpHeader,
+                       const hzl_SadtpFragment_t* fragment,
+                       const uint8_t* stk,
+                       bool isPreviousSession,
+                       hzl_Timestamp_t rxTimestamp,
+                       uint16_t maxSilenceIntervalMillis);
+
+/**
+ * @internal
+ * Finds the reception buffer of the message the given non-first fragment belongs to.
+ *
+ * @param [out] selected the buffer to append the fragment to
+ *
+ * @retval #HZL_OK on success
+ * @retval #HZL_ERR_SADTP_UNEXPECTED_FRAGMENT if no message is being received from that
+ *         Source in that Group, or the fragment is not the next one expected. In the latter
+ *         case the whole message is discarded.
+ */
+hzl_Err_t
+hzl_CommonSadtpRxContinue(hzl_SadtpRxBuffer_t** selected,
+                          hzl_SadtpRxBuffer_t* buffers,
+                          size_t amountOfBuffers,
+                          const hzl_Header_t* unpackedSadtpHeader,
+                          const hzl_SadtpFragment_t* fragment,
+                          hzl_Timestamp_t rxTimestamp);
+
+/**
+ * @internal
+ * Decrypts the fragment into the reception buffer, validating the tag after the last one.
+ *
+ * On any error, the message is discarded and its buffer freed.
+ *
+ * @param [out] isComplete true when the whole message was received and is valid. The
+ *        plaintext is then in the buffer data, which stays reserved for the user until
+ *        the next receiving call of this thread, see hzl_CommonSadtpRxCallBegin().
+ *
+ * @retval #HZL_OK on success
+ * @retval #HZL_ERR_TOO_LONG_CIPHERTEXT if the fragments exceed the announced length
+ * @retval #HZL_ERR_SECWARN_INVALID_TAG if the message is not authentic
+ */
+hzl_Err_t
+hzl_CommonSadtpRxAppend(bool* isComplete,
+                        hzl_SadtpRxBuffer_t* buffer,
+                        const hzl_SadtpFragment_t* fragment,
+                        hzl_Timestamp_t rxTimestamp);
 
 /**
  * @internal
@@ -149,6 +408,26 @@ hzl_ReqHashInit(hzl_Hash_t* hash,
                 const hzl_Header_t* unpackedReqHeader,
                 const uint8_t* reqNonce);
 
+/**
+ * @internal
+ * Initialised Hash function with the LTK and label of a REQ message only,
+ * i.e. the part of hzl_ReqHashInit() that is constant per Client and can be
+ * precomputed with hzl_HashSaveMidstate().
+ */
+void
+hzl_ReqHashInitKeyed(hzl_Hash_t* hash,
+                     const uint8_t* ltk);
+
+/**
+ * @internal
+ * Feeds the remaining fields of a REQ message (GID, SID, PTY, reqnonce)
+ * into a Hash function initialised with hzl_ReqHashInitKeyed().
+ */
+void
+hzl_ReqHashUpdateFields(hzl_Hash_t* hash,
+                        const hzl_Header_t* unpackedReqHeader,
+                        const uint8_t* reqNonce);
+
 /**
  * @internal
  * Computes the Counter Nonce Delay, i.e. the tolerance applied to a Counter Nonce
@@ -161,8 +440,9 @@ hzl_ReqHashInit(hzl_Hash_t* hash,
  * @param [in] lastValidRxMsgInstant timestamp of the last valid received message (`m`)
  * @param [in] evaluationInstant timestamp of the reception of the current Counter Nonce (`t`)
  * @param [in] maxCtrNonceDelay configuration parameter (`D`)
- * @param [in] maxSilenceInterval configuration parameter (`S`)
- * @return the allowed delay, expressed in the same unit as the Counter Nonce (i.e. unitless)
+ * @param [in] maxSilenceInterval configuration parameter (`S`), in [0, UINT16_MAX]
+ * @return the allowed delay, expressed in the same unit as the Counter Nonce (i.e. unitless),
+ *         rounded up exactly as the ceil() of the specification
  */
 hzl_CtrNonce_t
 hzl_CommonCtrDelay(hzl_Timestamp_t lastValidRxMsgInstant,
@@ -170,6 +450,39 @@ hzl_CommonCtrDelay(hzl_Timestamp_t lastValidRxMsgInstant,
                    hzl_CtrNonce_t maxCtrNonceDelay,
                    hzl_TimeDeltaMillis_t maxSilenceInterval);
 
+/**
+ * @internal
+ * Reserves up to \p amount consecutive Counter Nonces, advancing the counter past them.
+ *
+ * Saturates at #HZL_MAX_CTRNONCE: an expired counter is never advanced further, so fewer
+ * than \p amount values, or none, may be reserved. When built with #HZL_THREAD_SAFE
+ * it is lock-free, based on an atomic addition, and concurrent callers always obtain
+ * disjoint ranges.
+ *
+ * @param [in, out] ctrnonce counter to advance
+ * @param [in] amount of Counter Nonces to reserve
+ * @return the first reserved Counter Nonce, at most #HZL_MAX_CTRNONCE. Only the reserved
+ *         values below #HZL_MAX_CTRNONCE are usable: none, if the returned one is expired.
+ */
+hzl_CtrNonce_t
+hzl_CommonCtrNonceReserve(HZL_ATOMIC hzl_CtrNonce_t* ctrnonce,
+                          size_t amount);
+
+/**
+ * @internal
+ * Advances the counter past a received Counter Nonce, to `max(counter, received) + 1`,
+ * saturating at #HZL_MAX_CTRNONCE.
+ *
+ * When built with #HZL_THREAD_SAFE it is atomic, so it never hands out again the values
+ * reserved meanwhile with hzl_CommonCtrNonceReserve().
+ *
+ * @param [in, out] ctrnonce counter to advance
+ * @param [in] receivedCtrnonce Counter Nonce of a valid received message
+ */
+void
+hzl_CommonCtrNonceAdvancePast(HZL_ATOMIC hzl_CtrNonce_t* ctrnonce,
+                              hzl_CtrNonce_t receivedCtrnonce);
+
 #ifdef __cplusplus
 }
 #endif
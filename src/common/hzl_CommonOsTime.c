@@ -29,7 +29,8 @@
 /**
  * @file
  * @internal
- * Implementation of the hzl_OsTrng() function for different operating systems.
+ * Implementation of the hzl_OsCurrentTime() and hzl_OsCurrentTimeCoarse() functions
+ * for different operating systems.
  */
 
 #include "hzl_CommonInternal.h"
@@ -83,8 +84,74 @@ hzl_OsCurrentTime(hzl_Timestamp_t* const timestamp)
     return HZL_OK;
 }
 
+hzl_Err_t
+hzl_OsCurrentTimeCoarse(hzl_Timestamp_t* const timestamp)
+{
+    // Timestamp is never NULL, guaranteed by the caller.
+    // GetTickCount64 provides the milliseconds since system start, it's monotonic and
+    // has the resolution of the system timer (10-16 ms).
+    // Truncate the high bits, as for hzl_OsCurrentTime().
+    *timestamp = (hzl_Timestamp_t) GetTickCount64();
+    return HZL_OK;
+}
+
 #elif HZL_OS_AVAILABLE_NIX
 
+#if defined(CLOCK_MONOTONIC)
+
+/**
+ * @internal
+ * Converts the time of a POSIX clock to milliseconds since its unspecified starting point.
+ *
+ * @param [out] timestamp current time
+ * @param [in] clockId which clock to read
+ * @retval #HZL_OK on success
+ * @retval #HZL_ERR_CANNOT_GET_CURRENT_TIME is the clock cannot be read
+ */
+static hzl_Err_t
+hzl_OsClockMillis(hzl_Timestamp_t* const timestamp, const clockid_t clockId)
+{
+    struct timespec now;
+    if (clock_gettime(clockId, &now) == 0)
+    {
+        // Truncate the high bits, a we only need timestamps that show us a relative
+        // time for a short timeframe (some days at the very most).
+        // No rounding, we don't need this kind of accuracy.
+        *timestamp = (hzl_Timestamp_t) ((hzl_Timestamp_t) now.tv_sec * 1000U);
+        *timestamp += (hzl_Timestamp_t) ((hzl_Timestamp_t) now.tv_nsec / 1000000U);
+        return HZL_OK;
+    }
+    else
+    {
+        return HZL_ERR_CANNOT_GET_CURRENT_TIME;
+    }
+}
+
+hzl_Err_t
+hzl_OsCurrentTime(hzl_Timestamp_t* const timestamp)
+{
+    // Timestamp is never NULL, guaranteed by the caller.
+    // The monotonic clock is not affected by changes of the system wall-clock time
+    // (e.g. NTP steps or manual settings), which would otherwise make Sessions
+    // expire early or the received messages look too old or too new.
+    // On Linux it's served from the vDSO without entering the kernel.
+    return hzl_OsClockMillis(timestamp, CLOCK_MONOTONIC);
+}
+
+hzl_Err_t
+hzl_OsCurrentTimeCoarse(hzl_Timestamp_t* const timestamp)
+{
+#if defined(CLOCK_MONOTONIC_COARSE)
+    // Linux-only: the time of the last scheduler tick, cached by the kernel, so
+    // it's cheaper to read, but with the resolution of a tick (1-10 ms).
+    return hzl_OsClockMillis(timestamp, CLOCK_MONOTONIC_COARSE);
+#else
+    return hzl_OsClockMillis(timestamp, CLOCK_MONOTONIC);
+#endif
+}
+
+#else
+
 hzl_Err_t
 hzl_OsCurrentTime(hzl_Timestamp_t* const timestamp)
 {
@@ -92,6 +159,8 @@ hzl_OsCurrentTime(hzl_Timestamp_t* const timestamp)
     struct timeval now;
     // gettimeofday provides the amount of seconds.microseconds since
     // 1970-01-01T00:00:00.000 UTC, a.k.a. Epoch, a.k.a. Unix time.
+    // Used only on systems without a monotonic clock, as it jumps whenever
+    // the system time is changed.
     if (gettimeofday(&now, NULL) == 0)
     {
         // Convert seconds and remainder microseconds since Unix Epoch to milliseconds since it.
@@ -108,4 +177,12 @@ hzl_OsCurrentTime(hzl_Timestamp_t* const timestamp)
     }
 }
 
+hzl_Err_t
+hzl_OsCurrentTimeCoarse(hzl_Timestamp_t* const timestamp)
+{
+    return hzl_OsCurrentTime(timestamp);
+}
+
+#endif  /* CLOCK_MONOTONIC */
+
 #endif
@@ -54,8 +54,20 @@ hzl_OsTrng(uint8_t* const buffer, const size_t amount)
 
 #elif HZL_OS_AVAILABLE_NIX
 
-hzl_Err_t
-hzl_OsTrng(uint8_t* const buffer, const size_t amount)
+#if defined(__linux__)
+#include <sys/random.h> /* For getrandom() */
+#include <errno.h> /* For errno, EINTR */
+#endif
+
+/**
+ * @internal
+ * Reads the random bytes from /dev/urandom through stdio.
+ *
+ * Opens and closes the file on every call, which is slow, but works on
+ * any Unix-like system.
+ */
+static hzl_Err_t
+hzl_OsTrngUrandomFile(uint8_t* const buffer, const size_t amount)
 {
     FILE* urandom = fopen("/dev/urandom", "r");
     size_t obtained = 0;
@@ -71,4 +83,38 @@ hzl_OsTrng(uint8_t* const buffer, const size_t amount)
     }
 }
 
+#if defined(__linux__)
+
+hzl_Err_t
+hzl_OsTrng(uint8_t* const buffer, const size_t amount)
+{
+    // getrandom() draws from the same source as /dev/urandom with a single
+    // syscall, without file descriptors nor stdio buffering. Requests up to
+    // 256 B are never partial, but the loop handles interruptions by signals
+    // before the kernel entropy pool is initialised anyhow.
+    size_t obtained = 0;
+    while (obtained < amount)
+    {
+        const ssize_t result = getrandom(&buffer[obtained], amount - obtained, 0U);
+        if (result > 0) { obtained += (size_t) result; }
+        else if (result < 0 && errno == ENOSYS)
+        {
+            // Kernel older than 3.17
+            return hzl_OsTrngUrandomFile(&buffer[obtained], amount - obtained);
+        }
+        else if (result < 0 && errno != EINTR) { return HZL_ERR_CANNOT_GENERATE_RANDOM; }
+    }
+    return HZL_OK;
+}
+
+#else
+
+hzl_Err_t
+hzl_OsTrng(uint8_t* const buffer, const size_t amount)
+{
+    return hzl_OsTrngUrandomFile(buffer, amount);
+}
+
+#endif
+
 #endif
@@ -41,32 +41,47 @@ hzl_CommonCheckMsgBeforePacking(const uint8_t* const userData,
                                 const size_t userDataLen,
                                 const hzl_Gid_t group,
                                 const size_t metadataInPayloadLen,
-                                const uint8_t headerType)
+                                const hzl_HeaderCodec_t* const header)
 {
     if (userData == NULL && userDataLen != 0) { return HZL_ERR_NULL_SDU; }
-    const hzl_Gid_t maxGid = hzl_HeaderTypeMaxGid(headerType);
+    if (!hzl_HeaderCodecIsInitialised(header)) { return HZL_ERR_CTX_NOT_INITIALISED; }
+    const hzl_Gid_t maxGid = hzl_HeaderCodecMaxGid(header);
     if (group > maxGid) { return HZL_ERR_GID_TOO_LARGE_FOR_CONFIGURED_HEADER_TYPE; }
-    const uint8_t packedHdrLen = hzl_HeaderLen(headerType);
+    const uint8_t packedHdrLen = hzl_HeaderCodecPayloadLen(header);
     const size_t maxDataLen = HZL_MAX_CAN_FD_DATA_LEN - packedHdrLen - metadataInPayloadLen;
     if (userDataLen > maxDataLen) { return HZL_ERR_TOO_LONG_SDU; }
     return HZL_OK;
 }
 
 
+hzl_Err_t
+hzl_CommonUnpackHeader(hzl_Header_t* const unpackedHdr,
+                       const uint8_t* const receivedPdu,
+                       const size_t receivedPduLen,
+                       const hzl_CanId_t receivedCanId,
+                       const hzl_HeaderCodec_t* const header)
+{
+    if (receivedPdu == NULL && receivedPduLen != 0) { return HZL_ERR_NULL_PDU; }
+    if (!hzl_HeaderCodecIsInitialised(header)) { return HZL_ERR_CTX_NOT_INITIALISED; }
+    const uint8_t packedHdrLen = hzl_HeaderCodecPayloadLen(header);
+    if (receivedPduLen < packedHdrLen) { return HZL_ERR_TOO_SHORT_PDU_TO_CONTAIN_HEADER; }
+    hzl_HeaderCodecUnpack(header, unpackedHdr, receivedCanId, receivedPdu);
+    return HZL_OK;
+}
+
 /** @internal Verifies the basic integirty of the message data structure (NULL pointers,
  * minimum and maximum sizes). */
 hzl_Err_t
 hzl_CommonCheckReceivedGenericMsg(hzl_Header_t* const unpackedHdr,
                                   const uint8_t* const receivedPdu,
                                   const size_t receivedPduLen,
+                                  const hzl_CanId_t receivedCanId,
                                   const hzl_Sid_t receiverSid,
-                                  const uint8_t headerType)
+                                  const hzl_HeaderCodec_t* const header)
 {
-    if (receivedPdu == NULL && receivedPduLen != 0) { return HZL_ERR_NULL_PDU; }
-    const uint8_t packedHdrLen = hzl_HeaderLen(headerType);
-    if (receivedPduLen < packedHdrLen) { return HZL_ERR_TOO_SHORT_PDU_TO_CONTAIN_HEADER; }
-    hzl_HeaderUnpackFunc headerUnpackerFunc = hzl_HeaderUnpackFuncForType(headerType);
-    headerUnpackerFunc(unpackedHdr, receivedPdu);
+    HZL_ERR_DECLARE(err);
+    err = hzl_CommonUnpackHeader(unpackedHdr, receivedPdu, receivedPduLen, receivedCanId, header);
+    HZL_ERR_CHECK(err);
     if (unpackedHdr->sid == receiverSid) { return HZL_ERR_SECWARN_MESSAGE_FROM_MYSELF; }
     return HZL_OK;
 }
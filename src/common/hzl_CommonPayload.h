@@ -116,6 +116,17 @@ _Static_assert(HZL_RES_PAYLOAD_LEN == 44,
 _Static_assert(HZL_RES_AEADNONCE_RESNONCE_END <= HZL_AEAD_NONCE_LEN,
                "RES msg AEAD nonce is large enough to fit reqnonce||resnonce");
 
+// Associated data = label || GID || SID || PTY || clientSid || ctrnonce
+#define HZL_RES_AD_GID_IDX HZL_RES_LABEL_LEN
+#define HZL_RES_AD_SID_IDX (HZL_RES_AD_GID_IDX + HZL_GID_LEN)
+#define HZL_RES_AD_PTY_IDX (HZL_RES_AD_SID_IDX + HZL_SID_LEN)
+#define HZL_RES_AD_CLIENT_IDX (HZL_RES_AD_PTY_IDX + HZL_PTY_LEN)
+#define HZL_RES_AD_CTRNONCE_IDX (HZL_RES_AD_CLIENT_IDX + HZL_RES_CLIENT_LEN)
+#define HZL_RES_AD_LEN (HZL_RES_AD_CTRNONCE_IDX + HZL_RES_CTRNONCE_LEN)
+
+_Static_assert(HZL_RES_AD_LEN == 19,
+               "RES msg associated data must be exactly 19 bytes long");
+
 // Session Renewal Notification (REN)
 #define HZL_REN_LABEL "cbs_renewal"
 #define HZL_REN_LABEL_LEN 11U
@@ -178,6 +189,64 @@ _Static_assert(HZL_SADFD_PAYLOAD_LEN(0) == 12,
 _Static_assert(HZL_SADFD_AEADNONCE_SID_END <= HZL_AEAD_NONCE_LEN,
                "SAD msg AEAD nonce is large enough to fit ctrnonce||GID||SID");
 
+// Associated data = label || GID || SID || PTY || ptlen
+#define HZL_SADFD_AD_GID_IDX HZL_SADFD_LABEL_LEN
+#define HZL_SADFD_AD_SID_IDX (HZL_SADFD_AD_GID_IDX + HZL_GID_LEN)
+#define HZL_SADFD_AD_PTY_IDX (HZL_SADFD_AD_SID_IDX + HZL_SID_LEN)
+#define HZL_SADFD_AD_PTLEN_IDX (HZL_SADFD_AD_PTY_IDX + HZL_PTY_LEN)
+#define HZL_SADFD_AD_LEN (HZL_SADFD_AD_PTLEN_IDX + HZL_SADFD_PTLEN_LEN)
+
+_Static_assert(HZL_SADFD_AD_LEN == 18,
+               "SADFD msg associated data must be exactly 18 bytes long");
+
+// Secured Application Data over Transport Protocol (SADTP)
+// Every fragment: ctrnonce || fragment index || [ptlen, first fragment only] || stream chunk
+// where the stream is ctext || tag, split across the fragments in order.
+#define HZL_SADTP_LABEL "cbs_secured_tp"
+#define HZL_SADTP_LABEL_LEN 14U
+
+#define HZL_SADTP_CTRNONCE_IDX 0U
+#define HZL_SADTP_CTRNONCE_LEN HZL_CTRNONCE_LEN
+#define HZL_SADTP_CTRNONCE_END (HZL_SADTP_CTRNONCE_IDX + HZL_SADTP_CTRNONCE_LEN)
+
+#define HZL_SADTP_FRAGIDX_IDX HZL_SADTP_CTRNONCE_END
+#define HZL_SADTP_FRAGIDX_LEN 1U
+#define HZL_SADTP_FRAGIDX_END (HZL_SADTP_FRAGIDX_IDX + HZL_SADTP_FRAGIDX_LEN)
+
+#define HZL_SADTP_PTLEN_IDX HZL_SADTP_FRAGIDX_END
+#define HZL_SADTP_PTLEN_LEN 2U
+#define HZL_SADTP_PTLEN_END (HZL_SADTP_PTLEN_IDX + HZL_SADTP_PTLEN_LEN)
+
+/** Metadata preceding the stream chunk in the first fragment. */
+#define HZL_SADTP_FIRST_METADATA_LEN HZL_SADTP_PTLEN_END
+/** Metadata preceding the stream chunk in any other fragment. */
+#define HZL_SADTP_NEXT_METADATA_LEN HZL_SADTP_FRAGIDX_END
+
+// Associated data = label || GID || SID || PTY || ptlen
+#define HZL_SADTP_AD_GID_IDX HZL_SADTP_LABEL_LEN
+#define HZL_SADTP_AD_SID_IDX (HZL_SADTP_AD_GID_IDX + HZL_GID_LEN)
+#define HZL_SADTP_AD_PTY_IDX (HZL_SADTP_AD_SID_IDX + HZL_SID_LEN)
+#define HZL_SADTP_AD_PTLEN_IDX (HZL_SADTP_AD_PTY_IDX + HZL_PTY_LEN)
+#define HZL_SADTP_AD_LEN (HZL_SADTP_AD_PTLEN_IDX + HZL_SADTP_PTLEN_LEN)
+
+_Static_assert(HZL_SADTP_FIRST_METADATA_LEN == 6,
+               "First SADTP fragment must have exactly 6 bytes of metadata");
+_Static_assert(HZL_SADTP_MAX_AMOUNT_OF_FRAGMENTS - 1U <= UINT8_MAX,
+               "The SADTP fragment index must fit into its field");
+_Static_assert(HZL_SADTP_AMOUNT_OF_PDUS(0) == 1U
+               && HZL_SADTP_AMOUNT_OF_PDUS(64U - 3U - HZL_SADTP_FIRST_METADATA_LEN
+                                           - HZL_SADTP_TAG_LEN) == 1U
+               && HZL_SADTP_AMOUNT_OF_PDUS(64U - 3U - HZL_SADTP_FIRST_METADATA_LEN
+                                           - HZL_SADTP_TAG_LEN + 1U) == 2U,
+               "HZL_SADTP_AMOUNT_OF_PDUS() must match the SADTP layout with a 3 B header");
+_Static_assert(HZL_SADTP_AMOUNT_OF_PDUS(HZL_SADTP_MAX_DATA_LEN)
+               == HZL_SADTP_MAX_AMOUNT_OF_FRAGMENTS
+               && HZL_SADTP_AMOUNT_OF_PDUS(HZL_SADTP_MAX_DATA_LEN + 1U)
+                  > HZL_SADTP_MAX_AMOUNT_OF_FRAGMENTS,
+               "HZL_SADTP_MAX_DATA_LEN must fill all SADTP fragments with a 3 B header");
+_Static_assert(HZL_SADTP_MAX_DATA_LEN <= UINT16_MAX,
+               "The SADTP plaintext length must fit into its field");
+
 #ifdef __cplusplus
 }
 #endif
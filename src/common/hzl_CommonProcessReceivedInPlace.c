@@ -0,0 +1,68 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Helpers of the in-place processing of received messages, shared by
+ * hzl_ClientProcessReceivedInPlace() and hzl_ServerProcessReceivedInPlace().
+ */
+
+#include "hzl_CommonHeader.h"
+#include "hzl_CommonMessage.h"
+
+hzl_Err_t
+hzl_CommonProcessReceivedUnsecuredInPlace(hzl_RxSduView_t* const view,
+                                          const uint8_t* const rxPdu,
+                                          const size_t rxPduLen,
+                                          const hzl_Header_t* const unpackedUadHeader,
+                                          const hzl_HeaderCodec_t* const header)
+{
+    view->wasSecured = false;
+    view->isForUser = true;
+    view->gid = unpackedUadHeader->gid;
+    view->sid = unpackedUadHeader->sid;
+    const uint8_t packedHdrLen = hzl_HeaderCodecPayloadLen(header);
+    view->dataLen = rxPduLen - packedHdrLen;
+    view->data = rxPdu + packedHdrLen;
+    return HZL_OK;
+}
+
+void
+hzl_CommonRxViewOfMsg(hzl_RxSduView_t* const view,
+                      const hzl_RxSduMsg_t* const metadata,
+                      const uint8_t* const data)
+{
+    if (!metadata->isForUser) { return; }
+    view->dataLen = metadata->dataLen;
+    view->gid = metadata->gid;
+    view->sid = metadata->sid;
+    view->wasSecured = metadata->wasSecured;
+    view->isForUser = true;
+    view->data = data;
+}
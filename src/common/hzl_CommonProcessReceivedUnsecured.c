@@ -39,13 +39,13 @@ hzl_CommonProcessReceivedUnsecured(hzl_RxSduMsg_t* const unpackedMsg,
                                    const uint8_t* const rxPdu,
                                    const size_t rxPduLen,
                                    const hzl_Header_t* const unpackedUadHeader,
-                                   const uint8_t headerType)
+                                   const hzl_HeaderCodec_t* const header)
 {
     unpackedMsg->wasSecured = false;
     unpackedMsg->isForUser = true;
     unpackedMsg->gid = unpackedUadHeader->gid;
     unpackedMsg->sid = unpackedUadHeader->sid;
-    const uint8_t packedHdrLen = hzl_HeaderLen(headerType);
+    const uint8_t packedHdrLen = hzl_HeaderCodecPayloadLen(header);
     unpackedMsg->dataLen = rxPduLen - packedHdrLen;
     memcpy(unpackedMsg->data, rxPdu + packedHdrLen, unpackedMsg->dataLen);
     return HZL_OK;
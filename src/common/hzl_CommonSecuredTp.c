@@ -0,0 +1,487 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Segmentation and reassembly of the Secured Application Data over Transport Protocol
+ * (SADTP) messages, shared by the Client and Server.
+ *
+ * The `ciphertext || tag` stream of an SADTP message is split across consecutive fragments,
+ * each prefixed by the Counter Nonce of the message and the index of the fragment.
+ * The first fragment also carries the plaintext length, so the receiver knows where the
+ * ciphertext ends and the tag starts.
+ * The AEAD cipher runs over the fragments as they are built or received, so the message
+ * is never buffered whole in ciphertext form.
+ */
+
+#include "hzl.h"
+#include "hzl_CommonMessage.h"
+#include "hzl_CommonEndian.h"
+#include "hzl_CommonPayload.h"
+
+_Static_assert(sizeof(hzl_Aead_t) <= HZL_SADTP_AEAD_STATE_WORDS * sizeof(uint64_t),
+               "The AEAD state must fit into the SADTP reception buffer.");
+
+/**
+ * @internal
+ * Amount of plaintext bytes encrypted at once when building an SADTP message.
+ * Kept smaller than a frame, as the AEAD may output up to 7 previously-buffered bytes more
+ * than its input.
+ */
+#define HZL_SADTP_TX_PIECE_LEN 56U
+
+#ifdef HZL_THREAD_SAFE
+/** @internal Each thread counts its own receiving calls. */
+#define HZL_SADTP_RX_CALLS_STORAGE static _Thread_local
+#else
+#define HZL_SADTP_RX_CALLS_STORAGE static
+#endif
+
+/**
+ * @internal
+ * Amount of receiving calls of the API made so far by this thread.
+ * A complete SADTP message keeps its buffer reserved while the thread is still in the call
+ * that returned it, or has not made another one yet: its address tells the threads apart,
+ * its value the calls.
+ */
+HZL_SADTP_RX_CALLS_STORAGE uint32_t hzl_sadtpRxCalls = 0U;
+
+/** @internal Where the next bytes of the `ciphertext || tag` stream are written. */
+typedef struct hzl_SadtpTxStream
+{
+    hzl_CbsPduMsg_t* nextPdu;
+    hzl_CbsPduMsg_t* currentPdu;
+    const hzl_Header_t* unpackedSadtpHeader;
+    const hzl_HeaderCodec_t* header;
+    hzl_CtrNonce_t ctrnonce;
+    uint8_t packedHdrLen;
+    uint8_t nextFragmentIdx;
+} hzl_SadtpTxStream_t;
+
+void
+hzl_CommonAeadInitSadtp(hzl_Aead_t* const aead,
+                        const uint8_t* const stk,
+                        const hzl_Header_t* const unpackedSadtpHeader,
+                        const hzl_CtrNonce_t ctrnonce,
+                        const uint16_t plaintextLen)
+{
+    // Authenticated en/decryption initialisation with:
+    // aeadKey = currentStk
+    // aeadNonce = ctrnonce || GID || SID || 0...0 (the zero-padding IS required)
+    uint8_t aeadNonce[HZL_AEAD_NONCE_LEN] = {0};
+    hzl_EncodeLe24(&aeadNonce[HZL_SADFD_AEADNONCE_CTR_IDX], ctrnonce);
+    aeadNonce[HZL_SADFD_AEADNONCE_GID_IDX] = unpackedSadtpHeader->gid;
+    aeadNonce[HZL_SADFD_AEADNONCE_SID_IDX] = unpackedSadtpHeader->sid;
+    hzl_AeadInit(aead, stk, aeadNonce);
+
+    // Associated data = label || GID || SID || PTY || ptlen
+    // packed contiguously to be absorbed with a single update.
+    uint8_t assocData[HZL_SADTP_AD_LEN];
+    memcpy(assocData, HZL_SADTP_LABEL, HZL_SADTP_LABEL_LEN);
+    assocData[HZL_SADTP_AD_GID_IDX] = unpackedSadtpHeader->gid;
+    assocData[HZL_SADTP_AD_SID_IDX] = unpackedSadtpHeader->sid;
+    assocData[HZL_SADTP_AD_PTY_IDX] = unpackedSadtpHeader->pty;
+    hzl_EncodeLe16(&assocData[HZL_SADTP_AD_PTLEN_IDX], plaintextLen);
+    hzl_AeadAssocDataUpdate(aead, assocData, HZL_SADTP_AD_LEN);
+}
+
+/** @internal Amount of fragments required for the message, 0 if it's too long to transmit. */
+static size_t
+hzl_CommonSadtpAmountOfPdus(const size_t userDataLen,
+                            const uint8_t packedHdrLen)
+{
+    if (userDataLen > HZL_SADTP_MAX_DATA_LEN) { return 0U; }
+    const size_t streamLenPerPdu =
+            HZL_MAX_CAN_FD_DATA_LEN - packedHdrLen - HZL_SADTP_NEXT_METADATA_LEN;
+    // The first fragment carries the ptlen field too, so it fits that much less stream
+    const size_t streamLen = userDataLen + HZL_SADTP_TAG_LEN + HZL_SADTP_PTLEN_LEN;
+    const size_t amountOfPdus = (streamLen + streamLenPerPdu - 1U) / streamLenPerPdu;
+    if (amountOfPdus > HZL_SADTP_MAX_AMOUNT_OF_FRAGMENTS) { return 0U; }
+    return amountOfPdus;
+}
+
+hzl_Err_t
+hzl_CommonSadtpCheckMsgBeforePacking(size_t* const requiredPdus,
+                                     const uint8_t* const userData,
+                                     const size_t userDataLen,
+                                     const hzl_Gid_t group,
+                                     const size_t availablePdus,
+                                     const hzl_HeaderCodec_t* const header)
+{
+    if (userData == NULL && userDataLen != 0) { return HZL_ERR_NULL_SDU; }
+    if (!hzl_HeaderCodecIsInitialised(header)) { return HZL_ERR_CTX_NOT_INITIALISED; }
+    const hzl_Gid_t maxGid = hzl_HeaderCodecMaxGid(header);
+    if (group > maxGid) { return HZL_ERR_GID_TOO_LARGE_FOR_CONFIGURED_HEADER_TYPE; }
+    *requiredPdus = hzl_CommonSadtpAmountOfPdus(userDataLen, hzl_HeaderCodecPayloadLen(header));
+    if (*requiredPdus == 0U || *requiredPdus > availablePdus) { return HZL_ERR_TOO_LONG_SDU; }
+    return HZL_OK;
+}
+
+/** @internal Packs the header and metadata of the next fragment, making it current. */
+static void
+hzl_CommonSadtpTxStartFragment(hzl_SadtpTxStream_t* const stream)
+{
+    hzl_CbsPduMsg_t* const pdu = stream->nextPdu++;
+    hzl_HeaderCodecPack(stream->header, &pdu->canId, pdu->data, stream->unpackedSadtpHeader);
+    hzl_EncodeLe24(&pdu->data[stream->packedHdrLen + HZL_SADTP_CTRNONCE_IDX], stream->ctrnonce);
+    pdu->data[stream->packedHdrLen + HZL_SADTP_FRAGIDX_IDX] = stream->nextFragmentIdx++;
+    pdu->dataLen = stream->packedHdrLen + HZL_SADTP_NEXT_METADATA_LEN;
+    stream->currentPdu = pdu;
+}
+
+/** @internal Appends bytes to the `ciphertext || tag` stream, starting new fragments as
+ * the current one fills up. */
+static void
+hzl_CommonSadtpTxWrite(hzl_SadtpTxStream_t* const stream,
+                       const uint8_t* bytes,
+                       size_t amount)
+{
+    while (amount > 0U)
+    {
+        if (stream->currentPdu->dataLen == HZL_MAX_CAN_FD_DATA_LEN)
+        {
+            hzl_CommonSadtpTxStartFragment(stream);
+        }
+        size_t chunkLen = HZL_MAX_CAN_FD_DATA_LEN - stream->currentPdu->dataLen;
+        if (chunkLen > amount) { chunkLen = amount; }
+        memcpy(&stream->currentPdu->data[stream->currentPdu->dataLen], bytes, chunkLen);
+        stream->currentPdu->dataLen += chunkLen;
+        bytes += chunkLen;
+        amount -= chunkLen;
+    }
+}
+
+void
+hzl_CommonBuildSecuredTp(hzl_CbsPduMsg_t* const securedPdus,
+                         const uint8_t* const userData,
+                         const size_t userDataLen,
+                         const uint8_t* const stk,
+                         const hzl_Header_t* const unpackedSadtpHeader,
+                         const hzl_CtrNonce_t ctrnonce,
+                         const hzl_HeaderCodec_t* const header)
+{
+    const uint8_t packedHdrLen = hzl_HeaderCodecPayloadLen(header);
+    hzl_SadtpTxStream_t stream = {
+            .nextPdu = securedPdus,
+            .currentPdu = NULL,
+            .unpackedSadtpHeader = unpackedSadtpHeader,
+            .header = header,
+            .ctrnonce = ctrnonce,
+            .packedHdrLen = packedHdrLen,
+            .nextFragmentIdx = 0U,
+    };
+    hzl_CommonSadtpTxStartFragment(&stream);
+    hzl_EncodeLe16(&securedPdus[0].data[packedHdrLen + HZL_SADTP_PTLEN_IDX],
+                   (uint16_t) userDataLen);
+    securedPdus[0].dataLen = packedHdrLen + HZL_SADTP_FIRST_METADATA_LEN;
+    hzl_Aead_t aead;
+    hzl_CommonAeadInitSadtp(&aead, stk, unpackedSadtpHeader, ctrnonce, (uint16_t) userDataLen);
+    // The ciphertext goes through a small buffer, as the AEAD outputs it contiguously,
+    // while in the stream it may span two fragments.
+    uint8_t ciphertext[HZL_MAX_CAN_FD_DATA_LEN];
+    size_t encryptedLen = 0U;
+    size_t writtenCiphertextLen = 0U;
+    while (encryptedLen < userDataLen)
+    {
+        size_t pieceLen = userDataLen - encryptedLen;
+        if (pieceLen > HZL_SADTP_TX_PIECE_LEN) { pieceLen = HZL_SADTP_TX_PIECE_LEN; }
+        const size_t ciphertextLen = hzl_AeadEncryptUpdate(
+                &aead, ciphertext, &userData[encryptedLen], pieceLen);
+        hzl_CommonSadtpTxWrite(&stream, ciphertext, ciphertextLen);
+        encryptedLen += pieceLen;
+        writtenCiphertextLen += ciphertextLen;
+    }
+    // Finish authenticated encryption, flushing the last ciphertext bytes, and write the tag
+    uint8_t tag[HZL_SADTP_TAG_LEN];
+    hzl_AeadEncryptFinish(&aead, ciphertext, tag, HZL_SADTP_TAG_LEN);
+    hzl_CommonSadtpTxWrite(&stream, ciphertext,
+                           HZL_AEAD_PTLEN_TO_CTLEN(userDataLen) - writtenCiphertextLen);
+    hzl_CommonSadtpTxWrite(&stream, tag, HZL_SADTP_TAG_LEN);
+}
+
+hzl_Err_t
+hzl_CommonSadtpCheckRxBuffers(const hzl_SadtpRxBuffer_t* const buffers,
+                              const size_t amountOfBuffers)
+{
+    if (buffers == NULL)
+    {
+        return amountOfBuffers == 0U ? HZL_OK : HZL_ERR_NULL_SADTP_RX_BUFFERS;
+    }
+    for (size_t i = 0U; i < amountOfBuffers; i++)
+    {
+        if (buffers[i].data == NULL && buffers[i].capacity != 0U)
+        {
+            return HZL_ERR_NULL_SADTP_RX_BUFFERS;
+        }
+    }
+    return HZL_OK;
+}
+
+/** @internal Clears the internal state of the buffer, keeping the fields set by the user. */
+static void
+hzl_CommonSadtpRxClearInternals(hzl_SadtpRxBuffer_t* const buffer)
+{
+    uint8_t* const data = buffer->data;
+    const size_t capacity = buffer->capacity;
+    hzl_ZeroOut(buffer, sizeof(hzl_SadtpRxBuffer_t));
+    buffer->data = data;
+    buffer->capacity = capacity;
+}
+
+void
+hzl_CommonSadtpRxClearAll(hzl_SadtpRxBuffer_t* const buffers,
+                          const size_t amountOfBuffers)
+{
+    if (buffers == NULL) { return; }
+    for (size_t i = 0U; i < amountOfBuffers; i++)
+    {
+        if (buffers[i].data != NULL) { hzl_ZeroOut(buffers[i].data, buffers[i].capacity); }
+        hzl_CommonSadtpRxClearInternals(&buffers[i]);
+    }
+}
+
+/** @internal Discards the message being reassembled, erasing its unvalidated plaintext. */
+static void
+hzl_CommonSadtpRxDiscard(hzl_SadtpRxBuffer_t* const buffer)
+{
+    if (buffer->data != NULL) { hzl_ZeroOut(buffer->data, buffer->decryptedLen); }
+    hzl_CommonSadtpRxClearInternals(buffer);
+}
+
+hzl_Err_t
+hzl_CommonSadtpParseFragment(hzl_SadtpFragment_t* const fragment,
+                             const uint8_t* const rxPdu,
+                             const size_t rxPduLen,
+                             const uint8_t packedHdrLen)
+{
+    if (rxPduLen < packedHdrLen + HZL_SADTP_NEXT_METADATA_LEN)
+    {
+        return HZL_ERR_TOO_SHORT_PDU_TO_CONTAIN_SADTP;
+    }
+    if (rxPduLen > HZL_MAX_CAN_FD_DATA_LEN)
+    {
+        // The chunk would be longer than any fragment can carry.
+        return HZL_ERR_TOO_LONG_CIPHERTEXT;
+    }
+    fragment->ctrnonce = hzl_DecodeLe24(&rxPdu[packedHdrLen + HZL_SADTP_CTRNONCE_IDX]);
+    fragment->idx = rxPdu[packedHdrLen + HZL_SADTP_FRAGIDX_IDX];
+    size_t metadataLen = HZL_SADTP_NEXT_METADATA_LEN;
+    fragment->plaintextLen = 0U;
+    if (fragment->idx == 0U)
+    {
+        if (rxPduLen < packedHdrLen + HZL_SADTP_FIRST_METADATA_LEN)
+        {
+            return HZL_ERR_TOO_SHORT_PDU_TO_CONTAIN_SADTP;
+        }
+        fragment->plaintextLen = hzl_DecodeLe16(&rxPdu[packedHdrLen + HZL_SADTP_PTLEN_IDX]);
+        metadataLen = HZL_SADTP_FIRST_METADATA_LEN;
+    }
+    fragment->chunk = &rxPdu[packedHdrLen + metadataLen];
+    fragment->chunkLen = rxPduLen - packedHdrLen - metadataLen;
+    return HZL_OK;
+}
+
+void
+hzl_CommonSadtpRxCallBegin(void)
+{
+    hzl_sadtpRxCalls++;
+}
+
+/** @internal True if the buffer holds a complete message which this thread returned in an
+ * earlier receiving call, so the user is not reading it anymore. */
+static bool
+hzl_CommonSadtpRxIsReleasable(const hzl_SadtpRxBuffer_t* const buffer)
+{
+    return buffer->holder == &hzl_sadtpRxCalls && buffer->holderCall != hzl_sadtpRxCalls;
+}
+
+/** @internal True if the buffer received no fragments for too long to be still waited for,
+ * according to the Max Silence Interval of the Group of its own message.
+ * Never for a fragment received after \p now, e.g. by another thread with a fresher
+ * timestamp. */
+static bool
+hzl_CommonSadtpRxIsStale(const hzl_SadtpRxBuffer_t* const buffer,
+                         const hzl_Timestamp_t now)
+{
+    const hzl_TimeDeltaMillis_t silence = hzl_TimeDelta(buffer->lastFragmentInstant, now);
+    return silence > buffer->maxSilenceIntervalMillis
+           && silence <= (hzl_TimeDeltaMillis_t) INT32_MAX;
+}
+
+hzl_Err_t
+hzl_CommonSadtpRxStart(hzl_SadtpRxBuffer_t** const selected,
+                       hzl_SadtpRxBuffer_t* const buffers,
+                       const size_t amountOfBuffers,
+                       const hzl_Header_t* const unpackedSadtpHeader,
+                       const hzl_SadtpFragment_t* const fragment,
+                       const uint8_t* const stk,
+                       const bool isPreviousSession,
+                       const hzl_Timestamp_t rxTimestamp,
+                       const uint16_t maxSilenceIntervalMillis)
+{
+    *selected = NULL;
+    for (size_t i = 0U; i < amountOfBuffers; i++)
+    {
+        hzl_SadtpRxBuffer_t* const buffer = &buffers[i];
+        if (buffer->isInUse
+            && ((buffer->gid == unpackedSadtpHeader->gid
+                 && buffer->sid == unpackedSadtpHeader->sid)
+                || hzl_CommonSadtpRxIsStale(buffer, rxTimestamp)))
+        {
+            // A new message from the same Source and Group replaces its unfinished one,
+            // as the fragments are transmitted in order: the rest will never arrive.
+            hzl_CommonSadtpRxDiscard(buffer);
+        }
+        if (hzl_CommonSadtpRxIsReleasable(buffer))
+        {
+            // The complete message was returned to the user by an earlier call. Those of
+            // the current call (earlier in the same batch) and of other threads are kept.
+            hzl_CommonSadtpRxDiscard(buffer);
+        }
+        if (*selected == NULL && !buffer->isInUse && buffer->holder == NULL
+            && buffer->capacity >= fragment->plaintextLen)
+        {
+            *selected = buffer;
+        }
+    }
+    if (*selected == NULL) { return HZL_ERR_SADTP_NO_FREE_RX_BUFFER; }
+    hzl_SadtpRxBuffer_t* const buffer = *selected;
+    hzl_CommonSadtpRxClearInternals(buffer);
+    hzl_Aead_t aead;
+    hzl_CommonAeadInitSadtp(&aead, stk, unpackedSadtpHeader,
+                            fragment->ctrnonce, fragment->plaintextLen);
+    memcpy(buffer->aeadState, &aead, sizeof(aead));
+    hzl_ZeroOut(&aead, sizeof(aead));
+    buffer->lastFragmentInstant = rxTimestamp;
+    buffer->maxSilenceIntervalMillis = maxSilenceIntervalMillis;
+    buffer->ctrnonce = fragment->ctrnonce;
+    buffer->dataLen = fragment->plaintextLen;
+    buffer->gid = unpackedSadtpHeader->gid;
+    buffer->sid = unpackedSadtpHeader->sid;
+    buffer->isInUse = true;
+    buffer->isPreviousSession = isPreviousSession;
+    return HZL_OK;
+}
+
+hzl_Err_t
+hzl_CommonSadtpRxContinue(hzl_SadtpRxBuffer_t** const selected,
+                          hzl_SadtpRxBuffer_t* const buffers,
+                          const size_t amountOfBuffers,
+                          const hzl_Header_t* const unpackedSadtpHeader,
+                          const hzl_SadtpFragment_t* const fragment,
+                          const hzl_Timestamp_t rxTimestamp)
+{
+    *selected = NULL;
+    for (size_t i = 0U; i < amountOfBuffers; i++)
+    {
+        hzl_SadtpRxBuffer_t* const buffer = &buffers[i];
+        if (buffer->isInUse
+            && buffer->gid == unpackedSadtpHeader->gid
+            && buffer->sid == unpackedSadtpHeader->sid)
+        {
+            if (buffer->ctrnonce != fragment->ctrnonce
+                || buffer->nextFragmentIdx != fragment->idx
+                || hzl_CommonSadtpRxIsStale(buffer, rxTimestamp))
+            {
+                // A fragment went missing: the message cannot be completed anymore.
+                hzl_CommonSadtpRxDiscard(buffer);
+                return HZL_ERR_SADTP_UNEXPECTED_FRAGMENT;
+            }
+            *selected = buffer;
+            return HZL_OK;
+        }
+    }
+    return HZL_ERR_SADTP_UNEXPECTED_FRAGMENT;
+}
+
+hzl_Err_t
+hzl_CommonSadtpRxAppend(bool* const isComplete,
+                        hzl_SadtpRxBuffer_t* const buffer,
+                        const hzl_SadtpFragment_t* const fragment,
+                        const hzl_Timestamp_t rxTimestamp)
+{
+    HZL_ERR_DECLARE(err);
+    *isComplete = false;
+    const size_t ciphertextLen = HZL_AEAD_PTLEN_TO_CTLEN((size_t) buffer->dataLen);
+    const size_t streamLen = ciphertextLen + HZL_SADTP_TAG_LEN;
+    if (fragment->chunkLen > streamLen - buffer->receivedLen)
+    {
+        // More data than the first fragment announced: the message is malformed.
+        hzl_CommonSadtpRxDiscard(buffer);
+        return HZL_ERR_TOO_LONG_CIPHERTEXT;
+    }
+    // Split the chunk into the part of the ciphertext, decrypted straight into the user's
+    // buffer, and the part of the tag, collected until complete.
+    size_t ciphertextChunkLen = 0U;
+    if (buffer->receivedLen < ciphertextLen)
+    {
+        ciphertextChunkLen = ciphertextLen - buffer->receivedLen;
+        if (ciphertextChunkLen > fragment->chunkLen) { ciphertextChunkLen = fragment->chunkLen; }
+    }
+    hzl_Aead_t aead;
+    memcpy(&aead, buffer->aeadState, sizeof(aead));
+    buffer->decryptedLen += hzl_AeadDecryptUpdate(
+            &aead,
+            &buffer->data[buffer->decryptedLen],  // Output: plaintext
+            fragment->chunk,  // Input: ciphertext
+            ciphertextChunkLen);
+    const size_t tagChunkLen = fragment->chunkLen - ciphertextChunkLen;
+    if (tagChunkLen > 0U)
+    {
+        memcpy(&buffer->tag[buffer->receivedLen + ciphertextChunkLen - ciphertextLen],
+               &fragment->chunk[ciphertextChunkLen], tagChunkLen);
+    }
+    buffer->receivedLen += fragment->chunkLen;
+    buffer->nextFragmentIdx++;
+    buffer->lastFragmentInstant = rxTimestamp;
+    if (buffer->receivedLen < streamLen)
+    {
+        memcpy(buffer->aeadState, &aead, sizeof(aead));
+        hzl_ZeroOut(&aead, sizeof(aead));
+        return HZL_OK;
+    }
+    // Finish authenticated decryption and validate tag
+    err = hzl_AeadDecryptFinish(&aead, &buffer->data[buffer->decryptedLen],
+                                buffer->tag, HZL_SADTP_TAG_LEN);
+    buffer->decryptedLen = buffer->dataLen;
+    if (err != HZL_OK)
+    {
+        // Same as for SADFD messages: erase anything decrypted so far, as it's not valid.
+        hzl_CommonSadtpRxDiscard(buffer);
+        return err;
+    }
+    // Keep the plaintext for the user, clearing anything else, and the buffer reserved
+    // for it until the next receiving call of this thread
+    buffer->isInUse = false;
+    buffer->holder = &hzl_sadtpRxCalls;
+    buffer->holderCall = hzl_sadtpRxCalls;
+    hzl_ZeroOut(buffer->aeadState, sizeof(buffer->aeadState));
+    *isComplete = true;
+    return HZL_OK;
+}
@@ -37,11 +37,24 @@
 bool
 hzl_IsAllZeros(const uint8_t* bytes, size_t amount)
 {
+    // OR-reduction of all bytes without early exit: the runtime depends only
+    // on the amount of bytes, not on their values. Full words are loaded with
+    // memcpy(), which compilers turn into plain (possibly unaligned) loads.
+    uint64_t accumulatedWords = 0U;
+    while (amount >= sizeof(uint64_t))
+    {
+        uint64_t word;
+        memcpy(&word, bytes, sizeof(uint64_t));
+        accumulatedWords |= word;
+        bytes += sizeof(uint64_t);
+        amount -= sizeof(uint64_t);
+    }
+    uint8_t accumulatedBytes = 0U;
     while (amount--)
     {
-        if (*(bytes++) != 0U) { return false; }
+        accumulatedBytes |= *(bytes++);
     }
-    return true;
+    return (accumulatedWords | accumulatedBytes) == 0U;
 }
 
 hzl_Err_t
@@ -73,6 +86,13 @@ hzl_ZeroOut(void* const buffer, size_t amountOfBytes)
     // C11 standard function, guaranteed to set the memory and not to be optimised away by the
     // compiler, but noy many compilers implement it as of 2021.
     memset_s(buffer, amountOfBytes, 0, amountOfBytes);
+#elif defined(__GNUC__) || defined(__clang__)
+    // Plain memset() is word- or vector-wise in any decent C standard library.
+    // The empty assembly statement claims to read the buffer and clobber the
+    // memory, so the compiler must assume the zeros are observed and cannot
+    // elide the memset() as a dead store.
+    memset(buffer, 0, amountOfBytes);
+    __asm__ __volatile__("" : : "r"(buffer) : "memory");
 #else
     // Trying to cast the destination memory to volatile and writing manually,
     // but IT STILL MAY NOT WORK. See the following links for details
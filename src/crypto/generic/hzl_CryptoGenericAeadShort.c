@@ -0,0 +1,93 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Generic AEAD functions for short messages, for the crypto backends without their
+ * own: one-shot encryption and decryption and authenticated decryption of many
+ * independent messages, built on the streaming functions of the backend.
+ *
+ * Not part of any backend by default: list it among the `HZL_CRYPTO_BACKEND_SRC`
+ * of a custom backend implementing only the streaming functions.
+ * The messages of a batch are decrypted one after the other, thus the backend may
+ * define #HZL_AEAD_LANES as 1.
+ */
+
+#include "hzl_CommonAead.h"
+
+void
+hzl_AeadEncryptOneShot(uint8_t* const ciphertext,
+                       uint8_t* const tag,
+                       const uint8_t* const key,
+                       const uint8_t* const nonce,
+                       const uint8_t* const assocData,
+                       const size_t assocDataLen,
+                       const uint8_t* const plaintext,
+                       const size_t plaintextLen,
+                       const uint8_t tagLen)
+{
+    hzl_Aead_t aead;
+    hzl_AeadInit(&aead, key, nonce);
+    hzl_AeadAssocDataUpdate(&aead, assocData, assocDataLen);
+    const size_t written = hzl_AeadEncryptUpdate(&aead, ciphertext, plaintext, plaintextLen);
+    hzl_AeadEncryptFinish(&aead, &ciphertext[written], tag, tagLen);
+}
+
+hzl_Err_t
+hzl_AeadDecryptOneShot(uint8_t* const plaintext,
+                       const uint8_t* const key,
+                       const uint8_t* const nonce,
+                       const uint8_t* const assocData,
+                       const size_t assocDataLen,
+                       const uint8_t* const ciphertext,
+                       const size_t ciphertextLen,
+                       const uint8_t* const tag,
+                       const uint8_t tagLen)
+{
+    hzl_Aead_t aead;
+    hzl_AeadInit(&aead, key, nonce);
+    hzl_AeadAssocDataUpdate(&aead, assocData, assocDataLen);
+    const size_t written = hzl_AeadDecryptUpdate(&aead, plaintext, ciphertext, ciphertextLen);
+    const hzl_Err_t err = hzl_AeadDecryptFinish(&aead, &plaintext[written], tag, tagLen);
+    if (err != HZL_OK) { hzl_ZeroOut(plaintext, ciphertextLen); }
+    return err;
+}
+
+void
+hzl_AeadDecryptBatch(hzl_AeadJob_t* const jobs,
+                     const size_t amountOfJobs)
+{
+    for (size_t i = 0; i < amountOfJobs; i++)
+    {
+        hzl_AeadJob_t* const job = &jobs[i];
+        job->isTagValid = hzl_AeadDecryptOneShot(
+                job->plaintext, job->key, job->nonce, job->assocData, job->assocDataLen,
+                job->ciphertext, job->ciphertextLen, job->tag, job->tagLen) == HZL_OK;
+    }
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Types of the `libascon` crypto backend, the default one: Ascon-128 and
+ * Ascon-XOF from LibAscon.
+ *
+ * Each crypto backend provides its own `hzl_CryptoBackend.h` file, found
+ * through the include path selected by the `HZL_CRYPTO_BACKEND` CMake option,
+ * with the same defines and typedefs as this one, and the source files
+ * implementing all the functions of hzl_CommonAead.h and hzl_CommonHash.h,
+ * including the short-message ones hzl_AeadEncryptOneShot(),
+ * hzl_AeadDecryptOneShot() and hzl_AeadDecryptBatch().
+ * This backend implements those with fused Ascon-128 kernels; a backend without
+ * its own can use the generic ones built on the streaming functions,
+ * in `src/crypto/generic/`.
+ */
+
+#ifndef HZL_CRYPTO_BACKEND_H_
+#define HZL_CRYPTO_BACKEND_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "ascon.h"
+
+/** @internal Name of the crypto backend, as selected with `HZL_CRYPTO_BACKEND`. */
+#define HZL_CRYPTO_BACKEND_NAME "libascon"
+
+/** @internal Length of the nonce passed to the AEAD cipher in bytes. */
+#define HZL_AEAD_NONCE_LEN ASCON_AEAD_NONCE_LEN
+
+/**
+ * @internal
+ * Amount of independent messages decrypted in parallel by hzl_AeadDecryptBatch().
+ *
+ * The permutations of this many cipher states are computed by the same loops,
+ * one iteration per message, which the compiler maps onto vector instructions
+ * (e.g. 4x64 bit with AVX2) when available for the target CPU.
+ */
+#define HZL_AEAD_LANES 4U
+
+/**
+ * @internal
+ * AEAD-function state.
+ */
+typedef ascon_aead_ctx_t hzl_Aead_t;
+
+/**
+ * @internal
+ * State of the hash function. Must be a plain struct of at most
+ * #HZL_HASH_STATE_WORDS words, as it's copied to save a midstate.
+ */
+typedef ascon_hash_ctx_t hzl_Hash_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* HZL_CRYPTO_BACKEND_H_ */
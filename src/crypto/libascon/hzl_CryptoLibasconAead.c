@@ -29,11 +29,8 @@
 /**
  * @file
  * @internal
- * Hazelnet wrapper of the AEAD function: Authenticated Encryption with
- * Associated Data.
- *
- * The idea of this wrapper is to provide a stable interface in case the
- * implementation of the AEAD function is changed from one cipher to another.
+ * AEAD functions of the `libascon` crypto backend: Authenticated Encryption
+ * with Associated Data with Ascon-128 from LibAscon.
  */
 
 #include "hzl_CommonAead.h"
@@ -0,0 +1,494 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * AEAD functions of the `libascon` crypto backend for short messages: fused Ascon-128
+ * kernels for one-shot encryption and decryption and authenticated decryption of many
+ * independent messages at once.
+ *
+ * Implement the Ascon-128 AEAD cipher (v1.2), the same one LibAscon provides for
+ * hzl_AeadEncryptUpdate() and hzl_AeadDecryptUpdate(), directly on the input and
+ * output buffers, without the streaming context.
+ * The batch decryption keeps the states of #HZL_AEAD_LANES messages side by side:
+ * every step of the permutation is a loop over the messages, which the compiler
+ * vectorises. The absorption of the data is done per message, as the lengths may differ.
+ */
+
+#include "hzl_CommonAead.h"
+
+/** @internal Ascon-128 initialisation vector. */
+#define HZL_ASCON128_IV 0x80400c0600000000ULL
+/** @internal Ascon-128 rate: bytes absorbed between permutations. */
+#define HZL_ASCON128_RATE 8U
+/** @internal Rounds of the permutation during initialisation and finalisation. */
+#define HZL_ASCON_ROUNDS_A 12U
+/** @internal Rounds of the permutation while absorbing data. */
+#define HZL_ASCON_ROUNDS_B 6U
+/** @internal Maximum length of the tag the kernels can generate and check. */
+#define HZL_ASCON_MAX_TAG_LEN 16U
+
+/** @internal Rotation to the right of a 64-bit word. */
+#define HZL_ROR64(x, n) (((x) >> (n)) | ((x) << (64U - (n))))
+
+/**
+ * @internal
+ * One round of the Ascon permutation on the 5 state words, updated in place.
+ */
+#define HZL_ASCON_ROUND(x0, x1, x2, x3, x4, roundConstant) \
+    do { \
+        (x2) ^= (roundConstant); \
+        /* Substitution layer */ \
+        (x0) ^= (x4); \
+        (x4) ^= (x3); \
+        (x2) ^= (x1); \
+        const uint64_t t0 = ~(x0) & (x1); \
+        const uint64_t t1 = ~(x1) & (x2); \
+        const uint64_t t2 = ~(x2) & (x3); \
+        const uint64_t t3 = ~(x3) & (x4); \
+        const uint64_t t4 = ~(x4) & (x0); \
+        (x0) ^= t1; \
+        (x1) ^= t2; \
+        (x2) ^= t3; \
+        (x3) ^= t4; \
+        (x4) ^= t0; \
+        (x1) ^= (x0); \
+        (x0) ^= (x4); \
+        (x3) ^= (x2); \
+        (x2) = ~(x2); \
+        /* Linear diffusion layer */ \
+        (x0) ^= HZL_ROR64((x0), 19U) ^ HZL_ROR64((x0), 28U); \
+        (x1) ^= HZL_ROR64((x1), 61U) ^ HZL_ROR64((x1), 39U); \
+        (x2) ^= HZL_ROR64((x2), 1U) ^ HZL_ROR64((x2), 6U); \
+        (x3) ^= HZL_ROR64((x3), 10U) ^ HZL_ROR64((x3), 17U); \
+        (x4) ^= HZL_ROR64((x4), 7U) ^ HZL_ROR64((x4), 41U); \
+    } while (0)
+
+/** @internal Ascon state of a single message. */
+typedef struct hzl_AeadState
+{
+    uint64_t x0;
+    uint64_t x1;
+    uint64_t x2;
+    uint64_t x3;
+    uint64_t x4;
+} hzl_AeadState_t;
+
+/** @internal Ascon state of #HZL_AEAD_LANES messages, one 64-bit word of each per row. */
+typedef struct hzl_AeadLanes
+{
+    uint64_t x0[HZL_AEAD_LANES];
+    uint64_t x1[HZL_AEAD_LANES];
+    uint64_t x2[HZL_AEAD_LANES];
+    uint64_t x3[HZL_AEAD_LANES];
+    uint64_t x4[HZL_AEAD_LANES];
+} hzl_AeadLanes_t;
+
+/** @internal Big-endian load of up to 8 bytes into the most significant bytes of a word. */
+static uint64_t
+hzl_AeadLoadBe(const uint8_t* const bytes,
+               const size_t len)
+{
+    uint64_t word = 0;
+    for (size_t i = 0; i < len; i++)
+    {
+        word |= (uint64_t) bytes[i] << (56U - 8U * i);
+    }
+    return word;
+}
+
+/** @internal Big-endian store of the up to 8 most significant bytes of a word. */
+static void
+hzl_AeadStoreBe(uint8_t* const bytes,
+                const uint64_t word,
+                const size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        bytes[i] = (uint8_t) (word >> (56U - 8U * i));
+    }
+}
+
+/** @internal Padding of a partial block of \p len bytes. */
+static uint64_t
+hzl_AeadPad(const size_t len)
+{
+    return 0x80ULL << (56U - 8U * len);
+}
+
+/**
+ * @internal
+ * Ascon permutation with the given amount of rounds, applied to the states of the messages
+ * whose \p mask word is all ones; the others are left untouched.
+ */
+static void
+hzl_AeadLanesPermute(hzl_AeadLanes_t* const s,
+                     const uint_fast8_t rounds,
+                     const uint64_t* const mask)
+{
+    hzl_AeadLanes_t p = *s;
+    for (uint_fast8_t r = (uint_fast8_t) (HZL_ASCON_ROUNDS_A - rounds);
+         r < HZL_ASCON_ROUNDS_A; r++)
+    {
+        const uint64_t roundConstant = ((0xFU - r) << 4U) | r;
+        for (size_t l = 0; l < HZL_AEAD_LANES; l++)
+        {
+            HZL_ASCON_ROUND(p.x0[l], p.x1[l], p.x2[l], p.x3[l], p.x4[l], roundConstant);
+        }
+    }
+    for (size_t l = 0; l < HZL_AEAD_LANES; l++)
+    {
+        s->x0[l] = (p.x0[l] & mask[l]) | (s->x0[l] & ~mask[l]);
+        s->x1[l] = (p.x1[l] & mask[l]) | (s->x1[l] & ~mask[l]);
+        s->x2[l] = (p.x2[l] & mask[l]) | (s->x2[l] & ~mask[l]);
+        s->x3[l] = (p.x3[l] & mask[l]) | (s->x3[l] & ~mask[l]);
+        s->x4[l] = (p.x4[l] & mask[l]) | (s->x4[l] & ~mask[l]);
+    }
+    hzl_ZeroOut(&p, sizeof(p));
+}
+
+/** @internal Amount of full blocks absorbed before the last, padded one. */
+static size_t
+hzl_AeadFullBlocks(const size_t len)
+{
+    return len / HZL_ASCON128_RATE;
+}
+
+/** @internal Ascon permutation with the given amount of rounds. */
+static void
+hzl_AeadPermute(hzl_AeadState_t* const s,
+                const uint_fast8_t rounds)
+{
+    // Local copies of the words, so they are kept in registers across the rounds
+    uint64_t x0 = s->x0;
+    uint64_t x1 = s->x1;
+    uint64_t x2 = s->x2;
+    uint64_t x3 = s->x3;
+    uint64_t x4 = s->x4;
+    for (uint_fast8_t r = (uint_fast8_t) (HZL_ASCON_ROUNDS_A - rounds);
+         r < HZL_ASCON_ROUNDS_A; r++)
+    {
+        const uint64_t roundConstant = ((0xFU - r) << 4U) | r;
+        HZL_ASCON_ROUND(x0, x1, x2, x3, x4, roundConstant);
+    }
+    s->x0 = x0;
+    s->x1 = x1;
+    s->x2 = x2;
+    s->x3 = x3;
+    s->x4 = x4;
+}
+
+/**
+ * @internal
+ * Initialises the state with key and nonce, absorbs the associated data and applies
+ * the domain separation, leaving the state ready for the plaintext or ciphertext.
+ */
+static void
+hzl_AeadStart(hzl_AeadState_t* const s,
+              uint64_t* const k0,
+              uint64_t* const k1,
+              const uint8_t* const key,
+              const uint8_t* const nonce,
+              const uint8_t* const assocData,
+              const size_t assocDataLen)
+{
+    // Initialisation: state = IV || K || N, permutation, then xor with the key
+    *k0 = hzl_AeadLoadBe(&key[0], 8U);
+    *k1 = hzl_AeadLoadBe(&key[8], 8U);
+    s->x0 = HZL_ASCON128_IV;
+    s->x1 = *k0;
+    s->x2 = *k1;
+    s->x3 = hzl_AeadLoadBe(&nonce[0], 8U);
+    s->x4 = hzl_AeadLoadBe(&nonce[8], 8U);
+    hzl_AeadPermute(s, HZL_ASCON_ROUNDS_A);
+    s->x3 ^= *k0;
+    s->x4 ^= *k1;
+    // Associated data, padded only if not empty, then domain separation
+    if (assocDataLen > 0U)
+    {
+        const size_t fullBlocks = hzl_AeadFullBlocks(assocDataLen);
+        for (size_t block = 0; block < fullBlocks; block++)
+        {
+            s->x0 ^= hzl_AeadLoadBe(&assocData[block * HZL_ASCON128_RATE],
+                                    HZL_ASCON128_RATE);
+            hzl_AeadPermute(s, HZL_ASCON_ROUNDS_B);
+        }
+        const size_t remaining = assocDataLen % HZL_ASCON128_RATE;
+        s->x0 ^= hzl_AeadLoadBe(&assocData[fullBlocks * HZL_ASCON128_RATE], remaining)
+                 ^ hzl_AeadPad(remaining);
+        hzl_AeadPermute(s, HZL_ASCON_ROUNDS_B);
+    }
+    s->x4 ^= 1U;
+}
+
+/** @internal Finalisation: computed tag = (state xor key) after the permutation. */
+static void
+hzl_AeadFinish(hzl_AeadState_t* const s,
+               uint8_t* const computedTag,
+               const uint64_t k0,
+               const uint64_t k1)
+{
+    s->x1 ^= k0;
+    s->x2 ^= k1;
+    hzl_AeadPermute(s, HZL_ASCON_ROUNDS_A);
+    hzl_AeadStoreBe(&computedTag[0], s->x3 ^ k0, 8U);
+    hzl_AeadStoreBe(&computedTag[8], s->x4 ^ k1, 8U);
+}
+
+void
+hzl_AeadEncryptOneShot(uint8_t* const ciphertext,
+                       uint8_t* const tag,
+                       const uint8_t* const key,
+                       const uint8_t* const nonce,
+                       const uint8_t* const assocData,
+                       const size_t assocDataLen,
+                       const uint8_t* const plaintext,
+                       const size_t plaintextLen,
+                       const uint8_t tagLen)
+{
+    hzl_AeadState_t s;
+    uint64_t k0;
+    uint64_t k1;
+    hzl_AeadStart(&s, &k0, &k1, key, nonce, assocData, assocDataLen);
+    // Plaintext: each block is xored into the rate, which is the ciphertext
+    const size_t fullBlocks = hzl_AeadFullBlocks(plaintextLen);
+    for (size_t block = 0; block < fullBlocks; block++)
+    {
+        const size_t offset = block * HZL_ASCON128_RATE;
+        s.x0 ^= hzl_AeadLoadBe(&plaintext[offset], HZL_ASCON128_RATE);
+        hzl_AeadStoreBe(&ciphertext[offset], s.x0, HZL_ASCON128_RATE);
+        hzl_AeadPermute(&s, HZL_ASCON_ROUNDS_B);
+    }
+    const size_t offset = fullBlocks * HZL_ASCON128_RATE;
+    const size_t remaining = plaintextLen % HZL_ASCON128_RATE;
+    s.x0 ^= hzl_AeadLoadBe(&plaintext[offset], remaining);
+    hzl_AeadStoreBe(&ciphertext[offset], s.x0, remaining);
+    s.x0 ^= hzl_AeadPad(remaining);
+    uint8_t computedTag[HZL_ASCON_MAX_TAG_LEN];
+    hzl_AeadFinish(&s, computedTag, k0, k1);
+    memcpy(tag, computedTag, tagLen);
+    hzl_ZeroOut(computedTag, sizeof(computedTag));
+    hzl_ZeroOut(&s, sizeof(s));
+    hzl_ZeroOut(&k0, sizeof(k0));
+    hzl_ZeroOut(&k1, sizeof(k1));
+}
+
+hzl_Err_t
+hzl_AeadDecryptOneShot(uint8_t* const plaintext,
+                       const uint8_t* const key,
+                       const uint8_t* const nonce,
+                       const uint8_t* const assocData,
+                       const size_t assocDataLen,
+                       const uint8_t* const ciphertext,
+                       const size_t ciphertextLen,
+                       const uint8_t* const tag,
+                       const uint8_t tagLen)
+{
+    hzl_AeadState_t s;
+    uint64_t k0;
+    uint64_t k1;
+    hzl_AeadStart(&s, &k0, &k1, key, nonce, assocData, assocDataLen);
+    // Ciphertext: full blocks replace the rate, the last partial one is padded
+    const size_t fullBlocks = hzl_AeadFullBlocks(ciphertextLen);
+    for (size_t block = 0; block < fullBlocks; block++)
+    {
+        const size_t offset = block * HZL_ASCON128_RATE;
+        const uint64_t c = hzl_AeadLoadBe(&ciphertext[offset], HZL_ASCON128_RATE);
+        hzl_AeadStoreBe(&plaintext[offset], s.x0 ^ c, HZL_ASCON128_RATE);
+        s.x0 = c;
+        hzl_AeadPermute(&s, HZL_ASCON_ROUNDS_B);
+    }
+    const size_t offset = fullBlocks * HZL_ASCON128_RATE;
+    const size_t remaining = ciphertextLen % HZL_ASCON128_RATE;
+    const uint64_t c = hzl_AeadLoadBe(&ciphertext[offset], remaining);
+    hzl_AeadStoreBe(&plaintext[offset], s.x0 ^ c, remaining);
+    const uint64_t replaced = (remaining == 0U) ? 0U : (UINT64_MAX << (64U - 8U * remaining));
+    s.x0 = (s.x0 & ~replaced) ^ c ^ hzl_AeadPad(remaining);
+    uint8_t computedTag[HZL_ASCON_MAX_TAG_LEN];
+    hzl_AeadFinish(&s, computedTag, k0, k1);
+    // Constant-time comparison
+    uint8_t difference = 0;
+    for (size_t i = 0; i < tagLen; i++)
+    {
+        difference |= (uint8_t) (computedTag[i] ^ tag[i]);
+    }
+    hzl_ZeroOut(computedTag, sizeof(computedTag));
+    hzl_ZeroOut(&s, sizeof(s));
+    hzl_ZeroOut(&k0, sizeof(k0));
+    hzl_ZeroOut(&k1, sizeof(k1));
+    if (difference != 0U)
+    {
+        hzl_ZeroOut(plaintext, ciphertextLen);
+        return HZL_ERR_SECWARN_INVALID_TAG;
+    }
+    return HZL_OK;
+}
+
+/**
+ * @internal
+ * Decrypts up to #HZL_AEAD_LANES jobs together. Unused lanes carry an empty message
+ * with a zero key and their results are discarded.
+ */
+static void
+hzl_AeadDecryptLanes(hzl_AeadJob_t* const jobs,
+                     const size_t amountOfJobs)
+{
+    static const uint8_t noData[HZL_AEAD_NONCE_LEN] = {0};
+    hzl_AeadLanes_t s;
+    uint64_t k0[HZL_AEAD_LANES];
+    uint64_t k1[HZL_AEAD_LANES];
+    uint64_t mask[HZL_AEAD_LANES];
+    size_t maxAssocDataBlocks = 0;
+    size_t maxCiphertextBlocks = 0;
+    // Initialisation: state = IV || K || N, permutation, then xor with the key
+    for (size_t l = 0; l < HZL_AEAD_LANES; l++)
+    {
+        const bool isUsed = l < amountOfJobs;
+        const uint8_t* const key = isUsed ? jobs[l].key : noData;
+        const uint8_t* const nonce = isUsed ? jobs[l].nonce : noData;
+        k0[l] = hzl_AeadLoadBe(&key[0], 8U);
+        k1[l] = hzl_AeadLoadBe(&key[8], 8U);
+        s.x0[l] = HZL_ASCON128_IV;
+        s.x1[l] = k0[l];
+        s.x2[l] = k1[l];
+        s.x3[l] = hzl_AeadLoadBe(&nonce[0], 8U);
+        s.x4[l] = hzl_AeadLoadBe(&nonce[8], 8U);
+        mask[l] = UINT64_MAX;
+        if (isUsed && jobs[l].assocDataLen > 0U)
+        {
+            const size_t blocks = hzl_AeadFullBlocks(jobs[l].assocDataLen) + 1U;
+            if (blocks > maxAssocDataBlocks) { maxAssocDataBlocks = blocks; }
+        }
+        if (isUsed && hzl_AeadFullBlocks(jobs[l].ciphertextLen) > maxCiphertextBlocks)
+        {
+            maxCiphertextBlocks = hzl_AeadFullBlocks(jobs[l].ciphertextLen);
+        }
+    }
+    hzl_AeadLanesPermute(&s, HZL_ASCON_ROUNDS_A, mask);
+    for (size_t l = 0; l < HZL_AEAD_LANES; l++)
+    {
+        s.x3[l] ^= k0[l];
+        s.x4[l] ^= k1[l];
+    }
+    // Associated data, padded only if not empty, then domain separation
+    for (size_t block = 0; block < maxAssocDataBlocks; block++)
+    {
+        for (size_t l = 0; l < HZL_AEAD_LANES; l++)
+        {
+            mask[l] = 0;
+            if (l >= amountOfJobs || jobs[l].assocDataLen == 0U) { continue; }
+            const size_t fullBlocks = hzl_AeadFullBlocks(jobs[l].assocDataLen);
+            if (block > fullBlocks) { continue; }
+            const uint8_t* const data = &jobs[l].assocData[block * HZL_ASCON128_RATE];
+            if (block < fullBlocks)
+            {
+                s.x0[l] ^= hzl_AeadLoadBe(data, HZL_ASCON128_RATE);
+            }
+            else
+            {
+                const size_t remaining = jobs[l].assocDataLen % HZL_ASCON128_RATE;
+                s.x0[l] ^= hzl_AeadLoadBe(data, remaining) ^ hzl_AeadPad(remaining);
+            }
+            mask[l] = UINT64_MAX;
+        }
+        hzl_AeadLanesPermute(&s, HZL_ASCON_ROUNDS_B, mask);
+    }
+    for (size_t l = 0; l < HZL_AEAD_LANES; l++)
+    {
+        s.x4[l] ^= 1U;
+    }
+    // Ciphertext: full blocks replace the rate, the last partial one is padded
+    for (size_t block = 0; block < maxCiphertextBlocks; block++)
+    {
+        for (size_t l = 0; l < HZL_AEAD_LANES; l++)
+        {
+            mask[l] = 0;
+            if (l >= amountOfJobs || block >= hzl_AeadFullBlocks(jobs[l].ciphertextLen))
+            {
+                continue;
+            }
+            const size_t offset = block * HZL_ASCON128_RATE;
+            const uint64_t c = hzl_AeadLoadBe(&jobs[l].ciphertext[offset], HZL_ASCON128_RATE);
+            hzl_AeadStoreBe(&jobs[l].plaintext[offset], s.x0[l] ^ c, HZL_ASCON128_RATE);
+            s.x0[l] = c;
+            mask[l] = UINT64_MAX;
+        }
+        hzl_AeadLanesPermute(&s, HZL_ASCON_ROUNDS_B, mask);
+    }
+    for (size_t l = 0; l < amountOfJobs; l++)
+    {
+        const size_t offset = hzl_AeadFullBlocks(jobs[l].ciphertextLen) * HZL_ASCON128_RATE;
+        const size_t remaining = jobs[l].ciphertextLen % HZL_ASCON128_RATE;
+        const uint64_t c = hzl_AeadLoadBe(&jobs[l].ciphertext[offset], remaining);
+        hzl_AeadStoreBe(&jobs[l].plaintext[offset], s.x0[l] ^ c, remaining);
+        const uint64_t replaced = (remaining == 0U) ? 0U : (UINT64_MAX << (64U - 8U * remaining));
+        s.x0[l] = (s.x0[l] & ~replaced) ^ c ^ hzl_AeadPad(remaining);
+    }
+    // Finalisation: tag = (state xor key) after the permutation
+    for (size_t l = 0; l < HZL_AEAD_LANES; l++)
+    {
+        s.x1[l] ^= k0[l];
+        s.x2[l] ^= k1[l];
+        mask[l] = UINT64_MAX;
+    }
+    hzl_AeadLanesPermute(&s, HZL_ASCON_ROUNDS_A, mask);
+    for (size_t l = 0; l < amountOfJobs; l++)
+    {
+        uint8_t computedTag[HZL_ASCON_MAX_TAG_LEN];
+        hzl_AeadStoreBe(&computedTag[0], s.x3[l] ^ k0[l], 8U);
+        hzl_AeadStoreBe(&computedTag[8], s.x4[l] ^ k1[l], 8U);
+        // Constant-time comparison
+        uint8_t difference = 0;
+        for (size_t i = 0; i < jobs[l].tagLen; i++)
+        {
+            difference |= (uint8_t) (computedTag[i] ^ jobs[l].tag[i]);
+        }
+        jobs[l].isTagValid = difference == 0U;
+        if (!jobs[l].isTagValid)
+        {
+            hzl_ZeroOut(jobs[l].plaintext, jobs[l].ciphertextLen);
+        }
+        hzl_ZeroOut(computedTag, sizeof(computedTag));
+    }
+    hzl_ZeroOut(&s, sizeof(s));
+    hzl_ZeroOut(k0, sizeof(k0));
+    hzl_ZeroOut(k1, sizeof(k1));
+}
+
+void
+hzl_AeadDecryptBatch(hzl_AeadJob_t* const jobs,
+                     const size_t amountOfJobs)
+{
+    for (size_t first = 0; first < amountOfJobs; first += HZL_AEAD_LANES)
+    {
+        const size_t remaining = amountOfJobs - first;
+        hzl_AeadDecryptLanes(&jobs[first],
+                             remaining < HZL_AEAD_LANES ? remaining : HZL_AEAD_LANES);
+    }
+}
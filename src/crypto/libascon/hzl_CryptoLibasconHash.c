@@ -29,15 +29,15 @@
 /**
  * @file
  * @internal
- * Hazelnet wrapper of the Hash function.
- *
- * The idea of this wrapper is to provide a stable interface in case the
- * implementation of the hash function is swapped with another.
+ * Hash functions of the `libascon` crypto backend: Ascon-XOF from LibAscon.
  */
 
 #include "hzl_CommonHash.h"
 #include "ascon.h"
 
+_Static_assert(sizeof(hzl_Hash_t) <= HZL_HASH_STATE_WORDS * sizeof(uint64_t),
+               "The hash state must fit into the precomputed midstate.");
+
 void
 hzl_HashInit(hzl_Hash_t* const ctx)
 {
@@ -74,3 +74,17 @@ hzl_HashDigestCheck(hzl_Hash_t* const ctx,
         return HZL_ERR_SECWARN_INVALID_TAG;
     }
 }
+
+void
+hzl_HashSaveMidstate(uint64_t* const midstate,
+                     const hzl_Hash_t* const ctx)
+{
+    memcpy(midstate, ctx, sizeof(hzl_Hash_t));
+}
+
+void
+hzl_HashLoadMidstate(hzl_Hash_t* const ctx,
+                     const uint64_t* const midstate)
+{
+    memcpy(ctx, midstate, sizeof(hzl_Hash_t));
+}
@@ -29,7 +29,8 @@
 /**
  * @file
  * @internal
- * Implementation of hzl_ServerBuildSecuredFd().
+ * Implementation of hzl_ServerBuildSecuredFd(), hzl_ServerBuildSecuredFdInto() and
+ * hzl_ServerBuildSecuredFdBatch().
  */
 
 #include "hzl.h"
@@ -54,12 +55,15 @@ hzl_ServerDidAnyClientAlreadyRequest(const hzl_ServerCtx_t* const ctx,
            ctx->groupStates[groupId].sessionStartInstant;
 }
 
-inline static hzl_Err_t
-hzl_ServerBuildMsgSadfd(hzl_CbsPduMsg_t* const msgToTx,
-                        hzl_ServerCtx_t* const ctx,
+inline static size_t
+hzl_ServerBuildMsgSadfd(uint8_t* const pdu,
+                        hzl_CanId_t* const canId,
+                        const hzl_ServerCtx_t* const ctx,
                         const uint8_t* const userData,
                         const size_t userDataLen,
-                        const hzl_Gid_t groupId)
+                        const hzl_Gid_t groupId,
+                        const uint8_t* const stk,
+                        const hzl_CtrNonce_t ctrnonce)
 {
     // Prepare SADFD Header
     const hzl_Header_t unpackedSadfdHeader = {
@@ -67,39 +71,23 @@ hzl_ServerBuildMsgSadfd(hzl_CbsPduMsg_t* const msgToTx,
             .sid = HZL_SERVER_SID,
             .pty = HZL_PTY_SADFD,
     };
-    const uint8_t packedHdrLen = hzl_HeaderLen(ctx->serverConfig->headerType);
-    hzl_HeaderPackFunc const headerPackFunc =
-            hzl_HeaderPackFuncForType(ctx->serverConfig->headerType);
+    const uint8_t packedHdrLen = hzl_HeaderCodecPayloadLen(&ctx->header);
     // Prepare SADFD payload
-    // Write the packed header at the beginning of the CAN FD frame's payload.
-    headerPackFunc(msgToTx->data, &unpackedSadfdHeader);
+    // Write the packed header into the CAN ID and/or at the beginning of the CAN FD payload.
+    hzl_HeaderCodecPack(&ctx->header, canId, pdu, &unpackedSadfdHeader);
     // Write counter nonce after the header
-    hzl_EncodeLe24(&msgToTx->data[packedHdrLen + HZL_SADFD_CTRNONCE_IDX],
-                   ctx->groupStates[groupId].currentCtrNonce);
-    msgToTx->data[packedHdrLen + HZL_SADFD_PTLEN_IDX] = (uint8_t) userDataLen;
+    hzl_EncodeLe24(&pdu[packedHdrLen + HZL_SADFD_CTRNONCE_IDX], ctrnonce);
+    pdu[packedHdrLen + HZL_SADFD_PTLEN_IDX] = (uint8_t) userDataLen;
     // Encrypt the plaintext (user-data a.k.a. SDU) into the ctext field of the SADFD message
-    hzl_Aead_t aead;
-    hzl_CommonAeadInitSadfd(&aead,
-                            ctx->groupStates[groupId].currentStk,
-                            &unpackedSadfdHeader,
-                            ctx->groupStates[groupId].currentCtrNonce,
-                            (uint8_t) userDataLen);
-    const size_t processedPtLen = hzl_AeadEncryptUpdate(
-            &aead,
-            &msgToTx->data[packedHdrLen + HZL_SADFD_CTEXT_IDX],  // Output: ciphertext
-            userData,  // Input: plaintext
-            userDataLen);
-    // Finish authenticated encryption and write tag
-    hzl_AeadEncryptFinish(
-            &aead,
-            &msgToTx->data[packedHdrLen + HZL_SADFD_CTEXT_IDX + processedPtLen],
-            &msgToTx->data[packedHdrLen + HZL_SADFD_TAG_IDX(userDataLen)],
-            HZL_SADFD_TAG_LEN);
+    hzl_CommonSadfdEncrypt(&pdu[packedHdrLen + HZL_SADFD_CTEXT_IDX],  // Output
+                           &pdu[packedHdrLen + HZL_SADFD_TAG_IDX(userDataLen)],
+                           stk,
+                           &unpackedSadfdHeader,
+                           ctrnonce,
+                           userData,  // Input: plaintext
+                           (uint8_t) userDataLen);
     // Message is packed in binary format, ready to transmit
-    msgToTx->dataLen = packedHdrLen + HZL_SADFD_PAYLOAD_LEN(userDataLen);
-    // Increment the counter nonce, regardless of transmission success
-    hzl_ServerGroupIncrCurrentCtrnonce(ctx, groupId);
-    return HZL_OK;
+    return packedHdrLen + HZL_SADFD_PAYLOAD_LEN(userDataLen);
 }
 
 HZL_API hzl_Err_t
@@ -110,21 +98,120 @@ hzl_ServerBuildSecuredFd(hzl_CbsPduMsg_t* const securedPdu,
                          const hzl_Gid_t groupId)
 {
     if (securedPdu == NULL) { return HZL_ERR_NULL_PDU; }
-    securedPdu->dataLen = 0; // Make output message empty in case of later error.
+    return hzl_ServerBuildSecuredFdInto(securedPdu->data, HZL_MAX_CAN_FD_DATA_LEN,
+                                        &securedPdu->dataLen, &securedPdu->canId,
+                                        ctx, userData, userDataLen, groupId);
+}
+
+HZL_API hzl_Err_t
+hzl_ServerBuildSecuredFdInto(uint8_t* const securedPdu,
+                             const size_t securedPduCapacity,
+                             size_t* const securedPduLen,
+                             hzl_CanId_t* const securedCanId,
+                             hzl_ServerCtx_t* const ctx,
+                             const uint8_t* const userData,
+                             const size_t userDataLen,
+                             const hzl_Gid_t groupId)
+{
+    if (securedPdu == NULL || securedPduLen == NULL || securedCanId == NULL)
+    {
+        return HZL_ERR_NULL_PDU;
+    }
+    *securedPduLen = 0; // Make output message empty in case of later error.
+    *securedCanId = 0;
     HZL_ERR_DECLARE(err);
     err = hzl_ServerCheckCtxPointers(ctx);
     HZL_ERR_CHECK(err);
     err = hzl_CommonCheckMsgBeforePacking(
             userData, userDataLen, groupId,
-            HZL_SADFD_METADATA_IN_PAYLOAD_LEN, ctx->serverConfig->headerType);
+            HZL_SADFD_METADATA_IN_PAYLOAD_LEN, &ctx->header);
     HZL_ERR_CHECK(err);
+    const uint8_t packedHdrLen = hzl_HeaderCodecPayloadLen(&ctx->header);
+    if (securedPduCapacity < packedHdrLen + HZL_SADFD_PAYLOAD_LEN(userDataLen))
+    {
+        return HZL_ERR_TOO_SMALL_PDU_BUFFER;
+    }
     if (groupId >= ctx->serverConfig->amountOfGroups)
     {
         return HZL_ERR_UNKNOWN_GROUP;
     }
-    if (!hzl_ServerDidAnyClientAlreadyRequest(ctx, groupId))
+    // Take the Counter Nonce, regardless of transmission success, and a copy of its STK
+    // together, then encrypt with them.
+    uint8_t stk[HZL_STK_LEN];
+    hzl_CtrNonce_t ctrnonce = 0;
+    if (!hzl_ServerGroupReserveCurrentCtrnonces(stk, &ctrnonce, ctx, groupId, 1U))
     {
         return HZL_ERR_NO_POTENTIAL_RECEIVER;
     }
-    return hzl_ServerBuildMsgSadfd(securedPdu, ctx, userData, userDataLen, groupId);
+    *securedPduLen = hzl_ServerBuildMsgSadfd(
+            securedPdu, securedCanId, ctx, userData, userDataLen, groupId, stk, ctrnonce);
+    hzl_ZeroOut(stk, HZL_STK_LEN);
+    return HZL_OK;
+}
+
+HZL_API hzl_Err_t
+hzl_ServerBuildSecuredFdBatch(hzl_CbsPduMsg_t* const securedPdus,
+                              hzl_Err_t* const results,
+                              hzl_ServerCtx_t* const ctx,
+                              const hzl_TxSduMsg_t* const userData,
+                              const size_t amountOfMsgs)
+{
+    if (securedPdus == NULL) { return HZL_ERR_NULL_PDU; }
+    if (results == NULL) { return HZL_ERR_NULL_RESULTS; }
+    if (userData == NULL && amountOfMsgs != 0) { return HZL_ERR_NULL_SDU; }
+    for (size_t i = 0; i < amountOfMsgs; i++)
+    {
+        securedPdus[i].dataLen = 0; // Make output messages empty in case of later error.
+    }
+    HZL_ERR_DECLARE(err);
+    err = hzl_ServerCheckCtxPointers(ctx);
+    HZL_ERR_CHECK(err);
+    size_t runStart = 0;
+    while (runStart < amountOfMsgs)
+    {
+        // Handle each run of consecutive messages for the same Group at once:
+        // check the Group once and reserve the Counter Nonces for the whole run.
+        const hzl_Gid_t groupId = userData[runStart].gid;
+        size_t runEnd = runStart;
+        while (runEnd < amountOfMsgs && userData[runEnd].gid == groupId) { runEnd++; }
+        size_t amountToBuild = 0;
+        for (size_t i = runStart; i < runEnd; i++)
+        {
+            results[i] = hzl_CommonCheckMsgBeforePacking(
+                    userData[i].data, userData[i].dataLen, groupId,
+                    HZL_SADFD_METADATA_IN_PAYLOAD_LEN, &ctx->header);
+            if (results[i] == HZL_OK) { amountToBuild++; }
+        }
+        hzl_Err_t groupErr = HZL_OK;
+        uint8_t stk[HZL_STK_LEN];
+        hzl_CtrNonce_t ctrnonce = 0;
+        if (groupId >= ctx->serverConfig->amountOfGroups)
+        {
+            groupErr = HZL_ERR_UNKNOWN_GROUP;
+        }
+        else
+        {
+            // Take the Counter Nonces and a copy of their STK together, then encrypt
+            // with them.
+            if (!hzl_ServerGroupReserveCurrentCtrnonces(
+                    stk, &ctrnonce, ctx, groupId, amountToBuild))
+            {
+                groupErr = HZL_ERR_NO_POTENTIAL_RECEIVER;
+            }
+        }
+        for (size_t i = runStart; i < runEnd; i++)
+        {
+            if (results[i] == HZL_OK) { results[i] = groupErr; }
+            if (results[i] != HZL_OK) { continue; }
+            securedPdus[i].dataLen = hzl_ServerBuildMsgSadfd(
+                    securedPdus[i].data, &securedPdus[i].canId, ctx,
+                    userData[i].data, userData[i].dataLen,
+                    groupId, stk, ctrnonce);
+            // Saturating, as hzl_ServerGroupReserveCurrentCtrnonces() does
+            if (!HZL_IS_CTRNONCE_EXPIRED(ctrnonce)) { ctrnonce++; }
+        }
+        hzl_ZeroOut(stk, HZL_STK_LEN);
+        runStart = runEnd;
+    }
+    return HZL_OK;
 }
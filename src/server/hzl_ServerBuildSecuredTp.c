@@ -0,0 +1,83 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Implementation of hzl_ServerBuildSecuredTp().
+ */
+
+#include "hzl.h"
+#include "hzl_ServerInternal.h"
+#include "hzl_CommonHeader.h"
+#include "hzl_CommonPayload.h"
+#include "hzl_CommonMessage.h"
+
+HZL_API hzl_Err_t
+hzl_ServerBuildSecuredTp(hzl_CbsPduMsg_t* const securedPdus,
+                         size_t* const amountOfPdus,
+                         hzl_ServerCtx_t* const ctx,
+                         const uint8_t* const userData,
+                         const size_t userDataLen,
+                         const hzl_Gid_t groupId)
+{
+    if (securedPdus == NULL || amountOfPdus == NULL) { return HZL_ERR_NULL_PDU; }
+    const size_t availablePdus = *amountOfPdus;
+    *amountOfPdus = 0; // Make output message empty in case of later error.
+    HZL_ERR_DECLARE(err);
+    err = hzl_ServerCheckCtxPointers(ctx);
+    HZL_ERR_CHECK(err);
+    size_t requiredPdus = 0;
+    err = hzl_CommonSadtpCheckMsgBeforePacking(
+            &requiredPdus, userData, userDataLen, groupId,
+            availablePdus, &ctx->header);
+    HZL_ERR_CHECK(err);
+    if (groupId >= ctx->serverConfig->amountOfGroups)
+    {
+        return HZL_ERR_UNKNOWN_GROUP;
+    }
+    // Take the Counter Nonce, regardless of transmission success, and a copy of its STK
+    // together, then encrypt with them.
+    uint8_t stk[HZL_STK_LEN];
+    hzl_CtrNonce_t ctrnonce = 0;
+    if (!hzl_ServerGroupReserveCurrentCtrnonces(stk, &ctrnonce, ctx, groupId, 1U))
+    {
+        return HZL_ERR_NO_POTENTIAL_RECEIVER;
+    }
+    const hzl_Header_t unpackedSadtpHeader = {
+            .gid = groupId,
+            .sid = HZL_SERVER_SID,
+            .pty = HZL_PTY_SADTP,
+    };
+    hzl_CommonBuildSecuredTp(securedPdus, userData, userDataLen,
+                             stk, &unpackedSadtpHeader, ctrnonce,
+                             &ctx->header);
+    hzl_ZeroOut(stk, HZL_STK_LEN);
+    *amountOfPdus = requiredPdus;
+    return HZL_OK;
+}
@@ -50,5 +50,5 @@ hzl_ServerBuildUnsecured(hzl_CbsPduMsg_t* const unsecuredPdu,
                                     userDataLen,
                                     groupId,
                                     HZL_SERVER_SID,
-                                    ctx->serverConfig->headerType);
+                                    &ctx->header);
 }
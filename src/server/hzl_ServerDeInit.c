@@ -35,6 +35,7 @@
 #include "hzl.h"
 #include "hzl_Server.h"
 #include "hzl_ServerInternal.h"
+#include "hzl_CommonMessage.h"
 
 HZL_API hzl_Err_t
 hzl_ServerDeInit(hzl_ServerCtx_t* const ctx)
@@ -44,5 +45,17 @@ hzl_ServerDeInit(hzl_ServerCtx_t* const ctx)
     if (ctx->groupStates == NULL) { return HZL_ERR_NULL_STATES_GROUPS; }
     hzl_ZeroOut(ctx->groupStates,
                 ctx->serverConfig->amountOfGroups * sizeof(hzl_ServerGroupState_t));
+    hzl_CommonSadtpRxClearAll(ctx->sadtpRxBuffers, ctx->amountOfSadtpRxBuffers);
+    if (ctx->clientStates != NULL)
+    {
+        hzl_ZeroOut(ctx->clientStates,
+                    ctx->serverConfig->amountOfClients * sizeof(hzl_ServerClientState_t));
+    }
+    if (ctx->groupTimers != NULL)
+    {
+        hzl_ZeroOut(ctx->groupTimers,
+                    ctx->serverConfig->amountOfGroups * sizeof(hzl_ServerGroupTimer_t));
+    }
+    hzl_ZeroOut(&ctx->timerWheel, sizeof(ctx->timerWheel));
     return HZL_OK;
 }
@@ -36,20 +36,14 @@
 #include "hzl_Server.h"
 #include "hzl_ServerInternal.h"
 
-HZL_API hzl_Err_t
-hzl_ServerForceSessionRenewal(hzl_CbsPduMsg_t* const renewalPdu,
-                              hzl_ServerCtx_t* const ctx,
-                              const hzl_Gid_t groupId)
+/** @internal Enters the Session renewal phase if not already in it and builds a REN message,
+ * for a Group already known to exist. */
+inline static hzl_Err_t
+hzl_ServerForceSessionRenewalOfGroup(hzl_CbsPduMsg_t* const renewalPdu,
+                                     hzl_ServerCtx_t* const ctx,
+                                     const hzl_Gid_t groupId)
 {
-    if (renewalPdu == NULL) { return HZL_ERR_NULL_PDU; }
-    renewalPdu->dataLen = 0; // Make output message empty in case of later error.
     HZL_ERR_DECLARE(err);
-    err = hzl_ServerCheckCtxPointers(ctx);
-    HZL_ERR_CHECK(err);
-    if (groupId >= ctx->serverConfig->amountOfGroups)
-    {
-        return HZL_ERR_UNKNOWN_GROUP;
-    }
     const bool renewalPhaseIsActive = hzl_ServerSessionRenewalPhaseIsActive(ctx, groupId);
     if (!renewalPhaseIsActive
         && !hzl_ServerDidAnyClientAlreadyRequest(ctx, groupId))
@@ -70,3 +64,23 @@ hzl_ServerForceSessionRenewal(hzl_CbsPduMsg_t* const renewalPdu,
     }
     return hzl_ServerBuildMsgRenewal(renewalPdu, ctx, groupId);
 }
+
+HZL_API hzl_Err_t
+hzl_ServerForceSessionRenewal(hzl_CbsPduMsg_t* const renewalPdu,
+                              hzl_ServerCtx_t* const ctx,
+                              const hzl_Gid_t groupId)
+{
+    if (renewalPdu == NULL) { return HZL_ERR_NULL_PDU; }
+    renewalPdu->dataLen = 0; // Make output message empty in case of later error.
+    HZL_ERR_DECLARE(err);
+    err = hzl_ServerCheckCtxPointers(ctx);
+    HZL_ERR_CHECK(err);
+    if (groupId >= ctx->serverConfig->amountOfGroups)
+    {
+        return HZL_ERR_UNKNOWN_GROUP;
+    }
+    hzl_ServerGroupLock(ctx, groupId);
+    err = hzl_ServerForceSessionRenewalOfGroup(renewalPdu, ctx, groupId);
+    hzl_ServerGroupUnlock(ctx, groupId);
+    return err;
+}
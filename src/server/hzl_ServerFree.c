@@ -48,6 +48,12 @@ hzl_ServerFree(hzl_ServerCtx_t** const pCtx)
         HZL_SECURE_FREE(ctx->groupStates,
                         ctx->serverConfig->amountOfGroups *
                         sizeof(hzl_ServerGroupState_t));
+        HZL_SECURE_FREE(ctx->clientStates,
+                        ctx->serverConfig->amountOfClients *
+                        sizeof(hzl_ServerClientState_t));
+        HZL_SECURE_FREE(ctx->groupTimers,
+                        ctx->serverConfig->amountOfGroups *
+                        sizeof(hzl_ServerGroupTimer_t));
         // Here we force the pointer to the constant configuration to be writable just once
         // because we have to clear the configuration securely before freeing it.
         HZL_SECURE_FREE(ctx->clientConfigs,
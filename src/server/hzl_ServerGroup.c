@@ -32,17 +32,61 @@
  */
 
 #include "hzl_ServerInternal.h"
+#include "hzl_CommonMessage.h"
+
+#ifdef HZL_THREAD_SAFE
 
 void
-hzl_ServerGroupIncrCurrentCtrnonce(const hzl_ServerCtx_t* const ctx,
-                                   const hzl_Gid_t groupId)
+hzl_ServerGroupLock(const hzl_ServerCtx_t* const ctx,
+                    const hzl_Gid_t gid)
 {
-    if (!HZL_IS_CTRNONCE_EXPIRED(ctx->groupStates[groupId].currentCtrNonce))
+    if (gid < ctx->serverConfig->amountOfGroups)
     {
-        ctx->groupStates[groupId].currentCtrNonce++;
+        hzl_LockAcquire(&ctx->groupStates[gid].lock);
     }
 }
 
+void
+hzl_ServerGroupUnlock(const hzl_ServerCtx_t* const ctx,
+                      const hzl_Gid_t gid)
+{
+    if (gid < ctx->serverConfig->amountOfGroups)
+    {
+        hzl_LockRelease(&ctx->groupStates[gid].lock);
+    }
+}
+
+#endif  /* HZL_THREAD_SAFE */
+
+bool
+hzl_ServerGroupReserveCurrentCtrnonces(uint8_t* const stk,
+                                       hzl_CtrNonce_t* const firstCtrnonce,
+                                       const hzl_ServerCtx_t* const ctx,
+                                       const hzl_Gid_t groupId,
+                                       const size_t amount)
+{
+    hzl_ServerGroupState_t* const state = &ctx->groupStates[groupId];
+    bool isAnyReceiver;
+#ifdef HZL_THREAD_SAFE
+    // Lock-free: the STK and the Counter Nonces must just belong to the same Session.
+    uint_least16_t seq;
+    do
+    {
+        seq = hzl_SessionSeqReadBegin(&state->sessionSeq);
+#endif
+        isAnyReceiver = hzl_ServerDidAnyClientAlreadyRequest(ctx, groupId);
+        if (isAnyReceiver)
+        {
+            memcpy(stk, state->currentStk, HZL_STK_LEN);
+            *firstCtrnonce = hzl_CommonCtrNonceReserve(&state->currentCtrNonce, amount);
+        }
+#ifdef HZL_THREAD_SAFE
+    } while (hzl_SessionSeqReadRetry(&state->sessionSeq, seq));
+#endif
+    if (!isAnyReceiver) { hzl_ZeroOut(stk, HZL_STK_LEN); }
+    return isAnyReceiver;
+}
+
 void
 hzl_ServerGroupIncrPreviousCtrnonce(const hzl_ServerCtx_t* const ctx,
                                     const hzl_Gid_t groupId)
@@ -52,3 +96,83 @@ hzl_ServerGroupIncrPreviousCtrnonce(const hzl_ServerCtx_t* const ctx,
         ctx->groupStates[groupId].previousCtrNonce++;
     }
 }
+
+inline static bool
+hzl_ServerIsCtrNonceOfPreviousSession(const hzl_ServerCtx_t* const ctx,
+                                      const hzl_CtrNonce_t receivedCtrnonce,
+                                      const hzl_Gid_t gid)
+{
+    const hzl_CtrNonce_t average = (hzl_CtrNonce_t)
+            ((ctx->groupStates[gid].currentCtrNonce + ctx->groupStates[gid].previousCtrNonce) / 2U);
+    return receivedCtrnonce >= average;
+}
+
+hzl_Err_t
+hzl_ServerCheckRxCtrnonce(bool* const isPreviousSession,
+                          const hzl_ServerCtx_t* const ctx,
+                          const hzl_CtrNonce_t receivedCtrnonce,
+                          const hzl_Timestamp_t rxTimestamp,
+                          const hzl_Gid_t gid)
+{
+    if (HZL_IS_CTRNONCE_EXPIRED(receivedCtrnonce))
+    {
+        return HZL_ERR_SECWARN_RECEIVED_OVERFLOWN_NONCE;
+    }
+    // Check if belongs to the old or new session during a renewal phase
+    const bool isPrevious =
+            isPreviousSession != NULL
+            && hzl_ServerSessionRenewalPhaseIsActive(ctx, gid)
+            && hzl_ServerIsCtrNonceOfPreviousSession(ctx, receivedCtrnonce, gid);
+    hzl_Timestamp_t selectedLastRxTimestamp;
+    hzl_CtrNonce_t selectedCtrNonce;
+    if (isPrevious)
+    {
+        selectedLastRxTimestamp = ctx->groupStates[gid].previousRxLastMessageInstant;
+        selectedCtrNonce = ctx->groupStates[gid].previousCtrNonce;
+    }
+    else
+    {
+        selectedLastRxTimestamp = ctx->groupStates[gid].currentRxLastMessageInstant;
+        selectedCtrNonce = ctx->groupStates[gid].currentCtrNonce;
+    }
+    // Freshness of received ctrnonce compared to the ctrnonce of the last
+    // received message of the previous or current session, depending where
+    // the received message belongs.
+    const hzl_CtrNonce_t delay = hzl_CommonCtrDelay(
+            selectedLastRxTimestamp,
+            rxTimestamp,
+            ctx->groupConfigs[gid].maxCtrnonceDelayMsgs,
+            ctx->groupConfigs[gid].maxSilenceIntervalMillis);
+    // Casting to signed to avoid compiler errors. Counter nonces anyway use
+    // only 24 bits, so the signed value is the same as the unsigned.
+    const int32_t oldestToleratedCtrNonce = (int32_t) selectedCtrNonce - (int32_t) delay;
+    if ((int32_t) receivedCtrnonce < oldestToleratedCtrNonce)
+    {
+        return HZL_ERR_SECWARN_OLD_MESSAGE;
+    }
+    if (isPreviousSession != NULL) { *isPreviousSession = isPrevious; }
+    return HZL_OK;
+}
+
+void
+hzl_ServerGroupUpdateCtrnonceAndRxTimestamp(const hzl_ServerCtx_t* const ctx,
+                                            const hzl_CtrNonce_t receivedCtrnonce,
+                                            const hzl_Timestamp_t receptionTimestamp,
+                                            const bool isPreviousSession,
+                                            const hzl_Gid_t gid)
+{
+    if (isPreviousSession)
+    {
+        if (receivedCtrnonce > ctx->groupStates[gid].previousCtrNonce)
+        {
+            ctx->groupStates[gid].previousCtrNonce = receivedCtrnonce;
+        }
+        hzl_ServerGroupIncrPreviousCtrnonce(ctx, gid);
+        ctx->groupStates[gid].previousRxLastMessageInstant = receptionTimestamp;
+    }
+    else
+    {
+        hzl_CommonCtrNonceAdvancePast(&ctx->groupStates[gid].currentCtrNonce, receivedCtrnonce);
+        hzl_ServerUpdateCurrentRxLastMessageInstant(ctx, receptionTimestamp, gid);
+    }
+}
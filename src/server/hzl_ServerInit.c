@@ -36,6 +36,7 @@
 #include "hzl_Server.h"
 #include "hzl_ServerInternal.h"
 #include "hzl_CommonHeader.h"
+#include "hzl_CommonMessage.h"
 
 /** @internal Verifies the content of the Server Configuration structure. */
 static hzl_Err_t
@@ -44,6 +45,8 @@ hzl_ServerInitCheckServerConfig(const hzl_ServerConfig_t* const config)
     HZL_ERR_DECLARE(err);
     err = hzl_HeaderTypeCheck(config->headerType);
     HZL_ERR_CHECK(err);
+    err = hzl_HeaderPlacementCheck(config->headerPlacement);
+    HZL_ERR_CHECK(err);
     if (config->amountOfGroups == 0) { return HZL_ERR_ZERO_GROUPS; }
     const hzl_Gid_t maxGid = hzl_HeaderTypeMaxGid(config->headerType);
     const size_t maxAmountOfGroups = maxGid + 1U;  // [0, maxGid] = maxGid+1 possible groups
@@ -57,10 +60,8 @@ hzl_ServerInitCheckServerConfig(const hzl_ServerConfig_t* const config)
     {
         return HZL_ERR_TOO_MANY_CLIENTS_FOR_CONFIGURED_HEADER_TYPE;
     }
-    if (config->amountOfClients > HZL_SERVER_MAX_AMOUNT_OF_CLIENTS)
-    {
-        return HZL_ERR_TOO_MANY_CLIENTS;
-    }
+    // No need to check against HZL_SERVER_MAX_AMOUNT_OF_CLIENTS: the bitmap has a bit
+    // for any amount of Clients that fits into the uint8_t.
     return HZL_OK;
 }
 
@@ -105,24 +106,67 @@ hzl_ServerIsValidDelayBetweenRen(const hzl_ServerGroupConfig_t* const groupConfi
 }
 
 /** @internal Bitmap containing all possible SIDs for a given amount of Clients.
- * Operates on 64 bits in case the bitmap is expanded from 32 to 64 bits
- * (32 at the time of writing).
- * Example: if amountOfClients==3, then allClientSids==0b111
- * Example: if amountOfClients==32, then allClientSids==0xFFFFFFFF */
-inline static hzl_ServerBitMap_t
-hzl_ServerAllClientsBitmap(const hzl_ServerCtx_t* const ctx)
+ * Example: if amountOfClients==3, then allClientSids.words=={0b111, 0, 0, 0}
+ * Example: if amountOfClients==70, then allClientSids.words=={0xFF..FF, 0x3F, 0, 0} */
+static void
+hzl_ServerAllClientsBitmap(hzl_ServerBitMap_t* const allClientSids,
+                           const hzl_ServerCtx_t* const ctx)
+{
+    size_t remainingClients = ctx->serverConfig->amountOfClients;
+    for (size_t w = 0U; w < HZL_SERVER_BITMAP_WORDS; w++)
+    {
+        if (remainingClients >= HZL_SERVER_BITMAP_WORD_BITS)
+        {
+            allClientSids->words[w] = UINT64_MAX;
+            remainingClients -= HZL_SERVER_BITMAP_WORD_BITS;
+        }
+        else if (remainingClients > 0U)
+        {
+            allClientSids->words[w] =
+                    UINT64_MAX >> (HZL_SERVER_BITMAP_WORD_BITS - remainingClients);
+            remainingClients = 0U;
+        }
+        else
+        {
+            allClientSids->words[w] = 0U;
+        }
+    }
+}
+
+/** @internal True if \p bitmap contains all the SIDs in \p subset. */
+static bool
+hzl_ServerBitMapContainsAll(const hzl_ServerBitMap_t* const bitmap,
+                            const hzl_ServerBitMap_t* const subset)
 {
-    return (hzl_ServerBitMap_t)
-            (UINT64_MAX >> (64U - ctx->serverConfig->amountOfClients));
+    uint64_t missing = 0U;
+    for (size_t w = 0U; w < HZL_SERVER_BITMAP_WORDS; w++)
+    {
+        missing |= subset->words[w] & ~bitmap->words[w];
+    }
+    return missing == 0U;
+}
+
+/** @internal True if no SID is in the bitmap. */
+static bool
+hzl_ServerBitMapIsEmpty(const hzl_ServerBitMap_t* const bitmap)
+{
+    uint64_t any = 0U;
+    for (size_t w = 0U; w < HZL_SERVER_BITMAP_WORDS; w++)
+    {
+        any |= bitmap->words[w];
+    }
+    return any == 0U;
 }
 
 /** @internal Verifies the content of the array of Client Configuration structures. */
 static hzl_Err_t
 hzl_ServerInitCheckGroupConfigs(const hzl_ServerCtx_t* const ctx)
 {
-    const hzl_ServerBitMap_t allClientSids = hzl_ServerAllClientsBitmap(ctx);
+    hzl_ServerBitMap_t allClientSids;
+    hzl_ServerAllClientsBitmap(&allClientSids, ctx);
     if (ctx->groupConfigs[0].gid != HZL_BROADCAST_GID) { return HZL_ERR_MISSING_GID_0; }
-    if ((ctx->groupConfigs[0].clientSidsInGroupBitmap & allClientSids) != allClientSids)
+    if (!hzl_ServerBitMapContainsAll(&ctx->groupConfigs[0].clientSidsInGroupBitmap,
+                                     &allClientSids))
     {
         // The broadcast group bitmap must contain ALL the bits that map to the Clients
         // listed in the Clients config, but may contain SOME higher set bits, which are ignored.
@@ -147,11 +191,12 @@ hzl_ServerInitCheckGroupConfigs(const hzl_ServerCtx_t* const ctx)
             }
             // Note: skipping the first loo (index 0) as the broadcast group is already checked
             // outside of the loop.
-            if (ctx->groupConfigs[i].clientSidsInGroupBitmap == 0U)
+            if (hzl_ServerBitMapIsEmpty(&ctx->groupConfigs[i].clientSidsInGroupBitmap))
             {
                 return HZL_ERR_CLIENTS_BITMAP_ZERO_CLIENTS;
             }
-            if (ctx->groupConfigs[i].clientSidsInGroupBitmap & ~allClientSids)
+            if (!hzl_ServerBitMapContainsAll(&allClientSids,
+                                             &ctx->groupConfigs[i].clientSidsInGroupBitmap))
             {
                 // The bitmap contains some set bits outside of the possible range.
                 return HZL_ERR_CLIENTS_BITMAP_UNKNOWN_SID;
@@ -184,6 +229,10 @@ hzl_ServerCheckCtxPointers(const hzl_ServerCtx_t* const ctx)
     if (ctx->groupStates == NULL) { return HZL_ERR_NULL_STATES_GROUPS; }
     if (ctx->io.currentTime == NULL) { return HZL_ERR_NULL_CURRENT_TIME_FUNC; }
     if (ctx->io.trng == NULL) { return HZL_ERR_NULL_TRNG_FUNC; }
+    if (ctx->sadtpRxBuffers == NULL && ctx->amountOfSadtpRxBuffers != 0U)
+    {
+        return HZL_ERR_NULL_SADTP_RX_BUFFERS;
+    }
     return HZL_OK;
 }
 
@@ -197,7 +246,9 @@ hzl_ServerCheckCtx(const hzl_ServerCtx_t* const ctx)
     HZL_ERR_CHECK(err);
     err = hzl_ServerInitCheckClientConfigs(ctx);
     HZL_ERR_CHECK(err);
-    return hzl_ServerInitCheckGroupConfigs(ctx);
+    err = hzl_ServerInitCheckGroupConfigs(ctx);
+    HZL_ERR_CHECK(err);
+    return hzl_CommonSadtpCheckRxBuffers(ctx->sadtpRxBuffers, ctx->amountOfSadtpRxBuffers);
 }
 
 /** @internal Starts the current session of all Groups, clearing the remaining
@@ -222,15 +273,66 @@ hzl_ServerInitStartAllSessions(hzl_ServerCtx_t* const ctx)
         err = hzl_NonZeroTrng(ctx->groupStates[i].currentStk, ctx->io.trng, HZL_STK_LEN);
         HZL_ERR_CHECK(err);
         hzl_ZeroOut(ctx->groupStates[i].previousStk, HZL_STK_LEN);
+        ctx->groupStates[i].isRenewalPhaseActive = false;
+#ifdef HZL_THREAD_SAFE
+        HZL_LOCK_INIT(&ctx->groupStates[i].lock);
+        HZL_SESSION_SEQ_INIT(&ctx->groupStates[i].sessionSeq);
+#else
+        hzl_ZeroOut(ctx->groupStates[i].unusedPadding, sizeof(ctx->groupStates[i].unusedPadding));
+#endif
+        hzl_ZeroOut(ctx->groupStates[i].renHashMidstate,
+                    sizeof(ctx->groupStates[i].renHashMidstate));
     }
     return err;
 }
 
+/** @internal Precomputes the hash state after `LTK || label` of the Requests of each Client,
+ * if the optional Client states are provided. */
+static void
+hzl_ServerInitClientStates(hzl_ServerCtx_t* const ctx)
+{
+    if (ctx->clientStates == NULL) { return; }
+    hzl_Hash_t hash;
+    for (size_t i = 0; i < ctx->serverConfig->amountOfClients; i++)
+    {
+        hzl_ReqHashInitKeyed(&hash, ctx->clientConfigs[i].ltk);
+        hzl_HashSaveMidstate(ctx->clientStates[i].reqHashMidstate, &hash);
+    }
+    hzl_ZeroOut(&hash, sizeof(hash));
+}
+
+/** @internal Schedules the Session expiration of all Groups in the timer wheel and
+ * generates the STKs of their next Sessions, if the optional Group timers are provided. */
+static hzl_Err_t
+hzl_ServerInitGroupTimers(hzl_ServerCtx_t* const ctx)
+{
+    if (ctx->groupTimers == NULL) { return HZL_OK; }
+    HZL_ERR_DECLARE(err);
+    hzl_Timestamp_t now;
+    err = ctx->io.currentTime(&now);
+    HZL_ERR_CHECK(err);
+    hzl_ServerTimerWheelInit(ctx, now);  // Also zeroing all next STKs
+    for (size_t i = 0; i < ctx->serverConfig->amountOfGroups; i++)
+    {
+        hzl_ServerTimerWheelSchedule(ctx, (hzl_Gid_t) i, now,
+                                     hzl_ServerSessionNextEventDelay(ctx, now, (hzl_Gid_t) i));
+    }
+    // The first renewals already find their STK
+    return hzl_ServerNextStksPrepare(ctx);
+}
+
 HZL_API hzl_Err_t
 hzl_ServerInit(hzl_ServerCtx_t* const ctx)
 {
     HZL_ERR_DECLARE(err);
     err = hzl_ServerCheckCtx(ctx);
     HZL_ERR_CHECK(err);
-    return hzl_ServerInitStartAllSessions(ctx);
+    hzl_HeaderCodecInit(&ctx->header, ctx->serverConfig->headerType,
+                        ctx->serverConfig->headerPlacement);
+    hzl_CommonSadtpRxClearAll(ctx->sadtpRxBuffers, ctx->amountOfSadtpRxBuffers);
+    HZL_LOCK_INIT(&ctx->sadtpRxBuffersLock);
+    hzl_ServerInitClientStates(ctx);
+    err = hzl_ServerInitStartAllSessions(ctx);
+    HZL_ERR_CHECK(err);
+    return hzl_ServerInitGroupTimers(ctx);
 }
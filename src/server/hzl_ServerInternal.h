@@ -46,10 +46,30 @@ extern "C"
 
 /** Double-checking that the bitmap can hold the max amount of Clients. */
 _Static_assert(
-        sizeof(hzl_ServerBitMap_t) * 8U <= HZL_SERVER_MAX_AMOUNT_OF_CLIENTS,
+        sizeof(hzl_ServerBitMap_t) * 8U >= HZL_SERVER_MAX_AMOUNT_OF_CLIENTS,
         "The bitmap of Clients in the Group must be large enough to support "
         "the max amount of Clients.");
 
+/** @internal Amount of bits in each word of #hzl_ServerBitMap_t. */
+#define HZL_SERVER_BITMAP_WORD_BITS 64U
+
+/**
+ * @internal
+ * True if the Client with the given SID is in the bitmap. Constant time.
+ *
+ * @param [in] bitmap the set of Clients
+ * @param [in] sid of a Client, thus not the Server's one.
+ */
+inline static bool
+hzl_ServerBitMapHasSid(const hzl_ServerBitMap_t* const bitmap,
+                       const hzl_Sid_t sid)
+{
+    // SID 0 is server: SID 1 maps to bit at index 0, SID 2 to index 1 etc.
+    const uint32_t bitIdx = (uint32_t) sid - 1U;
+    return (bitmap->words[bitIdx / HZL_SERVER_BITMAP_WORD_BITS]
+            >> (bitIdx % HZL_SERVER_BITMAP_WORD_BITS)) & 1U;
+}
+
 /**
  * @internal
  * Verifies only the pointers to the context itself, its data structures
@@ -64,12 +84,27 @@ hzl_ServerCheckCtxPointers(const hzl_ServerCtx_t* ctx);
 
 /**
  * @internal
- * Increments the Group's Counter Nonce by 1, unless its upper limit was reached and the Nonce
- * is already expired.
+ * Reserves a range of consecutive Counter Nonces of the Group's current Session at once,
+ * together with a copy of the STK of the same Session, to encrypt with them.
+ *
+ * The Counter Nonce saturates at its upper limit, so the reserved values beyond it are all
+ * equal to #HZL_MAX_CTRNONCE.
+ * When built with #HZL_THREAD_SAFE it does not take the Group lock: it reads the Session
+ * again if a new one was started meanwhile, skipping the Counter Nonces reserved the first time.
+ *
+ * @param [out] stk where to copy the STK. Zeroed if no Client can receive yet.
+ * @param [out] firstCtrnonce first reserved Counter Nonce
+ * @param [in] ctx with the Group state
+ * @param [in] groupId of a Group within the configuration
+ * @param [in] amount of Counter Nonces to reserve.
+ * @return the same as hzl_ServerDidAnyClientAlreadyRequest(): when false, nothing is reserved.
  */
-void
-hzl_ServerGroupIncrCurrentCtrnonce(const hzl_ServerCtx_t* ctx,
-                                   hzl_Gid_t groupId);
+bool
+hzl_ServerGroupReserveCurrentCtrnonces(uint8_t* stk,
+                                       hzl_CtrNonce_t* firstCtrnonce,
+                                       const hzl_ServerCtx_t* ctx,
+                                       hzl_Gid_t groupId,
+                                       size_t amount);
 
 /**
  * @internal
@@ -80,6 +115,33 @@ void
 hzl_ServerGroupIncrPreviousCtrnonce(const hzl_ServerCtx_t* ctx,
                                     hzl_Gid_t groupId);
 
+/**
+ * @internal
+ * Checks the freshness of a received Counter Nonce against the local one of the Group.
+ *
+ * @param [out] isPreviousSession true if the Counter Nonce belongs to the previous Session
+ *        during a Session renewal phase. May be NULL to only consider the current Session.
+ *
+ * @retval #HZL_OK if the Counter Nonce is fresh enough
+ * @retval #HZL_ERR_SECWARN_RECEIVED_OVERFLOWN_NONCE if it reached its upper limit
+ * @retval #HZL_ERR_SECWARN_OLD_MESSAGE if it is too old
+ */
+hzl_Err_t
+hzl_ServerCheckRxCtrnonce(bool* isPreviousSession,
+                          const hzl_ServerCtx_t* ctx,
+                          hzl_CtrNonce_t receivedCtrnonce,
+                          hzl_Timestamp_t rxTimestamp,
+                          hzl_Gid_t gid);
+
+/** @internal Stores the Counter Nonce and timestamp of a valid received message
+ * of the current or previous Session. */
+void
+hzl_ServerGroupUpdateCtrnonceAndRxTimestamp(const hzl_ServerCtx_t* ctx,
+                                            hzl_CtrNonce_t receivedCtrnonce,
+                                            hzl_Timestamp_t receptionTimestamp,
+                                            bool isPreviousSession,
+                                            hzl_Gid_t gid);
+
 /** @internal Checks if the current Session is expired and, if so, it generates a new one,
  * builds a REN message as reaction PDU and starts the renewal phase. */
 hzl_Err_t
@@ -127,6 +189,120 @@ hzl_ServerUpdateCurrentRxLastMessageInstant(const hzl_ServerCtx_t* ctx,
                                             hzl_Timestamp_t rxTimestamp,
                                             hzl_Gid_t gid);
 
+/** @internal Milliseconds from \p now to the next time-driven event of the Group: the
+ * expiration of its Session or, during the renewal phase, the next REN notification or the
+ * end of the phase, whichever comes first. Zero if the event is already due. */
+hzl_TimeDeltaMillis_t
+hzl_ServerSessionNextEventDelay(const hzl_ServerCtx_t* ctx,
+                                hzl_Timestamp_t now,
+                                hzl_Gid_t gid);
+
+/**
+ * @internal
+ * Runs the time-driven event of a Group whose timer expired.
+ *
+ * Exits the renewal phase if it is over, builds the periodic REN notification during it or
+ * renews the Session if expired, building a REN message only if some Client can validate it.
+ *
+ * @param [out] renewalPdu where to build the REN message, if any. Its length is 0 when no
+ *        message was built. May be NULL when there is no space left, in which case the REN
+ *        message is not built and the event stays due.
+ * @param [out] nextEventDelay milliseconds from \p now to the next event of the Group.
+ */
+hzl_Err_t
+hzl_ServerSessionOnTimer(hzl_CbsPduMsg_t* renewalPdu,
+                         hzl_TimeDeltaMillis_t* nextEventDelay,
+                         hzl_ServerCtx_t* ctx,
+                         hzl_Timestamp_t now,
+                         hzl_Gid_t gid);
+
+/** @internal Empties the timer wheel and marks all Group timers as not scheduled, setting
+ * the wheel's time to \p now. */
+void
+hzl_ServerTimerWheelInit(hzl_ServerCtx_t* ctx,
+                         hzl_Timestamp_t now);
+
+/**
+ * @internal
+ * Empties the timer wheel, sets its time to \p now and schedules again the timers of the
+ * Groups with `gid % gidStep == firstGid` at their next event according to their state.
+ * The timers of the other Groups are left untouched, so they may be linked into another
+ * timer wheel, e.g. the one of another shard. Does nothing if the context has no Group timers.
+ */
+void
+hzl_ServerTimerWheelRebuild(hzl_ServerCtx_t* ctx,
+                            hzl_Timestamp_t now,
+                            size_t firstGid,
+                            size_t gidStep);
+
+/**
+ * @internal
+ * Schedules the timer of the Group to expire \p delay milliseconds after \p now, moving it
+ * if already scheduled. Delays of 0 expire at the next millisecond of the wheel, delays beyond
+ * the wheel span are shortened to it. Does nothing if the context has no Group timers.
+ */
+void
+hzl_ServerTimerWheelSchedule(hzl_ServerCtx_t* ctx,
+                             hzl_Gid_t gid,
+                             hzl_Timestamp_t now,
+                             hzl_TimeDeltaMillis_t delay);
+
+/**
+ * @internal
+ * Advances the timer wheel up to \p now, unscheduling the expired Group timers.
+ *
+ * @param [out] dueGroups GIDs of the Groups whose timer expired. At least as long as
+ *        the amount of Groups.
+ * @return the amount of GIDs written into \p dueGroups.
+ */
+size_t
+hzl_ServerTimerWheelAdvance(hzl_Gid_t* dueGroups,
+                            hzl_ServerCtx_t* ctx,
+                            hzl_Timestamp_t now);
+
+/**
+ * @internal
+ * Moves the pre-generated STK of the next Session of the Group into \p stk, leaving it all
+ * zeros to be generated again by hzl_ServerNextStksPrepare(). To be called with the lock
+ * of the Group state held.
+ *
+ * @return false if there is no pre-generated STK, either because the context has no Group
+ *         timers or because it was not generated yet, leaving \p stk untouched.
+ */
+bool
+hzl_ServerNextStkTake(uint8_t* stk,
+                      hzl_ServerCtx_t* ctx,
+                      hzl_Gid_t gid);
+
+/** @internal Generates the STKs of the next Sessions taken since the last call, i.e. the
+ * all-zero ones, with the Group timers known to exist. Implements
+ * hzl_ServerPrepareNextSessions(). */
+hzl_Err_t
+hzl_ServerNextStksPrepare(hzl_ServerCtx_t* ctx);
+
+#ifdef HZL_THREAD_SAFE
+
+/**
+ * @internal
+ * Takes the lock of the Group state, to work on it without other threads altering it.
+ * Does nothing for GIDs outside of the configuration, which have no state.
+ */
+void
+hzl_ServerGroupLock(const hzl_ServerCtx_t* ctx,
+                    hzl_Gid_t gid);
+
+/** @internal Releases the lock taken with hzl_ServerGroupLock() with the same GID. */
+void
+hzl_ServerGroupUnlock(const hzl_ServerCtx_t* ctx,
+                      hzl_Gid_t gid);
+
+#else
+
+#define hzl_ServerGroupLock(ctx, gid)
+#define hzl_ServerGroupUnlock(ctx, gid)
+
+#endif  /* HZL_THREAD_SAFE */
+
 #ifdef __cplusplus
 }
 #endif
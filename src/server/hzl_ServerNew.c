@@ -49,10 +49,20 @@ hzl_LoadBytes(uint8_t* const bytes, FILE* const fileStream, const size_t amount)
     return HZL_OK;
 }
 
-/** @internal Verifies the file starts with `"HZLs\0" = {0x68, 0x7A, 0x73, 0x00}`
- * to double check the correct binary file was selected. */
+/** @internal Format of the original configuration files, with 32-bit Client bitmaps. */
+#define HZL_SERVER_FILE_FORMAT_BITMAP32 0U
+/** @internal Format of the configuration files with #hzl_ServerBitMap_t-sized Client
+ * bitmaps, supporting up to #HZL_SERVER_MAX_AMOUNT_OF_CLIENTS Clients. */
+#define HZL_SERVER_FILE_FORMAT_BITMAP256 1U
+/** @internal Format of the configuration files like #HZL_SERVER_FILE_FORMAT_BITMAP256,
+ * with the #hzl_ServerConfig_t.headerPlacement byte. */
+#define HZL_SERVER_FILE_FORMAT_HEADER_PLACEMENT 2U
+
+/** @internal Verifies the file starts with `"HZLs" = {0x48, 0x5A, 0x4C, 0x73}`
+ * to double check the correct binary file was selected, followed by a byte with a
+ * known file format version. */
 static hzl_Err_t
-hzl_CheckMagicNumber(FILE* const fileStream)
+hzl_CheckMagicNumber(uint8_t* const formatVersion, FILE* const fileStream)
 {
     HZL_ERR_DECLARE(err);
     uint8_t magicNumber[5U] = {0};
@@ -62,10 +72,11 @@ hzl_CheckMagicNumber(FILE* const fileStream)
         || magicNumber[1] != 'Z'
         || magicNumber[2] != 'L'
         || magicNumber[3] != 's'
-        || magicNumber[4] != '\0')
+        || magicNumber[4] > HZL_SERVER_FILE_FORMAT_HEADER_PLACEMENT)
     {
         return HZL_ERR_INVALID_FILE_MAGIC_NUMBER;
     }
+    *formatVersion = magicNumber[4];
     return err;
 }
 
@@ -80,6 +91,32 @@ hzl_LoadUint32Le(uint32_t* const value, FILE* const fileStream)
     return err;
 }
 
+/** @internal Loads the bitmap of Clients in a Group from the file, as a uint32 in
+ * Little Endian encoding for the original file format or as 32 bytes (LSB first) otherwise. */
+static hzl_Err_t
+hzl_LoadBitMap(hzl_ServerBitMap_t* const bitmap,
+               FILE* const fileStream,
+               const uint8_t formatVersion)
+{
+    HZL_ERR_DECLARE(err);
+    hzl_ZeroOut(bitmap, sizeof(hzl_ServerBitMap_t));
+    if (formatVersion == HZL_SERVER_FILE_FORMAT_BITMAP32)
+    {
+        uint32_t narrowBitmap = 0U;
+        err = hzl_LoadUint32Le(&narrowBitmap, fileStream);
+        bitmap->words[0] = narrowBitmap;
+        return err;
+    }
+    uint8_t bytes[sizeof(hzl_ServerBitMap_t)] = {0};
+    err = hzl_LoadBytes(bytes, fileStream, sizeof(bytes));
+    for (size_t i = 0U; i < sizeof(bytes); i++)
+    {
+        bitmap->words[i / sizeof(uint64_t)] |=
+                (uint64_t) bytes[i] << (8U * (i % sizeof(uint64_t)));
+    }
+    return err;
+}
+
 /** @internal Loads a uint16 in Little Endian encoding from the file. */
 static hzl_Err_t
 hzl_LoadUint16Le(uint16_t* const value, FILE* const fileStream)
@@ -100,7 +137,9 @@ hzl_LoadUint8(uint8_t* const value, FILE* const fileStream)
 
 /** @internal Loads the Server Configuration structure from the file. */
 inline static hzl_Err_t
-hzl_LoadServerConfig(hzl_ServerConfig_t* const config, FILE* const fileStream)
+hzl_LoadServerConfig(hzl_ServerConfig_t* const config,
+                     FILE* const fileStream,
+                     const uint8_t formatVersion)
 {
     HZL_ERR_DECLARE(err);
     err = hzl_LoadUint8(&config->amountOfGroups, fileStream);
@@ -108,6 +147,11 @@ hzl_LoadServerConfig(hzl_ServerConfig_t* const config, FILE* const fileStream)
     err = hzl_LoadUint8(&config->amountOfClients, fileStream);
     HZL_ERR_CHECK(err);
     err = hzl_LoadUint8(&config->headerType, fileStream);
+    HZL_ERR_CHECK(err);
+    if (formatVersion >= HZL_SERVER_FILE_FORMAT_HEADER_PLACEMENT)
+    {
+        err = hzl_LoadUint8(&config->headerPlacement, fileStream);
+    }
     return err;
 }
 
@@ -124,7 +168,9 @@ hzl_LoadClientConfig(hzl_ServerClientConfig_t* const client, FILE* const fileStr
 
 /** @internal Loads a single Group configuration structure from the file. */
 inline static hzl_Err_t
-hzl_LoadGroupConfig(hzl_ServerGroupConfig_t* const group, FILE* const fileStream)
+hzl_LoadGroupConfig(hzl_ServerGroupConfig_t* const group,
+                    FILE* const fileStream,
+                    const uint8_t formatVersion)
 {
     HZL_ERR_DECLARE(err);
     err = hzl_LoadUint32Le(&group->maxCtrnonceDelayMsgs, fileStream);
@@ -135,7 +181,7 @@ hzl_LoadGroupConfig(hzl_ServerGroupConfig_t* const group, FILE* const fileStream
     HZL_ERR_CHECK(err);
     err = hzl_LoadUint32Le(&group->delayBetweenRenNotificationsMillis, fileStream);
     HZL_ERR_CHECK(err);
-    err = hzl_LoadUint32Le(&group->clientSidsInGroupBitmap, fileStream);
+    err = hzl_LoadBitMap(&group->clientSidsInGroupBitmap, fileStream, formatVersion);
     HZL_ERR_CHECK(err);
     err = hzl_LoadUint16Le(&group->maxSilenceIntervalMillis, fileStream);
     HZL_ERR_CHECK(err);
@@ -152,12 +198,13 @@ hzl_ServerNew(hzl_ServerCtx_t** const pCtx,
     HZL_ERR_DECLARE(err);
     FILE* fileStream = NULL;
     hzl_ServerCtx_t* ctx = NULL;
+    uint8_t formatVersion = HZL_SERVER_FILE_FORMAT_BITMAP32;
     if (pCtx == NULL) { return HZL_ERR_NULL_CTX; }
     *pCtx = NULL;  // Empty output in case of allocation errors.
     if (fileName == NULL) { return HZL_ERR_NULL_FILENAME; }
     fileStream = fopen(fileName, "r");
     if (fileStream == NULL) { return HZL_ERR_CANNOT_OPEN_CONFIG_FILE; }
-    err = hzl_CheckMagicNumber(fileStream);
+    err = hzl_CheckMagicNumber(&formatVersion, fileStream);
     HZL_ERR_CLEANUP(err);
     // At this point, the file was successfully opened and seems to be of the correct format.
     ctx = calloc(1U, sizeof(hzl_ServerCtx_t));
@@ -174,7 +221,8 @@ hzl_ServerNew(hzl_ServerCtx_t** const pCtx,
     }
     // Here we force the pointer to the constant configuration to be writable just once
     // because we have to fill the configuration in the first place.
-    err = hzl_LoadServerConfig((hzl_ServerConfig_t*) ctx->serverConfig, fileStream);
+    err = hzl_LoadServerConfig((hzl_ServerConfig_t*) ctx->serverConfig, fileStream,
+                               formatVersion);
     HZL_ERR_CLEANUP(err);
     ctx->clientConfigs = calloc(ctx->serverConfig->amountOfClients,
                                 sizeof(hzl_ServerClientConfig_t));
@@ -206,7 +254,7 @@ hzl_ServerNew(hzl_ServerCtx_t** const pCtx,
         // because we have to fill the configuration in the first place.
         err = hzl_LoadGroupConfig(
                 (hzl_ServerGroupConfig_t*) &ctx->groupConfigs[group],
-                fileStream);
+                fileStream, formatVersion);
         HZL_ERR_CLEANUP(err);
     }
     ctx->groupStates = calloc(
@@ -216,6 +264,20 @@ hzl_ServerNew(hzl_ServerCtx_t** const pCtx,
         err = HZL_ERR_MALLOC_FAILED;
         goto cleanup;
     }
+    ctx->clientStates = calloc(
+            ctx->serverConfig->amountOfClients, sizeof(hzl_ServerClientState_t));
+    if (ctx->clientStates == NULL)
+    {
+        err = HZL_ERR_MALLOC_FAILED;
+        goto cleanup;
+    }
+    ctx->groupTimers = calloc(
+            ctx->serverConfig->amountOfGroups, sizeof(hzl_ServerGroupTimer_t));
+    if (ctx->groupTimers == NULL)
+    {
+        err = HZL_ERR_MALLOC_FAILED;
+        goto cleanup;
+    }
     ctx->io.currentTime = hzl_OsCurrentTime;
     ctx->io.trng = hzl_OsTrng;
     err = hzl_ServerInit(ctx);
@@ -0,0 +1,101 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Implementation of the hzl_ServerPrepareNextSessions() function and of the pre-generated
+ * STKs of the next Sessions it refills.
+ */
+
+#include "hzl.h"
+#include "hzl_Server.h"
+#include "hzl_ServerInternal.h"
+#include "hzl_CommonInternal.h"
+
+bool
+hzl_ServerNextStkTake(uint8_t* const stk,
+                      hzl_ServerCtx_t* const ctx,
+                      const hzl_Gid_t gid)
+{
+    if (ctx->groupTimers == NULL
+        || hzl_IsAllZeros(ctx->groupTimers[gid].nextStk, HZL_STK_LEN))
+    {
+        return false;
+    }
+    memcpy(stk, ctx->groupTimers[gid].nextStk, HZL_STK_LEN);
+    hzl_ZeroOut(ctx->groupTimers[gid].nextStk, HZL_STK_LEN);
+    return true;
+}
+
+/** @internal True if the next STK of the Group was taken and must be generated again. */
+static bool
+hzl_ServerNextStkIsMissing(hzl_ServerCtx_t* const ctx,
+                           const hzl_Gid_t gid)
+{
+    hzl_ServerGroupLock(ctx, gid);
+    const bool isMissing = hzl_IsAllZeros(ctx->groupTimers[gid].nextStk, HZL_STK_LEN);
+    hzl_ServerGroupUnlock(ctx, gid);
+    return isMissing;
+}
+
+hzl_Err_t
+hzl_ServerNextStksPrepare(hzl_ServerCtx_t* const ctx)
+{
+    // The missing STKs are the all-zero ones in the Group timers, which are shared by all
+    // copies of the context (e.g. by the shards), so any of them may have taken them.
+    hzl_Err_t err = HZL_OK;
+    uint8_t stk[HZL_STK_LEN];
+    for (size_t i = 0U; i < ctx->serverConfig->amountOfGroups; i++)
+    {
+        const hzl_Gid_t gid = (hzl_Gid_t) i;
+        if (!hzl_ServerNextStkIsMissing(ctx, gid)) { continue; }
+        // Generated without holding the Group lock, the slowest part.
+        err = hzl_NonZeroTrng(stk, ctx->io.trng, HZL_STK_LEN);
+        if (err != HZL_OK) { break; }  // The remaining ones are retried at the next call
+        hzl_ServerGroupLock(ctx, gid);
+        // Another thread may have refilled it meanwhile.
+        if (hzl_IsAllZeros(ctx->groupTimers[gid].nextStk, HZL_STK_LEN))
+        {
+            memcpy(ctx->groupTimers[gid].nextStk, stk, HZL_STK_LEN);
+        }
+        hzl_ServerGroupUnlock(ctx, gid);
+    }
+    hzl_ZeroOut(stk, HZL_STK_LEN);
+    return err;
+}
+
+HZL_API hzl_Err_t
+hzl_ServerPrepareNextSessions(hzl_ServerCtx_t* const ctx)
+{
+    HZL_ERR_DECLARE(err);
+    err = hzl_ServerCheckCtxPointers(ctx);
+    HZL_ERR_CHECK(err);
+    if (ctx->groupTimers == NULL) { return HZL_ERR_NULL_GROUP_TIMERS; }
+    return hzl_ServerNextStksPrepare(ctx);
+}
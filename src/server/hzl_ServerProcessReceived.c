@@ -29,7 +29,8 @@
 /**
  * @file
  * @internal
- * Implementation of the hzl_ServerProcessReceived() function.
+ * Implementation of the hzl_ServerProcessReceived() function and of the message-type dispatch
+ * shared with hzl_ServerProcessReceivedBatch().
  */
 
 #include "hzl.h"
@@ -50,6 +51,8 @@ hzl_ServerProcessReceived(hzl_CbsPduMsg_t* const reactionPdu,
     HZL_ERR_DECLARE(err);
     err = hzl_ServerCheckCtxPointers(ctx);
     HZL_ERR_CHECK(err);
+    // The SADTP messages returned by the earlier calls of this thread are not read anymore
+    hzl_CommonSadtpRxCallBegin();
     // Get the RX timestamp ASAP to reduce the delays
     hzl_Timestamp_t rxTimestamp = 0;
     err = ctx->io.currentTime(&rxTimestamp);
@@ -59,36 +62,74 @@ hzl_ServerProcessReceived(hzl_CbsPduMsg_t* const reactionPdu,
     hzl_ZeroOut(receivedUserData, sizeof(hzl_RxSduMsg_t));
     hzl_ZeroOut(reactionPdu, sizeof(hzl_CbsPduMsg_t));
     HZL_ERR_CHECK(err); // Return from any error of currentTime() only after the cleanups
-    hzl_Header_t unpackedHdr;
-    err = hzl_CommonCheckReceivedGenericMsg(
-            &unpackedHdr, receivedPdu, receivedPduLen,
-            HZL_SERVER_SID, ctx->serverConfig->headerType);
-    HZL_ERR_CHECK(err);
-    receivedUserData->canId = receivedCanId;
-    switch (unpackedHdr.pty)
+    return hzl_ServerProcessReceivedDispatch(
+            reactionPdu, receivedUserData, ctx,
+            receivedPdu, receivedPduLen, receivedCanId, rxTimestamp, NULL);
+}
+
+/** @internal Handles the received message according to its payload type. */
+inline static hzl_Err_t
+hzl_ServerProcessReceivedByType(hzl_CbsPduMsg_t* const reactionPdu,
+                                hzl_RxSduMsg_t* const receivedUserData,
+                                hzl_ServerCtx_t* const ctx,
+                                const uint8_t* const receivedPdu,
+                                const size_t receivedPduLen,
+                                const hzl_Header_t* const unpackedHdr,
+                                const hzl_Timestamp_t rxTimestamp,
+                                hzl_ServerSadfdPrecomputed_t* const precomputed)
+{
+    switch (unpackedHdr->pty)
     {
         case HZL_PTY_REQ:
             return hzl_ServerProcessReceivedRequest(
                     reactionPdu, ctx,
-                    receivedPdu, receivedPduLen, &unpackedHdr, rxTimestamp);
+                    receivedPdu, receivedPduLen, unpackedHdr, rxTimestamp);
 
         case HZL_PTY_RES: // Fall-through to Server-only-msg error
         case HZL_PTY_REN:return HZL_ERR_SECWARN_SERVER_ONLY_MESSAGE;
 
-        case HZL_PTY_SADTP:return HZL_ERR_PROGRAMMING; // TODO to be implemented
+        case HZL_PTY_SADTP:
+            return hzl_ServerProcessReceivedSecuredTp(
+                    reactionPdu, receivedUserData,
+                    ctx, receivedPdu, receivedPduLen, unpackedHdr, rxTimestamp);
 
         case HZL_PTY_SADFD:
             return hzl_ServerProcessReceivedSecuredFd(
-                    reactionPdu, receivedUserData,
-                    ctx, receivedPdu, receivedPduLen, &unpackedHdr, rxTimestamp);
+                    reactionPdu, receivedUserData, receivedUserData->data,
+                    ctx, receivedPdu, receivedPduLen, unpackedHdr, rxTimestamp, precomputed);
 
         case HZL_PTY_UAD:
             return hzl_CommonProcessReceivedUnsecured(
                     receivedUserData, receivedPdu,
-                    receivedPduLen, &unpackedHdr, ctx->serverConfig->headerType);
+                    receivedPduLen, unpackedHdr, &ctx->header);
 
         case HZL_PTY_RFU1:  // Fall-through to default
         case HZL_PTY_RFU2:  // Fall-through to default
         default:return HZL_ERR_INVALID_PAYLOAD_TYPE;
     }
 }
+
+hzl_Err_t
+hzl_ServerProcessReceivedDispatch(hzl_CbsPduMsg_t* const reactionPdu,
+                                  hzl_RxSduMsg_t* const receivedUserData,
+                                  hzl_ServerCtx_t* const ctx,
+                                  const uint8_t* const receivedPdu,
+                                  const size_t receivedPduLen,
+                                  const hzl_CanId_t receivedCanId,
+                                  const hzl_Timestamp_t rxTimestamp,
+                                  hzl_ServerSadfdPrecomputed_t* const precomputed)
+{
+    HZL_ERR_DECLARE(err);
+    hzl_Header_t unpackedHdr;
+    err = hzl_CommonCheckReceivedGenericMsg(
+            &unpackedHdr, receivedPdu, receivedPduLen, receivedCanId,
+            HZL_SERVER_SID, &ctx->header);
+    HZL_ERR_CHECK(err);
+    receivedUserData->canId = receivedCanId;
+    hzl_ServerGroupLock(ctx, unpackedHdr.gid);
+    err = hzl_ServerProcessReceivedByType(
+            reactionPdu, receivedUserData, ctx,
+            receivedPdu, receivedPduLen, &unpackedHdr, rxTimestamp, precomputed);
+    hzl_ServerGroupUnlock(ctx, unpackedHdr.gid);
+    return err;
+}
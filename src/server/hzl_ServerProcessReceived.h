@@ -42,6 +42,68 @@ extern "C"
 
 #include "hzl_CommonInternal.h"
 #include "hzl_CommonHeader.h"
+#include "hzl_CommonAead.h"
+#include "hzl_CommonPayload.h"
+
+/**
+ * @internal
+ * Decryption of a received SADFD message prepared ahead of its sequential processing,
+ * to decrypt the messages of a batch together.
+ *
+ * The STK is chosen with the Group state at preparation time. The result is used only if
+ * the processing of the message chooses the same STK, otherwise the message is decrypted
+ * again, so the outcome is the same as processing the messages one by one.
+ */
+typedef struct hzl_ServerSadfdPrecomputed
+{
+    /** Decryption job, in the array passed to hzl_AeadDecryptBatch(). */
+    const hzl_AeadJob_t* job;
+    /** Copy of the STK used by the job, to check it is still the one to use. */
+    uint8_t stk[HZL_STK_LEN];
+    /** AEAD-nonce used by the job. */
+    uint8_t aeadNonce[HZL_AEAD_NONCE_LEN];
+    /** Associated data used by the job. */
+    uint8_t assocData[HZL_SADFD_AD_LEN];
+    /** True if the message is a SADFD message and the job is prepared for it. */
+    bool isPrepared;
+    /**
+     * True once hzl_ServerProcessReceivedSecuredFd() reached the decryption of the message,
+     * either using the result of the job or decrypting it again.
+     */
+    bool isConsumed;
+} hzl_ServerSadfdPrecomputed_t;
+
+/**
+ * @internal
+ * Unpacks the header of an already-timestamped received message and dispatches it to the
+ * handler of its payload type.
+ *
+ * Does not check the context, nor clears the output locations: the caller must have done it
+ * already. Shared by hzl_ServerProcessReceived() and hzl_ServerProcessReceivedBatch().
+ * Holds the lock of the Group of the message while handling it.
+ *
+ * @param [out] reactionPdu generated reaction message, if any. Already cleared.
+ * @param [out] receivedUserData unpacked data of the received message. Already cleared.
+ * @param [in, out] ctx to access the configurations and alter the Group states. Already checked.
+ * @param [in] receivedPdu received raw CBS message
+ * @param [in] receivedPduLen length of \p receivedPdu in bytes
+ * @param [in] receivedCanId identifier of the underlying layer's PDU
+ * @param [in] rxTimestamp timestamp of reception of the message
+ * @param [in, out] precomputed decryption of the message if it is a SADFD message,
+ *        performed in advance by hzl_ServerProcessReceivedBatch(). May be NULL.
+ *
+ * @return #HZL_OK on success or the proper error code if something is incorrect with the
+ *        message or with the local state
+ */
+hzl_Err_t
+hzl_ServerProcessReceivedDispatch(hzl_CbsPduMsg_t* reactionPdu,
+                                  hzl_RxSduMsg_t* receivedUserData,
+                                  hzl_ServerCtx_t* ctx,
+                                  const uint8_t* receivedPdu,
+                                  size_t receivedPduLen,
+                                  hzl_CanId_t receivedCanId,
+                                  hzl_Timestamp_t rxTimestamp,
+                                  hzl_ServerSadfdPrecomputed_t* precomputed);
 
 /** @internal Validates the GID and SID of the received message. */
 hzl_Err_t
@@ -76,12 +138,16 @@ hzl_ServerProcessReceivedRequest(hzl_CbsPduMsg_t* msgToTx,
  * Validates, decrypts and handles a received SADFD message, updating the local Counter Nonce.
  *
  * @param [out] reactionPdu REN message, generated if required. Contains 0 bytes of data otherwise.
- * @param [out] unpackedMsg decrypted, validated and unpacked data contained in the SADFD message
+ * @param [out] unpackedMsg validated and unpacked metadata of the SADFD message
+ * @param [out] plaintext where to decrypt the user data, either unpackedMsg->data or the
+ *        ciphertext field of \p rxPdu itself to decrypt in place
  * @param [in, out] ctx to access the Group configuration and alter its state
  * @param [in] rxPdu received raw SADFD message
  * @param [in] rxPduLen length of \p rxPdu in bytes
  * @param [in] unpackedSadfdHeader metadata of the CBS message in unpacked format
  * @param [in] rxTimestamp timestamp of reception of the SADFD message
+ * @param [in, out] precomputed decryption performed in advance, used if prepared with the
+ *        same STK. May be NULL.
  *
  * @return #HZL_OK on success or the proper error code if something is incorrect with the
  *        message or with the local state
@@ -89,19 +155,50 @@ hzl_ServerProcessReceivedRequest(hzl_CbsPduMsg_t* msgToTx,
 hzl_Err_t
 hzl_ServerProcessReceivedSecuredFd(hzl_CbsPduMsg_t* reactionPdu,
                                    hzl_RxSduMsg_t* unpackedMsg,
+                                   uint8_t* plaintext,
                                    hzl_ServerCtx_t* ctx,
                                    const uint8_t* rxPdu,
                                    size_t rxPduLen,
                                    const hzl_Header_t* unpackedSadfdHeader,
-                                   hzl_Timestamp_t rxTimestamp);
+                                   hzl_Timestamp_t rxTimestamp,
+                                   hzl_ServerSadfdPrecomputed_t* precomputed);
 
 /**
  * @internal
- * Validates, decrypts and handles a received SADTP message, updating the local Counter Nonce.
+ * Prepares the decryption of a received message, if it is a SADFD message that would pass
+ * the checks before its decryption with the current Group state, without altering it.
  *
- * @param [out] unpackedMsg decrypted, validated and unpacked data contained in the SADFD message
+ * @param [out] precomputed to fill, including the \p job it points to
+ * @param [out] job decryption to prepare, writing the plaintext into \p plaintext
+ * @param [out] plaintext where to decrypt the data to, at least #HZL_MAX_CAN_FD_DATA_LEN bytes
+ * @param [in] ctx to access the Group configuration and state. Already checked.
+ * @param [in] rxPdu received raw message
+ * @param [in] rxPduLen length of \p rxPdu in bytes
+ * @param [in] rxCanId CAN ID of the received message, carrying the header if so configured
+ * @param [in] rxTimestamp timestamp of reception of the message
+ *
+ * @return true if the job was prepared, false if the message must be processed normally
+ */
+bool
+hzl_ServerPrepareSecuredFdDecryption(hzl_ServerSadfdPrecomputed_t* precomputed,
+                                     hzl_AeadJob_t* job,
+                                     uint8_t* plaintext,
+                                     const hzl_ServerCtx_t* ctx,
+                                     const uint8_t* rxPdu,
+                                     size_t rxPduLen,
+                                     hzl_CanId_t rxCanId,
+                                     hzl_Timestamp_t rxTimestamp);
+
+/**
+ * @internal
+ * Validates, decrypts and reassembles a received SADTP fragment, updating the local Counter
+ * Nonce once the whole message is received and valid.
+ *
+ * @param [out] reactionPdu REN message, generated if required. Contains 0 bytes of data otherwise.
+ * @param [out] unpackedMsg metadata of the reassembled message, pointing to its data
+ *        in the reception buffer. Not for the user until the last fragment.
  * @param [in, out] ctx to access the Group configuration and alter its state
- * @param [in] rxPdu received raw SADTP message
+ * @param [in] rxPdu received raw SADTP fragment
  * @param [in] rxPduLen length of \p rxPdu in bytes
  * @param [in] unpackedSadtpHeader metadata of the CBS message in unpacked format
  * @param [in] rxTimestamp timestamp of reception
@@ -110,8 +207,9 @@ hzl_ServerProcessReceivedSecuredFd(hzl_CbsPduMsg_t* reactionPdu,
  *        message or with the local state
  */
 hzl_Err_t
-hzl_ServerProcessReceivedSecuredTp(hzl_RxSduMsg_t* unpackedMsg,
-                                   const hzl_ServerCtx_t* ctx,
+hzl_ServerProcessReceivedSecuredTp(hzl_CbsPduMsg_t* reactionPdu,
+                                   hzl_RxSduMsg_t* unpackedMsg,
+                                   hzl_ServerCtx_t* ctx,
                                    const uint8_t* rxPdu,
                                    size_t rxPduLen,
                                    const hzl_Header_t* unpackedSadtpHeader,
@@ -0,0 +1,113 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Implementation of the hzl_ServerProcessReceivedBatch() function.
+ */
+
+#include "hzl.h"
+#include "hzl_ServerInternal.h"
+#include "hzl_CommonMessage.h"
+#include "hzl_ServerProcessReceived.h"
+
+HZL_API hzl_Err_t
+hzl_ServerProcessReceivedBatch(hzl_CbsPduMsg_t* const reactionPdus,
+                               hzl_RxSduMsg_t* const receivedUserData,
+                               hzl_Err_t* const results,
+                               hzl_ServerCtx_t* const ctx,
+                               const uint8_t* const* const receivedPdus,
+                               const size_t* const receivedPduLens,
+                               const hzl_CanId_t* const receivedCanIds,
+                               const hzl_Timestamp_t* const rxTimestamps,
+                               const size_t amountOfPdus)
+{
+    if (reactionPdus == NULL) { return HZL_ERR_NULL_PDU; }
+    if (receivedUserData == NULL) { return HZL_ERR_NULL_SDU; }
+    if (results == NULL) { return HZL_ERR_NULL_RESULTS; }
+    if (receivedPdus == NULL || receivedPduLens == NULL || receivedCanIds == NULL)
+    {
+        return HZL_ERR_NULL_PDU;
+    }
+    HZL_ERR_DECLARE(err);
+    err = hzl_ServerCheckCtxPointers(ctx);
+    HZL_ERR_CHECK(err);
+    // Once per batch: the SADTP messages returned by the earlier calls of this thread are
+    // not read anymore, the ones reassembled in this batch all are
+    hzl_CommonSadtpRxCallBegin();
+    // Get the RX timestamp ASAP to reduce the delays, once for the whole batch
+    hzl_Timestamp_t batchRxTimestamp = 0;
+    if (rxTimestamps == NULL) { err = ctx->io.currentTime(&batchRxTimestamp); }
+    // Clear any data that may still linger in the output locations, if they are reused,
+    // as hzl_ServerProcessReceived() does, but in one pass over the contiguous arrays.
+    hzl_ZeroOut(receivedUserData, amountOfPdus * sizeof(hzl_RxSduMsg_t));
+    hzl_ZeroOut(reactionPdus, amountOfPdus * sizeof(hzl_CbsPduMsg_t));
+    HZL_ERR_CHECK(err); // Return from any error of currentTime() only after the cleanups
+    // The messages are processed in windows of HZL_AEAD_LANES: the SADFD messages of a window
+    // are decrypted together first, then all messages are processed in order as usual.
+    hzl_ServerSadfdPrecomputed_t precomputed[HZL_AEAD_LANES];
+    hzl_AeadJob_t jobs[HZL_AEAD_LANES];
+    for (size_t first = 0; first < amountOfPdus; first += HZL_AEAD_LANES)
+    {
+        const size_t windowLen = (amountOfPdus - first < HZL_AEAD_LANES)
+                                 ? amountOfPdus - first : HZL_AEAD_LANES;
+        size_t amountOfJobs = 0;
+        for (size_t w = 0; w < windowLen; w++)
+        {
+            const size_t i = first + w;
+            if (hzl_ServerPrepareSecuredFdDecryption(
+                    &precomputed[w], &jobs[amountOfJobs], receivedUserData[i].data, ctx,
+                    receivedPdus[i], receivedPduLens[i], receivedCanIds[i],
+                    (rxTimestamps == NULL) ? batchRxTimestamp : rxTimestamps[i]))
+            {
+                amountOfJobs++;
+            }
+        }
+        hzl_AeadDecryptBatch(jobs, amountOfJobs);
+        for (size_t w = 0; w < windowLen; w++)
+        {
+            const size_t i = first + w;
+            results[i] = hzl_ServerProcessReceivedDispatch(
+                    &reactionPdus[i], &receivedUserData[i], ctx,
+                    receivedPdus[i], receivedPduLens[i], receivedCanIds[i],
+                    (rxTimestamps == NULL) ? batchRxTimestamp : rxTimestamps[i],
+                    &precomputed[w]);
+            if (precomputed[w].isPrepared && !precomputed[w].isConsumed)
+            {
+                // The message was rejected before its decryption: do not leave the
+                // speculatively decrypted data in the output.
+                hzl_ZeroOut(receivedUserData[i].data, precomputed[w].job->ciphertextLen);
+            }
+        }
+    }
+    // The prepared jobs contain copies of the STKs
+    hzl_ZeroOut(precomputed, sizeof(precomputed));
+    hzl_ZeroOut(jobs, sizeof(jobs));
+    return HZL_OK;
+}
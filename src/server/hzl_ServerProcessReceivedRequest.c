@@ -56,9 +56,7 @@ hzl_ServerValidateSidAndGid(const hzl_ServerCtx_t* const ctx,
         return HZL_ERR_UNKNOWN_GROUP;
     }
     // SID 0 is server: already checked for that.
-    // SID 1 maps to bit at index 0, SID 2 to index 1 etc.
-    const hzl_ServerBitMap_t sidAsBitFlag = 1U << (sid - 1U);
-    if (!(ctx->groupConfigs[gid].clientSidsInGroupBitmap & sidAsBitFlag))
+    if (!hzl_ServerBitMapHasSid(&ctx->groupConfigs[gid].clientSidsInGroupBitmap, sid))
     {
         return HZL_ERR_SECWARN_NOT_IN_GROUP;
     }
@@ -79,12 +77,10 @@ hzl_ServerBuildMsgResponse(hzl_CbsPduMsg_t* const msgToTx,
             .sid = HZL_SERVER_SID,
             .pty = HZL_PTY_RES,
     };
-    const uint8_t packedHdrLen = hzl_HeaderLen(ctx->serverConfig->headerType);
-    hzl_HeaderPackFunc const headerPackFunc =
-            hzl_HeaderPackFuncForType(ctx->serverConfig->headerType);
+    const uint8_t packedHdrLen = hzl_HeaderCodecPayloadLen(&ctx->header);
     // Prepare RES Payload
     // Write the packed header at the beginning of the CAN FD frame's payload.
-    headerPackFunc(msgToTx->data, &unpackedResHeader);
+    hzl_HeaderCodecPack(&ctx->header, &msgToTx->canId, msgToTx->data, &unpackedResHeader);
     // Destination client
     msgToTx->data[packedHdrLen + HZL_RES_CLIENT_IDX] = clientSid;
     // Counter Nonce of the Group
@@ -126,9 +122,8 @@ hzl_ServerUpdateCurrentRxLastMessageInstant(const hzl_ServerCtx_t* const ctx,
                                             const hzl_Timestamp_t rxTimestamp,
                                             const hzl_Gid_t gid)
 {
-    ctx->groupStates[gid].currentRxLastMessageInstant = rxTimestamp;
-    if (ctx->groupStates[gid].currentRxLastMessageInstant
-        == ctx->groupStates[gid].sessionStartInstant)
+    hzl_Timestamp_t lastMessageInstant = rxTimestamp;
+    if (lastMessageInstant == ctx->groupStates[gid].sessionStartInstant)
     {
         // The Request was received IMMEDIATELY after the Session was started, within the
         // same millisecond. This happens on fast busses sometimes on the bus startup and
@@ -139,8 +134,10 @@ hzl_ServerUpdateCurrentRxLastMessageInstant(const hzl_ServerCtx_t* const ctx,
         // and sessionStartInstant to be different, as their equality is used to understand
         // whether there is at least one Client that has Requested the Session information.
         // There is one Client, otherwise we would not be in this function.
-        ctx->groupStates[gid].currentRxLastMessageInstant++;
+        lastMessageInstant++;
     }
+    // Stored once, as the transmitting threads may read it without the Group lock
+    ctx->groupStates[gid].currentRxLastMessageInstant = lastMessageInstant;
 }
 
 hzl_Err_t
@@ -155,7 +152,7 @@ hzl_ServerProcessReceivedRequest(hzl_CbsPduMsg_t* const msgToTx,
     err = hzl_ServerValidateSidAndGid(ctx, unpackedReqHeader->gid, unpackedReqHeader->sid);
     HZL_ERR_CHECK(err);
     // REQ msg must be long enough to contain the required fields
-    const uint8_t packedHdrLen = hzl_HeaderLen(ctx->serverConfig->headerType);
+    const uint8_t packedHdrLen = hzl_HeaderCodecPayloadLen(&ctx->header);
     if (rxPduLen < packedHdrLen + HZL_REQ_PAYLOAD_LEN)
     {
         // We would overflow valid memory.
@@ -169,8 +166,18 @@ hzl_ServerProcessReceivedRequest(hzl_CbsPduMsg_t* const msgToTx,
     // Validate the msg with
     // tag = hash(LTK || label || GID || SID || PTY || reqnonce)
     hzl_Hash_t hash;
-    hzl_ReqHashInit(&hash, ctx->clientConfigs[unpackedReqHeader->sid - 1U].ltk,
-                    unpackedReqHeader, encodedRequestNonce);
+    if (ctx->clientStates != NULL)
+    {
+        // Resume from the precomputed state after LTK || label.
+        hzl_HashLoadMidstate(
+                &hash, ctx->clientStates[unpackedReqHeader->sid - 1U].reqHashMidstate);
+        hzl_ReqHashUpdateFields(&hash, unpackedReqHeader, encodedRequestNonce);
+    }
+    else
+    {
+        hzl_ReqHashInit(&hash, ctx->clientConfigs[unpackedReqHeader->sid - 1U].ltk,
+                        unpackedReqHeader, encodedRequestNonce);
+    }
     err = hzl_HashDigestCheck(&hash,
                               &rxPdu[packedHdrLen + HZL_REQ_TAG_IDX],
                               HZL_REQ_TAG_LEN);
@@ -38,16 +38,6 @@
 #include "hzl_CommonEndian.h"
 #include "hzl_ServerProcessReceived.h"
 
-inline static bool
-hzl_ServerIsCtrNonceOfPreviousSession(const hzl_ServerCtx_t* const ctx,
-                                      const hzl_CtrNonce_t receivedCtrnonce,
-                                      const hzl_Gid_t gid)
-{
-    const hzl_CtrNonce_t average = (hzl_CtrNonce_t)
-            ((ctx->groupStates[gid].currentCtrNonce + ctx->groupStates[gid].previousCtrNonce) / 2U);
-    return receivedCtrnonce >= average;
-}
-
 /**
  * @internal
  * Selects the STK to use during a Session renewal phase.
@@ -61,88 +51,107 @@ hzl_ServerChoosePreviusOrCurrentStk(const hzl_ServerCtx_t* const ctx,
     else { return ctx->groupStates[gid].currentStk; }
 }
 
-static hzl_Err_t
-hzl_ServerCheckRxCtrnonce(bool* const isPreviousSession,
-                          const hzl_ServerCtx_t* const ctx,
-                          const hzl_CtrNonce_t receivedCtrnonce,
-                          const hzl_Timestamp_t rxTimestamp,
-                          const hzl_Gid_t gid)
+/**
+ * @internal
+ * Checks that the ciphertext length implied by the ptlen field fits into the received PDU.
+ */
+inline static hzl_Err_t
+hzl_ServerCheckSadfdCiphertextFits(const uint8_t packedHdrLen,
+                                   const size_t rxPduLen,
+                                   const uint8_t ctlen)
 {
-    if (HZL_IS_CTRNONCE_EXPIRED(receivedCtrnonce))
-    {
-        return HZL_ERR_SECWARN_RECEIVED_OVERFLOWN_NONCE;
-    }
-    // Check if belongs to the old or new session during a renewal phase
-    const bool isPrevious =
-            isPreviousSession != NULL
-            && hzl_ServerSessionRenewalPhaseIsActive(ctx, gid)
-            && hzl_ServerIsCtrNonceOfPreviousSession(ctx, receivedCtrnonce, gid);
-    hzl_Timestamp_t selectedLastRxTimestamp;
-    hzl_CtrNonce_t selectedCtrNonce;
-    if (isPrevious)
-    {
-        selectedLastRxTimestamp = ctx->groupStates[gid].previousRxLastMessageInstant;
-        selectedCtrNonce = ctx->groupStates[gid].previousCtrNonce;
-    }
-    else
-    {
-        selectedLastRxTimestamp = ctx->groupStates[gid].currentRxLastMessageInstant;
-        selectedCtrNonce = ctx->groupStates[gid].currentCtrNonce;
-    }
-    // Freshness of received ctrnonce compared to the ctrnonce of the last
-    // received message of the previous or current session, depending where
-    // the received message belongs.
-    const hzl_CtrNonce_t delay = hzl_CommonCtrDelay(
-            selectedLastRxTimestamp,
-            rxTimestamp,
-            ctx->groupConfigs[gid].maxCtrnonceDelayMsgs,
-            ctx->groupConfigs[gid].maxSilenceIntervalMillis);
-    // Casting to signed to avoid compiler errors. Counter nonces anyway use
-    // only 24 bits, so the signed value is the same as the unsigned.
-    const int32_t oldestToleratedCtrNonce = (int32_t) selectedCtrNonce - (int32_t) delay;
-    if ((int32_t) receivedCtrnonce < oldestToleratedCtrNonce)
+    const size_t pduLenInferredFromCtlen = packedHdrLen + HZL_SADFD_PAYLOAD_LEN(ctlen);
+    if (pduLenInferredFromCtlen > rxPduLen ||
+        pduLenInferredFromCtlen > HZL_MAX_CAN_FD_DATA_LEN)
     {
-        return HZL_ERR_SECWARN_OLD_MESSAGE;
+        // The ptlen field value implies a ciphertext length which exceeds the overall length
+        // of the PDU (CAN FD frame) as provided by the underlying CAN FD layer.
+        // Buffer overflow: we would read memory that may not be initialised by the CAN FD layer.
+        // Note: we are NOT checking whether rxPduLen > HZL_MAX_CAN_FD_DATA_LEN on purpose,
+        // as by doing so we achieve the same effect. We don't really care if the buffer where the
+        // PDU lays is much longer than the PDU itself, as long as it's long-enough to hold it.
+        return HZL_ERR_TOO_LONG_CIPHERTEXT;
     }
-    if (isPreviousSession != NULL) { *isPreviousSession = isPrevious; }
     return HZL_OK;
 }
 
-static void
-hzl_ServerGroupUpdateCtrnonceAndRxTimestamp(const hzl_ServerCtx_t* const ctx,
-                                            const hzl_CtrNonce_t receivedCtrnonce,
-                                            const hzl_Timestamp_t receptionTimestamp,
-                                            const bool isPreviousSession,
-                                            const hzl_Gid_t gid)
+bool
+hzl_ServerPrepareSecuredFdDecryption(hzl_ServerSadfdPrecomputed_t* const precomputed,
+                                     hzl_AeadJob_t* const job,
+                                     uint8_t* const plaintext,
+                                     const hzl_ServerCtx_t* const ctx,
+                                     const uint8_t* const rxPdu,
+                                     const size_t rxPduLen,
+                                     const hzl_CanId_t rxCanId,
+                                     const hzl_Timestamp_t rxTimestamp)
 {
-    if (isPreviousSession)
+    precomputed->job = job;
+    precomputed->isPrepared = false;
+    precomputed->isConsumed = false;
+    // Same checks as the ones preceding the decryption in hzl_ServerProcessReceivedSecuredFd(),
+    // without altering the Group state. Any message failing them is processed normally.
+    hzl_Header_t unpackedSadfdHeader;
+    if (hzl_CommonCheckReceivedGenericMsg(
+            &unpackedSadfdHeader, rxPdu, rxPduLen, rxCanId,
+            HZL_SERVER_SID, &ctx->header) != HZL_OK
+        || unpackedSadfdHeader.pty != HZL_PTY_SADFD
+        || hzl_ServerValidateSidAndGid(
+            ctx, unpackedSadfdHeader.gid, unpackedSadfdHeader.sid) != HZL_OK)
     {
-        if (receivedCtrnonce > ctx->groupStates[gid].previousCtrNonce)
-        {
-            ctx->groupStates[gid].previousCtrNonce = receivedCtrnonce;
-        }
-        hzl_ServerGroupIncrPreviousCtrnonce(ctx, gid);
-        ctx->groupStates[gid].previousRxLastMessageInstant = receptionTimestamp;
+        return false;
     }
-    else
+    const uint8_t packedHdrLen = hzl_HeaderCodecPayloadLen(&ctx->header);
+    if (rxPduLen < packedHdrLen + HZL_SADFD_METADATA_IN_PAYLOAD_LEN) { return false; }
+    const hzl_CtrNonce_t receivedCtrnonce = hzl_DecodeLe24(
+            &rxPdu[packedHdrLen + HZL_SADFD_CTRNONCE_IDX]);
+    const uint8_t ptlen = rxPdu[packedHdrLen + HZL_SADFD_PTLEN_IDX];
+    const uint8_t ctlen = HZL_AEAD_PTLEN_TO_CTLEN(ptlen);
+    if (hzl_ServerCheckSadfdCiphertextFits(packedHdrLen, rxPduLen, ctlen) != HZL_OK)
+    {
+        return false;
+    }
+    // The Group state may change before the message is processed, e.g. by other threads:
+    // the processing checks again that the STK copied here is still the one to use.
+    bool isPreviousSession = false;
+    hzl_ServerGroupLock(ctx, unpackedSadfdHeader.gid);
+    const bool isFresh = hzl_ServerCheckRxCtrnonce(
+            &isPreviousSession, ctx, receivedCtrnonce, rxTimestamp,
+            unpackedSadfdHeader.gid) == HZL_OK;
+    if (isFresh)
     {
-        if (receivedCtrnonce > ctx->groupStates[gid].currentCtrNonce)
-        {
-            ctx->groupStates[gid].currentCtrNonce = receivedCtrnonce;
-        }
-        hzl_ServerGroupIncrCurrentCtrnonce(ctx, gid);
-        hzl_ServerUpdateCurrentRxLastMessageInstant(ctx, receptionTimestamp, gid);
+        memcpy(precomputed->stk,
+               hzl_ServerChoosePreviusOrCurrentStk(
+                       ctx, isPreviousSession, unpackedSadfdHeader.gid),
+               HZL_STK_LEN);
     }
+    hzl_ServerGroupUnlock(ctx, unpackedSadfdHeader.gid);
+    if (!isFresh) { return false; }
+    hzl_CommonSadfdAeadNonceAndAssocData(precomputed->aeadNonce, precomputed->assocData,
+                                         &unpackedSadfdHeader, receivedCtrnonce, ptlen);
+    job->key = precomputed->stk;
+    job->nonce = precomputed->aeadNonce;
+    job->assocData = precomputed->assocData;
+    job->assocDataLen = HZL_SADFD_AD_LEN;
+    job->ciphertext = &rxPdu[packedHdrLen + HZL_SADFD_CTEXT_IDX];
+    job->ciphertextLen = ctlen;
+    job->plaintext = plaintext;
+    job->tag = &rxPdu[packedHdrLen + HZL_SADFD_TAG_IDX(ctlen)];
+    job->tagLen = HZL_SADFD_TAG_LEN;
+    job->isTagValid = false;
+    precomputed->isPrepared = true;
+    return true;
 }
 
 hzl_Err_t
 hzl_ServerProcessReceivedSecuredFd(hzl_CbsPduMsg_t* const reactionPdu,
                                    hzl_RxSduMsg_t* const unpackedMsg,
+                                   uint8_t* const plaintext,
                                    hzl_ServerCtx_t* const ctx,
                                    const uint8_t* const rxPdu,
                                    const size_t rxPduLen,
                                    const hzl_Header_t* const unpackedSadfdHeader,
-                                   const hzl_Timestamp_t rxTimestamp)
+                                   const hzl_Timestamp_t rxTimestamp,
+                                   hzl_ServerSadfdPrecomputed_t* const precomputed)
 {
     HZL_ERR_DECLARE(err);
     err = hzl_ServerValidateSidAndGid(ctx, unpackedSadfdHeader->gid, unpackedSadfdHeader->sid);
@@ -152,7 +161,7 @@ hzl_ServerProcessReceivedSecuredFd(hzl_CbsPduMsg_t* const reactionPdu,
     // Session should NOT be considered anymore.
     hzl_ServerSessionRenewalPhaseExitIfNeeded(ctx, rxTimestamp, unpackedSadfdHeader->gid);
     // SADFD msg must be long enough to contain at least the metadata (case of empty SDU)
-    const uint8_t packedHdrLen = hzl_HeaderLen(ctx->serverConfig->headerType);
+    const uint8_t packedHdrLen = hzl_HeaderCodecPayloadLen(&ctx->header);
     if (rxPduLen < packedHdrLen + HZL_SADFD_METADATA_IN_PAYLOAD_LEN)
     {
         // Cannot even read the metadata of the message, including the ciphertext length.
@@ -170,46 +179,38 @@ hzl_ServerProcessReceivedSecuredFd(hzl_CbsPduMsg_t* const reactionPdu,
     // Decrypt the ciphertext into the plaintext user-data (a.k.a. SDU).
     const uint8_t ptlen = rxPdu[packedHdrLen + HZL_SADFD_PTLEN_IDX];
     const uint8_t ctlen = HZL_AEAD_PTLEN_TO_CTLEN(ptlen);
-    const size_t pduLenInferredFromCtlen = packedHdrLen + HZL_SADFD_PAYLOAD_LEN(ctlen);
-    if (pduLenInferredFromCtlen > rxPduLen ||
-        pduLenInferredFromCtlen > HZL_MAX_CAN_FD_DATA_LEN)
+    err = hzl_ServerCheckSadfdCiphertextFits(packedHdrLen, rxPduLen, ctlen);
+    HZL_ERR_CHECK(err);
+    const uint8_t* const stk = hzl_ServerChoosePreviusOrCurrentStk(
+            ctx, isPreviousSession, unpackedSadfdHeader->gid);
+    const bool isPrecomputedValid = precomputed != NULL && precomputed->isPrepared
+                                    && memcmp(precomputed->stk, stk, HZL_STK_LEN) == 0;
+    if (precomputed != NULL)
     {
-        // The ptlen field value implies a ciphertext length which exceeds the overall length
-        // of the PDU (CAN FD frame) as provided by the underlying CAN FD layer.
-        // Buffer overflow: we would read memory that may not be initialised by the CAN FD layer.
-        // Note: we are NOT checking whether rxPduLen > HZL_MAX_CAN_FD_DATA_LEN on purpose,
-        // as by doing so we achieve the same effect. We don't really care if the buffer where the
-        // PDU lays is much longer than the PDU itself, as long as it's long-enough to hold it.
-        return HZL_ERR_TOO_LONG_CIPHERTEXT;
+        // From here on the plaintext contains the outcome of this decryption.
+        precomputed->isConsumed = true;
     }
-    hzl_Aead_t aead;
-    hzl_CommonAeadInitSadfd(
-            &aead,
-            hzl_ServerChoosePreviusOrCurrentStk(ctx, isPreviousSession,
-                                                unpackedSadfdHeader->gid),
-            unpackedSadfdHeader,
-            receivedCtrnonce,
-            ptlen);
-    const size_t processedPtLen = hzl_AeadDecryptUpdate(
-            &aead,
-            unpackedMsg->data,  // Output: plaintext
-            &rxPdu[packedHdrLen + HZL_SADFD_CTEXT_IDX],  // Input: ciphertext
-            ctlen);
-
-    // Finish authenticated decryption and validate tag
-    err = hzl_AeadDecryptFinish(
-            &aead,
-            &unpackedMsg->data[processedPtLen],
-            &rxPdu[packedHdrLen + HZL_SADFD_TAG_IDX(ctlen)],
-            HZL_SADFD_TAG_LEN);
-    if (err != HZL_OK)
+    if (isPrecomputedValid)
+    {
+        // Already decrypted into the plaintext as part of a batch with the same STK.
+        // The plaintext was already cleared in case of an invalid tag.
+        if (!precomputed->job->isTagValid) { return HZL_ERR_SECWARN_INVALID_TAG; }
+    }
+    else
     {
-        // Securely clear the decrypted data before returning. Some of the decrypted data may
-        // be correct, as potential errors could be injected later on in the ciphertext or even
-        // in the tag. Just to avoid any leakage of information or the user reading data that may
-        // not be correct, as it is not validated with the tag, erase everything written so far.
-        hzl_ZeroOut(unpackedMsg->data, ptlen);
-        return err;
+        // The plaintext is securely cleared in case of an invalid tag. Some of the decrypted
+        // data may be correct, as potential errors could be injected later on in the
+        // ciphertext or even in the tag, but the user must not read data not validated
+        // with the tag.
+        err = hzl_CommonSadfdDecrypt(
+                plaintext,  // Output
+                stk,
+                unpackedSadfdHeader,
+                receivedCtrnonce,
+                &rxPdu[packedHdrLen + HZL_SADFD_CTEXT_IDX],  // Input: ciphertext
+                ptlen,
+                &rxPdu[packedHdrLen + HZL_SADFD_TAG_IDX(ctlen)]);
+        HZL_ERR_CHECK(err);
     }
     // Save the received counter nonce as local one and the reception timestamp.
     hzl_ServerGroupUpdateCtrnonceAndRxTimestamp(ctx, receivedCtrnonce, rxTimestamp,
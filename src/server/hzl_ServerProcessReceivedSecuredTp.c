@@ -0,0 +1,125 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal Implementation of the hzl_ServerProcessReceivedSecuredTp() function
+ */
+
+#include "hzl_ServerInternal.h"
+#include "hzl_CommonMessage.h"
+#include "hzl_CommonHeader.h"
+#include "hzl_CommonPayload.h"
+#include "hzl_ServerProcessReceived.h"
+
+hzl_Err_t
+hzl_ServerProcessReceivedSecuredTp(hzl_CbsPduMsg_t* const reactionPdu,
+                                   hzl_RxSduMsg_t* const unpackedMsg,
+                                   hzl_ServerCtx_t* const ctx,
+                                   const uint8_t* const rxPdu,
+                                   const size_t rxPduLen,
+                                   const hzl_Header_t* const unpackedSadtpHeader,
+                                   const hzl_Timestamp_t rxTimestamp)
+{
+    HZL_ERR_DECLARE(err);
+    err = hzl_ServerValidateSidAndGid(ctx, unpackedSadtpHeader->gid, unpackedSadtpHeader->sid);
+    HZL_ERR_CHECK(err);
+    if (ctx->amountOfSadtpRxBuffers == 0U)
+    {
+        // The user did not provide any location to reassemble the messages into.
+        return HZL_ERR_MSG_IGNORED;
+    }
+    const hzl_Gid_t gid = unpackedSadtpHeader->gid;
+    // Same as for SADFD messages, avoid accepting messages of an expired previous Session.
+    hzl_ServerSessionRenewalPhaseExitIfNeeded(ctx, rxTimestamp, gid);
+    hzl_SadtpFragment_t fragment;
+    err = hzl_CommonSadtpParseFragment(
+            &fragment, rxPdu, rxPduLen, hzl_HeaderCodecPayloadLen(&ctx->header));
+    HZL_ERR_CHECK(err);
+    // Only the first fragment is checked for freshness, the following ones are bound
+    // to it by the same ctrnonce and by the tag of the whole message.
+    bool isPreviousSession = false;
+    if (fragment.idx == 0U)
+    {
+        err = hzl_ServerCheckRxCtrnonce(
+                &isPreviousSession, ctx, fragment.ctrnonce, rxTimestamp, gid);
+        HZL_ERR_CHECK(err);
+    }
+    // The reception buffers are shared by all Groups and threads. Once complete, the buffer
+    // stays reserved for the message until this thread's next receiving call, so only the
+    // pointer to it is taken out of the locked section: no other thread can reuse it.
+    hzl_SadtpRxBuffer_t* buffer;
+    bool isComplete = false;
+    hzl_CtrNonce_t rxCtrnonce = 0;
+    HZL_LOCK_ACQUIRE(&ctx->sadtpRxBuffersLock);
+    if (fragment.idx == 0U)
+    {
+        const uint8_t* const stk = isPreviousSession
+                                   ? ctx->groupStates[gid].previousStk
+                                   : ctx->groupStates[gid].currentStk;
+        err = hzl_CommonSadtpRxStart(
+                &buffer, ctx->sadtpRxBuffers, ctx->amountOfSadtpRxBuffers,
+                unpackedSadtpHeader, &fragment, stk, isPreviousSession,
+                rxTimestamp, ctx->groupConfigs[gid].maxSilenceIntervalMillis);
+    }
+    else
+    {
+        err = hzl_CommonSadtpRxContinue(
+                &buffer, ctx->sadtpRxBuffers, ctx->amountOfSadtpRxBuffers,
+                unpackedSadtpHeader, &fragment, rxTimestamp);
+    }
+    if (err == HZL_OK)
+    {
+        err = hzl_CommonSadtpRxAppend(&isComplete, buffer, &fragment, rxTimestamp);
+    }
+    if (err == HZL_OK && isComplete)
+    {
+        rxCtrnonce = buffer->ctrnonce;
+        isPreviousSession = buffer->isPreviousSession;
+        unpackedMsg->dataLen = buffer->dataLen;
+        unpackedMsg->reassembledData = buffer->data;
+    }
+    HZL_LOCK_RELEASE(&ctx->sadtpRxBuffersLock);
+    HZL_ERR_CHECK(err);
+    if (!isComplete)
+    {
+        // Wait for the next fragment, nothing for the user yet.
+        return HZL_OK;
+    }
+    // Save the received counter nonce as local one and the reception timestamp.
+    hzl_ServerGroupUpdateCtrnonceAndRxTimestamp(
+            ctx, rxCtrnonce, rxTimestamp, isPreviousSession, gid);
+    // The plaintext stays in the user-provided buffer: too large for the SDU struct.
+    unpackedMsg->wasSecured = true;
+    unpackedMsg->isForUser = true;
+    unpackedMsg->gid = gid;
+    unpackedMsg->sid = unpackedSadtpHeader->sid;
+    // Check if the Session is expired and should be renewed, as done for SADFD messages.
+    err = hzl_ServerSessionRenewalPhaseEnterIfNeeded(reactionPdu, ctx, rxTimestamp, gid);
+    return err;
+}
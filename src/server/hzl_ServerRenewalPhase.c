@@ -42,7 +42,7 @@ bool
 hzl_ServerSessionRenewalPhaseIsActive(const hzl_ServerCtx_t* const ctx,
                                       const hzl_Gid_t gid)
 {
-    return !hzl_IsAllZeros(ctx->groupStates[gid].previousStk, HZL_STK_LEN);
+    return ctx->groupStates[gid].isRenewalPhaseActive;
 }
 
 inline static bool
@@ -62,6 +62,26 @@ hzl_ServerSessionRenewalPhaseIsOver(const hzl_ServerCtx_t* const ctx,
     return haveEnoughSecuredMessagesBeenUsed || hasEnoughTimePassedSinceNewSessionStart;
 }
 
+inline static void
+hzl_RenHashInitKeyed(hzl_Hash_t* const hash,
+                     const uint8_t* const stk)
+{
+    hzl_HashInit(hash);
+    hzl_HashUpdate(hash, stk, HZL_STK_LEN);
+    hzl_HashUpdate(hash, (uint8_t*) HZL_REN_LABEL, HZL_REN_LABEL_LEN);
+}
+
+inline static void
+hzl_RenHashUpdateFields(hzl_Hash_t* const hash,
+                        const hzl_Header_t* const unpackedRenHeader,
+                        const uint8_t* const encodedCtrnonce)
+{
+    hzl_HashUpdate(hash, &unpackedRenHeader->gid, HZL_GID_LEN);
+    hzl_HashUpdate(hash, &unpackedRenHeader->sid, HZL_SID_LEN);
+    hzl_HashUpdate(hash, &unpackedRenHeader->pty, HZL_PTY_LEN);
+    hzl_HashUpdate(hash, encodedCtrnonce, HZL_REN_CTRNONCE_LEN);
+}
+
 hzl_Err_t
 hzl_ServerSessionRenewalPhaseEnter(hzl_ServerCtx_t* const ctx,
                                    const hzl_Gid_t gid)
@@ -69,16 +89,41 @@ hzl_ServerSessionRenewalPhaseEnter(hzl_ServerCtx_t* const ctx,
     HZL_ERR_DECLARE(err);
     // Backup previous Session information
     memcpy(ctx->groupStates[gid].previousStk, ctx->groupStates[gid].currentStk, HZL_STK_LEN);
+    // The previous STK authenticates all REN notifications of the renewal phase
+    hzl_Hash_t hash;
+    hzl_RenHashInitKeyed(&hash, ctx->groupStates[gid].previousStk);
+    hzl_HashSaveMidstate(ctx->groupStates[gid].renHashMidstate, &hash);
+    hzl_ZeroOut(&hash, sizeof(hash));
+    ctx->groupStates[gid].isRenewalPhaseActive = true;
     ctx->groupStates[gid].previousRxLastMessageInstant =
             ctx->groupStates[gid].currentRxLastMessageInstant;
     ctx->groupStates[gid].previousCtrNonce = ctx->groupStates[gid].currentCtrNonce;
-    // Start a new Session: set starting time, new random STK, reset counter nonce
-    err = ctx->io.currentTime(&ctx->groupStates[gid].sessionStartInstant);
-    HZL_ERR_CHECK(err);
-    ctx->groupStates[gid].currentRxLastMessageInstant = ctx->groupStates[gid].sessionStartInstant;
-    err = hzl_NonZeroTrng(ctx->groupStates[gid].currentStk, ctx->io.trng, HZL_STK_LEN);
+    // Start a new Session: set starting time, new random STK, reset counter nonce.
+    // Both are obtained upfront, to keep the transmitting threads waiting only for the copy.
+    // The STK is usually pre-generated, so the reception path does not wait for the TRNG.
+    hzl_Timestamp_t sessionStartInstant;
+    err = ctx->io.currentTime(&sessionStartInstant);
     HZL_ERR_CHECK(err);
+    uint8_t stk[HZL_STK_LEN];
+    if (!hzl_ServerNextStkTake(stk, ctx, gid))
+    {
+        err = hzl_NonZeroTrng(stk, ctx->io.trng, HZL_STK_LEN);
+        if (err != HZL_OK)
+        {
+            hzl_ZeroOut(stk, HZL_STK_LEN);
+            return err;
+        }
+    }
+    HZL_SESSION_CHANGE_BEGIN(&ctx->groupStates[gid].sessionSeq);
+    ctx->groupStates[gid].sessionStartInstant = sessionStartInstant;
+    ctx->groupStates[gid].currentRxLastMessageInstant = sessionStartInstant;
+    memcpy(ctx->groupStates[gid].currentStk, stk, HZL_STK_LEN);
     ctx->groupStates[gid].currentCtrNonce = 0;
+    HZL_SESSION_CHANGE_END(&ctx->groupStates[gid].sessionSeq);
+    hzl_ZeroOut(stk, HZL_STK_LEN);
+    // The first REN notification is built by the caller, the following ones by the timer.
+    hzl_ServerTimerWheelSchedule(ctx, gid, sessionStartInstant,
+                                 ctx->groupConfigs[gid].delayBetweenRenNotificationsMillis);
     return err;
 }
 
@@ -104,27 +149,13 @@ hzl_ServerSessionRenewalPhaseExit(hzl_ServerCtx_t* const ctx,
                                   const hzl_Gid_t gid)
 {
     hzl_ZeroOut(ctx->groupStates[gid].previousStk, HZL_STK_LEN);
+    hzl_ZeroOut(ctx->groupStates[gid].renHashMidstate,
+                sizeof(ctx->groupStates[gid].renHashMidstate));
+    ctx->groupStates[gid].isRenewalPhaseActive = false;
     ctx->groupStates[gid].previousRxLastMessageInstant = 0;
     ctx->groupStates[gid].previousCtrNonce = 0;
 }
 
-inline static void
-hzl_RenHashInit(hzl_Hash_t* const hash,
-                const uint8_t* const ltk,
-                const hzl_Header_t* const unpackedRenHeader,
-                const uint8_t* const encodedCtrnonce)
-{
-    // Authentication/validation of the msg with
-    // tag = hash(LTK || label || GID || SID || PTY || ctrnonce)
-    hzl_HashInit(hash);
-    hzl_HashUpdate(hash, ltk, HZL_LTK_LEN);
-    hzl_HashUpdate(hash, (uint8_t*) HZL_REN_LABEL, HZL_REN_LABEL_LEN);
-    hzl_HashUpdate(hash, &unpackedRenHeader->gid, HZL_GID_LEN);
-    hzl_HashUpdate(hash, &unpackedRenHeader->sid, HZL_SID_LEN);
-    hzl_HashUpdate(hash, &unpackedRenHeader->pty, HZL_PTY_LEN);
-    hzl_HashUpdate(hash, encodedCtrnonce, HZL_REN_CTRNONCE_LEN);
-}
-
 hzl_Err_t
 hzl_ServerBuildMsgRenewal(hzl_CbsPduMsg_t* const reactionPdu,
                           hzl_ServerCtx_t* const ctx,
@@ -136,20 +167,20 @@ hzl_ServerBuildMsgRenewal(hzl_CbsPduMsg_t* const reactionPdu,
             .sid = HZL_SERVER_SID,
             .pty = HZL_PTY_REN,
     };
-    const uint8_t packedHdrLen = hzl_HeaderLen(ctx->serverConfig->headerType);
-    hzl_HeaderPackFunc const headerPackFunc =
-            hzl_HeaderPackFuncForType(ctx->serverConfig->headerType);
+    const uint8_t packedHdrLen = hzl_HeaderCodecPayloadLen(&ctx->header);
     // Prepare REN Payload
     // Write the packed header at the beginning of the CAN FD frame's payload.
-    headerPackFunc(reactionPdu->data, &unpackedRenHeader);
+    hzl_HeaderCodecPack(&ctx->header, &reactionPdu->canId, reactionPdu->data, &unpackedRenHeader);
     // Write counter nonce after the header
     hzl_EncodeLe24(&reactionPdu->data[packedHdrLen + HZL_REN_CTRNONCE_IDX],
                    ctx->groupStates[gid].previousCtrNonce);
     // Authenticate the msg with
     // tag = hash(LTK || label || GID || SID || PTY || ctrnonce)
+    // resuming from the state after STK || label, precomputed when entering the renewal phase.
     hzl_Hash_t hash;
-    hzl_RenHashInit(&hash, ctx->groupStates[gid].previousStk, &unpackedRenHeader,
-                    &reactionPdu->data[packedHdrLen + HZL_REN_CTRNONCE_IDX]);
+    hzl_HashLoadMidstate(&hash, ctx->groupStates[gid].renHashMidstate);
+    hzl_RenHashUpdateFields(&hash, &unpackedRenHeader,
+                            &reactionPdu->data[packedHdrLen + HZL_REN_CTRNONCE_IDX]);
     hzl_HashDigest(&hash, &reactionPdu->data[packedHdrLen + HZL_REN_TAG_IDX],
                    HZL_REN_TAG_LEN);
     // Message is packed in binary format, ready to transmit
@@ -190,3 +221,99 @@ hzl_ServerSessionRenewalPhaseExitIfNeeded(hzl_ServerCtx_t* const ctx,
         hzl_ServerSessionRenewalPhaseExit(ctx, gid);
     }
 }
+
+/** @internal True if the current Session started after \p now, which happens when it was
+ * renewed with a fresher timestamp than \p now, e.g. by another thread. */
+inline static bool
+hzl_ServerSessionStartedAfter(const hzl_ServerCtx_t* const ctx,
+                              const hzl_Timestamp_t now,
+                              const hzl_Gid_t gid)
+{
+    return hzl_TimeDelta(ctx->groupStates[gid].sessionStartInstant, now)
+           > (hzl_TimeDeltaMillis_t) INT32_MAX;
+}
+
+hzl_TimeDeltaMillis_t
+hzl_ServerSessionNextEventDelay(const hzl_ServerCtx_t* const ctx,
+                                const hzl_Timestamp_t now,
+                                const hzl_Gid_t gid)
+{
+    const hzl_TimeDeltaMillis_t timeSinceSessionStart =
+            hzl_ServerSessionStartedAfter(ctx, now, gid)
+            ? 0U : hzl_TimeDelta(ctx->groupStates[gid].sessionStartInstant, now);
+    hzl_TimeDeltaMillis_t nextEventSinceSessionStart;
+    if (hzl_ServerSessionRenewalPhaseIsActive(ctx, gid))
+    {
+        // REN notifications every delay after the Session start, until the phase is over
+        // just after 6 delays, as checked in hzl_ServerSessionRenewalPhaseIsOver().
+        const hzl_TimeDeltaMillis_t delay =
+                ctx->groupConfigs[gid].delayBetweenRenNotificationsMillis;
+        const hzl_TimeDeltaMillis_t nextRenNotification =
+                delay * (timeSinceSessionStart / delay + 1U);
+        const hzl_TimeDeltaMillis_t renewalPhaseEnd = 6U * delay + 1U;
+        nextEventSinceSessionStart = nextRenNotification < renewalPhaseEnd
+                                     ? nextRenNotification : renewalPhaseEnd;
+    }
+    else
+    {
+        // Expiration just after the duration, as checked in hzl_ServerSessionIsExpired().
+        const hzl_TimeDeltaMillis_t duration = ctx->groupConfigs[gid].sessionDurationMillis;
+        nextEventSinceSessionStart = duration < UINT32_MAX ? duration + 1U : duration;
+    }
+    if (nextEventSinceSessionStart <= timeSinceSessionStart) { return 0U; }
+    return nextEventSinceSessionStart - timeSinceSessionStart;
+}
+
+hzl_Err_t
+hzl_ServerSessionOnTimer(hzl_CbsPduMsg_t* const renewalPdu,
+                         hzl_TimeDeltaMillis_t* const nextEventDelay,
+                         hzl_ServerCtx_t* const ctx,
+                         const hzl_Timestamp_t now,
+                         const hzl_Gid_t gid)
+{
+    HZL_ERR_DECLARE(err);
+    err = HZL_OK;
+    if (renewalPdu != NULL) { renewalPdu->dataLen = 0; }
+    if (hzl_ServerSessionStartedAfter(ctx, now, gid))
+    {
+        // Just renewed by someone else, nothing can be due yet.
+    }
+    else if (hzl_ServerSessionRenewalPhaseIsActive(ctx, gid))
+    {
+        if (hzl_ServerSessionRenewalPhaseIsOver(ctx, now, gid))
+        {
+            hzl_ServerSessionRenewalPhaseExit(ctx, gid);
+        }
+        else if (renewalPdu == NULL)
+        {
+            *nextEventDelay = 0U;
+            return HZL_OK;
+        }
+        else
+        {
+            err = hzl_ServerBuildMsgRenewal(renewalPdu, ctx, gid);
+        }
+    }
+    else if (hzl_ServerSessionIsExpired(ctx, now, gid))
+    {
+        const bool isAnyReceiver = hzl_ServerDidAnyClientAlreadyRequest(ctx, gid);
+        if (isAnyReceiver && renewalPdu == NULL)
+        {
+            *nextEventDelay = 0U;
+            return HZL_OK;
+        }
+        err = hzl_ServerSessionRenewalPhaseEnter(ctx, gid);
+        if (err == HZL_OK && isAnyReceiver)
+        {
+            err = hzl_ServerBuildMsgRenewal(renewalPdu, ctx, gid);
+        }
+        else if (err == HZL_OK)
+        {
+            // No Client knows the expired Session, so there is nobody to notify
+            // and no previous Session worth keeping.
+            hzl_ServerSessionRenewalPhaseExit(ctx, gid);
+        }
+    }
+    *nextEventDelay = hzl_ServerSessionNextEventDelay(ctx, now, gid);
+    return err;
+}
@@ -0,0 +1,451 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Implementation of the sharded Server runtime of hzl_ServerShards.h.
+ *
+ * Each shard has two single-producer single-consumer rings, one of received messages to
+ * process and one of user data to build messages from, both consumed by the shard's worker
+ * thread. The rings are lock-free: the producer only writes the head index, the consumer
+ * only the tail one. The mutex and condition variable of a shard are used only to put its
+ * worker to sleep when both rings are empty and to wake it up again.
+ */
+
+#include "hzl_ServerShards.h"
+#include "hzl_ServerInternal.h"
+#include "hzl_CommonInternal.h"
+#include "hzl_CommonHeader.h"
+
+#if HZL_OS_AVAILABLE_NIX
+
+#include <pthread.h>
+#include <stdatomic.h>
+
+/** @internal Size of a cache line, to keep the indices written by different threads apart. */
+#define HZL_CACHE_LINE_LEN 64U
+/** @internal Max amount of received messages a worker processes with a single batch call. */
+#define HZL_SERVER_SHARDS_BATCH_LEN 16U
+
+/** @internal Slot of a ring: a received message or the user data of a message to build. */
+typedef struct hzl_ServerShardsEntry
+{
+    uint8_t data[HZL_MAX_CAN_FD_DATA_LEN];
+    size_t dataLen;
+    hzl_CanId_t canId;  ///< Of the received message
+    hzl_Header_t header;  ///< Of the received message, unpacked when submitted
+    hzl_Timestamp_t rxTimestamp;  ///< Of the received message
+    hzl_Gid_t gid;  ///< Of the message to build
+} hzl_ServerShardsEntry_t;
+
+/** @internal Lock-free single-producer single-consumer ring of a shard. */
+typedef struct hzl_ServerShardsRing
+{
+    /** Free-running index of the next slot to write, written only by the producer. */
+    atomic_size_t head;
+    uint8_t headPadding[HZL_CACHE_LINE_LEN - sizeof(atomic_size_t)];
+    /** Free-running index of the next slot to read, written only by the consumer. */
+    atomic_size_t tail;
+    uint8_t tailPadding[HZL_CACHE_LINE_LEN - sizeof(atomic_size_t)];
+    /** Array of #hzl_ServerShardsConfig_t.ringCapacity slots. */
+    hzl_ServerShardsEntry_t* entries;
+    /** Capacity minus 1, masking the free-running indices into slot indices. */
+    size_t mask;
+} hzl_ServerShardsRing_t;
+
+/** @internal One shard: the owner of the Groups with `gid % amountOfShards == index`. */
+typedef struct hzl_ServerShard
+{
+    hzl_ServerShardsRing_t rxRing;
+    hzl_ServerShardsRing_t txRing;
+    /** Copy of the Server context with a slice of the SADTP reception buffers and
+     * a timer wheel of only the Groups of the shard. */
+    hzl_ServerCtx_t ctx;
+    struct hzl_ServerShards* shards;
+    size_t index;
+    pthread_t thread;
+    pthread_mutex_t sleepLock;
+    pthread_cond_t wakeUp;
+    /** Set by the worker while it's going to sleep, so the producers know to wake it up. */
+    atomic_bool isSleeping;
+    bool isSyncInitialised;
+    bool isThreadStarted;
+    // Outputs of the worker, kept here to avoid large stack frames in the thread
+    hzl_CbsPduMsg_t reactionPdus[HZL_SERVER_SHARDS_BATCH_LEN];
+    hzl_RxSduMsg_t receivedUserData[HZL_SERVER_SHARDS_BATCH_LEN];
+    hzl_Err_t results[HZL_SERVER_SHARDS_BATCH_LEN];
+    hzl_CbsPduMsg_t securedPdu;
+} hzl_ServerShard_t;
+
+struct hzl_ServerShards
+{
+    hzl_ServerShardsConfig_t config;
+    /** The user's context, only read by the producers to unpack the headers. */
+    hzl_ServerCtx_t* ctx;
+    /** Array of #hzl_ServerShardsConfig_t.amountOfShards shards. */
+    hzl_ServerShard_t* shardArray;
+    /** Set when freeing, to stop the workers once their rings are empty. */
+    atomic_bool isStopping;
+};
+
+/** @internal Slot to write the next entry into, NULL if the ring is full. Producer only. */
+inline static hzl_ServerShardsEntry_t*
+hzl_ShardsRingSlotToWrite(hzl_ServerShardsRing_t* const ring)
+{
+    const size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    const size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    if (head - tail > ring->mask) { return NULL; }
+    return &ring->entries[head & ring->mask];
+}
+
+/** @internal Publishes the written slot to the consumer and wakes it up if sleeping. */
+static void
+hzl_ShardsRingPublish(hzl_ServerShard_t* const shard, hzl_ServerShardsRing_t* const ring)
+{
+    const size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    atomic_store_explicit(&ring->head, head + 1U, memory_order_release);
+    // Orders the publication before reading the flag, pairing with the worker setting the
+    // flag before checking the rings once more: either it sees the entry or we see the flag.
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&shard->isSleeping, memory_order_relaxed))
+    {
+        pthread_mutex_lock(&shard->sleepLock);
+        pthread_cond_signal(&shard->wakeUp);
+        pthread_mutex_unlock(&shard->sleepLock);
+    }
+}
+
+/** @internal Amount of slots ready to be read. Consumer only. */
+inline static size_t
+hzl_ShardsRingReadable(hzl_ServerShardsRing_t* const ring)
+{
+    const size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    return atomic_load_explicit(&ring->head, memory_order_acquire) - tail;
+}
+
+/** @internal Hands the given amount of read slots back to the producer. Consumer only. */
+inline static void
+hzl_ShardsRingRelease(hzl_ServerShardsRing_t* const ring, const size_t amount)
+{
+    const size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    atomic_store_explicit(&ring->tail, tail + amount, memory_order_release);
+}
+
+/** @internal Processes a batch of received messages of the shard, returning their amount. */
+static size_t
+hzl_ServerShardProcessReceived(hzl_ServerShard_t* const shard)
+{
+    hzl_ServerShardsRing_t* const ring = &shard->rxRing;
+    size_t amount = hzl_ShardsRingReadable(ring);
+    if (amount == 0U) { return 0U; }
+    if (amount > HZL_SERVER_SHARDS_BATCH_LEN) { amount = HZL_SERVER_SHARDS_BATCH_LEN; }
+    const size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    const uint8_t* pdus[HZL_SERVER_SHARDS_BATCH_LEN];
+    size_t pduLens[HZL_SERVER_SHARDS_BATCH_LEN];
+    hzl_CanId_t canIds[HZL_SERVER_SHARDS_BATCH_LEN];
+    hzl_Timestamp_t rxTimestamps[HZL_SERVER_SHARDS_BATCH_LEN];
+    for (size_t i = 0; i < amount; i++)
+    {
+        const hzl_ServerShardsEntry_t* const entry = &ring->entries[(tail + i) & ring->mask];
+        pdus[i] = entry->data;
+        pduLens[i] = entry->dataLen;
+        canIds[i] = entry->canId;
+        rxTimestamps[i] = entry->rxTimestamp;
+    }
+    const hzl_Err_t err = hzl_ServerProcessReceivedBatch(
+            shard->reactionPdus, shard->receivedUserData, shard->results, &shard->ctx,
+            pdus, pduLens, canIds, rxTimestamps, amount);
+    const hzl_ServerShardsConfig_t* const config = &shard->shards->config;
+    for (size_t i = 0; i < amount; i++)
+    {
+        config->onProcessed(config->userData, shard->index,
+                            (err == HZL_OK) ? shard->results[i] : err,
+                            &ring->entries[(tail + i) & ring->mask].header,
+                            &shard->reactionPdus[i], &shard->receivedUserData[i]);
+    }
+    hzl_ZeroOut(shard->receivedUserData, amount * sizeof(hzl_RxSduMsg_t));
+    hzl_ShardsRingRelease(ring, amount);
+    return amount;
+}
+
+/** @internal Builds a batch of SADFD messages of the shard, returning their amount. */
+static size_t
+hzl_ServerShardBuildSecuredFd(hzl_ServerShard_t* const shard)
+{
+    hzl_ServerShardsRing_t* const ring = &shard->txRing;
+    size_t amount = hzl_ShardsRingReadable(ring);
+    if (amount > HZL_SERVER_SHARDS_BATCH_LEN) { amount = HZL_SERVER_SHARDS_BATCH_LEN; }
+    const size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    const hzl_ServerShardsConfig_t* const config = &shard->shards->config;
+    for (size_t i = 0; i < amount; i++)
+    {
+        hzl_ServerShardsEntry_t* const entry = &ring->entries[(tail + i) & ring->mask];
+        const hzl_Err_t err = hzl_ServerBuildSecuredFd(
+                &shard->securedPdu, &shard->ctx, entry->data, entry->dataLen, entry->gid);
+        config->onBuilt(config->userData, shard->index, err, &shard->securedPdu);
+        // Do not leave the plaintext around in the ring
+        hzl_ZeroOut(entry, sizeof(hzl_ServerShardsEntry_t));
+    }
+    if (amount != 0U) { hzl_ShardsRingRelease(ring, amount); }
+    return amount;
+}
+
+/** @internal Main function of the worker thread of a shard. */
+static void*
+hzl_ServerShardWorker(void* const arg)
+{
+    hzl_ServerShard_t* const shard = arg;
+    for (;;)
+    {
+        const size_t handled = hzl_ServerShardProcessReceived(shard)
+                               + hzl_ServerShardBuildSecuredFd(shard);
+        if (handled != 0U) { continue; }
+        // Both rings were empty: sleep until a producer publishes something. The rings are
+        // checked again after setting the flag, as a producer may have published in between.
+        pthread_mutex_lock(&shard->sleepLock);
+        atomic_store(&shard->isSleeping, true);
+        const bool isIdle = hzl_ShardsRingReadable(&shard->rxRing) == 0U
+                            && hzl_ShardsRingReadable(&shard->txRing) == 0U;
+        const bool isStopping = atomic_load(&shard->shards->isStopping);
+        if (isIdle && !isStopping) { pthread_cond_wait(&shard->wakeUp, &shard->sleepLock); }
+        atomic_store(&shard->isSleeping, false);
+        pthread_mutex_unlock(&shard->sleepLock);
+        if (isIdle && isStopping) { break; }
+    }
+    return NULL;
+}
+
+/** @internal Allocates the rings of a shard and starts its worker thread. */
+static hzl_Err_t
+hzl_ServerShardStart(hzl_ServerShard_t* const shard, const size_t ringCapacity)
+{
+    shard->rxRing.entries = calloc(ringCapacity, sizeof(hzl_ServerShardsEntry_t));
+    shard->txRing.entries = calloc(ringCapacity, sizeof(hzl_ServerShardsEntry_t));
+    if (shard->rxRing.entries == NULL || shard->txRing.entries == NULL)
+    {
+        return HZL_ERR_MALLOC_FAILED;
+    }
+    shard->rxRing.mask = ringCapacity - 1U;
+    shard->txRing.mask = ringCapacity - 1U;
+    atomic_init(&shard->rxRing.head, 0U);
+    atomic_init(&shard->rxRing.tail, 0U);
+    atomic_init(&shard->txRing.head, 0U);
+    atomic_init(&shard->txRing.tail, 0U);
+    atomic_init(&shard->isSleeping, false);
+    if (pthread_mutex_init(&shard->sleepLock, NULL) != 0) { return HZL_ERR_CANNOT_START_THREAD; }
+    if (pthread_cond_init(&shard->wakeUp, NULL) != 0)
+    {
+        pthread_mutex_destroy(&shard->sleepLock);
+        return HZL_ERR_CANNOT_START_THREAD;
+    }
+    shard->isSyncInitialised = true;
+    if (pthread_create(&shard->thread, NULL, hzl_ServerShardWorker, shard) != 0)
+    {
+        return HZL_ERR_CANNOT_START_THREAD;
+    }
+    shard->isThreadStarted = true;
+    return HZL_OK;
+}
+
+/** @internal Amount of shards owning at least one Group, as shard `gid % amountOfShards`
+ * owns each Group: the others stay idle. */
+static size_t
+hzl_ServerShardsOwningGroups(const hzl_ServerCtx_t* const ctx,
+                             const hzl_ServerShardsConfig_t* const config)
+{
+    const size_t amountOfGroups = ctx->serverConfig->amountOfGroups;
+    return (config->amountOfShards < amountOfGroups) ? config->amountOfShards : amountOfGroups;
+}
+
+HZL_API hzl_Err_t
+hzl_ServerShardsNew(hzl_ServerShards_t** const pShards,
+                    hzl_ServerCtx_t* const ctx,
+                    const hzl_ServerShardsConfig_t* const config)
+{
+    if (pShards == NULL) { return HZL_ERR_NULL_CTX; }
+    if (ctx == NULL) { return HZL_ERR_NULL_CTX; }
+    if (config == NULL) { return HZL_ERR_NULL_CONFIG_SERVER; }
+    if (!hzl_HeaderCodecIsInitialised(&ctx->header)) { return HZL_ERR_CTX_NOT_INITIALISED; }
+    if (config->amountOfShards == 0U
+        || config->amountOfShards > HZL_SERVER_MAX_AMOUNT_OF_SHARDS)
+    {
+        return HZL_ERR_INVALID_AMOUNT_OF_SHARDS;
+    }
+    if (config->ringCapacity < 2U || (config->ringCapacity & (config->ringCapacity - 1U)) != 0U)
+    {
+        return HZL_ERR_INVALID_RING_CAPACITY;
+    }
+    if (ctx->amountOfSadtpRxBuffers != 0U
+        && ctx->amountOfSadtpRxBuffers < hzl_ServerShardsOwningGroups(ctx, config))
+    {
+        // Some shards would receive no SADTP message of their Groups at all
+        return HZL_ERR_INVALID_AMOUNT_OF_SHARDS;
+    }
+    if (config->onProcessed == NULL) { return HZL_ERR_NULL_SHARDS_CALLBACK; }
+    hzl_ServerShards_t* shards = calloc(1U, sizeof(hzl_ServerShards_t));
+    if (shards == NULL) { return HZL_ERR_MALLOC_FAILED; }
+    shards->config = *config;
+    shards->ctx = ctx;
+    atomic_init(&shards->isStopping, false);
+    shards->shardArray = calloc(config->amountOfShards, sizeof(hzl_ServerShard_t));
+    if (shards->shardArray == NULL)
+    {
+        hzl_ServerShardsFree(&shards);
+        return HZL_ERR_MALLOC_FAILED;
+    }
+    hzl_Timestamp_t now = ctx->timerWheel.now;
+    if (ctx->groupTimers != NULL && ctx->io.currentTime(&now) != HZL_OK)
+    {
+        hzl_ServerShardsFree(&shards);
+        return HZL_ERR_CANNOT_GET_CURRENT_TIME;
+    }
+    // Only the shards owning Groups receive messages: they split the SADTP reception
+    // buffers, the first ones taking one more each for the remainder of the division.
+    const size_t sadtpRxShards = hzl_ServerShardsOwningGroups(ctx, config);
+    const size_t sadtpRxBuffersPerShard = ctx->amountOfSadtpRxBuffers / sadtpRxShards;
+    const size_t sadtpRxBuffersRemainder = ctx->amountOfSadtpRxBuffers % sadtpRxShards;
+    size_t firstSadtpRxBuffer = 0U;
+    for (size_t i = 0; i < config->amountOfShards; i++)
+    {
+        hzl_ServerShard_t* const shard = &shards->shardArray[i];
+        shard->shards = shards;
+        shard->index = i;
+        shard->ctx = *ctx;
+        shard->ctx.amountOfSadtpRxBuffers = (i >= sadtpRxShards) ? 0U
+                : sadtpRxBuffersPerShard + ((i < sadtpRxBuffersRemainder) ? 1U : 0U);
+        shard->ctx.sadtpRxBuffers = (shard->ctx.amountOfSadtpRxBuffers == 0U)
+                                    ? NULL : &ctx->sadtpRxBuffers[firstSadtpRxBuffer];
+        firstSadtpRxBuffer += shard->ctx.amountOfSadtpRxBuffers;
+        // The Group timers are shared, but each one is linked only into the wheel of the
+        // shard owning the Group, so no shard touches the timers of another one.
+        hzl_ServerTimerWheelRebuild(&shard->ctx, now, i, config->amountOfShards);
+        const hzl_Err_t err = hzl_ServerShardStart(shard, config->ringCapacity);
+        if (err != HZL_OK)
+        {
+            hzl_ServerShardsFree(&shards);
+            return err;
+        }
+    }
+    *pShards = shards;
+    return HZL_OK;
+}
+
+HZL_API void
+hzl_ServerShardsFree(hzl_ServerShards_t** const pShards)
+{
+    if (pShards == NULL || *pShards == NULL) { return; }
+    hzl_ServerShards_t* const shards = *pShards;
+    atomic_store(&shards->isStopping, true);
+    if (shards->shardArray != NULL)
+    {
+        for (size_t i = 0; i < shards->config.amountOfShards; i++)
+        {
+            hzl_ServerShard_t* const shard = &shards->shardArray[i];
+            if (shard->isThreadStarted)
+            {
+                pthread_mutex_lock(&shard->sleepLock);
+                pthread_cond_signal(&shard->wakeUp);
+                pthread_mutex_unlock(&shard->sleepLock);
+                pthread_join(shard->thread, NULL);
+            }
+            if (shard->isSyncInitialised)
+            {
+                pthread_cond_destroy(&shard->wakeUp);
+                pthread_mutex_destroy(&shard->sleepLock);
+            }
+            free(shard->rxRing.entries);
+            free(shard->txRing.entries);
+            hzl_ZeroOut(shard, sizeof(hzl_ServerShard_t));
+        }
+        free(shards->shardArray);
+    }
+    // The shards relinked the Group timers into their own wheels and rescheduled the Groups
+    // they renewed: back into the wheel of the context, at their next event.
+    hzl_ServerCtx_t* const ctx = shards->ctx;
+    if (ctx->groupTimers != NULL)
+    {
+        hzl_Timestamp_t now;
+        if (ctx->io.currentTime(&now) != HZL_OK) { now = ctx->timerWheel.now; }
+        hzl_ServerTimerWheelRebuild(ctx, now, 0U, 1U);
+    }
+    hzl_ZeroOut(shards, sizeof(hzl_ServerShards_t));
+    free(shards);
+    *pShards = NULL;
+}
+
+HZL_API hzl_Err_t
+hzl_ServerShardsSubmitReceived(hzl_ServerShards_t* const shards,
+                               const uint8_t* const receivedPdu,
+                               const size_t receivedPduLen,
+                               const hzl_CanId_t receivedCanId)
+{
+    if (shards == NULL) { return HZL_ERR_NULL_CTX; }
+    if (receivedPdu == NULL) { return HZL_ERR_NULL_PDU; }
+    HZL_ERR_DECLARE(err);
+    hzl_Header_t unpackedHdr;
+    err = hzl_ServerUnpackHeader(&unpackedHdr, shards->ctx, receivedPdu, receivedPduLen,
+                                 receivedCanId);
+    HZL_ERR_CHECK(err);
+    if (receivedPduLen > HZL_MAX_CAN_FD_DATA_LEN) { return HZL_ERR_TOO_LONG_CIPHERTEXT; }
+    hzl_ServerShard_t* const shard =
+            &shards->shardArray[unpackedHdr.gid % shards->config.amountOfShards];
+    hzl_ServerShardsEntry_t* const entry = hzl_ShardsRingSlotToWrite(&shard->rxRing);
+    if (entry == NULL) { return HZL_ERR_SHARD_RING_FULL; }
+    // The reception instant is now, not when the shard gets to the message
+    err = shards->ctx->io.currentTime(&entry->rxTimestamp);
+    HZL_ERR_CHECK(err);
+    memcpy(entry->data, receivedPdu, receivedPduLen);
+    entry->dataLen = receivedPduLen;
+    entry->canId = receivedCanId;
+    entry->header = unpackedHdr;
+    hzl_ShardsRingPublish(shard, &shard->rxRing);
+    return HZL_OK;
+}
+
+HZL_API hzl_Err_t
+hzl_ServerShardsSubmitSecuredFd(hzl_ServerShards_t* const shards,
+                                const uint8_t* const userData,
+                                const size_t userDataLen,
+                                const hzl_Gid_t groupId)
+{
+    if (shards == NULL) { return HZL_ERR_NULL_CTX; }
+    if (shards->config.onBuilt == NULL) { return HZL_ERR_NULL_SHARDS_CALLBACK; }
+    if (userData == NULL && userDataLen != 0U) { return HZL_ERR_NULL_SDU; }
+    if (userDataLen > HZL_MAX_CAN_FD_DATA_LEN) { return HZL_ERR_TOO_LONG_SDU; }
+    hzl_ServerShard_t* const shard = &shards->shardArray[groupId % shards->config.amountOfShards];
+    hzl_ServerShardsEntry_t* const entry = hzl_ShardsRingSlotToWrite(&shard->txRing);
+    if (entry == NULL) { return HZL_ERR_SHARD_RING_FULL; }
+    if (userDataLen != 0U) { memcpy(entry->data, userData, userDataLen); }
+    entry->dataLen = userDataLen;
+    entry->gid = groupId;
+    hzl_ShardsRingPublish(shard, &shard->txRing);
+    return HZL_OK;
+}
+
+#endif  /* HZL_OS_AVAILABLE_NIX */
@@ -0,0 +1,74 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Implementation of the hzl_ServerTick() function.
+ */
+
+#include "hzl.h"
+#include "hzl_Server.h"
+#include "hzl_ServerInternal.h"
+
+HZL_API hzl_Err_t
+hzl_ServerTick(hzl_CbsPduMsg_t* const renewalPdus,
+               size_t* const amountOfPdus,
+               hzl_ServerCtx_t* const ctx,
+               const hzl_Timestamp_t now)
+{
+    if (renewalPdus == NULL || amountOfPdus == NULL) { return HZL_ERR_NULL_PDU; }
+    const size_t availablePdus = *amountOfPdus;
+    *amountOfPdus = 0; // Make output message empty in case of later error.
+    HZL_ERR_DECLARE(err);
+    err = hzl_ServerCheckCtxPointers(ctx);
+    HZL_ERR_CHECK(err);
+    if (ctx->groupTimers == NULL) { return HZL_ERR_NULL_GROUP_TIMERS; }
+    // Each Group is in the wheel at most once, so at most all of them are due.
+    hzl_Gid_t dueGroups[UINT8_MAX];
+    const size_t amountOfDueGroups = hzl_ServerTimerWheelAdvance(dueGroups, ctx, now);
+    hzl_Err_t firstErr = HZL_OK;
+    for (size_t i = 0U; i < amountOfDueGroups; i++)
+    {
+        const hzl_Gid_t gid = dueGroups[i];
+        hzl_CbsPduMsg_t* const renewalPdu =
+                *amountOfPdus < availablePdus ? &renewalPdus[*amountOfPdus] : NULL;
+        hzl_TimeDeltaMillis_t nextEventDelay = 0U;
+        hzl_ServerGroupLock(ctx, gid);
+        err = hzl_ServerSessionOnTimer(renewalPdu, &nextEventDelay, ctx, now, gid);
+        // Rescheduled even on error, so no Group is ever left out of the wheel.
+        hzl_ServerTimerWheelSchedule(ctx, gid, now, nextEventDelay);
+        hzl_ServerGroupUnlock(ctx, gid);
+        if (renewalPdu != NULL && renewalPdu->dataLen > 0U) { (*amountOfPdus)++; }
+        if (err != HZL_OK && firstErr == HZL_OK) { firstErr = err; }
+    }
+    // Replacing the STKs used by the renewals, here or since the last call.
+    err = hzl_ServerNextStksPrepare(ctx);
+    if (err != HZL_OK && firstErr == HZL_OK) { firstErr = err; }
+    return firstErr;
+}
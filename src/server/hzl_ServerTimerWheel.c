@@ -0,0 +1,293 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Hierarchical timer wheel of the Group timers, driving hzl_ServerTick().
+ *
+ * Level 0 has one slot per millisecond, each higher level has slots as long as all the
+ * slots of the level below. A timer is stored in the lowest level it fits in and moved
+ * ("cascaded") one level down when its slot is reached, so scheduling costs constant time and
+ * advancing costs time proportional to the expired timers, jumping over the empty slots
+ * with the help of a bitmap of occupied slots per level.
+ */
+
+#include "hzl_ServerInternal.h"
+#include "hzl_CommonInternal.h"
+
+/** @internal Bits of the timestamp indexing the slots of a level. */
+#define HZL_SERVER_TIMER_WHEEL_SLOT_BITS 6U
+
+/** @internal Span of the whole wheel in milliseconds: no timer may be further away. */
+#define HZL_SERVER_TIMER_WHEEL_SPAN \
+    (1U << (HZL_SERVER_TIMER_WHEEL_SLOT_BITS * HZL_SERVER_TIMER_WHEEL_LEVELS))
+
+/** @internal Value of #hzl_ServerGroupTimer_t.slot of timers not in the wheel. */
+#define HZL_SERVER_TIMER_UNSCHEDULED UINT16_MAX
+
+_Static_assert((1U << HZL_SERVER_TIMER_WHEEL_SLOT_BITS) == HZL_SERVER_TIMER_WHEEL_SLOTS,
+               "The slots of a level must be indexed by exactly the slot bits");
+_Static_assert(HZL_SERVER_TIMER_WHEEL_SLOTS == 8U * sizeof(uint64_t),
+               "The occupied slots of a level must fit exactly into a uint64");
+_Static_assert(HZL_SERVER_TIMER_WHEEL_SLOT_BITS * HZL_SERVER_TIMER_WHEEL_LEVELS
+               < 8U * sizeof(hzl_Timestamp_t),
+               "The wheel must span less than the timestamp range");
+
+/** @internal Signed milliseconds from \p from to \p to, with wrap-around of the timestamps. */
+inline static int32_t
+hzl_ServerTimerWheelDistance(const hzl_Timestamp_t from,
+                             const hzl_Timestamp_t to)
+{
+    const uint32_t delta = to - from;
+    return delta <= INT32_MAX ? (int32_t) delta : -(int32_t) (UINT32_MAX - delta) - 1;
+}
+
+/** @internal Shift of the timestamps to obtain the slot index of a level. */
+inline static uint32_t
+hzl_ServerTimerWheelShift(const size_t level)
+{
+    return HZL_SERVER_TIMER_WHEEL_SLOT_BITS * (uint32_t) level;
+}
+
+/** @internal Index of the lowest set bit, for a non-zero \p bits. */
+static uint32_t
+hzl_ServerTimerWheelLowestBit(uint64_t bits)
+{
+    uint32_t index = 0U;
+    for (uint32_t width = 32U; width > 0U; width /= 2U)
+    {
+        if ((bits & (UINT64_MAX >> (64U - width))) == 0U)
+        {
+            bits >>= width;
+            index += width;
+        }
+    }
+    return index;
+}
+
+/** @internal Links the timer of the Group into the slot matching its deadline. */
+static void
+hzl_ServerTimerWheelInsert(hzl_ServerTimerWheel_t* const wheel,
+                           hzl_ServerGroupTimer_t* const timers,
+                           const hzl_Gid_t gid)
+{
+    hzl_ServerGroupTimer_t* const timer = &timers[gid];
+    const uint32_t delta = timer->deadline - wheel->now;
+    size_t level = 0U;
+    while (level + 1U < HZL_SERVER_TIMER_WHEEL_LEVELS
+           && (delta >> hzl_ServerTimerWheelShift(level + 1U)) != 0U)
+    {
+        level++;
+    }
+    const uint32_t index = (timer->deadline >> hzl_ServerTimerWheelShift(level))
+                           & (HZL_SERVER_TIMER_WHEEL_SLOTS - 1U);
+    const uint16_t slot = (uint16_t) (level * HZL_SERVER_TIMER_WHEEL_SLOTS + index);
+    timer->slot = slot;
+    timer->previous = 0U;
+    timer->next = wheel->slotHeads[slot];
+    if (timer->next != 0U) { timers[timer->next - 1U].previous = (uint8_t) (gid + 1U); }
+    wheel->slotHeads[slot] = (uint8_t) (gid + 1U);
+    wheel->occupiedSlots[level] |= 1ULL << index;
+}
+
+/** @internal Unlinks the timer of the Group from its slot, if any. */
+static void
+hzl_ServerTimerWheelRemove(hzl_ServerTimerWheel_t* const wheel,
+                           hzl_ServerGroupTimer_t* const timers,
+                           const hzl_Gid_t gid)
+{
+    hzl_ServerGroupTimer_t* const timer = &timers[gid];
+    const uint16_t slot = timer->slot;
+    if (slot == HZL_SERVER_TIMER_UNSCHEDULED) { return; }
+    if (timer->previous != 0U) { timers[timer->previous - 1U].next = timer->next; }
+    else { wheel->slotHeads[slot] = timer->next; }
+    if (timer->next != 0U) { timers[timer->next - 1U].previous = timer->previous; }
+    if (wheel->slotHeads[slot] == 0U)
+    {
+        wheel->occupiedSlots[slot / HZL_SERVER_TIMER_WHEEL_SLOTS] &=
+                ~(1ULL << (slot % HZL_SERVER_TIMER_WHEEL_SLOTS));
+    }
+    timer->slot = HZL_SERVER_TIMER_UNSCHEDULED;
+    timer->next = 0U;
+    timer->previous = 0U;
+}
+
+/**
+ * @internal
+ * Earliest instant after the wheel's time at which a slot must be processed, or \p target
+ * if the wheel is empty.
+ *
+ * That is the next occupied slot of the lowest non-empty level, if still in the current
+ * revolution of that level, otherwise the start of the next revolution, where the
+ * level above cascades (conservatively, as it may turn out empty).
+ */
+static hzl_Timestamp_t
+hzl_ServerTimerWheelNextStep(const hzl_ServerTimerWheel_t* const wheel,
+                             const hzl_Timestamp_t target)
+{
+    for (size_t level = 0U; level < HZL_SERVER_TIMER_WHEEL_LEVELS; level++)
+    {
+        const uint64_t occupied = wheel->occupiedSlots[level];
+        if (occupied == 0U) { continue; }
+        const uint32_t shift = hzl_ServerTimerWheelShift(level);
+        const uint32_t revolutionShift = hzl_ServerTimerWheelShift(level + 1U);
+        const uint32_t current = (wheel->now >> shift) & (HZL_SERVER_TIMER_WHEEL_SLOTS - 1U);
+        const uint64_t later = current == HZL_SERVER_TIMER_WHEEL_SLOTS - 1U
+                               ? 0U : occupied & (UINT64_MAX << (current + 1U));
+        const hzl_Timestamp_t revolutionStart =
+                (wheel->now >> revolutionShift) << revolutionShift;
+        if (later != 0U)
+        {
+            return revolutionStart + (hzl_ServerTimerWheelLowestBit(later) << shift);
+        }
+        return revolutionStart + (1U << revolutionShift);
+    }
+    return target;
+}
+
+/** @internal Moves the timers of the current slot of the level to the lower levels,
+ * or to the due ones if already expired. */
+static size_t
+hzl_ServerTimerWheelCascade(hzl_Gid_t* const dueGroups,
+                            size_t amountOfDueGroups,
+                            hzl_ServerTimerWheel_t* const wheel,
+                            hzl_ServerGroupTimer_t* const timers,
+                            const size_t level)
+{
+    const uint32_t index = (wheel->now >> hzl_ServerTimerWheelShift(level))
+                           & (HZL_SERVER_TIMER_WHEEL_SLOTS - 1U);
+    const size_t slot = level * HZL_SERVER_TIMER_WHEEL_SLOTS + index;
+    while (wheel->slotHeads[slot] != 0U)
+    {
+        const hzl_Gid_t gid = (hzl_Gid_t) (wheel->slotHeads[slot] - 1U);
+        hzl_ServerTimerWheelRemove(wheel, timers, gid);
+        if (level == 0U || hzl_ServerTimerWheelDistance(wheel->now, timers[gid].deadline) <= 0)
+        {
+            dueGroups[amountOfDueGroups++] = gid;
+        }
+        else
+        {
+            hzl_ServerTimerWheelInsert(wheel, timers, gid);
+        }
+    }
+    return amountOfDueGroups;
+}
+
+void
+hzl_ServerTimerWheelInit(hzl_ServerCtx_t* const ctx,
+                         const hzl_Timestamp_t now)
+{
+    hzl_ZeroOut(ctx->timerWheel.slotHeads, sizeof(ctx->timerWheel.slotHeads));
+    hzl_ZeroOut(ctx->timerWheel.occupiedSlots, sizeof(ctx->timerWheel.occupiedSlots));
+    ctx->timerWheel.now = now;
+    HZL_LOCK_INIT(&ctx->timerWheel.lock);
+    for (size_t i = 0U; i < ctx->serverConfig->amountOfGroups; i++)
+    {
+        ctx->groupTimers[i].deadline = now;
+        ctx->groupTimers[i].slot = HZL_SERVER_TIMER_UNSCHEDULED;
+        ctx->groupTimers[i].next = 0U;
+        ctx->groupTimers[i].previous = 0U;
+        hzl_ZeroOut(ctx->groupTimers[i].nextStk, HZL_STK_LEN);
+    }
+}
+
+void
+hzl_ServerTimerWheelRebuild(hzl_ServerCtx_t* const ctx,
+                            const hzl_Timestamp_t now,
+                            const size_t firstGid,
+                            const size_t gidStep)
+{
+    if (ctx->groupTimers == NULL) { return; }
+    hzl_ZeroOut(ctx->timerWheel.slotHeads, sizeof(ctx->timerWheel.slotHeads));
+    hzl_ZeroOut(ctx->timerWheel.occupiedSlots, sizeof(ctx->timerWheel.occupiedSlots));
+    ctx->timerWheel.now = now;
+    HZL_LOCK_INIT(&ctx->timerWheel.lock);
+    for (size_t i = firstGid; i < ctx->serverConfig->amountOfGroups; i += gidStep)
+    {
+        ctx->groupTimers[i].slot = HZL_SERVER_TIMER_UNSCHEDULED;
+        ctx->groupTimers[i].next = 0U;
+        ctx->groupTimers[i].previous = 0U;
+        hzl_ServerTimerWheelSchedule(ctx, (hzl_Gid_t) i, now,
+                                     hzl_ServerSessionNextEventDelay(ctx, now, (hzl_Gid_t) i));
+    }
+}
+
+void
+hzl_ServerTimerWheelSchedule(hzl_ServerCtx_t* const ctx,
+                             const hzl_Gid_t gid,
+                             const hzl_Timestamp_t now,
+                             const hzl_TimeDeltaMillis_t delay)
+{
+    if (ctx->groupTimers == NULL) { return; }
+    HZL_LOCK_ACQUIRE(&ctx->timerWheel.lock);
+    hzl_ServerTimerWheel_t* const wheel = &ctx->timerWheel;
+    // The delay is relative to the caller's time, the wheel is at its own.
+    int64_t delta = (int64_t) hzl_ServerTimerWheelDistance(wheel->now, now) + delay;
+    if (delta < 1) { delta = 1; }
+    if (delta >= (int64_t) HZL_SERVER_TIMER_WHEEL_SPAN)
+    {
+        delta = (int64_t) HZL_SERVER_TIMER_WHEEL_SPAN - 1;
+    }
+    hzl_ServerTimerWheelRemove(wheel, ctx->groupTimers, gid);
+    ctx->groupTimers[gid].deadline = wheel->now + (uint32_t) delta;
+    hzl_ServerTimerWheelInsert(wheel, ctx->groupTimers, gid);
+    HZL_LOCK_RELEASE(&ctx->timerWheel.lock);
+}
+
+size_t
+hzl_ServerTimerWheelAdvance(hzl_Gid_t* const dueGroups,
+                            hzl_ServerCtx_t* const ctx,
+                            const hzl_Timestamp_t now)
+{
+    size_t amountOfDueGroups = 0U;
+    HZL_LOCK_ACQUIRE(&ctx->timerWheel.lock);
+    hzl_ServerTimerWheel_t* const wheel = &ctx->timerWheel;
+    while (hzl_ServerTimerWheelDistance(wheel->now, now) > 0)
+    {
+        const hzl_Timestamp_t step = hzl_ServerTimerWheelNextStep(wheel, now);
+        if (hzl_ServerTimerWheelDistance(step, now) < 0)
+        {
+            wheel->now = now;  // Nothing happens in between
+            break;
+        }
+        wheel->now = step;
+        // From the top, so the cascaded timers can be cascaded further in the same step.
+        for (size_t level = HZL_SERVER_TIMER_WHEEL_LEVELS; level-- > 0U;)
+        {
+            const uint32_t levelMask = (1U << hzl_ServerTimerWheelShift(level)) - 1U;
+            if ((wheel->now & levelMask) == 0U)
+            {
+                amountOfDueGroups = hzl_ServerTimerWheelCascade(
+                        dueGroups, amountOfDueGroups, wheel, ctx->groupTimers, level);
+            }
+        }
+    }
+    HZL_LOCK_RELEASE(&ctx->timerWheel.lock);
+    return amountOfDueGroups;
+}
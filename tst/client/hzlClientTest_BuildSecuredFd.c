@@ -119,6 +119,7 @@ hzlClientTest_ClientBuildSecuredFdDataLenMustBeShortEnough(void)
 static void
 hzlClientTest_ClientBuildSecuredFdDataLenDependsOnHeaderLen(void)
 {
+    if (!HZL_TEST_IS_HEADER_TYPE_BUILT(HZL_HEADER_6)) { return; }
     hzl_Err_t err;
     hzl_ClientConfig_t clientConfigWithNewHeaderType =
             HZL_TEST_CORRECT_CLIENT_CONFIG;
@@ -155,6 +156,7 @@ hzlClientTest_ClientBuildSecuredFdDataLenDependsOnHeaderLen(void)
 static void
 hzlClientTest_ClientBuildSecuredFdCompactHeaderPreventsTooManyGroups(void)
 {
+    if (!HZL_TEST_IS_HEADER_TYPE_BUILT(HZL_HEADER_4)) { return; }
     hzl_Err_t err;
     hzl_ClientConfig_t clientConfigWithNewHeaderType =
             HZL_TEST_CORRECT_CLIENT_CONFIG;
@@ -281,6 +283,7 @@ hzlClientTest_ClientBuildSecuredFdHeaderIsPackedBeforePayload(void)
 static void
 hzlClientTest_ClientBuildSecuredFdHeaderPackingDependsOnType(void)
 {
+    if (!HZL_TEST_IS_HEADER_TYPE_BUILT(HZL_HEADER_4)) { return; }
     hzl_Err_t err;
     hzl_ClientGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
     hzl_ClientConfig_t clientConfigWithNewHeaderType =
@@ -463,6 +466,7 @@ hzlClientTest_ClientBuildSecuredFdSuccessfullyUsesNewKeyDuringRenewalPhase(void)
     groupStates[0].previousCtrNonce = 0x111111;
     groupStates[0].previousStk[0] = 150;
     atto_zeros(&groupStates[0].previousStk[1], 15);  // The rest is zeros
+    groupStates[0].isRenewalPhaseActive = true;
     hzl_CbsPduMsg_t msgToTx = {0};
     const uint8_t userData[64] = {'A', 'B', 'C', 'D', 'E'};
     size_t userDataLen = 5;
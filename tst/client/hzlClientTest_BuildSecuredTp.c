@@ -0,0 +1,215 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Tests of the hzl_ClientBuildSecuredTp() function.
+ *
+ * @warning
+ * REDUCING COVERAGE ON PURPOSE. NOT implementing all the testcases for all possible incorrect
+ * content of the context, because they have already been checked for the hzl_ClientInit()
+ * function and the inner checks are exactly the same, performed by the same internal
+ * function hzl_ClientCheckCtxPointers().
+ */
+
+#include "hzlTest.h"
+
+static void
+hzlClientTest_ClientBuildSecuredTpMsgToTxMustBeNotNull(void)
+{
+    hzl_Err_t err;
+    hzl_CbsPduMsg_t securedPdus[2];
+    size_t amountOfPdus = 2;
+
+    err = hzl_ClientBuildSecuredTp(NULL, &amountOfPdus, NULL, (void*) 1, 0, 0);
+    atto_eq(err, HZL_ERR_NULL_PDU);
+
+    err = hzl_ClientBuildSecuredTp(securedPdus, NULL, NULL, (void*) 1, 0, 0);
+    atto_eq(err, HZL_ERR_NULL_PDU);
+}
+
+static void
+hzlClientTest_ClientBuildSecuredTpCtxMustBeNotNull(void)
+{
+    hzl_Err_t err;
+    hzl_CbsPduMsg_t securedPdus[2];
+    size_t amountOfPdus = 2;
+
+    err = hzl_ClientBuildSecuredTp(securedPdus, &amountOfPdus, NULL, NULL, 0, 0);
+
+    atto_eq(err, HZL_ERR_NULL_CTX);
+    atto_eq(amountOfPdus, 0);
+}
+
+// NOTE: tests for all possible issues WITHIN the context are skipped. See warning in file header.
+
+static void
+hzlClientTest_ClientBuildSecuredTpDataLenMustFitIntoThePdus(void)
+{
+    hzl_Err_t err;
+    hzl_ClientGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ClientCtx_t ctx = {
+            .clientConfig = &HZL_TEST_CORRECT_CLIENT_CONFIG,
+            .groupConfigs = HZL_TEST_CLIENT_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ClientInit(&ctx);
+    atto_eq(err, HZL_OK);
+    // Dummy established-session state
+    groupStates[0].currentCtrNonce = 1;
+    groupStates[0].currentStk[0] = 99;
+    hzl_CbsPduMsg_t securedPdus[2];
+    const uint8_t userData[100] = {1, 2, 3, 4};
+    size_t amountOfPdus;
+    // Requirement for this test: the header 0 is 3 bytes long, thus 57 bytes of stream in
+    // each fragment after the first one, which carries 55 bytes.
+    atto_eq(ctx.clientConfig->headerType, HZL_HEADER_0);
+
+    amountOfPdus = 2;
+    err = hzl_ClientBuildSecuredTp(securedPdus, &amountOfPdus, &ctx, userData, 0, 0);
+    atto_eq(err, HZL_OK);
+    atto_eq(amountOfPdus, 1);
+
+    amountOfPdus = 2;
+    err = hzl_ClientBuildSecuredTp(securedPdus, &amountOfPdus, &ctx, userData, 96, 0);
+    atto_eq(err, HZL_OK);  // 55 + 57 = 96 + tag
+    atto_eq(amountOfPdus, 2);
+
+    amountOfPdus = 2;
+    err = hzl_ClientBuildSecuredTp(securedPdus, &amountOfPdus, &ctx, userData, 97, 0);
+    atto_eq(err, HZL_ERR_TOO_LONG_SDU);  // Would require 3 fragments
+    atto_eq(amountOfPdus, 0);
+
+    amountOfPdus = 2;
+    err = hzl_ClientBuildSecuredTp(securedPdus, &amountOfPdus, &ctx, NULL, 1, 0);
+    atto_eq(err, HZL_ERR_NULL_SDU);
+    atto_eq(amountOfPdus, 0);
+
+    amountOfPdus = SIZE_MAX;
+    err = hzl_ClientBuildSecuredTp(securedPdus, &amountOfPdus, &ctx, userData, 0x10000, 0);
+    atto_eq(err, HZL_ERR_TOO_LONG_SDU);  // Plaintext length does not fit the 2-bytes field
+    atto_eq(amountOfPdus, 0);
+
+    static hzl_CbsPduMsg_t allPdus[HZL_SADTP_MAX_AMOUNT_OF_FRAGMENTS + 1U];
+    static uint8_t longestUserData[HZL_SADTP_MAX_DATA_LEN + 1U];
+    amountOfPdus = HZL_SADTP_MAX_AMOUNT_OF_FRAGMENTS + 1U;
+    err = hzl_ClientBuildSecuredTp(allPdus, &amountOfPdus, &ctx,
+                                   longestUserData, HZL_SADTP_MAX_DATA_LEN, 0);
+    atto_eq(err, HZL_OK);  // Fills all fragments
+    atto_eq(amountOfPdus, HZL_SADTP_MAX_AMOUNT_OF_FRAGMENTS);
+    atto_eq(allPdus[amountOfPdus - 1U].dataLen, HZL_MAX_CAN_FD_DATA_LEN);
+
+    amountOfPdus = HZL_SADTP_MAX_AMOUNT_OF_FRAGMENTS + 1U;
+    err = hzl_ClientBuildSecuredTp(allPdus, &amountOfPdus, &ctx,
+                                   longestUserData, HZL_SADTP_MAX_DATA_LEN + 1U, 0);
+    atto_eq(err, HZL_ERR_TOO_LONG_SDU);  // Would require one fragment too many
+    atto_eq(amountOfPdus, 0);
+}
+
+static void
+hzlClientTest_ClientBuildSecuredTpRequiresHandshake(void)
+{
+    hzl_Err_t err;
+    hzl_ClientGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ClientCtx_t ctx = {
+            .clientConfig = &HZL_TEST_CORRECT_CLIENT_CONFIG,
+            .groupConfigs = HZL_TEST_CLIENT_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ClientInit(&ctx);
+    atto_eq(err, HZL_OK);
+    hzl_CbsPduMsg_t securedPdus[2];
+    size_t amountOfPdus = 2;
+
+    err = hzl_ClientBuildSecuredTp(securedPdus, &amountOfPdus, &ctx, NULL, 0, 0);
+
+    atto_eq(err, HZL_ERR_SESSION_NOT_ESTABLISHED);
+    atto_eq(amountOfPdus, 0);
+}
+
+static void
+hzlClientTest_ClientBuildSecuredTpSuccessfully(void)
+{
+    hzl_Err_t err;
+    hzl_ClientGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ClientCtx_t ctx = {
+            .clientConfig = &HZL_TEST_CORRECT_CLIENT_CONFIG,
+            .groupConfigs = HZL_TEST_CLIENT_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ClientInit(&ctx);
+    atto_eq(err, HZL_OK);
+    groupStates[0].currentCtrNonce = 0x010203;
+    groupStates[0].currentStk[0] = 99;
+    hzl_CbsPduMsg_t securedPdus[HZL_SADTP_AMOUNT_OF_PDUS(100)];
+    size_t amountOfPdus = HZL_SADTP_AMOUNT_OF_PDUS(100);
+    uint8_t userData[100];
+    for (size_t i = 0; i < sizeof(userData); i++) { userData[i] = (uint8_t) i; }
+
+    err = hzl_ClientBuildSecuredTp(securedPdus, &amountOfPdus, &ctx,
+                                   userData, sizeof(userData), 0);
+
+    atto_eq(err, HZL_OK);
+    // 100 bytes of plaintext + 16 of tag = 55 + 57 + 4 bytes of stream
+    atto_eq(amountOfPdus, 3);
+    atto_eq(securedPdus[0].dataLen, 64);
+    atto_eq(securedPdus[1].dataLen, 64);
+    atto_eq(securedPdus[2].dataLen, 3 + 3 + 1 + 4);
+    for (uint8_t i = 0; i < amountOfPdus; i++)
+    {
+        // Packed Header 0
+        atto_eq(securedPdus[i].data[0], 0);  // GID from API call
+        atto_eq(securedPdus[i].data[1], 13);  // SID from client config
+        atto_eq(securedPdus[i].data[2], 3);  // PTY SADTP
+        // Same ctrnonce for all fragments
+        atto_eq(securedPdus[i].data[3], 0x03);  // Ctrnonce low
+        atto_eq(securedPdus[i].data[4], 0x02);  // Ctrnonce mid
+        atto_eq(securedPdus[i].data[5], 0x01);  // Ctrnonce high
+        atto_eq(securedPdus[i].data[6], i);  // Fragment index
+    }
+    // Ptlen only in the first fragment
+    atto_eq(securedPdus[0].data[7], 100);  // Ptlen low
+    atto_eq(securedPdus[0].data[8], 0);  // Ptlen high
+    // The ciphertext is not the plaintext
+    atto_memneq(&securedPdus[0].data[9], userData, 55);
+    // Ctrnonce was incremented in the state once for the whole message
+    atto_eq(groupStates[0].currentCtrNonce, 0x010204);
+}
+
+void hzlClientTest_ClientBuildSecuredTp(void)
+{
+    hzlClientTest_ClientBuildSecuredTpMsgToTxMustBeNotNull();
+    hzlClientTest_ClientBuildSecuredTpCtxMustBeNotNull();
+    hzlClientTest_ClientBuildSecuredTpDataLenMustFitIntoThePdus();
+    hzlClientTest_ClientBuildSecuredTpRequiresHandshake();
+    hzlClientTest_ClientBuildSecuredTpSuccessfully();
+}
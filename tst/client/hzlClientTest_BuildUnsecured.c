@@ -92,6 +92,25 @@ hzlClientTest_ClientBuildUnsecuredUserDataMustBeNotNullWhenPositiveDataLen(void)
     atto_eq(err, HZL_OK);
 }
 
+static void
+hzlClientTest_ClientBuildUnsecuredCtxMustBeInitialised(void)
+{
+    hzl_Err_t err;
+    hzl_CbsPduMsg_t msgToTx = {0};
+    hzl_ClientGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ClientCtx_t ctx = {
+            .clientConfig = &HZL_TEST_CORRECT_CLIENT_CONFIG,
+            .groupConfigs = HZL_TEST_CLIENT_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+
+    // The header codec is prepared only by hzl_ClientInit()
+    err = hzl_ClientBuildUnsecured(&msgToTx, &ctx, NULL, 0, 0);
+
+    atto_eq(err, HZL_ERR_CTX_NOT_INITIALISED);
+}
+
 static void
 hzlClientTest_ClientBuildUnsecuredDataLenMustBeShortEnough(void)
 {
@@ -123,6 +142,7 @@ hzlClientTest_ClientBuildUnsecuredDataLenMustBeShortEnough(void)
 static void
 hzlClientTest_ClientBuildUnsecuredDataLenDependsOnHeaderLen(void)
 {
+    if (!HZL_TEST_IS_HEADER_TYPE_BUILT(HZL_HEADER_6)) { return; }
     hzl_Err_t err;
     hzl_ClientConfig_t clientConfigWithNewHeaderType =
             HZL_TEST_CORRECT_CLIENT_CONFIG;
@@ -156,6 +176,7 @@ hzlClientTest_ClientBuildUnsecuredDataLenDependsOnHeaderLen(void)
 static void
 hzlClientTest_ClientBuildUnsecuredCompactHeaderPreventsTooManyGroups(void)
 {
+    if (!HZL_TEST_IS_HEADER_TYPE_BUILT(HZL_HEADER_4)) { return; }
     hzl_Err_t err;
     hzl_ClientConfig_t clientConfigWithNewHeaderType =
             HZL_TEST_CORRECT_CLIENT_CONFIG;
@@ -253,6 +274,7 @@ hzlClientTest_ClientBuildUnsecuredHeaderIsPackedBeforePayload(void)
 static void
 hzlClientTest_ClientBuildUnsecuredHeaderPackingDependsOnType(void)
 {
+    if (!HZL_TEST_IS_HEADER_TYPE_BUILT(HZL_HEADER_4)) { return; }
     hzl_Err_t err;
     hzl_ClientGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
     hzl_ClientConfig_t clientConfigWithNewHeaderType =
@@ -294,6 +316,7 @@ void hzlClientTest_ClientBuildUnsecured(void)
     hzlClientTest_ClientBuildUnsecuredMsgToTxMustBeNotNull();
     hzlClientTest_ClientBuildUnsecuredCtxMustBeNotNull();
     hzlClientTest_ClientBuildUnsecuredUserDataMustBeNotNullWhenPositiveDataLen();
+    hzlClientTest_ClientBuildUnsecuredCtxMustBeInitialised();
     hzlClientTest_ClientBuildUnsecuredDataLenMustBeShortEnough();
     hzlClientTest_ClientBuildUnsecuredDataLenDependsOnHeaderLen();
     hzlClientTest_ClientBuildUnsecuredCompactHeaderPreventsTooManyGroups();
@@ -83,10 +83,43 @@ hzlClientTest_ClientInitCorrectCtxSucceeds(void)
                ctx.clientConfig->amountOfGroups * sizeof(hzl_ClientGroupState_t));
 }
 
+static void
+hzlClientTest_ClientInitBuildsGroupLookupTable(void)
+{
+    hzl_Err_t err;
+    hzl_ClientGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ClientCtx_t ctx = {
+            .clientConfig = &HZL_TEST_CORRECT_CLIENT_CONFIG,
+            .groupConfigs = HZL_TEST_CLIENT_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    memset(ctx.groupSlotOfGid, 0xAA, sizeof(ctx.groupSlotOfGid));
+
+    err = hzl_ClientInit(&ctx);
+
+    atto_eq(err, HZL_OK);
+    // Configured GIDs are 0, 2, 3: the slot is their index + 1
+    atto_eq(ctx.groupSlotOfGid[0], 1);
+    atto_eq(ctx.groupSlotOfGid[1], 0);
+    atto_eq(ctx.groupSlotOfGid[2], 2);
+    atto_eq(ctx.groupSlotOfGid[3], 3);
+    atto_zeros(&ctx.groupSlotOfGid[4], HZL_AMOUNT_OF_GIDS - 4);
+    // Building messages for a GID not in the configuration fails
+    hzl_CbsPduMsg_t msgToTx;
+    err = hzl_ClientBuildRequest(&msgToTx, &ctx, 1);
+    atto_eq(err, HZL_ERR_UNKNOWN_GROUP);
+    err = hzl_ClientBuildRequest(&msgToTx, &ctx, 255);
+    atto_eq(err, HZL_ERR_UNKNOWN_GROUP);
+    err = hzl_ClientBuildRequest(&msgToTx, &ctx, 3);
+    atto_eq(err, HZL_OK);
+}
+
 void hzlClientTest_ClientInit(void)
 {
     hzlClientTest_ClientInitCtxMustBeNotNull();
     hzlClientTest_ClientInitGroupStatesMustBeNotNull();
     hzlClientTest_ClientInitCorrectCtxSucceeds();
+    hzlClientTest_ClientInitBuildsGroupLookupTable();
     HZL_TEST_PARTIAL_REPORT();
 }
@@ -107,6 +107,14 @@ hzlClientTest_ClientInitConfigHeaderTypeMustBeStandard(void)
     err = hzl_ClientInit(&ctx);
 
     atto_eq(err, HZL_ERR_INVALID_HEADER_TYPE);
+    // When built with a fixed header type, the other standard ones are unsupported too
+    for (uint8_t type = HZL_HEADER_0; type <= HZL_HEADER_6; type++)
+    {
+        if (HZL_TEST_IS_HEADER_TYPE_BUILT(type)) { continue; }
+        incorrectConfig.headerType = type;
+        err = hzl_ClientInit(&ctx);
+        atto_eq(err, HZL_ERR_INVALID_HEADER_TYPE);
+    }
 }
 
 static void
@@ -131,6 +139,7 @@ hzlClientTest_ClientInitConfigClientSidMustBeNonZero(void)
 static void
 hzlClientTest_ClientInitConfigClientSidMustFitForHeaderType(void)
 {
+    if (!HZL_TEST_IS_HEADER_TYPE_BUILT(HZL_HEADER_4)) { return; }
     hzl_Err_t err;
     hzl_ClientGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
     hzl_ClientConfig_t clientConfigWithSmallHeaderType =
@@ -155,6 +164,8 @@ hzlClientTest_ClientInitConfigClientSidMustFitForHeaderType(void)
 static void
 hzlClientTest_ClientInitConfigClientAmountOfGroupsMustFitForHeaderType(void)
 {
+    if (!HZL_TEST_IS_HEADER_TYPE_BUILT(HZL_HEADER_3)
+        || !HZL_TEST_IS_HEADER_TYPE_BUILT(HZL_HEADER_5)) { return; }
     hzl_Err_t err;
     hzl_ClientGroupState_t groupStates[HZL_MAX_TEST_AMOUNT_OF_GROUPS];
     hzl_ClientConfig_t clientConfigWithSmallHeaderType =
@@ -191,6 +202,7 @@ hzlClientTest_ClientInitConfigClientAmountOfGroupsMustFitForHeaderType(void)
 static void
 hzlClientTest_ClientInitConfigClientMustHaveOnlyBroadcastWhenHeader5Or6(void)
 {
+    if (!HZL_TEST_IS_HEADER_TYPE_BUILT(HZL_HEADER_6)) { return; }
     // Headers 5 or 6 don't have a field for the GID, as this is assumed to
     // be the only group. Thus there must be only 1 group configuration and it
     // must be the one for the GID 0.
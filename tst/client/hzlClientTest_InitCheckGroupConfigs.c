@@ -157,6 +157,7 @@ hzlClientTest_ClientInitGroupConfigsMaxCounterNonceDelayMustBeInValidRange(void)
 static void
 hzlClientTest_ClientInitGroupConfigsGidsMustFitForHeaderType(void)
 {
+    if (!HZL_TEST_IS_HEADER_TYPE_BUILT(HZL_HEADER_4)) { return; }
     hzl_Err_t err;
     hzl_ClientGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
     hzl_ClientConfig_t clientConfigWithSmallHeaderType =
@@ -40,6 +40,7 @@
  */
 int main(void)
 {
+    HZL_TEST_SKIP_UNLESS_CONFIG_HEADER_TYPE_BUILT();
     hzlClientTest_ClientInit();
     hzlClientTest_ClientInitCheckClientConfig();
     hzlClientTest_ClientInitCheckGroupConfigs();
@@ -50,12 +51,17 @@ int main(void)
     hzlClientTest_ClientBuildRequest();
     hzlClientTest_ClientBuildUnsecured();
     hzlClientTest_ClientBuildSecuredFd();
+    hzlClientTest_ClientBuildSecuredFdBatch();
+    hzlClientTest_ClientBuildSecuredFdInto();
+    hzlClientTest_ClientBuildSecuredTp();
     hzlClientTest_ClientProcessReceived();
     hzlClientTest_ClientProcessReceivedUnsecured();
     hzlClientTest_ClientProcessReceivedSecuredFd();
     hzlClientTest_ClientProcessReceivedRequest();
     hzlClientTest_ClientProcessReceivedResponse();
     hzlClientTest_ClientProcessReceivedRenewal();
+    hzlClientTest_ClientProcessReceivedInPlace();
+    hzlClientTest_ClientUnpackHeader();
     HZL_TEST_PARTIAL_REPORT();
     return atto_at_least_one_fail;
 }
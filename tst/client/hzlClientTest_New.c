@@ -75,7 +75,10 @@ hzlClientTest_ClientNewFileMustHaveProperMagicNumber(void)
     hzl_ClientCtx_t* ctx;
 
     err = hzl_ClientNew(&ctx, "clientconfigfiles/invalidMagicNumber.hzl");
+    atto_eq(err, HZL_ERR_INVALID_FILE_MAGIC_NUMBER);
 
+    // Valid magic number but unknown file format version.
+    err = hzl_ClientNew(&ctx, "clientconfigfiles/invalidFormatVersion.hzl");
     atto_eq(err, HZL_ERR_INVALID_FILE_MAGIC_NUMBER);
 }
 
@@ -146,6 +149,33 @@ hzlClientTest_ClientNewFileAliceIsAccepted(void)
     hzl_ClientFree(&ctx);
 }
 
+static void
+hzlClientTest_ClientNewFileWithHeaderPlacementIsAccepted(void)
+{
+    hzl_Err_t err;
+    hzl_ClientCtx_t* ctx;
+
+    // Same configuration as Alice.hzl, whose padding byte is ignored, in the newer format
+    err = hzl_ClientNew(&ctx, "clientconfigfiles/Alice.hzl");
+    atto_eq(err, HZL_OK);
+    atto_eq(ctx->clientConfig->headerPlacement, HZL_HEADER_IN_PAYLOAD);
+    hzl_ClientFree(&ctx);
+
+    err = hzl_ClientNew(&ctx, "clientconfigfiles/AliceHeaderMixed.hzl");
+
+    atto_eq(err, HZL_OK);
+    atto_eq(ctx->clientConfig->sid, 1);
+    atto_eq(ctx->clientConfig->headerType, 0);
+    atto_eq(ctx->clientConfig->amountOfGroups, 3);
+    atto_eq(ctx->clientConfig->headerPlacement, HZL_HEADER_MIXED);
+    atto_eq(ctx->groupConfigs[2].gid, 3);
+    // Header Type 0: the GID byte is in the CAN ID, SID and PTY in the payload
+    atto_eq(ctx->header.canIdMask, 0xFFU);
+    atto_eq(ctx->header.canIdLen, 1);
+
+    hzl_ClientFree(&ctx);
+}
+
 static void
 hzlClientTest_ClientNewBobAndCharlieAreAccepted(void)
 {
@@ -179,6 +209,32 @@ hzlClientTest_ClientNewOsIoFunctionsWork(void)
     atto_neq(ctx->groupStates[0].requestNonce, 0);
 }
 
+static void
+hzlClientTest_ClientNewCurrentTimeIsMonotonic(void)
+{
+    hzl_Err_t err;
+    hzl_ClientCtx_t* ctx;
+    err = hzl_ClientNew(&ctx, "clientconfigfiles/Alice.hzl");
+    atto_eq(err, HZL_OK);
+    hzl_Timestamp_t before = 0;
+    hzl_Timestamp_t after = 0;
+
+    err = ctx->io.currentTime(&before);
+    atto_eq(err, HZL_OK);
+    err = ctx->io.currentTime(&after);
+    atto_eq(err, HZL_OK);
+    atto_lt((hzl_Timestamp_t) (after - before), 1000U);
+
+    atto_eq(hzl_ClientCurrentTimeCoarse(NULL), HZL_ERR_CANNOT_GET_CURRENT_TIME);
+    ctx->io.currentTime = hzl_ClientCurrentTimeCoarse;
+    err = ctx->io.currentTime(&before);
+    atto_eq(err, HZL_OK);
+    err = ctx->io.currentTime(&after);
+    atto_eq(err, HZL_OK);
+    atto_lt((hzl_Timestamp_t) (after - before), 1000U);
+    hzl_ClientFree(&ctx);
+}
+
 #endif  /* HZL_OS_AVAILABLE */
 
 void hzlClientTest_ClientNew(void)
@@ -191,8 +247,10 @@ void hzlClientTest_ClientNew(void)
     hzlClientTest_ClientNewFileMustHaveProperLength();
     hzlClientTest_ClientNewFileMustHaveValidConfig();
     hzlClientTest_ClientNewFileAliceIsAccepted();
+    hzlClientTest_ClientNewFileWithHeaderPlacementIsAccepted();
     hzlClientTest_ClientNewBobAndCharlieAreAccepted();
     hzlClientTest_ClientNewOsIoFunctionsWork();
+    hzlClientTest_ClientNewCurrentTimeIsMonotonic();
     HZL_TEST_PARTIAL_REPORT();
 #endif  /* HZL_OS_AVAILABLE */
 }
@@ -136,6 +136,7 @@ hzlClientTest_ClientProcessReceivedMsgMustHaveEnoughDataLenForCbsHeader0(void)
 static void
 hzlClientTest_ClientProcessReceivedMsgMustHaveEnoughDataLenForCbsHeader4(void)
 {
+    if (!HZL_TEST_IS_HEADER_TYPE_BUILT(HZL_HEADER_4)) { return; }
     hzl_Err_t err;
     hzl_ClientConfig_t clientConfigWithNewHeaderType =
             HZL_TEST_CORRECT_CLIENT_CONFIG;
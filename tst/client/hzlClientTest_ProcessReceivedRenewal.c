@@ -250,6 +250,7 @@ hzlClientTest_ClientProcessReceivedRenewalReceiverMustNotBeInRenewalPhase(void)
     groupStates[0].previousCtrNonce = 0;
     groupStates[0].previousStk[0] = 111;
     atto_zeros(&groupStates[0].previousStk[1], 15);  // The rest is zeros
+    groupStates[0].isRenewalPhaseActive = true;
     hzl_CbsPduMsg_t msgToTx = {0};
     hzl_RxSduMsg_t unpackedMsg = {0};
     size_t rxPduLen = 64;
@@ -85,6 +85,7 @@ hzlClientTest_ClientProcessReceivedSadfdMsgMustNotHaveTooLongPlaintextHeader0(vo
 static void
 hzlClientTest_ClientProcessReceivedSadfdMsgMustNotHaveTooLongPlaintextHeader6(void)
 {
+    if (!HZL_TEST_IS_HEADER_TYPE_BUILT(HZL_HEADER_6)) { return; }
     hzl_Err_t err;
     hzl_ClientConfig_t clientConfigWithNewHeaderType =
             HZL_TEST_CORRECT_CLIENT_CONFIG;
@@ -581,6 +582,7 @@ hzlClientTest_ClientProcessReceivedSadfdCurrentSessionAcceptedDuringRenewal(void
     groupStates[0].previousCtrNonce = 0xF11111;
     groupStates[0].previousStk[0] = 222;
     atto_zeros(&groupStates[0].previousStk[1], 15);  // The rest is zeros
+    groupStates[0].isRenewalPhaseActive = true;
     // Dummy new session state as obtained from a RES message
     groupStates[0].currentCtrNonce = 0x010200;
     groupStates[0].currentStk[0] = 99;
@@ -638,6 +640,7 @@ hzlClientTest_ClientProcessReceivedSadfdPreviousSessionAcceptedDuringRenewal(voi
     groupStates[0].previousCtrNonce = 0x010200;
     groupStates[0].previousStk[0] = 99;
     atto_zeros(&groupStates[0].previousStk[1], 15);  // The rest is zeros
+    groupStates[0].isRenewalPhaseActive = true;
     // Dummy new session state as obtained from a RES message
     groupStates[0].currentCtrNonce = 3;
     groupStates[0].currentStk[0] = 100;
@@ -695,6 +698,7 @@ hzlClientTest_ClientProcessReceivedSadfdPreviousSessionRejectedAfterTooManyMsgs(
     groupStates[0].previousCtrNonce = 0x010202;
     groupStates[0].previousStk[0] = 99;
     atto_zeros(&groupStates[0].previousStk[1], 15);  // The rest is zeros
+    groupStates[0].isRenewalPhaseActive = true;
     // Dummy new session state as obtained from a RES message
     groupStates[0].currentCtrNonce = 3;
     groupStates[0].currentStk[0] = 100;
@@ -730,6 +734,7 @@ hzlClientTest_ClientProcessReceivedSadfdPreviousSessionRejectedAfterTooManyMsgs(
     // session is deleted.
     atto_eq(groupStates[0].previousCtrNonce, 0);
     atto_zeros(groupStates[0].previousStk, HZL_STK_LEN);
+    atto_false(groupStates[0].isRenewalPhaseActive);
 }
 
 static void
@@ -751,6 +756,7 @@ hzlClientTest_ClientProcessReceivedSadfdPreviousSessionRejectedAfterTooMuchTime(
     groupStates[0].previousCtrNonce = 0x010200;
     groupStates[0].previousStk[0] = 99;
     atto_zeros(&groupStates[0].previousStk[1], 15);  // The rest is zeros
+    groupStates[0].isRenewalPhaseActive = true;
     // Dummy new session state as obtained from a RES message
     groupStates[0].currentCtrNonce = 3;
     groupStates[0].currentStk[0] = 100;
@@ -790,6 +796,7 @@ hzlClientTest_ClientProcessReceivedSadfdPreviousSessionRejectedAfterTooMuchTime(
     // session is deleted.
     atto_eq(groupStates[0].previousCtrNonce, 0);
     atto_zeros(groupStates[0].previousStk, HZL_STK_LEN);
+    atto_false(groupStates[0].isRenewalPhaseActive);
 }
 
 void hzlClientTest_ClientProcessReceivedSecuredFd(void)
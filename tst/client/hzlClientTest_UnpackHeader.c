@@ -0,0 +1,161 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Tests of the hzl_ClientUnpackHeader() function.
+ */
+
+#include "hzlTest.h"
+
+static void
+hzlClientTest_ClientUnpackHeaderMustHaveNonNullArgs(void)
+{
+    hzl_Err_t err;
+    hzl_ClientGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ClientCtx_t ctx = {
+            .clientConfig = &HZL_TEST_CORRECT_CLIENT_CONFIG,
+            .groupConfigs = HZL_TEST_CLIENT_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ClientInit(&ctx);
+    atto_eq(err, HZL_OK);
+    hzl_Header_t hdr;
+    const uint8_t rxPdu[3] = {0, 1, 4};
+
+    err = hzl_ClientUnpackHeader(NULL, &ctx, rxPdu, sizeof(rxPdu), 0xABC);
+    atto_eq(err, HZL_ERR_NULL_HEADER);
+    err = hzl_ClientUnpackHeader(&hdr, NULL, rxPdu, sizeof(rxPdu), 0xABC);
+    atto_eq(err, HZL_ERR_NULL_CTX);
+    err = hzl_ClientUnpackHeader(&hdr, &ctx, NULL, 1, 0xABC);
+    atto_eq(err, HZL_ERR_NULL_PDU);
+}
+
+static void
+hzlClientTest_ClientUnpackHeaderCtxMustBeInitialised(void)
+{
+    hzl_Err_t err;
+    hzl_ClientCtx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    hzl_Header_t hdr;
+    const uint8_t rxPdu[3] = {0, 1, 4};
+
+    err = hzl_ClientUnpackHeader(&hdr, &ctx, rxPdu, sizeof(rxPdu), 0xABC);
+    atto_eq(err, HZL_ERR_CTX_NOT_INITIALISED);
+}
+
+static void
+hzlClientTest_ClientUnpackHeaderInPayload(void)
+{
+    hzl_Err_t err;
+    hzl_ClientGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ClientCtx_t ctx = {
+            .clientConfig = &HZL_TEST_CORRECT_CLIENT_CONFIG,
+            .groupConfigs = HZL_TEST_CLIENT_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ClientInit(&ctx);
+    atto_eq(err, HZL_OK);
+    hzl_Header_t hdr;
+    const uint8_t rxPdu[5] = {0, 1, 4, 0xAA, 0xBB};
+
+    err = hzl_ClientUnpackHeader(&hdr, &ctx, rxPdu, sizeof(rxPdu), 0x1FFFFFFF);
+    atto_eq(err, HZL_OK);
+    atto_eq(hdr.gid, 0);
+    atto_eq(hdr.sid, 1);
+    atto_eq(hdr.pty, 4);
+    err = hzl_ClientUnpackHeader(&hdr, &ctx, rxPdu, 2, 0x1FFFFFFF);
+    atto_eq(err, HZL_ERR_TOO_SHORT_PDU_TO_CONTAIN_HEADER);
+}
+
+static void
+hzlClientTest_ClientUnpackHeaderInCanId(void)
+{
+    hzl_Err_t err;
+    hzl_ClientConfig_t clientConfig = HZL_TEST_CORRECT_CLIENT_CONFIG;
+    clientConfig.headerPlacement = HZL_HEADER_IN_CAN_ID;
+    hzl_ClientGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ClientCtx_t ctx = {
+            .clientConfig = &clientConfig,
+            .groupConfigs = HZL_TEST_CLIENT_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ClientInit(&ctx);
+    atto_eq(err, HZL_OK);
+    hzl_Header_t hdr;
+
+    // Bits above the header are for the user to set and are ignored
+    err = hzl_ClientUnpackHeader(&hdr, &ctx, NULL, 0,
+                                 0x1F000000U | (2U << 16U) | (1U << 8U) | 4U);
+    atto_eq(err, HZL_OK);
+    atto_eq(hdr.gid, 2);
+    atto_eq(hdr.sid, 1);
+    atto_eq(hdr.pty, 4);
+}
+
+static void
+hzlClientTest_ClientUnpackHeaderMixed(void)
+{
+    hzl_Err_t err;
+    hzl_ClientConfig_t clientConfig = HZL_TEST_CORRECT_CLIENT_CONFIG;
+    clientConfig.headerPlacement = HZL_HEADER_MIXED;
+    hzl_ClientGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ClientCtx_t ctx = {
+            .clientConfig = &clientConfig,
+            .groupConfigs = HZL_TEST_CLIENT_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ClientInit(&ctx);
+    atto_eq(err, HZL_OK);
+    hzl_Header_t hdr;
+    // GID in the CAN ID, SID and PTY in the payload
+    const uint8_t rxPdu[2] = {1, 4};
+
+    err = hzl_ClientUnpackHeader(&hdr, &ctx, rxPdu, sizeof(rxPdu), 0x1FFFFF00U | 2U);
+    atto_eq(err, HZL_OK);
+    atto_eq(hdr.gid, 2);
+    atto_eq(hdr.sid, 1);
+    atto_eq(hdr.pty, 4);
+    err = hzl_ClientUnpackHeader(&hdr, &ctx, rxPdu, 1, 0x1FFFFF00U | 2U);
+    atto_eq(err, HZL_ERR_TOO_SHORT_PDU_TO_CONTAIN_HEADER);
+}
+
+void hzlClientTest_ClientUnpackHeader(void)
+{
+    hzlClientTest_ClientUnpackHeaderMustHaveNonNullArgs();
+    hzlClientTest_ClientUnpackHeaderCtxMustBeInitialised();
+    hzlClientTest_ClientUnpackHeaderInPayload();
+    hzlClientTest_ClientUnpackHeaderInCanId();
+    hzlClientTest_ClientUnpackHeaderMixed();
+    HZL_TEST_PARTIAL_REPORT();
+}
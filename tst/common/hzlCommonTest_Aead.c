@@ -0,0 +1,347 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Known-answer tests of the short-message AEAD functions hzl_AeadEncryptOneShot(),
+ * hzl_AeadDecryptOneShot() and hzl_AeadDecryptBatch() of the selected crypto backend.
+ *
+ * The expected outputs are obtained with the streaming functions of the same backend,
+ * which for the LibAscon backend are the ones of LibAscon itself.
+ */
+
+#include <string.h>
+#include "hzlTest.h"
+#include "hzl_CommonAead.h"
+
+/** Longest ciphertext being tested, covering all CAN FD payloads. */
+#define HZL_TEST_AEAD_MAX_CTLEN 64U
+/** Amount of tested ciphertext lengths, from 0 to #HZL_TEST_AEAD_MAX_CTLEN included. */
+#define HZL_TEST_AEAD_AMOUNT_OF_CTLENS (HZL_TEST_AEAD_MAX_CTLEN + 1U)
+/** Longest tag being tested. */
+#define HZL_TEST_AEAD_MAX_TAGLEN 16U
+
+/** Tested associated data lengths: empty, single byte, around one 8-byte rate block. */
+static const size_t hzlCommonTest_aeadAssocDataLens[] = {0U, 1U, 7U, 8U, 9U};
+/** Tested tag lengths: shortest, truncated, full. */
+static const uint8_t hzlCommonTest_aeadTagLens[] = {1U, 8U, 16U};
+
+static void
+hzlCommonTest_AeadFill(uint8_t* bytes, size_t amount, uint8_t seed)
+{
+    for (size_t i = 0U; i < amount; i++)
+    {
+        bytes[i] = (uint8_t) (seed + 31U * i);
+    }
+}
+
+/**
+ * Reference authenticated encryption through the streaming functions,
+ * the data being fed in a single update each.
+ */
+static void
+hzlCommonTest_AeadReferenceEncrypt(uint8_t* ciphertext,
+                                   uint8_t* tag,
+                                   const uint8_t* key,
+                                   const uint8_t* nonce,
+                                   const uint8_t* assocData,
+                                   size_t assocDataLen,
+                                   const uint8_t* plaintext,
+                                   size_t plaintextLen,
+                                   uint8_t tagLen)
+{
+    hzl_Aead_t aead;
+
+    hzl_AeadInit(&aead, key, nonce);
+    hzl_AeadAssocDataUpdate(&aead, assocData, assocDataLen);
+    const size_t written = hzl_AeadEncryptUpdate(&aead, ciphertext, plaintext, plaintextLen);
+    hzl_AeadEncryptFinish(&aead, &ciphertext[written], tag, tagLen);
+}
+
+/**
+ * Reference authenticated decryption through the streaming functions,
+ * the data being fed in a single update each.
+ */
+static hzl_Err_t
+hzlCommonTest_AeadReferenceDecrypt(uint8_t* plaintext,
+                                   const uint8_t* key,
+                                   const uint8_t* nonce,
+                                   const uint8_t* assocData,
+                                   size_t assocDataLen,
+                                   const uint8_t* ciphertext,
+                                   size_t ciphertextLen,
+                                   const uint8_t* tag,
+                                   uint8_t tagLen)
+{
+    hzl_Aead_t aead;
+
+    hzl_AeadInit(&aead, key, nonce);
+    hzl_AeadAssocDataUpdate(&aead, assocData, assocDataLen);
+    const size_t written = hzl_AeadDecryptUpdate(&aead, plaintext, ciphertext, ciphertextLen);
+    return hzl_AeadDecryptFinish(&aead, &plaintext[written], tag, tagLen);
+}
+
+static void
+hzlCommonTest_AeadKnownAnswerEmptyMessage(void)
+{
+    // Official Ascon-128 v1.2 test vector, Count = 1 of LWC_AEAD_KAT_128_128.txt
+    const uint8_t expectedTag[HZL_TEST_AEAD_MAX_TAGLEN] = {
+        0xE3, 0x55, 0x15, 0x9F, 0x29, 0x29, 0x11, 0xF7,
+        0x94, 0xCB, 0x14, 0x32, 0xA0, 0x10, 0x3A, 0x8A,
+    };
+    uint8_t key[16];
+    uint8_t nonce[HZL_AEAD_NONCE_LEN];
+    uint8_t tag[HZL_TEST_AEAD_MAX_TAGLEN] = {0};
+    uint8_t unused = 0xAAU;
+
+    if (strcmp(HZL_CRYPTO_BACKEND_NAME, "libascon") != 0) { return; }
+    for (uint8_t i = 0U; i < sizeof(key); i++) { key[i] = i; }
+    for (uint8_t i = 0U; i < sizeof(nonce); i++) { nonce[i] = i; }
+
+    hzl_AeadEncryptOneShot(&unused, tag, key, nonce, &unused, 0U, &unused, 0U, sizeof(tag));
+    atto_memeq(tag, expectedTag, sizeof(tag));
+    atto_eq(unused, 0xAAU);
+    atto_eq(hzl_AeadDecryptOneShot(&unused, key, nonce, &unused, 0U, &unused, 0U,
+                                   expectedTag, sizeof(expectedTag)), HZL_OK);
+    atto_eq(unused, 0xAAU);
+}
+
+static void
+hzlCommonTest_AeadEncryptOneShotMatchesReference(void)
+{
+    uint8_t key[16];
+    uint8_t nonce[HZL_AEAD_NONCE_LEN];
+    uint8_t assocData[16];
+    uint8_t plaintext[HZL_TEST_AEAD_MAX_CTLEN];
+    uint8_t expectedCiphertext[HZL_TEST_AEAD_MAX_CTLEN];
+    uint8_t expectedTag[HZL_TEST_AEAD_MAX_TAGLEN];
+    uint8_t ciphertext[HZL_TEST_AEAD_MAX_CTLEN];
+    uint8_t tag[HZL_TEST_AEAD_MAX_TAGLEN];
+
+    hzlCommonTest_AeadFill(key, sizeof(key), 0x10U);
+    hzlCommonTest_AeadFill(nonce, sizeof(nonce), 0x20U);
+    hzlCommonTest_AeadFill(assocData, sizeof(assocData), 0x30U);
+    for (size_t a = 0U; a < sizeof(hzlCommonTest_aeadAssocDataLens) / sizeof(size_t); a++)
+    {
+        const size_t assocDataLen = hzlCommonTest_aeadAssocDataLens[a];
+        for (size_t t = 0U; t < sizeof(hzlCommonTest_aeadTagLens); t++)
+        {
+            const uint8_t tagLen = hzlCommonTest_aeadTagLens[t];
+            for (size_t ptLen = 0U; ptLen <= HZL_TEST_AEAD_MAX_CTLEN; ptLen++)
+            {
+                hzlCommonTest_AeadFill(plaintext, ptLen, (uint8_t) ptLen);
+                hzlCommonTest_AeadReferenceEncrypt(expectedCiphertext, expectedTag, key, nonce,
+                                                   assocData, assocDataLen,
+                                                   plaintext, ptLen, tagLen);
+                memset(ciphertext, 0, sizeof(ciphertext));
+                memset(tag, 0, sizeof(tag));
+
+                hzl_AeadEncryptOneShot(ciphertext, tag, key, nonce, assocData, assocDataLen,
+                                       plaintext, ptLen, tagLen);
+                atto_memeq(ciphertext, expectedCiphertext, ptLen);
+                atto_memeq(tag, expectedTag, tagLen);
+                // Nothing is written past the end of the outputs
+                atto_zeros(&ciphertext[ptLen], sizeof(ciphertext) - ptLen);
+                atto_zeros(&tag[tagLen], sizeof(tag) - tagLen);
+
+                // In-place
+                memcpy(ciphertext, plaintext, ptLen);
+                hzl_AeadEncryptOneShot(ciphertext, tag, key, nonce, assocData, assocDataLen,
+                                       ciphertext, ptLen, tagLen);
+                atto_memeq(ciphertext, expectedCiphertext, ptLen);
+                atto_memeq(tag, expectedTag, tagLen);
+            }
+        }
+    }
+}
+
+static void
+hzlCommonTest_AeadDecryptOneShotMatchesReference(void)
+{
+    uint8_t key[16];
+    uint8_t nonce[HZL_AEAD_NONCE_LEN];
+    uint8_t assocData[16];
+    uint8_t expectedPlaintext[HZL_TEST_AEAD_MAX_CTLEN];
+    uint8_t ciphertext[HZL_TEST_AEAD_MAX_CTLEN];
+    uint8_t tag[HZL_TEST_AEAD_MAX_TAGLEN];
+    uint8_t plaintext[HZL_TEST_AEAD_MAX_CTLEN];
+
+    hzlCommonTest_AeadFill(key, sizeof(key), 0x40U);
+    hzlCommonTest_AeadFill(nonce, sizeof(nonce), 0x50U);
+    hzlCommonTest_AeadFill(assocData, sizeof(assocData), 0x60U);
+    for (size_t a = 0U; a < sizeof(hzlCommonTest_aeadAssocDataLens) / sizeof(size_t); a++)
+    {
+        const size_t assocDataLen = hzlCommonTest_aeadAssocDataLens[a];
+        for (size_t t = 0U; t < sizeof(hzlCommonTest_aeadTagLens); t++)
+        {
+            const uint8_t tagLen = hzlCommonTest_aeadTagLens[t];
+            for (size_t ctLen = 0U; ctLen <= HZL_TEST_AEAD_MAX_CTLEN; ctLen++)
+            {
+                hzlCommonTest_AeadFill(expectedPlaintext, ctLen, (uint8_t) ~ctLen);
+                hzlCommonTest_AeadReferenceEncrypt(ciphertext, tag, key, nonce,
+                                                   assocData, assocDataLen,
+                                                   expectedPlaintext, ctLen, tagLen);
+
+                memset(plaintext, 0, sizeof(plaintext));
+                atto_eq(hzl_AeadDecryptOneShot(plaintext, key, nonce, assocData, assocDataLen,
+                                               ciphertext, ctLen, tag, tagLen), HZL_OK);
+                atto_memeq(plaintext, expectedPlaintext, ctLen);
+                atto_zeros(&plaintext[ctLen], sizeof(plaintext) - ctLen);
+
+                // Tampered tag: the plaintext is zeroed out
+                tag[tagLen - 1U] ^= 0x01U;
+                memset(plaintext, 0xFF, sizeof(plaintext));
+                atto_eq(hzl_AeadDecryptOneShot(plaintext, key, nonce, assocData, assocDataLen,
+                                               ciphertext, ctLen, tag, tagLen),
+                        HZL_ERR_SECWARN_INVALID_TAG);
+                atto_zeros(plaintext, ctLen);
+                tag[tagLen - 1U] ^= 0x01U;
+                if (ctLen > 0U)
+                {
+                    // Tampered ciphertext: with the shortest tags a forgery may also pass,
+                    // so the outcome must just match the reference one
+                    ciphertext[0] ^= 0x80U;
+                    const hzl_Err_t expectedErr = hzlCommonTest_AeadReferenceDecrypt(
+                            expectedPlaintext, key, nonce, assocData, assocDataLen,
+                            ciphertext, ctLen, tag, tagLen);
+                    atto_eq(hzl_AeadDecryptOneShot(plaintext, key, nonce,
+                                                   assocData, assocDataLen,
+                                                   ciphertext, ctLen, tag, tagLen),
+                            expectedErr);
+                    if (expectedErr == HZL_OK)
+                    {
+                        atto_memeq(plaintext, expectedPlaintext, ctLen);
+                    }
+                    else
+                    {
+                        atto_zeros(plaintext, ctLen);
+                    }
+                    if (tagLen >= 8U)
+                    {
+                        atto_eq(expectedErr, HZL_ERR_SECWARN_INVALID_TAG);
+                    }
+                    ciphertext[0] ^= 0x80U;
+                    hzlCommonTest_AeadFill(expectedPlaintext, ctLen, (uint8_t) ~ctLen);
+                }
+
+                // In-place
+                memcpy(plaintext, ciphertext, ctLen);
+                atto_eq(hzl_AeadDecryptOneShot(plaintext, key, nonce, assocData, assocDataLen,
+                                               plaintext, ctLen, tag, tagLen), HZL_OK);
+                atto_memeq(plaintext, expectedPlaintext, ctLen);
+            }
+        }
+    }
+}
+
+static void
+hzlCommonTest_AeadDecryptBatchMatchesReference(void)
+{
+    // One job per ciphertext length, each with a different key, nonce, associated data length
+    // and tag length, so every lane of every window mixes them
+    static uint8_t keys[HZL_TEST_AEAD_AMOUNT_OF_CTLENS][16];
+    static uint8_t nonces[HZL_TEST_AEAD_AMOUNT_OF_CTLENS][HZL_AEAD_NONCE_LEN];
+    static uint8_t assocData[HZL_TEST_AEAD_AMOUNT_OF_CTLENS][16];
+    static uint8_t expectedPlaintexts[HZL_TEST_AEAD_AMOUNT_OF_CTLENS][HZL_TEST_AEAD_MAX_CTLEN];
+    static uint8_t ciphertexts[HZL_TEST_AEAD_AMOUNT_OF_CTLENS][HZL_TEST_AEAD_MAX_CTLEN];
+    static uint8_t tags[HZL_TEST_AEAD_AMOUNT_OF_CTLENS][HZL_TEST_AEAD_MAX_TAGLEN];
+    static uint8_t plaintexts[HZL_TEST_AEAD_AMOUNT_OF_CTLENS][HZL_TEST_AEAD_MAX_CTLEN];
+    static hzl_AeadJob_t jobs[HZL_TEST_AEAD_AMOUNT_OF_CTLENS];
+
+    for (size_t i = 0U; i < HZL_TEST_AEAD_AMOUNT_OF_CTLENS; i++)
+    {
+        const size_t amountOfAssocDataLens =
+                sizeof(hzlCommonTest_aeadAssocDataLens) / sizeof(size_t);
+        hzlCommonTest_AeadFill(keys[i], sizeof(keys[i]), (uint8_t) (3U * i));
+        hzlCommonTest_AeadFill(nonces[i], sizeof(nonces[i]), (uint8_t) (5U * i));
+        hzlCommonTest_AeadFill(assocData[i], sizeof(assocData[i]), (uint8_t) (7U * i));
+        hzlCommonTest_AeadFill(expectedPlaintexts[i], i, (uint8_t) (11U * i));
+        jobs[i].key = keys[i];
+        jobs[i].nonce = nonces[i];
+        jobs[i].assocData = assocData[i];
+        jobs[i].assocDataLen = hzlCommonTest_aeadAssocDataLens[i % amountOfAssocDataLens];
+        jobs[i].ciphertext = ciphertexts[i];
+        jobs[i].ciphertextLen = i;
+        jobs[i].plaintext = plaintexts[i];
+        jobs[i].tag = tags[i];
+        jobs[i].tagLen = hzlCommonTest_aeadTagLens[i % sizeof(hzlCommonTest_aeadTagLens)];
+        hzlCommonTest_AeadReferenceEncrypt(ciphertexts[i], tags[i], keys[i], nonces[i],
+                                           assocData[i], jobs[i].assocDataLen,
+                                           expectedPlaintexts[i], i, jobs[i].tagLen);
+    }
+    // Every 7th job has a tampered tag, landing on different lanes of different windows
+    for (size_t i = 0U; i < HZL_TEST_AEAD_AMOUNT_OF_CTLENS; i += 7U)
+    {
+        tags[i][0] ^= 0x01U;
+    }
+
+    // Batches of any size, also smaller than a window or ending with a partial one
+    for (size_t amountOfJobs = 0U; amountOfJobs <= HZL_TEST_AEAD_AMOUNT_OF_CTLENS;
+         amountOfJobs++)
+    {
+        for (size_t first = 0U; first + amountOfJobs <= HZL_TEST_AEAD_AMOUNT_OF_CTLENS;
+             first += amountOfJobs + 1U)
+        {
+            for (size_t i = first; i < first + amountOfJobs; i++)
+            {
+                memset(plaintexts[i], 0xFF, sizeof(plaintexts[i]));
+                jobs[i].isTagValid = (i % 7U == 0U);  // Opposite of the expected one
+            }
+
+            hzl_AeadDecryptBatch(&jobs[first], amountOfJobs);
+            for (size_t i = first; i < first + amountOfJobs; i++)
+            {
+                if (i % 7U == 0U)
+                {
+                    atto_false(jobs[i].isTagValid);
+                    atto_zeros(plaintexts[i], i);
+                }
+                else
+                {
+                    atto_true(jobs[i].isTagValid);
+                    atto_memeq(plaintexts[i], expectedPlaintexts[i], i);
+                }
+                // Nothing is written past the end of the plaintext
+                for (size_t j = i; j < HZL_TEST_AEAD_MAX_CTLEN; j++)
+                {
+                    atto_eq(plaintexts[i][j], 0xFFU);
+                }
+            }
+        }
+    }
+}
+
+void
+hzlCommonTest_CommonAead(void)
+{
+    hzlCommonTest_AeadKnownAnswerEmptyMessage();
+    hzlCommonTest_AeadEncryptOneShotMatchesReference();
+    hzlCommonTest_AeadDecryptOneShotMatchesReference();
+    hzlCommonTest_AeadDecryptBatchMatchesReference();
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Tests of the internal hzl_CommonCtrDelay() function.
+ *
+ * The expected values are computed in double precision, which is exact for this domain: the
+ * numerator D*R is below 2^38, so it is an exact double, and when D*R/S is not an integer it
+ * is at least 1/S > 2^-17 away from one, much more than the 2^-30 rounding error of the
+ * division at the largest quotient 2^22. The ceil() of the double quotient is thus exact.
+ */
+
+#include "hzlTest.h"
+#include "hzl_CommonMessage.h"
+
+/** Largest configurable Max Silence Interval. */
+#define HZL_TEST_LARGEST_MAX_SILENCE_INTERVAL UINT16_MAX
+
+/** Exact ceil(D * (1 - t/S)) of the CBS specification, see the file documentation. */
+static hzl_CtrNonce_t
+hzlCommonTest_CtrDelayReference(const hzl_TimeDeltaMillis_t sinceLastMsg,
+                                const hzl_CtrNonce_t maxCtrNonceDelay,
+                                const hzl_TimeDeltaMillis_t maxSilenceInterval)
+{
+    if (sinceLastMsg >= maxSilenceInterval) { return 0; }
+    const double quotient = ((double) maxCtrNonceDelay
+                             * (double) (maxSilenceInterval - sinceLastMsg))
+                            / (double) maxSilenceInterval;
+    const hzl_CtrNonce_t floored = (hzl_CtrNonce_t) quotient;
+    return floored + ((double) floored < quotient);
+}
+
+/** The previous single-precision implementation, off by at most 1 due to its roundings. */
+static hzl_CtrNonce_t
+hzlCommonTest_CtrDelayFloat(const hzl_TimeDeltaMillis_t sinceLastMsg,
+                            const hzl_CtrNonce_t maxCtrNonceDelay,
+                            const hzl_TimeDeltaMillis_t maxSilenceInterval)
+{
+    if (sinceLastMsg >= maxSilenceInterval) { return 0; }
+    const float fraction = (float) sinceLastMsg / (float) maxSilenceInterval;
+    const float delay = (float) maxCtrNonceDelay * (1.0f - fraction);
+    const hzl_CtrNonce_t floored = (hzl_CtrNonce_t) delay;
+    return floored + ((float) floored < delay);
+}
+
+/** True if the delay is exact and at most 1 away from the previous implementation. */
+static bool
+hzlCommonTest_CtrDelayMatches(const hzl_TimeDeltaMillis_t sinceLastMsg,
+                              const hzl_CtrNonce_t maxCtrNonceDelay,
+                              const hzl_TimeDeltaMillis_t maxSilenceInterval)
+{
+    const hzl_CtrNonce_t delay = hzl_CommonCtrDelay(
+            1000U, 1000U + sinceLastMsg, maxCtrNonceDelay, maxSilenceInterval);
+    const hzl_CtrNonce_t expected = hzlCommonTest_CtrDelayReference(
+            sinceLastMsg, maxCtrNonceDelay, maxSilenceInterval);
+    const hzl_CtrNonce_t previous = hzlCommonTest_CtrDelayFloat(
+            sinceLastMsg, maxCtrNonceDelay, maxSilenceInterval);
+    return delay == expected && delay + 1U >= previous && delay <= previous + 1U;
+}
+
+static void
+hzlCommonTest_CommonCtrDelayBoundaries(void)
+{
+    // No silence interval: no tolerance
+    atto_eq(hzl_CommonCtrDelay(0, 0, 100, 0), 0);
+    // Silence interval elapsed: no tolerance
+    atto_eq(hzl_CommonCtrDelay(0, 1000, 100, 1000), 0);
+    atto_eq(hzl_CommonCtrDelay(0, 1001, 100, 1000), 0);
+    // No time elapsed: full tolerance
+    atto_eq(hzl_CommonCtrDelay(0, 0, 100, 1000), 100);
+    atto_eq(hzl_CommonCtrDelay(0, 0, HZL_LARGEST_MAX_COUNTER_NONCE_DELAY,
+                               HZL_TEST_LARGEST_MAX_SILENCE_INTERVAL),
+            HZL_LARGEST_MAX_COUNTER_NONCE_DELAY);
+    // Half the time elapsed: half the tolerance, rounded up
+    atto_eq(hzl_CommonCtrDelay(0, 500, 100, 1000), 50);
+    atto_eq(hzl_CommonCtrDelay(0, 500, 101, 1000), 51);
+    // Any remaining time gives at least 1 of tolerance
+    atto_eq(hzl_CommonCtrDelay(0, 999, 1, 1000), 1);
+    atto_eq(hzl_CommonCtrDelay(0, 65534, 1, 65535), 1);
+    // The timestamps may wrap around
+    atto_eq(hzl_CommonCtrDelay(UINT32_MAX - 249U, 250U, 100, 1000), 50);
+    // Exactly representable results are not rounded up: 3 * 4/6 == 2
+    atto_eq(hzl_CommonCtrDelay(0, 2, 3, 6), 2);
+}
+
+static void
+hzlCommonTest_CommonCtrDelayAllElapsedTimesAndSilenceIntervals(void)
+{
+    // Every Max Silence Interval and elapsed time, for the delays stressing the integer
+    // splitting of D: below, equal and above the interval, plus the largest ones.
+    const hzl_CtrNonce_t delays[] = {
+            0, 1, 2, 3, 255, 256, 1000, 65534, 65535, 65536, 65537, 1000003,
+            HZL_LARGEST_MAX_COUNTER_NONCE_DELAY - 1U, HZL_LARGEST_MAX_COUNTER_NONCE_DELAY,
+    };
+    for (hzl_TimeDeltaMillis_t interval = 0;
+         interval <= HZL_TEST_LARGEST_MAX_SILENCE_INTERVAL;
+         interval += (interval < 512U) ? 1U : 9289U)
+    {
+        for (hzl_TimeDeltaMillis_t elapsed = 0; elapsed <= interval; elapsed++)
+        {
+            for (size_t i = 0; i < sizeof(delays) / sizeof(delays[0]); i++)
+            {
+                atto_true(hzlCommonTest_CtrDelayMatches(elapsed, delays[i], interval));
+            }
+        }
+    }
+}
+
+static void
+hzlCommonTest_CommonCtrDelayAllDelays(void)
+{
+    // Every Max Counter Nonce Delay, for elapsed times and intervals at the edges
+    const hzl_TimeDeltaMillis_t elapsedAndIntervals[][2] = {
+            {0, 65535}, {1, 65535}, {21845, 65535}, {65534, 65535}, {333, 1000}, {1, 3},
+    };
+    for (size_t i = 0; i < sizeof(elapsedAndIntervals) / sizeof(elapsedAndIntervals[0]); i++)
+    {
+        for (hzl_CtrNonce_t delay = 0; delay <= HZL_LARGEST_MAX_COUNTER_NONCE_DELAY; delay++)
+        {
+            atto_true(hzlCommonTest_CtrDelayMatches(
+                    elapsedAndIntervals[i][0], delay, elapsedAndIntervals[i][1]));
+        }
+    }
+}
+
+void hzlCommonTest_CommonCtrDelay(void)
+{
+    hzlCommonTest_CommonCtrDelayBoundaries();
+    hzlCommonTest_CommonCtrDelayAllElapsedTimesAndSilenceIntervals();
+    hzlCommonTest_CommonCtrDelayAllDelays();
+    HZL_TEST_PARTIAL_REPORT();
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Tests of the internal hzl_CommonCtrNonceReserve() and hzl_CommonCtrNonceAdvancePast()
+ * functions.
+ */
+
+#include "hzlTest.h"
+#include "hzl_CommonInternal.h"
+#include "hzl_CommonMessage.h"
+
+static void
+hzlCommonTest_CommonCtrNonceReserveWithinLimit(void)
+{
+    HZL_ATOMIC hzl_CtrNonce_t ctrnonce = 0;
+
+    atto_eq(hzl_CommonCtrNonceReserve(&ctrnonce, 1U), 0);
+    atto_eq(ctrnonce, 1);
+    atto_eq(hzl_CommonCtrNonceReserve(&ctrnonce, 10U), 1);
+    atto_eq(ctrnonce, 11);
+    atto_eq(hzl_CommonCtrNonceReserve(&ctrnonce, 0U), 11);
+    atto_eq(ctrnonce, 11);
+}
+
+static void
+hzlCommonTest_CommonCtrNonceReserveSaturates(void)
+{
+    HZL_ATOMIC hzl_CtrNonce_t ctrnonce = HZL_MAX_CTRNONCE - 3U;
+
+    // Only 3 values are left: the counter stops at the limit
+    atto_eq(hzl_CommonCtrNonceReserve(&ctrnonce, 5U), HZL_MAX_CTRNONCE - 3U);
+    atto_eq(ctrnonce, HZL_MAX_CTRNONCE);
+    atto_true(HZL_IS_CTRNONCE_EXPIRED(ctrnonce));
+    // Once expired, nothing more is reserved
+    atto_eq(hzl_CommonCtrNonceReserve(&ctrnonce, 1U), HZL_MAX_CTRNONCE);
+    atto_eq(ctrnonce, HZL_MAX_CTRNONCE);
+    atto_eq(hzl_CommonCtrNonceReserve(&ctrnonce, SIZE_MAX), HZL_MAX_CTRNONCE);
+    atto_eq(ctrnonce, HZL_MAX_CTRNONCE);
+    // Exactly up to the limit
+    ctrnonce = HZL_MAX_CTRNONCE - 1U;
+    atto_eq(hzl_CommonCtrNonceReserve(&ctrnonce, 1U), HZL_MAX_CTRNONCE - 1U);
+    atto_eq(ctrnonce, HZL_MAX_CTRNONCE);
+}
+
+void
+hzlCommonTest_CommonCtrNonceReserve(void)
+{
+    hzlCommonTest_CommonCtrNonceReserveWithinLimit();
+    hzlCommonTest_CommonCtrNonceReserveSaturates();
+}
+
+static void
+hzlCommonTest_CommonCtrNonceAdvancePastReceived(void)
+{
+    HZL_ATOMIC hzl_CtrNonce_t ctrnonce = 10;
+
+    // Older received ones just consume one value
+    hzl_CommonCtrNonceAdvancePast(&ctrnonce, 3U);
+    atto_eq(ctrnonce, 11);
+    hzl_CommonCtrNonceAdvancePast(&ctrnonce, 11U);
+    atto_eq(ctrnonce, 12);
+    // Newer received ones move the counter past them
+    hzl_CommonCtrNonceAdvancePast(&ctrnonce, 100U);
+    atto_eq(ctrnonce, 101);
+}
+
+static void
+hzlCommonTest_CommonCtrNonceAdvancePastSaturates(void)
+{
+    HZL_ATOMIC hzl_CtrNonce_t ctrnonce = 10;
+
+    hzl_CommonCtrNonceAdvancePast(&ctrnonce, HZL_MAX_CTRNONCE - 1U);
+    atto_eq(ctrnonce, HZL_MAX_CTRNONCE);
+    hzl_CommonCtrNonceAdvancePast(&ctrnonce, 3U);
+    atto_eq(ctrnonce, HZL_MAX_CTRNONCE);
+    hzl_CommonCtrNonceAdvancePast(&ctrnonce, HZL_MAX_CTRNONCE - 1U);
+    atto_eq(ctrnonce, HZL_MAX_CTRNONCE);
+}
+
+void
+hzlCommonTest_CommonCtrNonceAdvancePast(void)
+{
+    hzlCommonTest_CommonCtrNonceAdvancePastReceived();
+    hzlCommonTest_CommonCtrNonceAdvancePastSaturates();
+}
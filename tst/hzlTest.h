@@ -46,6 +46,7 @@ extern "C"
 #include "hzl_ClientOs.h"
 #include "hzl_Server.h"
 #include "hzl_ServerOs.h"
+#include "hzl_ServerShards.h"
 
 /**
  * @def HZL_TEST_PARTIAL_REPORT
@@ -61,6 +62,43 @@ extern "C"
 #define HZL_TEST_PARTIAL_REPORT()
 #endif
 
+/**
+ * @def HZL_TEST_IS_HEADER_TYPE_BUILT
+ * True if the libraries under test support the given CBS header type: any of them,
+ * unless built with HZL_FIXED_HEADER_TYPE. Test cases of other header types are skipped.
+ * The sample correct configurations use the header type 0, thus the test suites
+ * support only HZL_FIXED_HEADER_TYPE=0 among the fixed ones.
+ */
+#ifdef HZL_FIXED_HEADER_TYPE
+#define HZL_TEST_IS_HEADER_TYPE_BUILT(type) ((type) == HZL_FIXED_HEADER_TYPE)
+#else
+#define HZL_TEST_IS_HEADER_TYPE_BUILT(type) true
+#endif
+
+/** Exit code of a test runner skipping all of its test cases, as ctest expects it. */
+#define HZL_TEST_SKIP_RETURN_CODE 77
+
+/**
+ * @def HZL_TEST_SKIP_UNLESS_CONFIG_HEADER_TYPE_BUILT
+ * Ends the test runner calling it from its main function as skipped when the libraries
+ * under test do not support the CBS header type 0 of the sample correct configurations,
+ * as almost all test cases would fail on their setup.
+ */
+#if HZL_OS_AVAILABLE
+#define HZL_TEST_SKIP_UNLESS_CONFIG_HEADER_TYPE_BUILT() do { \
+        if (!HZL_TEST_IS_HEADER_TYPE_BUILT(HZL_HEADER_0)) { \
+            printf("Skip | the test configurations use the CBS header type 0\n"); \
+            return HZL_TEST_SKIP_RETURN_CODE; \
+        } \
+    } while(0)
+#else
+#define HZL_TEST_SKIP_UNLESS_CONFIG_HEADER_TYPE_BUILT() do { \
+        if (!HZL_TEST_IS_HEADER_TYPE_BUILT(HZL_HEADER_0)) { \
+            return HZL_TEST_SKIP_RETURN_CODE; \
+        } \
+    } while(0)
+#endif
+
 /** Default amount of Groups in the sample correct configuration. */
 #define HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS 3U
 /** Maximum allocated amount of Groups in the sample correct configuration. */
@@ -104,6 +142,15 @@ hzlTest_IoMockupCurrentTimeFailing(hzl_Timestamp_t* timestamp);
 hzl_Err_t
 hzlTest_IoMockupCurrentTimeSucceeding(hzl_Timestamp_t* timestamp);
 
+// Tests of the internal functions shared by Client and Server, grouping test cases.
+void hzlCommonTest_CommonAead(void);
+
+void hzlCommonTest_CommonCtrDelay(void);
+
+void hzlCommonTest_CommonCtrNonceReserve(void);
+
+void hzlCommonTest_CommonCtrNonceAdvancePast(void);
+
 // Client test running functions, grouping test cases.
 void hzlClientTest_ClientInit(void);
 
@@ -125,6 +172,12 @@ void hzlClientTest_ClientBuildUnsecured(void);
 
 void hzlClientTest_ClientBuildSecuredFd(void);
 
+void hzlClientTest_ClientBuildSecuredFdBatch(void);
+
+void hzlClientTest_ClientBuildSecuredFdInto(void);
+
+void hzlClientTest_ClientBuildSecuredTp(void);
+
 void hzlClientTest_ClientProcessReceived(void);
 
 void hzlClientTest_ClientProcessReceivedUnsecured(void);
@@ -137,6 +190,10 @@ void hzlClientTest_ClientProcessReceivedResponse(void);
 
 void hzlClientTest_ClientProcessReceivedRenewal(void);
 
+void hzlClientTest_ClientProcessReceivedInPlace(void);
+
+void hzlClientTest_ClientUnpackHeader(void);
+
 // Server test running functions, grouping test cases.
 void hzlServerTest_ServerInit(void);
 
@@ -156,6 +213,12 @@ void hzlServerTest_ServerBuildUnsecured(void);
 
 void hzlServerTest_ServerBuildSecuredFd(void);
 
+void hzlServerTest_ServerBuildSecuredFdBatch(void);
+
+void hzlServerTest_ServerBuildSecuredFdInto(void);
+
+void hzlServerTest_ServerBuildSecuredTp(void);
+
 void hzlServerTest_ServerProcessReceived(void);
 
 void hzlServerTest_ServerProcessReceivedRequest(void);
@@ -166,8 +229,24 @@ void hzlServerTest_ServerProcessReceivedUnsecured(void);
 
 void hzlServerTest_ServerProcessReceivedSecuredFd(void);
 
+void hzlServerTest_ServerProcessReceivedBatch(void);
+
+void hzlServerTest_ServerProcessReceivedInPlace(void);
+
+void hzlServerTest_ServerUnpackHeader(void);
+
 void hzlServerTest_ServerForceSessionRenewal(void);
 
+void hzlServerTest_ServerTick(void);
+
+void hzlServerTest_ServerPrepareNextSessions(void);
+
+void hzlServerTest_ServerShardsNew(void);
+
+void hzlServerTest_ServerShardsSubmitReceived(void);
+
+void hzlServerTest_ServerShardsSubmitSecuredFd(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -41,6 +41,10 @@
 
 #include "hzlTest.h"
 
+#if HZL_OS_AVAILABLE_NIX && defined(HZL_THREAD_SAFE)
+#include <pthread.h>
+#endif
+
 #define CAN_ID 0x123U
 
 typedef enum hzlTest_Sid
@@ -66,12 +70,14 @@ typedef struct hzlInteropTest_Bus
     hzl_ClientCtx_t* alice;
     hzl_ClientCtx_t* bob;
     hzl_ClientCtx_t* charlie;
+    bool isUp;  ///< True once all Parties are set up.
 } hzlInteropTest_Bus_t;
 
 static void
 hzlInteropTest_BusInit(hzlInteropTest_Bus_t* const bus)
 {
     hzl_Err_t err;
+    memset(bus, 0, sizeof(hzlInteropTest_Bus_t));
     err = hzl_ServerNew(&bus->server, "serverconfigfiles/Server.hzl");
     atto_eq(err, HZL_OK);
     err = hzl_ClientNew(&bus->alice, "clientconfigfiles/Alice.hzl");
@@ -80,8 +86,21 @@ hzlInteropTest_BusInit(hzlInteropTest_Bus_t* const bus)
     atto_eq(err, HZL_OK);
     err = hzl_ClientNew(&bus->charlie, "clientconfigfiles/Charlie.hzl");
     atto_eq(err, HZL_OK);
+    bus->isUp = true;
 }
 
+/**
+ * Sets up the Parties of the bus from the main function, ending the test runner if any of
+ * them cannot be, as all test cases use them.
+ */
+#define HZL_INTEROP_BUS_INIT(bus) do { \
+        hzlInteropTest_BusInit(bus); \
+        if (!(bus)->isUp) { \
+            hzlInteropTest_BusTeardown(bus); \
+            return atto_at_least_one_fail; \
+        } \
+    } while(0)
+
 static void
 hzlInteropTest_BusTeardown(hzlInteropTest_Bus_t* const bus)
 {
@@ -445,18 +464,1121 @@ hzlInteropTest_RenewalPhase(hzlInteropTest_Bus_t* const bus)
     atto_eq(sdu.isForUser, false);
 }
 
+/** Feeds all fragments of an SADTP message to a receiver, expecting it complete at the end. */
+static void
+hzlInteropTest_ClientReceiveSadtp(hzl_ClientCtx_t* const receiver,
+                                  const hzl_CbsPduMsg_t* const fragments,
+                                  const size_t amountOfFragments,
+                                  hzl_RxSduMsg_t* const sdu)
+{
+    hzl_Err_t err;
+    hzl_CbsPduMsg_t nothing;
+    for (size_t i = 0; i < amountOfFragments; i++)
+    {
+        err = hzl_ClientProcessReceived(&nothing, sdu, receiver,
+                                        fragments[i].data, fragments[i].dataLen, CAN_ID);
+        atto_eq(err, HZL_OK);
+        atto_eq(nothing.dataLen, 0);
+        atto_eq(sdu->isForUser, i == amountOfFragments - 1U);
+    }
+}
+
+static void
+hzlInteropTest_SecuredTpExchange(hzlInteropTest_Bus_t* const bus)
+{
+    hzl_Err_t err;
+    hzl_CbsPduMsg_t sadtp[HZL_SADTP_AMOUNT_OF_PDUS(300)];
+    hzl_CbsPduMsg_t nothing;
+    hzl_RxSduMsg_t sdu;
+    size_t amountOfPdus;
+    static uint8_t sadData[300];
+    static uint8_t serverRxData[300];
+    static uint8_t aliceRxData[300];
+    static uint8_t bobRxData[300];
+    static hzl_SadtpRxBuffer_t serverRx = {.data = serverRxData, .capacity = 300};
+    static hzl_SadtpRxBuffer_t aliceRx = {.data = aliceRxData, .capacity = 300};
+    static hzl_SadtpRxBuffer_t bobRx = {.data = bobRxData, .capacity = 300};
+    bus->server->sadtpRxBuffers = &serverRx;
+    bus->server->amountOfSadtpRxBuffers = 1;
+    bus->alice->sadtpRxBuffers = &aliceRx;
+    bus->alice->amountOfSadtpRxBuffers = 1;
+    bus->bob->sadtpRxBuffers = &bobRx;
+    bus->bob->amountOfSadtpRxBuffers = 1;
+    for (size_t i = 0; i < sizeof(sadData); i++) { sadData[i] = (uint8_t) i; }
+
+    // Alice transmits messages of various lengths to Bob and the Server, including the
+    // ones where the tag is split across the last two fragments.
+    const size_t lengths[] = {0, 1, 40, 41, 42, 56, 57, 100, 113, 300};
+    for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++)
+    {
+        amountOfPdus = sizeof(sadtp) / sizeof(sadtp[0]);
+        err = hzl_ClientBuildSecuredTp(sadtp, &amountOfPdus, bus->alice,
+                                       sadData, lengths[l], GID_SAB);
+        atto_eq(err, HZL_OK);
+        atto_ge(amountOfPdus, 1);
+        atto_le(amountOfPdus, HZL_SADTP_AMOUNT_OF_PDUS(lengths[l]));
+        for (size_t i = 0; i < amountOfPdus; i++)
+        {
+            err = hzl_ServerProcessReceived(&nothing, &sdu, bus->server,
+                                            sadtp[i].data, sadtp[i].dataLen, CAN_ID);
+            atto_eq(err, HZL_OK);
+            atto_eq(nothing.dataLen, 0);
+            atto_eq(sdu.isForUser, i == amountOfPdus - 1U);
+        }
+        atto_eq(sdu.wasSecured, true);
+        atto_eq(sdu.gid, GID_SAB);
+        atto_eq(sdu.sid, ALICE);
+        atto_eq(sdu.dataLen, lengths[l]);
+        atto_memeq(sdu.reassembledData, sadData, lengths[l]);
+        hzlInteropTest_ClientReceiveSadtp(bus->bob, sadtp, amountOfPdus, &sdu);
+        atto_eq(sdu.sid, ALICE);
+        atto_eq(sdu.dataLen, lengths[l]);
+        atto_memeq(sdu.reassembledData, sadData, lengths[l]);
+        // Charlie does not have any reception buffer, nor is in the Group
+        err = hzl_ClientProcessReceived(&nothing, &sdu, bus->charlie,
+                                        sadtp[0].data, sadtp[0].dataLen, CAN_ID);
+        atto_eq(err, HZL_ERR_MSG_IGNORED);
+        atto_eq(sdu.isForUser, false);
+    }
+
+    // Server transmits to Alice and Bob
+    amountOfPdus = sizeof(sadtp) / sizeof(sadtp[0]);
+    err = hzl_ServerBuildSecuredTp(sadtp, &amountOfPdus, bus->server,
+                                   sadData, 200, GID_SAB);
+    atto_eq(err, HZL_OK);
+    hzlInteropTest_ClientReceiveSadtp(bus->alice, sadtp, amountOfPdus, &sdu);
+    atto_eq(sdu.sid, SERVER);
+    atto_eq(sdu.dataLen, 200);
+    atto_memeq(sdu.reassembledData, sadData, 200);
+    hzlInteropTest_ClientReceiveSadtp(bus->bob, sadtp, amountOfPdus, &sdu);
+    atto_eq(sdu.sid, SERVER);
+    atto_eq(sdu.dataLen, 200);
+    atto_memeq(sdu.reassembledData, sadData, 200);
+
+    // Not enough space for all fragments
+    amountOfPdus = 2;
+    err = hzl_ClientBuildSecuredTp(sadtp, &amountOfPdus, bus->alice, sadData, 200, GID_SAB);
+    atto_eq(err, HZL_ERR_TOO_LONG_SDU);
+    atto_eq(amountOfPdus, 0);
+
+    // Tampered tag: the message is discarded, its plaintext erased
+    amountOfPdus = sizeof(sadtp) / sizeof(sadtp[0]);
+    err = hzl_ClientBuildSecuredTp(sadtp, &amountOfPdus, bus->alice, sadData, 200, GID_SAB);
+    atto_eq(err, HZL_OK);
+    sadtp[amountOfPdus - 1U].data[sadtp[amountOfPdus - 1U].dataLen - 1U] ^= 0x01U;
+    for (size_t i = 0; i < amountOfPdus; i++)
+    {
+        err = hzl_ClientProcessReceived(&nothing, &sdu, bus->bob,
+                                        sadtp[i].data, sadtp[i].dataLen, CAN_ID);
+        atto_eq(sdu.isForUser, false);
+    }
+    atto_eq(err, HZL_ERR_SECWARN_INVALID_TAG);
+    atto_eq(bobRx.isInUse, false);
+    atto_zeros(bobRxData, 200);
+
+    // Missing fragment: the following one is rejected, as is the rest of the message
+    amountOfPdus = sizeof(sadtp) / sizeof(sadtp[0]);
+    err = hzl_ClientBuildSecuredTp(sadtp, &amountOfPdus, bus->alice, sadData, 200, GID_SAB);
+    atto_eq(err, HZL_OK);
+    atto_ge(amountOfPdus, 4);
+    err = hzl_ServerProcessReceived(&nothing, &sdu, bus->server,
+                                    sadtp[0].data, sadtp[0].dataLen, CAN_ID);
+    atto_eq(err, HZL_OK);
+    err = hzl_ServerProcessReceived(&nothing, &sdu, bus->server,
+                                    sadtp[2].data, sadtp[2].dataLen, CAN_ID);
+    atto_eq(err, HZL_ERR_SADTP_UNEXPECTED_FRAGMENT);
+    atto_eq(sdu.isForUser, false);
+    err = hzl_ServerProcessReceived(&nothing, &sdu, bus->server,
+                                    sadtp[3].data, sadtp[3].dataLen, CAN_ID);
+    atto_eq(err, HZL_ERR_SADTP_UNEXPECTED_FRAGMENT);
+    atto_eq(serverRx.isInUse, false);
+
+    // Message too large for the reception buffer
+    serverRx.capacity = 100;
+    amountOfPdus = sizeof(sadtp) / sizeof(sadtp[0]);
+    err = hzl_ClientBuildSecuredTp(sadtp, &amountOfPdus, bus->alice, sadData, 200, GID_SAB);
+    atto_eq(err, HZL_OK);
+    err = hzl_ServerProcessReceived(&nothing, &sdu, bus->server,
+                                    sadtp[0].data, sadtp[0].dataLen, CAN_ID);
+    atto_eq(err, HZL_ERR_SADTP_NO_FREE_RX_BUFFER);
+    serverRx.capacity = 300;
+}
+
+#define HZL_INTEROP_SADFD_BATCH_LEN 50U
+
+static void
+hzlInteropTest_Handshake(hzl_ServerCtx_t* const server,
+                         hzl_ClientCtx_t* const client,
+                         const hzl_Gid_t gid)
+{
+    hzl_Err_t err;
+    hzl_CbsPduMsg_t req;
+    hzl_CbsPduMsg_t res;
+    hzl_CbsPduMsg_t nothing;
+    hzl_RxSduMsg_t sdu;
+    err = hzl_ClientBuildRequest(&req, client, gid);
+    atto_eq(err, HZL_OK);
+    err = hzl_ServerProcessReceived(&res, &sdu, server, req.data, req.dataLen, CAN_ID);
+    atto_eq(err, HZL_OK);
+    err = hzl_ClientProcessReceived(&nothing, &sdu, client, res.data, res.dataLen, CAN_ID);
+    atto_eq(err, HZL_OK);
+}
+
+static void
+hzlInteropTest_SecuredFdBatchExchange(hzlInteropTest_Bus_t* const bus)
+{
+    hzl_Err_t err;
+    static hzl_CbsPduMsg_t sadfd[HZL_INTEROP_SADFD_BATCH_LEN];
+    static hzl_CbsPduMsg_t reactions[HZL_INTEROP_SADFD_BATCH_LEN];
+    static hzl_RxSduMsg_t sdus[HZL_INTEROP_SADFD_BATCH_LEN];
+    hzl_Err_t results[HZL_INTEROP_SADFD_BATCH_LEN];
+    const uint8_t* pdus[HZL_INTEROP_SADFD_BATCH_LEN];
+    size_t pduLens[HZL_INTEROP_SADFD_BATCH_LEN];
+    hzl_CanId_t canIds[HZL_INTEROP_SADFD_BATCH_LEN];
+    uint8_t sadData[HZL_MAX_CAN_FD_DATA_LEN];
+    for (size_t i = 0; i < sizeof(sadData); i++) { sadData[i] = (uint8_t) (0xA0U + i); }
+    // Alice and Bob establish the Sessions of two Groups
+    hzlInteropTest_Handshake(bus->server, bus->alice, GID_SAB);
+    hzlInteropTest_Handshake(bus->server, bus->bob, GID_SBC);
+
+    // Alice and Bob alternate in two Groups with different STKs, transmitting every
+    // plaintext length fitting a frame, so the messages decrypted together differ in
+    // key and length.
+    for (size_t i = 0; i < HZL_INTEROP_SADFD_BATCH_LEN; i++)
+    {
+        const bool isFromAlice = (i % 2U) == 0U;
+        err = hzl_ClientBuildSecuredFd(&sadfd[i], isFromAlice ? bus->alice : bus->bob,
+                                       sadData, i, isFromAlice ? GID_SAB : GID_SBC);
+        atto_eq(err, HZL_OK);
+        pdus[i] = sadfd[i].data;
+        pduLens[i] = sadfd[i].dataLen;
+        canIds[i] = CAN_ID;
+    }
+    // Tampered ciphertext and tampered tag
+    sadfd[13].data[sadfd[13].dataLen - 10U] ^= 0x01U;
+    sadfd[30].data[sadfd[30].dataLen - 1U] ^= 0x80U;
+
+    err = hzl_ServerProcessReceivedBatch(reactions, sdus, results, bus->server,
+                                         pdus, pduLens, canIds, NULL,
+                                         HZL_INTEROP_SADFD_BATCH_LEN);
+
+    atto_eq(err, HZL_OK);
+    for (size_t i = 0; i < HZL_INTEROP_SADFD_BATCH_LEN; i++)
+    {
+        if (i == 13U || i == 30U)
+        {
+            atto_eq(results[i], HZL_ERR_SECWARN_INVALID_TAG);
+            atto_false(sdus[i].isForUser);
+            atto_zeros(sdus[i].data, HZL_MAX_CAN_FD_DATA_LEN);
+            continue;
+        }
+        atto_eq(results[i], HZL_OK);
+        atto_true(sdus[i].isForUser);
+        atto_true(sdus[i].wasSecured);
+        atto_eq(sdus[i].sid, (i % 2U) == 0U ? ALICE : BOB);
+        atto_eq(sdus[i].gid, (i % 2U) == 0U ? GID_SAB : GID_SBC);
+        atto_eq(sdus[i].dataLen, i);
+        atto_memeq(sdus[i].data, sadData, i);
+        atto_zeros(&sdus[i].data[i], HZL_MAX_CAN_FD_DATA_LEN - i);
+        atto_eq(reactions[i].dataLen, 0);
+    }
+
+    // A message passing the Counter Nonce check when its window is prepared, but too old
+    // once the newer message before it in the window is processed, is rejected before
+    // its decryption: no plaintext is left in the output.
+    hzl_CbsPduMsg_t older;
+    err = hzl_ClientBuildSecuredFd(&older, bus->alice, sadData, 10, GID_SAB);
+    atto_eq(err, HZL_OK);
+    for (size_t i = 0; i < 100U; i++)
+    {
+        err = hzl_ClientBuildSecuredFd(&sadfd[0], bus->alice, sadData, 10, GID_SAB);
+        atto_eq(err, HZL_OK);
+    }
+    pduLens[0] = sadfd[0].dataLen;
+    pdus[1] = older.data;
+    pduLens[1] = older.dataLen;
+    err = hzl_ServerProcessReceivedBatch(reactions, sdus, results, bus->server,
+                                         pdus, pduLens, canIds, NULL, 2);
+    atto_eq(err, HZL_OK);
+    atto_eq(results[0], HZL_OK);
+    atto_memeq(sdus[0].data, sadData, 10);
+    atto_eq(results[1], HZL_ERR_SECWARN_OLD_MESSAGE);
+    atto_false(sdus[1].isForUser);
+    atto_eq(sdus[1].dataLen, 0);
+    atto_zeros(sdus[1].data, HZL_MAX_CAN_FD_DATA_LEN);
+}
+
+/** Clock of the Parties, before being shifted by the tests. */
+static hzl_TimestampFunc hzlInteropTest_unshiftedTime;
+/** Milliseconds the shifted clock is ahead of the unshifted one. */
+static hzl_Timestamp_t hzlInteropTest_timeShiftMillis;
+
+static hzl_Err_t
+hzlInteropTest_ShiftedTime(hzl_Timestamp_t* const timestamp)
+{
+    const hzl_Err_t err = hzlInteropTest_unshiftedTime(timestamp);
+    *timestamp += hzlInteropTest_timeShiftMillis;
+    return err;
+}
+
+/** Feeds the given fragments of an SADTP message to the Server, expecting no errors. */
+static void
+hzlInteropTest_ServerReceiveSadtpFragments(hzl_ServerCtx_t* const server,
+                                           const hzl_CbsPduMsg_t* const fragments,
+                                           const size_t from,
+                                           const size_t to,
+                                           hzl_RxSduMsg_t* const sdu)
+{
+    hzl_Err_t err;
+    hzl_CbsPduMsg_t nothing;
+    for (size_t i = from; i < to; i++)
+    {
+        err = hzl_ServerProcessReceived(&nothing, sdu, server,
+                                        fragments[i].data, fragments[i].dataLen, CAN_ID);
+        atto_eq(err, HZL_OK);
+        atto_eq(nothing.dataLen, 0);
+    }
+}
+
+static void
+hzlInteropTest_SecuredTpStalenessPerGroup(hzlInteropTest_Bus_t* const bus)
+{
+    hzl_Err_t err;
+    hzl_CbsPduMsg_t fromAlice[HZL_SADTP_AMOUNT_OF_PDUS(200)];
+    hzl_CbsPduMsg_t fromBob[HZL_SADTP_AMOUNT_OF_PDUS(200)];
+    hzl_CbsPduMsg_t nothing;
+    hzl_RxSduMsg_t sdu;
+    size_t amountOfAlicePdus = sizeof(fromAlice) / sizeof(fromAlice[0]);
+    size_t amountOfBobPdus = sizeof(fromBob) / sizeof(fromBob[0]);
+    static uint8_t sadData[200];
+    static uint8_t serverRxData[2][200];
+    static hzl_SadtpRxBuffer_t serverRx[2] = {
+            {.data = serverRxData[0], .capacity = 200},
+            {.data = serverRxData[1], .capacity = 200},
+    };
+    for (size_t i = 0; i < sizeof(sadData); i++) { sadData[i] = (uint8_t) (0x55U ^ i); }
+    // Same Server as on the bus, with a clock the test can move forward and a Group
+    // with a much shorter Max Silence Interval than the others
+    hzl_ServerGroupConfig_t groupConfigs[GID_SC + 1U];
+    memcpy(groupConfigs, bus->server->groupConfigs, sizeof(groupConfigs));
+    groupConfigs[GID_SBC].maxSilenceIntervalMillis = 1U;
+    atto_gt(groupConfigs[GID_SAB].maxSilenceIntervalMillis, 100U);
+    hzl_ServerCtx_t server = *bus->server;
+    server.groupConfigs = groupConfigs;
+    server.sadtpRxBuffers = serverRx;
+    server.amountOfSadtpRxBuffers = 2;
+    hzlInteropTest_unshiftedTime = bus->server->io.currentTime;
+    hzlInteropTest_timeShiftMillis = 0U;
+    server.io.currentTime = hzlInteropTest_ShiftedTime;
+    err = hzl_ClientBuildSecuredTp(fromAlice, &amountOfAlicePdus, bus->alice,
+                                   sadData, sizeof(sadData), GID_SAB);
+    atto_eq(err, HZL_OK);
+    atto_ge(amountOfAlicePdus, 3);
+    err = hzl_ClientBuildSecuredTp(fromBob, &amountOfBobPdus, bus->bob,
+                                   sadData, sizeof(sadData), GID_SBC);
+    atto_eq(err, HZL_OK);
+    atto_ge(amountOfBobPdus, 3);
+
+    // Alice's message, silent for longer than the Max Silence Interval of Bob's Group
+    // but not of its own, is not discarded when Bob's message starts.
+    hzlInteropTest_ServerReceiveSadtpFragments(&server, fromAlice, 0, 1, &sdu);
+    hzlInteropTest_timeShiftMillis += 100U;
+    hzlInteropTest_ServerReceiveSadtpFragments(&server, fromBob, 0, 1, &sdu);
+    hzlInteropTest_ServerReceiveSadtpFragments(&server, fromAlice, 1, amountOfAlicePdus, &sdu);
+    atto_true(sdu.isForUser);
+    atto_eq(sdu.gid, GID_SAB);
+    atto_eq(sdu.sid, ALICE);
+    atto_eq(sdu.dataLen, sizeof(sadData));
+    atto_memeq(sdu.reassembledData, sadData, sizeof(sadData));
+
+    // Bob's message, silent for longer than the Max Silence Interval of its own Group,
+    // is discarded when another message starts.
+    hzlInteropTest_timeShiftMillis += 100U;
+    amountOfAlicePdus = sizeof(fromAlice) / sizeof(fromAlice[0]);
+    err = hzl_ClientBuildSecuredTp(fromAlice, &amountOfAlicePdus, bus->alice,
+                                   sadData, sizeof(sadData), GID_SAB);
+    atto_eq(err, HZL_OK);
+    hzlInteropTest_ServerReceiveSadtpFragments(&server, fromAlice, 0, 1, &sdu);
+    err = hzl_ServerProcessReceived(&nothing, &sdu, &server,
+                                    fromBob[1].data, fromBob[1].dataLen, CAN_ID);
+    atto_eq(err, HZL_ERR_SADTP_UNEXPECTED_FRAGMENT);
+    atto_false(sdu.isForUser);
+}
+
+/** Longest message of the interleaved SADTP batch. */
+#define HZL_INTEROP_SADTP_BATCH_DATA_LEN 200U
+/** Fragments of the longest message of the interleaved SADTP batch. */
+#define HZL_INTEROP_SADTP_MSG_PDUS HZL_SADTP_AMOUNT_OF_PDUS(HZL_INTEROP_SADTP_BATCH_DATA_LEN)
+/** Fragments of all messages of the interleaved SADTP batch. */
+#define HZL_INTEROP_SADTP_BATCH_LEN (3U * HZL_INTEROP_SADTP_MSG_PDUS)
+
+static void
+hzlInteropTest_SecuredTpBatchInterleaved(hzlInteropTest_Bus_t* const bus)
+{
+    hzl_Err_t err;
+    static hzl_CbsPduMsg_t fromAlice[2U * HZL_INTEROP_SADTP_MSG_PDUS];
+    static hzl_CbsPduMsg_t fromBob[HZL_INTEROP_SADTP_MSG_PDUS];
+    static hzl_CbsPduMsg_t reactions[HZL_INTEROP_SADTP_BATCH_LEN];
+    static hzl_RxSduMsg_t sdus[HZL_INTEROP_SADTP_BATCH_LEN];
+    hzl_Err_t results[HZL_INTEROP_SADTP_BATCH_LEN];
+    const uint8_t* pdus[HZL_INTEROP_SADTP_BATCH_LEN];
+    size_t pduLens[HZL_INTEROP_SADTP_BATCH_LEN];
+    hzl_CanId_t canIds[HZL_INTEROP_SADTP_BATCH_LEN];
+    static uint8_t firstData[60];
+    static uint8_t secondData[150];
+    static uint8_t bobData[HZL_INTEROP_SADTP_BATCH_DATA_LEN];
+    static uint8_t serverRxData[3][HZL_INTEROP_SADTP_BATCH_DATA_LEN];
+    static hzl_SadtpRxBuffer_t serverRx[3] = {
+            {.data = serverRxData[0], .capacity = HZL_INTEROP_SADTP_BATCH_DATA_LEN},
+            {.data = serverRxData[1], .capacity = HZL_INTEROP_SADTP_BATCH_DATA_LEN},
+            {.data = serverRxData[2], .capacity = HZL_INTEROP_SADTP_BATCH_DATA_LEN},
+    };
+    memset(firstData, 0x11, sizeof(firstData));
+    memset(secondData, 0x22, sizeof(secondData));
+    memset(bobData, 0x33, sizeof(bobData));
+    hzl_ServerCtx_t server = *bus->server;
+    server.sadtpRxBuffers = serverRx;
+    server.amountOfSadtpRxBuffers = 3;
+    // Alice transmits two messages back to back, Bob a long one at the same time
+    size_t amountOfFirstPdus = sizeof(fromAlice) / sizeof(fromAlice[0]);
+    err = hzl_ClientBuildSecuredTp(fromAlice, &amountOfFirstPdus, bus->alice,
+                                   firstData, sizeof(firstData), GID_SAB);
+    atto_eq(err, HZL_OK);
+    size_t amountOfAlicePdus = sizeof(fromAlice) / sizeof(fromAlice[0]) - amountOfFirstPdus;
+    err = hzl_ClientBuildSecuredTp(&fromAlice[amountOfFirstPdus], &amountOfAlicePdus,
+                                   bus->alice, secondData, sizeof(secondData), GID_SAB);
+    atto_eq(err, HZL_OK);
+    amountOfAlicePdus += amountOfFirstPdus;
+    size_t amountOfBobPdus = sizeof(fromBob) / sizeof(fromBob[0]);
+    err = hzl_ClientBuildSecuredTp(fromBob, &amountOfBobPdus, bus->bob,
+                                   bobData, sizeof(bobData), GID_SBC);
+    atto_eq(err, HZL_OK);
+    // Bob's message is still being reassembled when Alice's second one starts
+    atto_gt(amountOfBobPdus, amountOfFirstPdus);
+
+    // The fragments alternate between Alice and Bob on the bus, all in one batch:
+    // Alice's second message must not take over the buffer of her first one, which the
+    // user has not read yet.
+    size_t amountOfPdus = 0;
+    for (size_t a = 0, b = 0; a < amountOfAlicePdus || b < amountOfBobPdus;)
+    {
+        if (a < amountOfAlicePdus)
+        {
+            pdus[amountOfPdus] = fromAlice[a].data;
+            pduLens[amountOfPdus++] = fromAlice[a++].dataLen;
+        }
+        if (b < amountOfBobPdus)
+        {
+            pdus[amountOfPdus] = fromBob[b].data;
+            pduLens[amountOfPdus++] = fromBob[b++].dataLen;
+        }
+    }
+    for (size_t i = 0; i < amountOfPdus; i++) { canIds[i] = CAN_ID; }
+    err = hzl_ServerProcessReceivedBatch(reactions, sdus, results, &server,
+                                         pdus, pduLens, canIds, NULL, amountOfPdus);
+    atto_eq(err, HZL_OK);
+    // Each message is read only after the whole batch was processed
+    size_t amountOfMessages = 0;
+    for (size_t i = 0; i < amountOfPdus; i++)
+    {
+        atto_eq(results[i], HZL_OK);
+        atto_eq(reactions[i].dataLen, 0);
+        if (!sdus[i].isForUser) { continue; }
+        amountOfMessages++;
+        if (sdus[i].dataLen == sizeof(firstData))
+        {
+            atto_eq(sdus[i].sid, ALICE);
+            atto_memeq(sdus[i].reassembledData, firstData, sizeof(firstData));
+        }
+        else if (sdus[i].dataLen == sizeof(secondData))
+        {
+            atto_eq(sdus[i].sid, ALICE);
+            atto_memeq(sdus[i].reassembledData, secondData, sizeof(secondData));
+        }
+        else
+        {
+            atto_eq(sdus[i].sid, BOB);
+            atto_eq(sdus[i].dataLen, sizeof(bobData));
+            atto_memeq(sdus[i].reassembledData, bobData, sizeof(bobData));
+        }
+    }
+    atto_eq(amountOfMessages, 3);
+
+    // The next call frees the buffers of the messages of the previous one, erasing them
+    amountOfBobPdus = sizeof(fromBob) / sizeof(fromBob[0]);
+    err = hzl_ClientBuildSecuredTp(fromBob, &amountOfBobPdus, bus->bob,
+                                   bobData, 40, GID_SBC);
+    atto_eq(err, HZL_OK);
+    for (size_t i = 0; i < amountOfBobPdus; i++)
+    {
+        pdus[i] = fromBob[i].data;
+        pduLens[i] = fromBob[i].dataLen;
+    }
+    err = hzl_ServerProcessReceivedBatch(reactions, sdus, results, &server,
+                                         pdus, pduLens, canIds, NULL, amountOfBobPdus);
+    atto_eq(err, HZL_OK);
+    atto_eq(results[amountOfBobPdus - 1U], HZL_OK);
+    atto_true(sdus[amountOfBobPdus - 1U].isForUser);
+    atto_eq(sdus[amountOfBobPdus - 1U].reassembledData, serverRxData[0]);
+    atto_memeq(serverRxData[0], bobData, 40);
+    atto_zeros(&serverRxData[0][40], HZL_INTEROP_SADTP_BATCH_DATA_LEN - 40U);
+    atto_zeros(serverRxData[1], HZL_INTEROP_SADTP_BATCH_DATA_LEN);
+    atto_zeros(serverRxData[2], HZL_INTEROP_SADTP_BATCH_DATA_LEN);
+    atto_eq(serverRx[1].holder, NULL);
+    atto_eq(serverRx[2].holder, NULL);
+}
+
+/** Bits of the 29-bit CAN ID the user sets on its own, above the ones carrying the header. */
+#define HZL_INTEROP_USER_CAN_ID_BITS 0x1B000000U
+
+static void
+hzlInteropTest_HeaderPlacementExchange(hzlInteropTest_Bus_t* const bus,
+                                       const hzl_HeaderPlacement_t placement,
+                                       const size_t headerLenInCanId)
+{
+    hzl_Err_t err;
+    // Same Parties as on the bus, configured with the given header placement
+    hzl_ServerConfig_t serverConfig = *bus->server->serverConfig;
+    serverConfig.headerPlacement = placement;
+    hzl_ServerCtx_t server = *bus->server;
+    server.serverConfig = &serverConfig;
+    err = hzl_ServerInit(&server);
+    atto_eq(err, HZL_OK);
+    hzl_ClientConfig_t aliceConfig = *bus->alice->clientConfig;
+    aliceConfig.headerPlacement = placement;
+    hzl_ClientCtx_t alice = *bus->alice;
+    alice.clientConfig = &aliceConfig;
+    err = hzl_ClientInit(&alice);
+    atto_eq(err, HZL_OK);
+    const hzl_CanId_t expectedMask = (hzl_CanId_t) ((1ULL << (8U * headerLenInCanId)) - 1U);
+    atto_eq(server.header.canIdMask, expectedMask);
+    atto_eq(alice.header.canIdMask, expectedMask);
+    hzl_CbsPduMsg_t req;
+    hzl_CbsPduMsg_t res;
+    hzl_CbsPduMsg_t nothing;
+    hzl_RxSduMsg_t sdu;
+
+    // Handshake, the CAN ID of each message carrying its header bits
+    err = hzl_ClientBuildRequest(&req, &alice, GID_SAB);
+    atto_eq(err, HZL_OK);
+    atto_eq(req.canId & ~expectedMask, 0);
+    err = hzl_ServerProcessReceived(&res, &sdu, &server, req.data, req.dataLen,
+                                    HZL_INTEROP_USER_CAN_ID_BITS | req.canId);
+    atto_eq(err, HZL_OK);
+    atto_neq(res.dataLen, 0);
+    err = hzl_ClientProcessReceived(&nothing, &sdu, &alice, res.data, res.dataLen,
+                                    HZL_INTEROP_USER_CAN_ID_BITS | res.canId);
+    atto_eq(err, HZL_OK);
+
+    // SADFD: the payload is shorter by the part of the header moved to the CAN ID
+    const uint8_t sadData[] = "ABCDE";
+    hzl_CbsPduMsg_t sadfd;
+    err = hzl_ClientBuildSecuredFd(&sadfd, &alice, sadData, sizeof(sadData), GID_SAB);
+    atto_eq(err, HZL_OK);
+    const size_t sadfdLenWithHeaderInPayload = 3U + 3U + 1U + sizeof(sadData) + 8U;
+    atto_eq(sadfd.dataLen, sadfdLenWithHeaderInPayload - headerLenInCanId);
+    err = hzl_ServerProcessReceived(&nothing, &sdu, &server, sadfd.data, sadfd.dataLen,
+                                    HZL_INTEROP_USER_CAN_ID_BITS | sadfd.canId);
+    atto_eq(err, HZL_OK);
+    atto_true(sdu.isForUser);
+    atto_true(sdu.wasSecured);
+    atto_eq(sdu.sid, ALICE);
+    atto_eq(sdu.gid, GID_SAB);
+    atto_eq(sdu.canId, HZL_INTEROP_USER_CAN_ID_BITS | sadfd.canId);
+    atto_eq(sdu.dataLen, sizeof(sadData));
+    atto_memeq(sdu.data, sadData, sizeof(sadData));
+    hzl_Header_t hdr;
+    err = hzl_ServerUnpackHeader(&hdr, &server, sadfd.data, sadfd.dataLen,
+                                 HZL_INTEROP_USER_CAN_ID_BITS | sadfd.canId);
+    atto_eq(err, HZL_OK);
+    atto_eq(hdr.gid, GID_SAB);
+    atto_eq(hdr.sid, ALICE);
+
+    // UAD from the Server
+    err = hzl_ServerBuildUnsecured(&sadfd, &server, sadData, sizeof(sadData), GID_SAB);
+    atto_eq(err, HZL_OK);
+    atto_eq(sadfd.dataLen, 3U + sizeof(sadData) - headerLenInCanId);
+    err = hzl_ClientProcessReceived(&nothing, &sdu, &alice, sadfd.data, sadfd.dataLen,
+                                    HZL_INTEROP_USER_CAN_ID_BITS | sadfd.canId);
+    atto_eq(err, HZL_OK);
+    atto_true(sdu.isForUser);
+    atto_false(sdu.wasSecured);
+    atto_eq(sdu.sid, SERVER);
+    atto_memeq(sdu.data, sadData, sizeof(sadData));
+    if (placement == HZL_HEADER_IN_CAN_ID)
+    {
+        // The header is not read from the payload: a different CAN ID means a different
+        // transmitter, here the receiver itself.
+        err = hzl_ClientProcessReceived(&nothing, &sdu, &alice, sadfd.data, sadfd.dataLen,
+                                        (GID_SAB << 16U) | (ALICE << 8U) | 5U);
+        atto_eq(err, HZL_ERR_SECWARN_MESSAGE_FROM_MYSELF);
+    }
+    else if (placement == HZL_HEADER_MIXED)
+    {
+        // The GID is read from the CAN ID, the rest of the header from the payload
+        err = hzl_ClientProcessReceived(&nothing, &sdu, &alice, sadfd.data, sadfd.dataLen,
+                                        HZL_INTEROP_USER_CAN_ID_BITS | GID_SC);
+        atto_eq(err, HZL_OK);
+        atto_eq(sdu.gid, GID_SC);
+        atto_eq(sdu.sid, SERVER);
+    }
+}
+
+#if HZL_OS_AVAILABLE_NIX
+
+/** Amount of shards of the sharded Server: GID_SA and GID_SAB are owned by different ones. */
+#define HZL_INTEROP_AMOUNT_OF_SHARDS 2U
+
+/**
+ * Last outcome of the sharded Server per GID. Read only after hzl_ServerShardsFree() joined
+ * the worker threads, so no further sync is needed.
+ */
+typedef struct hzlInteropTest_ShardsRecord
+{
+    hzl_Err_t processedResult[GID_SC + 1U];
+    size_t processedShardIndex[GID_SC + 1U];
+    hzl_CbsPduMsg_t reactionPdu[GID_SC + 1U];
+    hzl_RxSduMsg_t receivedUserData[GID_SC + 1U];
+    hzl_Err_t builtResult[GID_SC + 1U];
+    hzl_CbsPduMsg_t builtPdu[GID_SC + 1U];
+} hzlInteropTest_ShardsRecord_t;
+
+static void
+hzlInteropTest_ShardsRecordProcessed(void* const userData,
+                                     const size_t shardIndex,
+                                     const hzl_Err_t result,
+                                     const hzl_Header_t* const receivedHeader,
+                                     const hzl_CbsPduMsg_t* const reactionPdu,
+                                     const hzl_RxSduMsg_t* const receivedUserData)
+{
+    hzlInteropTest_ShardsRecord_t* const record = userData;
+    const hzl_Gid_t gid = receivedHeader->gid;
+    if (gid > GID_SC) { return; }
+    record->processedResult[gid] = result;
+    record->processedShardIndex[gid] = shardIndex;
+    record->reactionPdu[gid] = *reactionPdu;
+    record->receivedUserData[gid] = *receivedUserData;
+}
+
+static void
+hzlInteropTest_ShardsRecordBuilt(void* const userData,
+                                 const size_t shardIndex,
+                                 const hzl_Err_t result,
+                                 const hzl_CbsPduMsg_t* const securedPdu)
+{
+    (void) shardIndex;
+    hzlInteropTest_ShardsRecord_t* const record = userData;
+    const hzl_Gid_t gid = securedPdu->data[0];  // Header type 0 in the payload
+    if (gid > GID_SC) { return; }
+    record->builtResult[gid] = result;
+    record->builtPdu[gid] = *securedPdu;
+}
+
+static void
+hzlInteropTest_ShardedServerExchange(hzlInteropTest_Bus_t* const bus)
+{
+    hzl_Err_t err;
+    hzlInteropTest_ShardsRecord_t record;
+    memset(&record, 0, sizeof(record));
+    const hzl_ServerShardsConfig_t config = {
+            .amountOfShards = HZL_INTEROP_AMOUNT_OF_SHARDS,
+            .ringCapacity = 4,
+            .onProcessed = hzlInteropTest_ShardsRecordProcessed,
+            .onBuilt = hzlInteropTest_ShardsRecordBuilt,
+            .userData = &record,
+    };
+    hzl_ServerShards_t* shards = NULL;
+    hzl_CbsPduMsg_t req;
+    hzl_CbsPduMsg_t nothing;
+    hzl_RxSduMsg_t sdu;
+    const hzl_Gid_t gids[] = {GID_SA, GID_SAB};
+
+    // Handshakes of Alice in two Groups owned by different shards
+    err = hzl_ServerShardsNew(&shards, bus->server, &config);
+    atto_eq(err, HZL_OK);
+    for (size_t i = 0; i < sizeof(gids) / sizeof(gids[0]); i++)
+    {
+        err = hzl_ClientBuildRequest(&req, bus->alice, gids[i]);
+        atto_eq(err, HZL_OK);
+        err = hzl_ServerShardsSubmitReceived(shards, req.data, req.dataLen, CAN_ID);
+        atto_eq(err, HZL_OK);
+    }
+    hzl_ServerShardsFree(&shards);
+    for (size_t i = 0; i < sizeof(gids) / sizeof(gids[0]); i++)
+    {
+        const hzl_Gid_t gid = gids[i];
+        atto_eq(record.processedResult[gid], HZL_OK);
+        atto_eq(record.processedShardIndex[gid], gid % HZL_INTEROP_AMOUNT_OF_SHARDS);
+        atto_neq(record.reactionPdu[gid].dataLen, 0);
+        err = hzl_ClientProcessReceived(&nothing, &sdu, bus->alice, record.reactionPdu[gid].data,
+                                        record.reactionPdu[gid].dataLen, CAN_ID);
+        atto_eq(err, HZL_OK);
+    }
+
+    // Secured messages in both directions
+    const uint8_t sadData[] = "ABCDE";
+    hzl_CbsPduMsg_t sadfd;
+    err = hzl_ServerShardsNew(&shards, bus->server, &config);
+    atto_eq(err, HZL_OK);
+    for (size_t i = 0; i < sizeof(gids) / sizeof(gids[0]); i++)
+    {
+        err = hzl_ClientBuildSecuredFd(&sadfd, bus->alice, sadData, sizeof(sadData), gids[i]);
+        atto_eq(err, HZL_OK);
+        err = hzl_ServerShardsSubmitReceived(shards, sadfd.data, sadfd.dataLen, CAN_ID);
+        atto_eq(err, HZL_OK);
+        err = hzl_ServerShardsSubmitSecuredFd(shards, sadData, sizeof(sadData), gids[i]);
+        atto_eq(err, HZL_OK);
+    }
+    hzl_ServerShardsFree(&shards);
+    for (size_t i = 0; i < sizeof(gids) / sizeof(gids[0]); i++)
+    {
+        const hzl_Gid_t gid = gids[i];
+        atto_eq(record.processedResult[gid], HZL_OK);
+        atto_true(record.receivedUserData[gid].isForUser);
+        atto_true(record.receivedUserData[gid].wasSecured);
+        atto_eq(record.receivedUserData[gid].sid, ALICE);
+        atto_eq(record.receivedUserData[gid].dataLen, sizeof(sadData));
+        atto_memeq(record.receivedUserData[gid].data, sadData, sizeof(sadData));
+        atto_eq(record.builtResult[gid], HZL_OK);
+        err = hzl_ClientProcessReceived(&nothing, &sdu, bus->alice, record.builtPdu[gid].data,
+                                        record.builtPdu[gid].dataLen, CAN_ID);
+        atto_eq(err, HZL_OK);
+        atto_true(sdu.wasSecured);
+        atto_eq(sdu.sid, SERVER);
+        atto_eq(sdu.gid, gid);
+        atto_memeq(sdu.data, sadData, sizeof(sadData));
+    }
+}
+
+/**
+ * Checks that the timer wheel of the Server holds every Group timer exactly once, each one
+ * in the slot it claims and after the one it claims. Stops at a loop in the links.
+ */
+static void
+hzlInteropTest_ServerCheckTimerWheel(const hzl_ServerCtx_t* const server)
+{
+    const size_t amountOfGroups = server->serverConfig->amountOfGroups;
+    size_t amount = 0U;
+    for (size_t slot = 0U;
+         slot < HZL_SERVER_TIMER_WHEEL_LEVELS * HZL_SERVER_TIMER_WHEEL_SLOTS; slot++)
+    {
+        uint8_t previous = 0U;
+        for (uint8_t index = server->timerWheel.slotHeads[slot];
+             index != 0U && amount <= amountOfGroups;
+             index = server->groupTimers[index - 1U].next)
+        {
+            atto_eq(server->groupTimers[index - 1U].slot, slot);
+            atto_eq(server->groupTimers[index - 1U].previous, previous);
+            previous = index;
+            amount++;
+        }
+    }
+    atto_eq(amount, amountOfGroups);
+}
+
+static void
+hzlInteropTest_ShardedSessionExpiration(hzlInteropTest_Bus_t* const bus)
+{
+    hzl_Err_t err;
+    hzlInteropTest_ShardsRecord_t record;
+    memset(&record, 0, sizeof(record));
+    const hzl_ServerShardsConfig_t config = {
+            .amountOfShards = HZL_INTEROP_AMOUNT_OF_SHARDS,
+            .ringCapacity = 4,
+            .onProcessed = hzlInteropTest_ShardsRecordProcessed,
+            .onBuilt = NULL,
+            .userData = &record,
+    };
+    hzl_ServerShards_t* shards = NULL;
+    hzl_CbsPduMsg_t sadfd;
+    hzl_CbsPduMsg_t nothing;
+    hzl_RxSduMsg_t sdu;
+    const uint8_t sadData[] = "ABCDE";
+    const hzl_Gid_t gids[] = {GID_SA, GID_SAB};
+    uint8_t nextStks[sizeof(gids) / sizeof(gids[0])][HZL_STK_LEN];
+    // Same Server as on the bus, with a clock the test can move forward
+    hzl_ServerCtx_t server = *bus->server;
+    hzlInteropTest_unshiftedTime = bus->server->io.currentTime;
+    hzlInteropTest_timeShiftMillis = 0U;
+    server.io.currentTime = hzlInteropTest_ShiftedTime;
+    hzlInteropTest_ServerCheckTimerWheel(&server);
+    for (size_t i = 0; i < sizeof(gids) / sizeof(gids[0]); i++)
+    {
+        hzlInteropTest_Handshake(&server, bus->alice, gids[i]);
+    }
+
+    // The Sessions of two Groups owned by different shards expire and are renewed
+    // concurrently by the shards upon reception of a secured message.
+    hzlInteropTest_timeShiftMillis =
+            server.groupConfigs[GID_SA].sessionDurationMillis + 10U;
+    atto_eq(server.groupConfigs[GID_SAB].sessionDurationMillis,
+            server.groupConfigs[GID_SA].sessionDurationMillis);
+    for (size_t i = 0; i < sizeof(gids) / sizeof(gids[0]); i++)
+    {
+        memcpy(nextStks[i], server.groupTimers[gids[i]].nextStk, HZL_STK_LEN);
+    }
+    err = hzl_ServerShardsNew(&shards, &server, &config);
+    atto_eq(err, HZL_OK);
+    for (size_t i = 0; i < sizeof(gids) / sizeof(gids[0]); i++)
+    {
+        err = hzl_ClientBuildSecuredFd(&sadfd, bus->alice, sadData, sizeof(sadData), gids[i]);
+        atto_eq(err, HZL_OK);
+        err = hzl_ServerShardsSubmitReceived(shards, sadfd.data, sadfd.dataLen, CAN_ID);
+        atto_eq(err, HZL_OK);
+    }
+    hzl_ServerShardsFree(&shards);
+    for (size_t i = 0; i < sizeof(gids) / sizeof(gids[0]); i++)
+    {
+        const hzl_Gid_t gid = gids[i];
+        atto_eq(record.processedResult[gid], HZL_OK);
+        atto_eq(record.processedShardIndex[gid], gid % HZL_INTEROP_AMOUNT_OF_SHARDS);
+        atto_true(record.receivedUserData[gid].isForUser);
+        atto_neq(record.reactionPdu[gid].dataLen, 0);  // REN message
+        err = hzl_ClientProcessReceived(&nothing, &sdu, bus->alice,
+                                        record.reactionPdu[gid].data,
+                                        record.reactionPdu[gid].dataLen, CAN_ID);
+        atto_eq(err, HZL_OK);
+        atto_neq(nothing.dataLen, 0);  // Request of the new Session
+        // The new Sessions use the pre-generated STKs, to be generated again
+        atto_memeq(server.groupStates[gid].currentStk, nextStks[i], HZL_STK_LEN);
+        atto_zeros(server.groupTimers[gid].nextStk, HZL_STK_LEN);
+    }
+    err = hzl_ServerPrepareNextSessions(&server);
+    atto_eq(err, HZL_OK);
+    for (size_t i = 0; i < sizeof(gids) / sizeof(gids[0]); i++)
+    {
+        const hzl_Gid_t gid = gids[i];
+        const uint8_t zeros[HZL_STK_LEN] = {0};
+        atto_memneq(server.groupTimers[gid].nextStk, zeros, HZL_STK_LEN);
+        atto_memneq(server.groupTimers[gid].nextStk, nextStks[i], HZL_STK_LEN);
+    }
+
+    // Back to a single thread, the timer wheel of the context holds every Group once,
+    // with the next REN notification of the renewed ones.
+    hzlInteropTest_ServerCheckTimerWheel(&server);
+    hzl_Timestamp_t nextRenNotification = 0U;
+    for (size_t i = 0; i < sizeof(gids) / sizeof(gids[0]); i++)
+    {
+        const hzl_Gid_t gid = gids[i];
+        nextRenNotification = server.groupStates[gid].sessionStartInstant
+                              + server.groupConfigs[gid].delayBetweenRenNotificationsMillis;
+        atto_eq(server.groupTimers[gid].deadline, nextRenNotification);
+    }
+    hzl_CbsPduMsg_t renewalPdus[GID_SC + 1U];
+    size_t amountOfPdus = GID_SC + 1U;
+    err = hzl_ServerTick(renewalPdus, &amountOfPdus, &server, nextRenNotification);
+    atto_eq(err, HZL_OK);
+    atto_eq(amountOfPdus, 2);
+    hzlInteropTest_ServerCheckTimerWheel(&server);
+}
+
+/** Longest SADTP message received by the sharded Server. */
+#define HZL_INTEROP_SHARDS_SADTP_LEN 200U
+/** SADTP reception buffers of the sharded Server, not a multiple of the amount of shards. */
+#define HZL_INTEROP_SHARDS_SADTP_BUFFERS 5U
+
+/** SADTP messages the sharded Server completed, copied while the handler is called. */
+typedef struct hzlInteropTest_ShardsSadtpRecord
+{
+    size_t amountOfMessages;
+    hzl_Err_t results[HZL_INTEROP_SHARDS_SADTP_BUFFERS];
+    hzl_Sid_t sids[HZL_INTEROP_SHARDS_SADTP_BUFFERS];
+    size_t dataLens[HZL_INTEROP_SHARDS_SADTP_BUFFERS];
+    uint8_t data[HZL_INTEROP_SHARDS_SADTP_BUFFERS][HZL_INTEROP_SHARDS_SADTP_LEN];
+    size_t amountOfErrors;
+} hzlInteropTest_ShardsSadtpRecord_t;
+
+static void
+hzlInteropTest_ShardsRecordSadtp(void* const userData,
+                                 const size_t shardIndex,
+                                 const hzl_Err_t result,
+                                 const hzl_Header_t* const receivedHeader,
+                                 const hzl_CbsPduMsg_t* const reactionPdu,
+                                 const hzl_RxSduMsg_t* const receivedUserData)
+{
+    (void) shardIndex;
+    (void) receivedHeader;
+    (void) reactionPdu;
+    hzlInteropTest_ShardsSadtpRecord_t* const record = userData;
+    if (result != HZL_OK) { record->amountOfErrors++; }
+    if (!receivedUserData->isForUser
+        || record->amountOfMessages == HZL_INTEROP_SHARDS_SADTP_BUFFERS
+        || receivedUserData->dataLen > HZL_INTEROP_SHARDS_SADTP_LEN)
+    {
+        return;
+    }
+    const size_t i = record->amountOfMessages++;
+    record->results[i] = result;
+    record->sids[i] = receivedUserData->sid;
+    record->dataLens[i] = receivedUserData->dataLen;
+    memcpy(record->data[i], receivedUserData->reassembledData, receivedUserData->dataLen);
+}
+
+static void
+hzlInteropTest_ShardedSecuredTpInterleaved(hzlInteropTest_Bus_t* const bus)
+{
+    hzl_Err_t err;
+    static hzlInteropTest_ShardsSadtpRecord_t record;
+    memset(&record, 0, sizeof(record));
+    const hzl_ServerShardsConfig_t config = {
+            .amountOfShards = HZL_INTEROP_AMOUNT_OF_SHARDS,
+            .ringCapacity = 16,
+            .onProcessed = hzlInteropTest_ShardsRecordSadtp,
+            .userData = &record,
+    };
+    hzl_ServerShards_t* shards = NULL;
+    static hzl_CbsPduMsg_t fromAlice[2U * HZL_SADTP_AMOUNT_OF_PDUS(HZL_INTEROP_SHARDS_SADTP_LEN)];
+    static hzl_CbsPduMsg_t fromBob[HZL_SADTP_AMOUNT_OF_PDUS(HZL_INTEROP_SHARDS_SADTP_LEN)];
+    static uint8_t firstData[60];
+    static uint8_t secondData[150];
+    static uint8_t bobData[HZL_INTEROP_SHARDS_SADTP_LEN];
+    static uint8_t serverRxData[HZL_INTEROP_SHARDS_SADTP_BUFFERS][HZL_INTEROP_SHARDS_SADTP_LEN];
+    static hzl_SadtpRxBuffer_t serverRx[HZL_INTEROP_SHARDS_SADTP_BUFFERS];
+    for (size_t i = 0; i < HZL_INTEROP_SHARDS_SADTP_BUFFERS; i++)
+    {
+        serverRx[i].data = serverRxData[i];
+        serverRx[i].capacity = HZL_INTEROP_SHARDS_SADTP_LEN;
+    }
+    bus->server->sadtpRxBuffers = serverRx;
+    bus->server->amountOfSadtpRxBuffers = HZL_INTEROP_SHARDS_SADTP_BUFFERS;
+    memset(firstData, 0x44, sizeof(firstData));
+    memset(secondData, 0x55, sizeof(secondData));
+    memset(bobData, 0x66, sizeof(bobData));
+    // Both Groups are owned by the first shard, which gets 3 of the 5 buffers
+    atto_eq(GID_SA % HZL_INTEROP_AMOUNT_OF_SHARDS, 0);
+    atto_eq(GID_SABC % HZL_INTEROP_AMOUNT_OF_SHARDS, 0);
+    hzlInteropTest_Handshake(bus->server, bus->alice, GID_SA);
+    hzlInteropTest_Handshake(bus->server, bus->bob, GID_SABC);
+    size_t amountOfFirstPdus = sizeof(fromAlice) / sizeof(fromAlice[0]);
+    err = hzl_ClientBuildSecuredTp(fromAlice, &amountOfFirstPdus, bus->alice,
+                                   firstData, sizeof(firstData), GID_SA);
+    atto_eq(err, HZL_OK);
+    size_t amountOfAlicePdus = sizeof(fromAlice) / sizeof(fromAlice[0]) - amountOfFirstPdus;
+    err = hzl_ClientBuildSecuredTp(&fromAlice[amountOfFirstPdus], &amountOfAlicePdus,
+                                   bus->alice, secondData, sizeof(secondData), GID_SA);
+    atto_eq(err, HZL_OK);
+    amountOfAlicePdus += amountOfFirstPdus;
+    size_t amountOfBobPdus = sizeof(fromBob) / sizeof(fromBob[0]);
+    err = hzl_ClientBuildSecuredTp(fromBob, &amountOfBobPdus, bus->bob,
+                                   bobData, sizeof(bobData), GID_SABC);
+    atto_eq(err, HZL_OK);
+    atto_gt(amountOfBobPdus, amountOfFirstPdus);
+    atto_le(amountOfAlicePdus + amountOfBobPdus, config.ringCapacity);
+
+    // Alice's two messages and Bob's one interleaved on the bus, all queued at once, so
+    // the shard processes them in as few batches as possible before calling the handler
+    err = hzl_ServerShardsNew(&shards, bus->server, &config);
+    atto_eq(err, HZL_OK);
+    for (size_t a = 0, b = 0; a < amountOfAlicePdus || b < amountOfBobPdus;)
+    {
+        if (a < amountOfAlicePdus)
+        {
+            err = hzl_ServerShardsSubmitReceived(shards, fromAlice[a].data,
+                                                 fromAlice[a].dataLen, CAN_ID);
+            atto_eq(err, HZL_OK);
+            a++;
+        }
+        if (b < amountOfBobPdus)
+        {
+            err = hzl_ServerShardsSubmitReceived(shards, fromBob[b].data,
+                                                 fromBob[b].dataLen, CAN_ID);
+            atto_eq(err, HZL_OK);
+            b++;
+        }
+    }
+    hzl_ServerShardsFree(&shards);
+    atto_eq(record.amountOfErrors, 0);
+    atto_eq(record.amountOfMessages, 3);
+    for (size_t i = 0; i < record.amountOfMessages; i++)
+    {
+        atto_eq(record.results[i], HZL_OK);
+        if (record.dataLens[i] == sizeof(firstData))
+        {
+            atto_eq(record.sids[i], ALICE);
+            atto_memeq(record.data[i], firstData, sizeof(firstData));
+        }
+        else if (record.dataLens[i] == sizeof(secondData))
+        {
+            atto_eq(record.sids[i], ALICE);
+            atto_memeq(record.data[i], secondData, sizeof(secondData));
+        }
+        else
+        {
+            atto_eq(record.sids[i], BOB);
+            atto_eq(record.dataLens[i], sizeof(bobData));
+            atto_memeq(record.data[i], bobData, sizeof(bobData));
+        }
+    }
+}
+
+#ifdef HZL_THREAD_SAFE
+
+/** Threads sharing the Server and Client contexts, each transmitting in its own Group. */
+#define HZL_INTEROP_AMOUNT_OF_THREADS 4U
+/** Exchanges of each thread. */
+#define HZL_INTEROP_THREAD_ITERATIONS 200U
+/** Length of the SADTP messages of each exchange. */
+#define HZL_INTEROP_THREAD_SADTP_LEN 150U
+
+/** Work and outcome of one of the threads sharing the contexts. */
+typedef struct hzlInteropTest_Thread
+{
+    hzl_ServerCtx_t* server;
+    hzl_ClientCtx_t* client;
+    hzl_Gid_t gid;
+    pthread_t thread;
+    /** Exchanges that went as expected, checked after the thread is joined. */
+    size_t amountOfPassed;
+} hzlInteropTest_Thread_t;
+
+/** True if the Server received exactly the data from the Client in the SDU. */
+static bool
+hzlInteropTest_ThreadCheckSdu(const hzlInteropTest_Thread_t* const work,
+                              const hzl_RxSduMsg_t* const sdu,
+                              const uint8_t* const expected,
+                              const size_t expectedLen)
+{
+    const uint8_t* const data = sdu->reassembledData != NULL ? sdu->reassembledData : sdu->data;
+    return sdu->isForUser && sdu->wasSecured
+           && sdu->gid == work->gid && sdu->sid == work->client->clientConfig->sid
+           && sdu->dataLen == expectedLen && memcmp(data, expected, expectedLen) == 0;
+}
+
+/** One SADFD and one SADTP message per iteration, from the Client to the Server. */
+static void*
+hzlInteropTest_ThreadExchange(void* const arg)
+{
+    hzlInteropTest_Thread_t* const work = arg;
+    hzl_CbsPduMsg_t sadtp[HZL_SADTP_AMOUNT_OF_PDUS(HZL_INTEROP_THREAD_SADTP_LEN)];
+    hzl_CbsPduMsg_t sadfd;
+    hzl_CbsPduMsg_t nothing;
+    hzl_RxSduMsg_t sdu;
+    uint8_t sadData[HZL_INTEROP_THREAD_SADTP_LEN];
+    for (size_t i = 0; i < HZL_INTEROP_THREAD_ITERATIONS; i++)
+    {
+        // Data unique to the thread and iteration, so any mix-up shows
+        memset(sadData, (int) (work->gid * 16U + i % 16U), sizeof(sadData));
+        if (hzl_ClientBuildSecuredFd(&sadfd, work->client, sadData, 10, work->gid) != HZL_OK
+            || hzl_ServerProcessReceived(&nothing, &sdu, work->server,
+                                         sadfd.data, sadfd.dataLen, CAN_ID) != HZL_OK
+            || !hzlInteropTest_ThreadCheckSdu(work, &sdu, sadData, 10))
+        {
+            return NULL;
+        }
+        size_t amountOfPdus = sizeof(sadtp) / sizeof(sadtp[0]);
+        if (hzl_ClientBuildSecuredTp(sadtp, &amountOfPdus, work->client,
+                                     sadData, sizeof(sadData), work->gid) != HZL_OK)
+        {
+            return NULL;
+        }
+        for (size_t f = 0; f < amountOfPdus; f++)
+        {
+            if (hzl_ServerProcessReceived(&nothing, &sdu, work->server,
+                                          sadtp[f].data, sadtp[f].dataLen, CAN_ID) != HZL_OK)
+            {
+                return NULL;
+            }
+        }
+        if (!hzlInteropTest_ThreadCheckSdu(work, &sdu, sadData, sizeof(sadData)))
+        {
+            return NULL;
+        }
+        work->amountOfPassed++;
+    }
+    return NULL;
+}
+
+static void
+hzlInteropTest_ConcurrentExchange(hzlInteropTest_Bus_t* const bus)
+{
+    int result;
+    // Each thread keeps at most one complete message and reassembles one more
+    static uint8_t serverRxData[2U * HZL_INTEROP_AMOUNT_OF_THREADS][HZL_INTEROP_THREAD_SADTP_LEN];
+    static hzl_SadtpRxBuffer_t serverRx[2U * HZL_INTEROP_AMOUNT_OF_THREADS];
+    for (size_t i = 0; i < 2U * HZL_INTEROP_AMOUNT_OF_THREADS; i++)
+    {
+        serverRx[i].data = serverRxData[i];
+        serverRx[i].capacity = HZL_INTEROP_THREAD_SADTP_LEN;
+    }
+    bus->server->sadtpRxBuffers = serverRx;
+    bus->server->amountOfSadtpRxBuffers = 2U * HZL_INTEROP_AMOUNT_OF_THREADS;
+    hzlInteropTest_Thread_t threads[HZL_INTEROP_AMOUNT_OF_THREADS] = {
+            {.server = bus->server, .client = bus->alice, .gid = GID_SA},
+            {.server = bus->server, .client = bus->alice, .gid = GID_SAB},
+            {.server = bus->server, .client = bus->bob, .gid = GID_SBC},
+            {.server = bus->server, .client = bus->bob, .gid = GID_SABC},
+    };
+    for (size_t t = 0; t < HZL_INTEROP_AMOUNT_OF_THREADS; t++)
+    {
+        hzlInteropTest_Handshake(bus->server, threads[t].client, threads[t].gid);
+    }
+
+    // All threads transmit and receive at the same time on the same contexts
+    for (size_t t = 0; t < HZL_INTEROP_AMOUNT_OF_THREADS; t++)
+    {
+        result = pthread_create(&threads[t].thread, NULL,
+                                hzlInteropTest_ThreadExchange, &threads[t]);
+        atto_eq(result, 0);
+    }
+    for (size_t t = 0; t < HZL_INTEROP_AMOUNT_OF_THREADS; t++)
+    {
+        result = pthread_join(threads[t].thread, NULL);
+        atto_eq(result, 0);
+    }
+    for (size_t t = 0; t < HZL_INTEROP_AMOUNT_OF_THREADS; t++)
+    {
+        atto_eq(threads[t].amountOfPassed, HZL_INTEROP_THREAD_ITERATIONS);
+    }
+}
+
+#endif  /* HZL_THREAD_SAFE */
+
+#endif  /* HZL_OS_AVAILABLE_NIX */
+
 /**
  * Main function.
  * @return 0 if all tests passed, non-zero otherwise.
  */
 int main(void)
 {
+    HZL_TEST_SKIP_UNLESS_CONFIG_HEADER_TYPE_BUILT();
     hzlInteropTest_Bus_t bus;
-    hzlInteropTest_BusInit(&bus);
+    HZL_INTEROP_BUS_INIT(&bus);
     hzlInteropTest_UadExchange(&bus);
     hzlInteropTest_InitialisationPhase(&bus);
+    hzlInteropTest_SecuredTpExchange(&bus);
     hzlInteropTest_RenewalPhase(&bus);
     hzlInteropTest_BusTeardown(&bus);
+    // Fresh Sessions, not in a renewal phase
+    HZL_INTEROP_BUS_INIT(&bus);
+    hzlInteropTest_SecuredFdBatchExchange(&bus);
+    hzlInteropTest_SecuredTpStalenessPerGroup(&bus);
+    hzlInteropTest_SecuredTpBatchInterleaved(&bus);
+    hzlInteropTest_BusTeardown(&bus);
+    // Same messages with the header in the payload, in the CAN ID or split between them
+    HZL_INTEROP_BUS_INIT(&bus);
+    hzlInteropTest_HeaderPlacementExchange(&bus, HZL_HEADER_IN_PAYLOAD, 0U);
+    hzlInteropTest_HeaderPlacementExchange(&bus, HZL_HEADER_IN_CAN_ID, 3U);
+    hzlInteropTest_HeaderPlacementExchange(&bus, HZL_HEADER_MIXED, 1U);
+    hzlInteropTest_BusTeardown(&bus);
+#if HZL_OS_AVAILABLE_NIX
+    // The Server running on multiple threads
+    HZL_INTEROP_BUS_INIT(&bus);
+    hzlInteropTest_ShardedServerExchange(&bus);
+    hzlInteropTest_BusTeardown(&bus);
+    HZL_INTEROP_BUS_INIT(&bus);
+    hzlInteropTest_ShardedSessionExpiration(&bus);
+    hzlInteropTest_BusTeardown(&bus);
+    HZL_INTEROP_BUS_INIT(&bus);
+    hzlInteropTest_ShardedSecuredTpInterleaved(&bus);
+    hzlInteropTest_BusTeardown(&bus);
+#ifdef HZL_THREAD_SAFE
+    // Multiple threads sharing the same contexts
+    HZL_INTEROP_BUS_INIT(&bus);
+    hzlInteropTest_ConcurrentExchange(&bus);
+    hzlInteropTest_BusTeardown(&bus);
+#endif  /* HZL_THREAD_SAFE */
+#endif  /* HZL_OS_AVAILABLE_NIX */
     HZL_TEST_PARTIAL_REPORT();
     return atto_at_least_one_fail;
 }
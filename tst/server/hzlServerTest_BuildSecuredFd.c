@@ -120,6 +120,7 @@ hzlServerTest_ServerBuildSecuredFdDataLenMustBeShortEnough(void)
 static void
 hzlServerTest_ServerBuildSecuredFdDataLenDependsOnHeaderLen(void)
 {
+    if (!HZL_TEST_IS_HEADER_TYPE_BUILT(HZL_HEADER_6)) { return; }
     hzl_Err_t err;
     hzl_ServerConfig_t serverConfigWithNewHeaderType =
             HZL_TEST_CORRECT_SERVER_CONFIG;
@@ -155,6 +156,7 @@ hzlServerTest_ServerBuildSecuredFdDataLenDependsOnHeaderLen(void)
 static void
 hzlServerTest_ServerBuildSecuredFdCompactHeaderPreventsTooManyGroups(void)
 {
+    if (!HZL_TEST_IS_HEADER_TYPE_BUILT(HZL_HEADER_4)) { return; }
     hzl_Err_t err;
     hzl_ServerConfig_t serverConfigWithNewHeaderType =
             HZL_TEST_CORRECT_SERVER_CONFIG;
@@ -283,6 +285,7 @@ hzlServerTest_ServerBuildSecuredFdHeaderIsPackedBeforePayload(void)
 static void
 hzlServerTest_ServerBuildSecuredFdHeaderPackingDependsOnType(void)
 {
+    if (!HZL_TEST_IS_HEADER_TYPE_BUILT(HZL_HEADER_4)) { return; }
     hzl_Err_t err;
     hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
     hzl_ServerConfig_t serverConfigWithNewHeaderType =
@@ -450,6 +453,7 @@ hzlServerTest_ServerBuildSecuredFdSuccessfullyUsesNewKeyDuringRenewalPhase(void)
     groupStates[0].previousCtrNonce = 0x111111;
     groupStates[0].previousStk[0] = 150;
     memset(&groupStates[0].previousStk[1], 0, 15);
+    groupStates[0].isRenewalPhaseActive = true;
     hzl_CbsPduMsg_t msgToTx = {0};
     const uint8_t userData[64] = {'A', 'B', 'C', 'D', 'E'};
     size_t userDataLen = 5;
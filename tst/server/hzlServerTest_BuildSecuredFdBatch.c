@@ -0,0 +1,181 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Tests of the hzl_ServerBuildSecuredFdBatch() function.
+ *
+ * @warning
+ * REDUCING COVERAGE ON PURPOSE. NOT implementing all the testcases for every incorrect
+ * message, because each message of the batch goes through the same checks and packing
+ * used by hzl_ServerBuildSecuredFd(), which are already tested. The batch is instead
+ * compared against the messages built one by one.
+ */
+
+#include "hzlTest.h"
+
+#define HZL_TEST_BATCH_LEN 6U
+
+static void
+hzlServerTest_ServerBuildSecuredFdBatchMustHaveNonNullArgs(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    hzl_CbsPduMsg_t securedPdus[1];
+    hzl_Err_t results[1];
+    const hzl_TxSduMsg_t userData[1] = {{.data = (const uint8_t*) "ABCDE", .dataLen = 5}};
+
+    err = hzl_ServerBuildSecuredFdBatch(NULL, results, &ctx, userData, 1);
+    atto_eq(err, HZL_ERR_NULL_PDU);
+    err = hzl_ServerBuildSecuredFdBatch(securedPdus, NULL, &ctx, userData, 1);
+    atto_eq(err, HZL_ERR_NULL_RESULTS);
+    err = hzl_ServerBuildSecuredFdBatch(securedPdus, results, NULL, userData, 1);
+    atto_eq(err, HZL_ERR_NULL_CTX);
+    err = hzl_ServerBuildSecuredFdBatch(securedPdus, results, &ctx, NULL, 1);
+    atto_eq(err, HZL_ERR_NULL_SDU);
+    err = hzl_ServerBuildSecuredFdBatch(securedPdus, results, &ctx, NULL, 0);
+    atto_eq(err, HZL_OK);
+}
+
+static void
+hzlServerTest_ServerBuildSecuredFdBatchSameAsOneByOne(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t batchGroupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t batchCtx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = batchGroupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ServerInit(&batchCtx);
+    atto_eq(err, HZL_OK);
+    // Fake a Request being already received in GID 0 and 1, not in GID 2
+    batchGroupStates[0].currentRxLastMessageInstant = batchGroupStates[0].sessionStartInstant + 1U;
+    batchGroupStates[1].currentRxLastMessageInstant = batchGroupStates[1].sessionStartInstant + 1U;
+    batchGroupStates[0].currentCtrNonce = 0x010203;
+    hzl_ServerGroupState_t singleGroupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    memcpy(singleGroupStates, batchGroupStates, sizeof(singleGroupStates));
+    hzl_ServerCtx_t singleCtx = batchCtx;
+    singleCtx.groupStates = singleGroupStates;
+    const uint8_t tooLongData[64] = {0};
+    const hzl_TxSduMsg_t userData[HZL_TEST_BATCH_LEN] = {
+            {.data = (const uint8_t*) "ABCDE", .dataLen = 5, .gid = 0},
+            {.data = (const uint8_t*) "FGH", .dataLen = 3, .gid = 1},
+            {.data = (const uint8_t*) "IJ", .dataLen = 2, .gid = 2},
+            {.data = NULL, .dataLen = 0, .gid = 1},
+            {.data = tooLongData, .dataLen = 64, .gid = 1},
+            {.data = (const uint8_t*) "KL", .dataLen = 2, .gid = 9},
+    };
+    hzl_CbsPduMsg_t batchPdus[HZL_TEST_BATCH_LEN];
+    hzl_Err_t results[HZL_TEST_BATCH_LEN];
+
+    err = hzl_ServerBuildSecuredFdBatch(batchPdus, results, &batchCtx, userData,
+                                        HZL_TEST_BATCH_LEN);
+
+    atto_eq(err, HZL_OK);
+    for (size_t i = 0; i < HZL_TEST_BATCH_LEN; i++)
+    {
+        hzl_CbsPduMsg_t singlePdu;
+        const hzl_Err_t singleErr = hzl_ServerBuildSecuredFd(
+                &singlePdu, &singleCtx, userData[i].data, userData[i].dataLen, userData[i].gid);
+        atto_eq(results[i], singleErr);
+        atto_eq(batchPdus[i].dataLen, singlePdu.dataLen);
+        atto_memeq(batchPdus[i].data, singlePdu.data, singlePdu.dataLen);
+    }
+    atto_eq(results[0], HZL_OK);
+    atto_eq(results[1], HZL_OK);
+    atto_eq(results[2], HZL_ERR_NO_POTENTIAL_RECEIVER);
+    atto_eq(results[3], HZL_OK);
+    atto_eq(results[4], HZL_ERR_TOO_LONG_SDU);
+    atto_eq(results[5], HZL_ERR_UNKNOWN_GROUP);
+    atto_eq(batchPdus[2].dataLen, 0);
+    atto_eq(batchPdus[4].dataLen, 0);
+    atto_eq(batchPdus[5].dataLen, 0);
+    // Only the successfully built messages consumed a Counter Nonce
+    atto_eq(batchGroupStates[0].currentCtrNonce, 0x010203 + 1);
+    atto_eq(batchGroupStates[1].currentCtrNonce, 2);
+    atto_eq(batchGroupStates[2].currentCtrNonce, 0);
+    atto_memeq(batchGroupStates, singleGroupStates, sizeof(batchGroupStates));
+}
+
+static void
+hzlServerTest_ServerBuildSecuredFdBatchSaturatesAtMaxCtrnonce(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    // Fake a Request being already received
+    groupStates[0].currentRxLastMessageInstant = groupStates[0].sessionStartInstant + 1U;
+    groupStates[0].currentCtrNonce = 0xFFFFFF - 1;
+    const hzl_TxSduMsg_t userData[3] = {
+            {.data = (const uint8_t*) "A", .dataLen = 1, .gid = 0},
+            {.data = (const uint8_t*) "B", .dataLen = 1, .gid = 0},
+            {.data = (const uint8_t*) "C", .dataLen = 1, .gid = 0},
+    };
+    hzl_CbsPduMsg_t securedPdus[3];
+    hzl_Err_t results[3];
+
+    err = hzl_ServerBuildSecuredFdBatch(securedPdus, results, &ctx, userData, 3);
+
+    atto_eq(err, HZL_OK);
+    atto_eq(results[0], HZL_OK);
+    atto_eq(securedPdus[0].data[3], 0xFE);  // Ctrnonce low
+    atto_eq(results[1], HZL_OK);
+    atto_eq(securedPdus[1].data[3], 0xFF);  // Ctrnonce low
+    atto_eq(results[2], HZL_OK);
+    atto_eq(securedPdus[2].data[3], 0xFF);  // Ctrnonce low, saturated
+    atto_eq(groupStates[0].currentCtrNonce, 0xFFFFFF);
+}
+
+void hzlServerTest_ServerBuildSecuredFdBatch(void)
+{
+    hzlServerTest_ServerBuildSecuredFdBatchMustHaveNonNullArgs();
+    hzlServerTest_ServerBuildSecuredFdBatchSameAsOneByOne();
+    hzlServerTest_ServerBuildSecuredFdBatchSaturatesAtMaxCtrnonce();
+    HZL_TEST_PARTIAL_REPORT();
+}
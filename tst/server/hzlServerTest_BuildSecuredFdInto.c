@@ -0,0 +1,176 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Tests of the hzl_ServerBuildSecuredFdInto() function.
+ *
+ * @warning
+ * REDUCING COVERAGE ON PURPOSE. NOT implementing all the testcases for every incorrect
+ * message, because the message goes through the same checks and packing used by
+ * hzl_ServerBuildSecuredFd(), which are already tested. The message is instead compared
+ * against the one built by hzl_ServerBuildSecuredFd().
+ */
+
+#include "hzlTest.h"
+
+static void
+hzlServerTest_ServerBuildSecuredFdIntoMustHaveNonNullArgs(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    uint8_t frame[64];
+    size_t frameLen = 99;
+    hzl_CanId_t frameCanId = 99;
+
+    err = hzl_ServerBuildSecuredFdInto(NULL, sizeof(frame), &frameLen, &frameCanId,
+                                       &ctx, (const uint8_t*) "ABCDE", 5, 0);
+    atto_eq(err, HZL_ERR_NULL_PDU);
+    err = hzl_ServerBuildSecuredFdInto(frame, sizeof(frame), NULL, &frameCanId,
+                                       &ctx, (const uint8_t*) "ABCDE", 5, 0);
+    atto_eq(err, HZL_ERR_NULL_PDU);
+    err = hzl_ServerBuildSecuredFdInto(frame, sizeof(frame), &frameLen, NULL,
+                                       &ctx, (const uint8_t*) "ABCDE", 5, 0);
+    atto_eq(err, HZL_ERR_NULL_PDU);
+    err = hzl_ServerBuildSecuredFdInto(frame, sizeof(frame), &frameLen, &frameCanId,
+                                       NULL, (const uint8_t*) "ABCDE", 5, 0);
+    atto_eq(err, HZL_ERR_NULL_CTX);
+    atto_eq(frameLen, 0);
+    frameLen = 99;
+    err = hzl_ServerBuildSecuredFdInto(frame, sizeof(frame), &frameLen, &frameCanId,
+                                       &ctx, NULL, 5, 0);
+    atto_eq(err, HZL_ERR_NULL_SDU);
+    atto_eq(frameLen, 0);
+}
+
+static void
+hzlServerTest_ServerBuildSecuredFdIntoSameAsBuildSecuredFd(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    // Fake a Request being already received in GID 0
+    groupStates[0].currentRxLastMessageInstant = groupStates[0].sessionStartInstant + 1U;
+    groupStates[0].currentCtrNonce = 0x010203;
+    hzl_ServerGroupState_t otherGroupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    memcpy(otherGroupStates, groupStates, sizeof(otherGroupStates));
+    hzl_ServerCtx_t otherCtx = ctx;
+    otherCtx.groupStates = otherGroupStates;
+    hzl_CbsPduMsg_t expectedPdu;
+    err = hzl_ServerBuildSecuredFd(&expectedPdu, &otherCtx, (const uint8_t*) "ABCDE", 5, 0);
+    atto_eq(err, HZL_OK);
+    // Larger than a CAN FD frame, as the frame struct of a driver may be
+    uint8_t frame[72];
+    memset(frame, 0xAA, sizeof(frame));
+    size_t frameLen = 0;
+    hzl_CanId_t frameCanId = 99;
+
+    err = hzl_ServerBuildSecuredFdInto(frame, sizeof(frame), &frameLen, &frameCanId,
+                                       &ctx, (const uint8_t*) "ABCDE", 5, 0);
+
+    atto_eq(err, HZL_OK);
+    atto_eq(frameLen, expectedPdu.dataLen);
+    atto_eq(frameCanId, expectedPdu.canId);
+    atto_memeq(frame, expectedPdu.data, expectedPdu.dataLen);
+    // Nothing written past the message
+    for (size_t i = frameLen; i < sizeof(frame); i++) { atto_eq(frame[i], 0xAA); }
+    atto_memeq(groupStates, otherGroupStates, sizeof(groupStates));
+}
+
+static void
+hzlServerTest_ServerBuildSecuredFdIntoMustFitInBuffer(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    // Fake a Request being already received in GID 0
+    groupStates[0].currentRxLastMessageInstant = groupStates[0].sessionStartInstant + 1U;
+    groupStates[0].currentCtrNonce = 0x010203;
+    const hzl_CtrNonce_t ctrnonceBefore = groupStates[0].currentCtrNonce;
+    uint8_t frame[64];
+    memset(frame, 0xAA, sizeof(frame));
+    size_t frameLen = 99;
+    hzl_CanId_t frameCanId = 99;
+    hzl_ServerGroupState_t otherGroupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    memcpy(otherGroupStates, groupStates, sizeof(otherGroupStates));
+    hzl_ServerCtx_t otherCtx = ctx;
+    otherCtx.groupStates = otherGroupStates;
+    hzl_CbsPduMsg_t expectedPdu;
+    err = hzl_ServerBuildSecuredFd(&expectedPdu, &otherCtx, (const uint8_t*) "ABCDE", 5, 0);
+    atto_eq(err, HZL_OK);
+    const size_t exactLen = expectedPdu.dataLen;
+
+    err = hzl_ServerBuildSecuredFdInto(frame, exactLen - 1, &frameLen, &frameCanId,
+                                       &ctx, (const uint8_t*) "ABCDE", 5, 0);
+
+    atto_eq(err, HZL_ERR_TOO_SMALL_PDU_BUFFER);
+    atto_eq(frameLen, 0);
+    for (size_t i = 0; i < sizeof(frame); i++) { atto_eq(frame[i], 0xAA); }
+    atto_eq(groupStates[0].currentCtrNonce, ctrnonceBefore);  // Not consumed
+
+    err = hzl_ServerBuildSecuredFdInto(frame, exactLen, &frameLen, &frameCanId,
+                                       &ctx, (const uint8_t*) "ABCDE", 5, 0);
+
+    atto_eq(err, HZL_OK);
+    atto_eq(frameLen, exactLen);
+    atto_eq(groupStates[0].currentCtrNonce, ctrnonceBefore + 1);
+}
+
+void hzlServerTest_ServerBuildSecuredFdInto(void)
+{
+    hzlServerTest_ServerBuildSecuredFdIntoMustHaveNonNullArgs();
+    hzlServerTest_ServerBuildSecuredFdIntoSameAsBuildSecuredFd();
+    hzlServerTest_ServerBuildSecuredFdIntoMustFitInBuffer();
+    HZL_TEST_PARTIAL_REPORT();
+}
@@ -0,0 +1,175 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Tests of the hzl_ServerBuildSecuredTp() function.
+ *
+ * @warning
+ * REDUCING COVERAGE ON PURPOSE. NOT implementing all the testcases for all possible incorrect
+ * content of the context, because they have already been checked for the hzl_ServerInit()
+ * function and the inner checks are exactly the same, performed by the same internal
+ * function hzl_ServerCheckCtxPointers().
+ */
+
+#include "hzlTest.h"
+
+static void
+hzlServerTest_ServerBuildSecuredTpMsgToTxMustBeNotNull(void)
+{
+    hzl_Err_t err;
+    hzl_CbsPduMsg_t securedPdus[2];
+    size_t amountOfPdus = 2;
+
+    err = hzl_ServerBuildSecuredTp(NULL, &amountOfPdus, NULL, (void*) 1, 0, 0);
+    atto_eq(err, HZL_ERR_NULL_PDU);
+
+    err = hzl_ServerBuildSecuredTp(securedPdus, NULL, NULL, (void*) 1, 0, 0);
+    atto_eq(err, HZL_ERR_NULL_PDU);
+}
+
+static void
+hzlServerTest_ServerBuildSecuredTpCtxMustBeNotNull(void)
+{
+    hzl_Err_t err;
+    hzl_CbsPduMsg_t securedPdus[2];
+    size_t amountOfPdus = 2;
+
+    err = hzl_ServerBuildSecuredTp(securedPdus, &amountOfPdus, NULL, NULL, 0, 0);
+
+    atto_eq(err, HZL_ERR_NULL_CTX);
+    atto_eq(amountOfPdus, 0);
+}
+
+// NOTE: tests for all possible issues WITHIN the context are skipped. See warning in file header.
+
+static void
+hzlServerTest_ServerBuildSecuredTpRequiresPotentialReceiver(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    hzl_CbsPduMsg_t securedPdus[2];
+    size_t amountOfPdus = 2;
+
+    err = hzl_ServerBuildSecuredTp(securedPdus, &amountOfPdus, &ctx, NULL, 0, 0);
+
+    atto_eq(err, HZL_ERR_NO_POTENTIAL_RECEIVER);
+    atto_eq(amountOfPdus, 0);
+}
+
+static void
+hzlServerTest_ServerBuildSecuredTpUnknownGroup(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    hzl_CbsPduMsg_t securedPdus[2];
+    size_t amountOfPdus = 2;
+
+    err = hzl_ServerBuildSecuredTp(securedPdus, &amountOfPdus, &ctx, NULL, 0,
+                                   HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS);
+
+    atto_eq(err, HZL_ERR_UNKNOWN_GROUP);
+    atto_eq(amountOfPdus, 0);
+}
+
+static void
+hzlServerTest_ServerBuildSecuredTpSuccessfully(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    // Fake a Request being already received
+    groupStates[0].currentRxLastMessageInstant = groupStates[0].sessionStartInstant + 1U;
+    groupStates[0].currentCtrNonce = 0x010203;
+    hzl_CbsPduMsg_t securedPdus[HZL_SADTP_AMOUNT_OF_PDUS(60)];
+    size_t amountOfPdus = HZL_SADTP_AMOUNT_OF_PDUS(60);
+    const uint8_t userData[60] = {1, 2, 3, 4};
+    // Requirement for this test: the header 0 is 3 bytes long.
+    atto_eq(ctx.serverConfig->headerType, HZL_HEADER_0);
+
+    err = hzl_ServerBuildSecuredTp(securedPdus, &amountOfPdus, &ctx,
+                                   userData, sizeof(userData), 0);
+
+    atto_eq(err, HZL_OK);
+    // 60 bytes of plaintext + 16 of tag = 55 + 21 bytes of stream
+    atto_eq(amountOfPdus, 2);
+    atto_eq(securedPdus[0].dataLen, 64);
+    atto_eq(securedPdus[1].dataLen, 3 + 3 + 1 + 21);
+    for (uint8_t i = 0; i < amountOfPdus; i++)
+    {
+        // Packed Header 0
+        atto_eq(securedPdus[i].data[0], 0);  // GID from API call
+        atto_eq(securedPdus[i].data[1], 0);  // Server SID
+        atto_eq(securedPdus[i].data[2], 3);  // PTY SADTP
+        // Same ctrnonce for all fragments
+        atto_eq(securedPdus[i].data[3], 0x03);  // Ctrnonce low
+        atto_eq(securedPdus[i].data[4], 0x02);  // Ctrnonce mid
+        atto_eq(securedPdus[i].data[5], 0x01);  // Ctrnonce high
+        atto_eq(securedPdus[i].data[6], i);  // Fragment index
+    }
+    atto_eq(securedPdus[0].data[7], 60);  // Ptlen low
+    atto_eq(securedPdus[0].data[8], 0);  // Ptlen high
+    // Ctrnonce was incremented in the state once for the whole message
+    atto_eq(groupStates[0].currentCtrNonce, 0x010204);
+}
+
+void hzlServerTest_ServerBuildSecuredTp(void)
+{
+    hzlServerTest_ServerBuildSecuredTpMsgToTxMustBeNotNull();
+    hzlServerTest_ServerBuildSecuredTpCtxMustBeNotNull();
+    hzlServerTest_ServerBuildSecuredTpRequiresPotentialReceiver();
+    hzlServerTest_ServerBuildSecuredTpUnknownGroup();
+    hzlServerTest_ServerBuildSecuredTpSuccessfully();
+}
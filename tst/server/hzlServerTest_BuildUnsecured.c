@@ -94,6 +94,26 @@ hzlServerTest_ServerBuildUnsecuredUserDataMustBeNotNullWhenPositiveDataLen(void)
     atto_eq(err, HZL_OK);
 }
 
+static void
+hzlServerTest_ServerBuildUnsecuredCtxMustBeInitialised(void)
+{
+    hzl_Err_t err;
+    hzl_CbsPduMsg_t msgToTx = {0};
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+
+    // The header codec is prepared only by hzl_ServerInit()
+    err = hzl_ServerBuildUnsecured(&msgToTx, &ctx, NULL, 0, 0);
+
+    atto_eq(err, HZL_ERR_CTX_NOT_INITIALISED);
+}
+
 static void
 hzlServerTest_ServerBuildUnsecuredDataLenMustBeShortEnough(void)
 {
@@ -126,6 +146,7 @@ hzlServerTest_ServerBuildUnsecuredDataLenMustBeShortEnough(void)
 static void
 hzlServerTest_ServerBuildUnsecuredDataLenDependsOnHeaderLen(void)
 {
+    if (!HZL_TEST_IS_HEADER_TYPE_BUILT(HZL_HEADER_6)) { return; }
     hzl_Err_t err;
     hzl_ServerConfig_t serverConfigWithNewHeaderType =
             HZL_TEST_CORRECT_SERVER_CONFIG;
@@ -159,6 +180,7 @@ hzlServerTest_ServerBuildUnsecuredDataLenDependsOnHeaderLen(void)
 static void
 hzlServerTest_ServerBuildUnsecuredCompactHeaderPreventsTooManyGroups(void)
 {
+    if (!HZL_TEST_IS_HEADER_TYPE_BUILT(HZL_HEADER_4)) { return; }
     hzl_Err_t err;
     hzl_ServerConfig_t serverConfigWithNewHeaderType =
             HZL_TEST_CORRECT_SERVER_CONFIG;
@@ -258,6 +280,7 @@ hzlServerTest_ServerBuildUnsecuredHeaderIsPackedBeforePayload(void)
 static void
 hzlServerTest_ServerBuildUnsecuredHeaderPackingDependsOnType(void)
 {
+    if (!HZL_TEST_IS_HEADER_TYPE_BUILT(HZL_HEADER_4)) { return; }
     hzl_Err_t err;
     hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
     hzl_ServerConfig_t serverConfigWithNewHeaderType =
@@ -299,6 +322,7 @@ void hzlServerTest_ServerBuildUnsecured(void)
     hzlServerTest_ServerBuildUnsecuredMsgToTxMustBeNotNull();
     hzlServerTest_ServerBuildUnsecuredCtxMustBeNotNull();
     hzlServerTest_ServerBuildUnsecuredUserDataMustBeNotNullWhenPositiveDataLen();
+    hzlServerTest_ServerBuildUnsecuredCtxMustBeInitialised();
     hzlServerTest_ServerBuildUnsecuredDataLenMustBeShortEnough();
     hzlServerTest_ServerBuildUnsecuredDataLenDependsOnHeaderLen();
     hzlServerTest_ServerBuildUnsecuredCompactHeaderPreventsTooManyGroups();
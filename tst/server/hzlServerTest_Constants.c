@@ -71,7 +71,7 @@ const hzl_ServerGroupConfig_t
                 .ctrNonceUpperLimit = 0xFF0000,
                 .sessionDurationMillis = 50000, // Shorter on purpose to simplify expiration tests
                 .delayBetweenRenNotificationsMillis = 4000,
-                .clientSidsInGroupBitmap = 0xFFFFFFFFU,  // Broadcast
+                .clientSidsInGroupBitmap = {.words = {0xFFFFFFFFU}},  // Broadcast
                 .maxSilenceIntervalMillis = 5000,
         },
         [1]={
@@ -80,7 +80,7 @@ const hzl_ServerGroupConfig_t
                 .ctrNonceUpperLimit = 0xFF0000,
                 .sessionDurationMillis = 1200000,
                 .delayBetweenRenNotificationsMillis = 4000,
-                .clientSidsInGroupBitmap = 1,
+                .clientSidsInGroupBitmap = {.words = {1}},
                 .maxSilenceIntervalMillis = 5000,
         },
         [2]={
@@ -89,7 +89,7 @@ const hzl_ServerGroupConfig_t
                 .ctrNonceUpperLimit = 0xFF0000,
                 .sessionDurationMillis = 1200000,
                 .delayBetweenRenNotificationsMillis = 4000,
-                .clientSidsInGroupBitmap = 2, // SID == 1 does NOT belong
+                .clientSidsInGroupBitmap = {.words = {2}}, // SID == 1 does NOT belong
                 .maxSilenceIntervalMillis = 5000,
         },
         // Larger than HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS on purpose,
@@ -100,7 +100,7 @@ const hzl_ServerGroupConfig_t
                 .ctrNonceUpperLimit = 0xFF0000,
                 .sessionDurationMillis = 1200000,
                 .delayBetweenRenNotificationsMillis = 4000,
-                .clientSidsInGroupBitmap = 3,
+                .clientSidsInGroupBitmap = {.words = {3}},
                 .maxSilenceIntervalMillis = 5000,
         },
         [4]={
@@ -109,7 +109,7 @@ const hzl_ServerGroupConfig_t
                 .ctrNonceUpperLimit = 0xFF0000,
                 .sessionDurationMillis = 1200000,
                 .delayBetweenRenNotificationsMillis = 4000,
-                .clientSidsInGroupBitmap = 4,
+                .clientSidsInGroupBitmap = {.words = {4}},
                 .maxSilenceIntervalMillis = 5000,
         },
         [5]={
@@ -118,7 +118,7 @@ const hzl_ServerGroupConfig_t
                 .ctrNonceUpperLimit = 0xFF0000,
                 .sessionDurationMillis = 1200000,
                 .delayBetweenRenNotificationsMillis = 4000,
-                .clientSidsInGroupBitmap = 5,
+                .clientSidsInGroupBitmap = {.words = {5}},
                 .maxSilenceIntervalMillis = 5000,
         },
         [6]={
@@ -127,7 +127,7 @@ const hzl_ServerGroupConfig_t
                 .ctrNonceUpperLimit = 0xFF0000,
                 .sessionDurationMillis = 1200000,
                 .delayBetweenRenNotificationsMillis = 4000,
-                .clientSidsInGroupBitmap = 6,
+                .clientSidsInGroupBitmap = {.words = {6}},
                 .maxSilenceIntervalMillis = 5000,
         },
         [7]={
@@ -136,7 +136,7 @@ const hzl_ServerGroupConfig_t
                 .ctrNonceUpperLimit = 0xFF0000,
                 .sessionDurationMillis = 1200000,
                 .delayBetweenRenNotificationsMillis = 4000,
-                .clientSidsInGroupBitmap = 7,
+                .clientSidsInGroupBitmap = {.words = {7}},
                 .maxSilenceIntervalMillis = 5000,
         },
         [8]={
@@ -145,7 +145,7 @@ const hzl_ServerGroupConfig_t
                 .ctrNonceUpperLimit = 0xFF0000,
                 .sessionDurationMillis = 1200000,
                 .delayBetweenRenNotificationsMillis = 4000,
-                .clientSidsInGroupBitmap = 8,
+                .clientSidsInGroupBitmap = {.words = {8}},
                 .maxSilenceIntervalMillis = 5000,
         },
         [9]={
@@ -154,7 +154,7 @@ const hzl_ServerGroupConfig_t
                 .ctrNonceUpperLimit = 0xFF0000,
                 .sessionDurationMillis = 1200000,
                 .delayBetweenRenNotificationsMillis = 4000,
-                .clientSidsInGroupBitmap = 9,
+                .clientSidsInGroupBitmap = {.words = {9}},
                 .maxSilenceIntervalMillis = 5000,
         },
 };
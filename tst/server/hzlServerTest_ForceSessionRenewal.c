@@ -88,8 +88,9 @@ hzlServerTest_ServerForceSessionRenewalGidMustBeValid(void)
     hzl_CbsPduMsg_t msgToTx = {0};
     // Assume at least one Client Requested the state already:
     // the last RX message was after the start of the session.
-    hzlTest_IoMockupCurrentTimeSucceeding(
-            &groupStates[ctx.serverConfig->amountOfGroups - 1U].currentRxLastMessageInstant);
+    hzl_Timestamp_t now;
+    hzlTest_IoMockupCurrentTimeSucceeding(&now);
+    groupStates[ctx.serverConfig->amountOfGroups - 1U].currentRxLastMessageInstant = now;
 
     err = hzl_ServerForceSessionRenewal(&msgToTx, &ctx, ctx.serverConfig->amountOfGroups);
     atto_eq(err, HZL_ERR_UNKNOWN_GROUP);
@@ -141,7 +142,9 @@ hzlServerTest_ServerForceSessionRenewalRenewsAndBuildsRenMsg(void)
     memset(&groupStates[1].currentStk[1], 0, 15);  // The rest is zeros
     // Assume at least one Client Requested the state already:
     // the last RX message was after the start of the session.
-    hzlTest_IoMockupCurrentTimeSucceeding(&groupStates[1].currentRxLastMessageInstant);
+    hzl_Timestamp_t now;
+    hzlTest_IoMockupCurrentTimeSucceeding(&now);
+    groupStates[1].currentRxLastMessageInstant = now;
 
     err = hzl_ServerForceSessionRenewal(&msgToTx, &ctx, 1);
 
@@ -194,7 +197,9 @@ hzlServerTest_ServerForceSessionRenewalOnlyBuildRenMsgDuringExistingRenewal(void
     memset(&groupStates[1].currentStk[1], 0, 15);  // The rest is zeros
     // Assume at least one Client Requested the state already:
     // the last RX message was after the start of the session.
-    hzlTest_IoMockupCurrentTimeSucceeding(&groupStates[1].currentRxLastMessageInstant);
+    hzl_Timestamp_t now;
+    hzlTest_IoMockupCurrentTimeSucceeding(&now);
+    groupStates[1].currentRxLastMessageInstant = now;
 
     err = hzl_ServerForceSessionRenewal(&msgToTx, &ctx, 1);
     atto_eq(err, HZL_OK);
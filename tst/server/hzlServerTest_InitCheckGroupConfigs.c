@@ -235,11 +235,11 @@ hzlServerTest_ServerInitGroupConfigsBitmapMustHaveAtLeastOneClient(void)
             .io = HZL_TEST_CORRECT_IO,
     };
 
-    modifiedGroupConfigs[1].clientSidsInGroupBitmap = 0;
+    modifiedGroupConfigs[1].clientSidsInGroupBitmap = (hzl_ServerBitMap_t) {0};
     err = hzl_ServerInit(&ctx);
     atto_eq(err, HZL_ERR_CLIENTS_BITMAP_ZERO_CLIENTS);
 
-    modifiedGroupConfigs[1].clientSidsInGroupBitmap = 1;
+    modifiedGroupConfigs[1].clientSidsInGroupBitmap = (hzl_ServerBitMap_t) {.words = {1}};
     err = hzl_ServerInit(&ctx);
     atto_eq(err, HZL_OK);
 }
@@ -262,13 +262,23 @@ hzlServerTest_ServerInitGroupConfigsBitmapMustHaveKnownClients(void)
     };
 
     // Bits outside of the range of known clients
-    modifiedGroupConfigs[1].clientSidsInGroupBitmap = 0xFFFFFFFF;
+    modifiedGroupConfigs[1].clientSidsInGroupBitmap = (hzl_ServerBitMap_t) {
+            .words = {0xFFFFFFFF}
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_ERR_CLIENTS_BITMAP_UNKNOWN_SID);
+
+    // Bits outside of the range of known clients, in a higher bitmap word
+    modifiedGroupConfigs[1].clientSidsInGroupBitmap = (hzl_ServerBitMap_t) {
+            .words = {1, 0, 1}
+    };
     err = hzl_ServerInit(&ctx);
     atto_eq(err, HZL_ERR_CLIENTS_BITMAP_UNKNOWN_SID);
 
     // ALL known clients, but no extra ones.
-    modifiedGroupConfigs[1].clientSidsInGroupBitmap =
-            (1U << ctx.serverConfig->amountOfClients) - 1U;
+    modifiedGroupConfigs[1].clientSidsInGroupBitmap = (hzl_ServerBitMap_t) {
+            .words = {(1U << ctx.serverConfig->amountOfClients) - 1U}
+    };
     err = hzl_ServerInit(&ctx);
     atto_eq(err, HZL_OK);
 }
@@ -289,27 +299,42 @@ hzlServerTest_ServerInitGroupConfigsBitmapMustHaveCompleteBroadcastGroup(void)
             .groupStates = groupStates,
             .io = HZL_TEST_CORRECT_IO,
     };
-    hzl_ServerBitMap_t broadcastBitmap = 0;
+    uint64_t broadcastBitmap = 0;
     for (size_t i = 0U; i < ctx.serverConfig->amountOfClients; i++)
     {
         broadcastBitmap |= 1U << i;
     }
 
     // Subset of bits is rejected.
-    modifiedGroupConfigs[0].clientSidsInGroupBitmap = broadcastBitmap >> 1U;
+    modifiedGroupConfigs[0].clientSidsInGroupBitmap = (hzl_ServerBitMap_t) {
+            .words = {broadcastBitmap >> 1U}
+    };
     err = hzl_ServerInit(&ctx);
     atto_eq(err, HZL_ERR_CLIENTS_BITMAP_INVALID_BROADCAST_GROUP);
 
-    modifiedGroupConfigs[0].clientSidsInGroupBitmap = ~(broadcastBitmap & 2);
+    modifiedGroupConfigs[0].clientSidsInGroupBitmap = (hzl_ServerBitMap_t) {
+            .words = {~(broadcastBitmap & 2), UINT64_MAX, UINT64_MAX, UINT64_MAX}
+    };
     err = hzl_ServerInit(&ctx);
     atto_eq(err, HZL_ERR_CLIENTS_BITMAP_INVALID_BROADCAST_GROUP);
 
-    modifiedGroupConfigs[0].clientSidsInGroupBitmap = broadcastBitmap;
+    modifiedGroupConfigs[0].clientSidsInGroupBitmap = (hzl_ServerBitMap_t) {
+            .words = {broadcastBitmap}
+    };
     err = hzl_ServerInit(&ctx);
     atto_eq(err, HZL_OK);
 
     // One bit higher than the rest of the bitmap
-    modifiedGroupConfigs[0].clientSidsInGroupBitmap = (broadcastBitmap << 1U) | 1U;
+    modifiedGroupConfigs[0].clientSidsInGroupBitmap = (hzl_ServerBitMap_t) {
+            .words = {(broadcastBitmap << 1U) | 1U}
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+
+    // Higher set bits in the other bitmap words are ignored as well
+    modifiedGroupConfigs[0].clientSidsInGroupBitmap = (hzl_ServerBitMap_t) {
+            .words = {broadcastBitmap, 1, 0, UINT64_MAX}
+    };
     err = hzl_ServerInit(&ctx);
     atto_eq(err, HZL_OK);
 }
@@ -110,11 +110,21 @@ hzlServerTest_ServerInitConfigHeaderTypeMustBeStandard(void)
     err = hzl_ServerInit(&ctx);
 
     atto_eq(err, HZL_ERR_INVALID_HEADER_TYPE);
+    // When built with a fixed header type, the other standard ones are unsupported too
+    for (uint8_t type = HZL_HEADER_0; type <= HZL_HEADER_6; type++)
+    {
+        if (HZL_TEST_IS_HEADER_TYPE_BUILT(type)) { continue; }
+        modifiedServerConfig.headerType = type;
+        err = hzl_ServerInit(&ctx);
+        atto_eq(err, HZL_ERR_INVALID_HEADER_TYPE);
+    }
 }
 
 static void
 hzlServerTest_ServerInitConfigServerAmountOfGroupsMustFitForHeaderType(void)
 {
+    if (!HZL_TEST_IS_HEADER_TYPE_BUILT(HZL_HEADER_3)
+        || !HZL_TEST_IS_HEADER_TYPE_BUILT(HZL_HEADER_5)) { return; }
     hzl_Err_t err;
     hzl_ServerGroupState_t groupStates[HZL_MAX_TEST_AMOUNT_OF_GROUPS];
     hzl_ServerConfig_t modifiedServerConfig = HZL_TEST_CORRECT_SERVER_CONFIG;
@@ -149,6 +159,7 @@ hzlServerTest_ServerInitConfigServerAmountOfGroupsMustFitForHeaderType(void)
 static void
 hzlServerTest_ServerInitConfigServerAmountOfClientsMustFitForHeaderType(void)
 {
+    if (!HZL_TEST_IS_HEADER_TYPE_BUILT(HZL_HEADER_3)) { return; }
     hzl_Err_t err;
     hzl_ServerGroupState_t groupStates[HZL_MAX_TEST_AMOUNT_OF_GROUPS];
     hzl_ServerConfig_t modifiedServerConfig = HZL_TEST_CORRECT_SERVER_CONFIG;
@@ -172,38 +183,48 @@ hzlServerTest_ServerInitConfigServerAmountOfClientsMustFitForHeaderType(void)
 static void
 hzlServerTest_ServerInitConfigServerAmountOfClientsMustFitInBitmap(void)
 {
+    // The bitmap has a bit for every SID fitting into the uint8_t amountOfClients,
+    // so the maximum amount of Clients is always accepted.
     hzl_Err_t err;
     hzl_ServerGroupState_t groupStates[HZL_MAX_TEST_AMOUNT_OF_GROUPS];
     hzl_ServerConfig_t modifiedServerConfig = HZL_TEST_CORRECT_SERVER_CONFIG;
     hzl_ServerClientConfig_t modifiedClientConfigs[HZL_SERVER_MAX_AMOUNT_OF_CLIENTS];
     for (size_t i = 0; i < HZL_SERVER_MAX_AMOUNT_OF_CLIENTS; i++)
     {
-        // Copy same config over many times. It's not about the correct clients config,
-        // just about the amount of clients. We don't want to read invalid memory.
         modifiedClientConfigs[i] = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS[0];
+        modifiedClientConfigs[i].sid = (hzl_Sid_t) (i + 1U);
+    }
+    hzl_ServerGroupConfig_t modifiedGroupConfigs[HZL_MAX_TEST_AMOUNT_OF_GROUPS];
+    memcpy(modifiedGroupConfigs, HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+           sizeof(modifiedGroupConfigs));
+    for (size_t w = 0; w < HZL_SERVER_BITMAP_WORDS; w++)
+    {
+        modifiedGroupConfigs[0].clientSidsInGroupBitmap.words[w] = UINT64_MAX;
     }
     hzl_ServerCtx_t ctx = {
             .serverConfig = &modifiedServerConfig,
-            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
-            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .clientConfigs = modifiedClientConfigs,
+            .groupConfigs = modifiedGroupConfigs,
             .groupStates = groupStates,
             .io = HZL_TEST_CORRECT_IO,
     };
 
-    modifiedServerConfig.amountOfClients = HZL_SERVER_MAX_AMOUNT_OF_CLIENTS + 1;
+    modifiedServerConfig.amountOfClients = HZL_SERVER_MAX_AMOUNT_OF_CLIENTS;
     err = hzl_ServerInit(&ctx);
-    atto_eq(err, HZL_ERR_TOO_MANY_CLIENTS);
+    atto_eq(err, HZL_OK);
 
-    modifiedServerConfig.amountOfClients = HZL_SERVER_MAX_AMOUNT_OF_CLIENTS;
+    // A Group may contain a Client with a SID not fitting in the first bitmap word
+    modifiedGroupConfigs[1].clientSidsInGroupBitmap = (hzl_ServerBitMap_t) {
+            .words = {0, 0, 0, 1ULL << 62U}  // SID 255
+    };
     err = hzl_ServerInit(&ctx);
-    atto_neq(err, HZL_ERR_TOO_MANY_CLIENTS); // Some of the client configs are wrong
-    // Avoid "unused variable" error: we don't need its value, but need the valid memory location
-    (void) modifiedClientConfigs;
+    atto_eq(err, HZL_OK);
 }
 
 static void
 hzlServerTest_ServerInitConfigServerMustHaveOnlyBroadcastWhenHeader5Or6(void)
 {
+    if (!HZL_TEST_IS_HEADER_TYPE_BUILT(HZL_HEADER_6)) { return; }
     // Headers 5 or 6 don't have a field for the GID, as this is assumed to
     // be the only group. Thus there must be only 1 group configuration and it
     // must be the one for the GID 0.
@@ -40,6 +40,7 @@
  */
 int main(void)
 {
+    HZL_TEST_SKIP_UNLESS_CONFIG_HEADER_TYPE_BUILT();
     hzlServerTest_ServerInit();
     hzlServerTest_ServerInitCheckServerConfig();
     hzlServerTest_ServerInitCheckClientConfigs();
@@ -49,12 +50,23 @@ int main(void)
     hzlServerTest_ServerNew();
     hzlServerTest_ServerBuildUnsecured();
     hzlServerTest_ServerBuildSecuredFd();
+    hzlServerTest_ServerBuildSecuredFdBatch();
+    hzlServerTest_ServerBuildSecuredFdInto();
+    hzlServerTest_ServerBuildSecuredTp();
     hzlServerTest_ServerProcessReceived();
     hzlServerTest_ServerProcessReceivedRequest();
     hzlServerTest_ServerProcessReceivedServerOnlyMsg();
     hzlServerTest_ServerProcessReceivedUnsecured();
     hzlServerTest_ServerProcessReceivedSecuredFd();
+    hzlServerTest_ServerProcessReceivedBatch();
+    hzlServerTest_ServerProcessReceivedInPlace();
+    hzlServerTest_ServerUnpackHeader();
     hzlServerTest_ServerForceSessionRenewal();
+    hzlServerTest_ServerTick();
+    hzlServerTest_ServerPrepareNextSessions();
+    hzlServerTest_ServerShardsNew();
+    hzlServerTest_ServerShardsSubmitReceived();
+    hzlServerTest_ServerShardsSubmitSecuredFd();
     HZL_TEST_PARTIAL_REPORT();
     return atto_at_least_one_fail;
 }
@@ -75,7 +75,10 @@ hzlServerTest_ServerNewFileMustHaveProperMagicNumber(void)
     hzl_ServerCtx_t* ctx;
 
     err = hzl_ServerNew(&ctx, "serverconfigfiles/invalidMagicNumber.hzl");
+    atto_eq(err, HZL_ERR_INVALID_FILE_MAGIC_NUMBER);
 
+    // Valid magic number but unknown file format version.
+    err = hzl_ServerNew(&ctx, "serverconfigfiles/invalidFormatVersion.hzl");
     atto_eq(err, HZL_ERR_INVALID_FILE_MAGIC_NUMBER);
 }
 
@@ -167,7 +170,7 @@ hzlServerTest_ServerNewFileValidIsAccepted(void)
     atto_eq(ctx->groupConfigs[0].ctrNonceUpperLimit, 0xFF0000U);
     atto_eq(ctx->groupConfigs[0].sessionDurationMillis, 36000000);
     atto_eq(ctx->groupConfigs[0].delayBetweenRenNotificationsMillis, 10000);
-    atto_eq(ctx->groupConfigs[0].clientSidsInGroupBitmap, 0xFFFFFFFFU);
+    atto_eq(ctx->groupConfigs[0].clientSidsInGroupBitmap.words[0], 0xFFFFFFFFU);
     atto_eq(ctx->groupConfigs[0].maxSilenceIntervalMillis, 5000);
     atto_eq(ctx->groupConfigs[0].gid, 0);
 
@@ -175,7 +178,7 @@ hzlServerTest_ServerNewFileValidIsAccepted(void)
     atto_eq(ctx->groupConfigs[1].ctrNonceUpperLimit, 1000);
     atto_eq(ctx->groupConfigs[1].sessionDurationMillis, 36000000);
     atto_eq(ctx->groupConfigs[1].delayBetweenRenNotificationsMillis, 5000);
-    atto_eq(ctx->groupConfigs[1].clientSidsInGroupBitmap, 0x06U);
+    atto_eq(ctx->groupConfigs[1].clientSidsInGroupBitmap.words[0], 0x06U);
     atto_eq(ctx->groupConfigs[1].maxSilenceIntervalMillis, 5000);
     atto_eq(ctx->groupConfigs[1].gid, 1);
 
@@ -183,7 +186,7 @@ hzlServerTest_ServerNewFileValidIsAccepted(void)
     atto_eq(ctx->groupConfigs[2].ctrNonceUpperLimit, 0xFF0000U);
     atto_eq(ctx->groupConfigs[2].sessionDurationMillis, 36000000);
     atto_eq(ctx->groupConfigs[2].delayBetweenRenNotificationsMillis, 5000);
-    atto_eq(ctx->groupConfigs[2].clientSidsInGroupBitmap, 0x01U);
+    atto_eq(ctx->groupConfigs[2].clientSidsInGroupBitmap.words[0], 0x01U);
     atto_eq(ctx->groupConfigs[2].maxSilenceIntervalMillis, 5001);
     atto_eq(ctx->groupConfigs[2].gid, 2);
 
@@ -191,7 +194,7 @@ hzlServerTest_ServerNewFileValidIsAccepted(void)
     atto_eq(ctx->groupConfigs[3].ctrNonceUpperLimit, 0xFF0000U);
     atto_eq(ctx->groupConfigs[3].sessionDurationMillis, 36000000);
     atto_eq(ctx->groupConfigs[3].delayBetweenRenNotificationsMillis, 5000);
-    atto_eq(ctx->groupConfigs[3].clientSidsInGroupBitmap, 0x03U);
+    atto_eq(ctx->groupConfigs[3].clientSidsInGroupBitmap.words[0], 0x03U);
     atto_eq(ctx->groupConfigs[3].maxSilenceIntervalMillis, 5002);
     atto_eq(ctx->groupConfigs[3].gid, 3);
 
@@ -199,7 +202,7 @@ hzlServerTest_ServerNewFileValidIsAccepted(void)
     atto_eq(ctx->groupConfigs[4].ctrNonceUpperLimit, 16710000);
     atto_eq(ctx->groupConfigs[4].sessionDurationMillis, 36000001);
     atto_eq(ctx->groupConfigs[4].delayBetweenRenNotificationsMillis, 5077);
-    atto_eq(ctx->groupConfigs[4].clientSidsInGroupBitmap, 0x04U);
+    atto_eq(ctx->groupConfigs[4].clientSidsInGroupBitmap.words[0], 0x04U);
     atto_eq(ctx->groupConfigs[4].maxSilenceIntervalMillis, 5000);
     atto_eq(ctx->groupConfigs[4].gid, 4);
 
@@ -223,6 +226,125 @@ hzlServerTest_ServerNewFileValidIsAccepted(void)
     hzl_ServerFree(&ctx);
 }
 
+static void
+hzlServerTest_ServerNewFileWithWideBitmapIsAccepted(void)
+{
+    hzl_Err_t err;
+    hzl_ServerCtx_t* ctx = NULL;
+
+    err = hzl_ServerNew(&ctx, "serverconfigfiles/ServerBitmap256.hzl");
+
+    atto_eq(err, HZL_OK);
+    // Server Config: more Clients than a 32-bit bitmap could hold
+    atto_eq(ctx->serverConfig->amountOfGroups, 2);
+    atto_eq(ctx->serverConfig->amountOfClients, 70);
+    atto_eq(ctx->serverConfig->headerType, 0);
+    atto_eq(ctx->clientConfigs[69].sid, 70);
+    atto_eq(ctx->clientConfigs[69].ltk[0], 70);
+    atto_eq(ctx->clientConfigs[69].ltk[15], 70);
+
+    // Broadcast Group contains all 70 Clients
+    atto_eq(ctx->groupConfigs[0].gid, 0);
+    atto_eq(ctx->groupConfigs[0].clientSidsInGroupBitmap.words[0], UINT64_MAX);
+    atto_eq(ctx->groupConfigs[0].clientSidsInGroupBitmap.words[1], 0x3FU);
+    atto_eq(ctx->groupConfigs[0].clientSidsInGroupBitmap.words[2], 0U);
+    atto_eq(ctx->groupConfigs[0].clientSidsInGroupBitmap.words[3], 0U);
+    atto_eq(ctx->groupConfigs[0].maxSilenceIntervalMillis, 5000);
+
+    // Group 1 contains SIDs 2, 66, 70
+    atto_eq(ctx->groupConfigs[1].gid, 1);
+    atto_eq(ctx->groupConfigs[1].clientSidsInGroupBitmap.words[0], 0x02U);
+    atto_eq(ctx->groupConfigs[1].clientSidsInGroupBitmap.words[1], 0x22U);
+    atto_eq(ctx->groupConfigs[1].clientSidsInGroupBitmap.words[2], 0U);
+    atto_eq(ctx->groupConfigs[1].clientSidsInGroupBitmap.words[3], 0U);
+    atto_eq(ctx->groupConfigs[1].maxCtrnonceDelayMsgs, 22);
+    atto_eq(ctx->groupConfigs[1].maxSilenceIntervalMillis, 5000);
+
+    // Membership of SIDs in the higher bitmap words is checked on reception
+    hzl_CbsPduMsg_t msgToTx = {0};
+    hzl_RxSduMsg_t unpackedMsg = {0};
+    uint8_t rxPdu[64] = {
+            // Header 0
+            1,  // GID
+            67,  // SID, which does NOT belong into Group with GID==1
+            2,  // PTY == REQ
+            8, 9, 10, 11, 12, 13, 14, 15,  // Reqnonce
+            20, 21, 22, 23, 24, 25, 26, 27,  // tag (incorrect)
+            28, 29, 30, 31, 32, 33, 34, 35,  // tag (incorrect)
+    };
+    err = hzl_ServerProcessReceived(&msgToTx, &unpackedMsg, ctx, rxPdu, sizeof(rxPdu), 0xABC);
+    atto_eq(err, HZL_ERR_SECWARN_NOT_IN_GROUP);
+    rxPdu[1] = 66;
+    err = hzl_ServerProcessReceived(&msgToTx, &unpackedMsg, ctx, rxPdu, sizeof(rxPdu), 0xABC);
+    atto_eq(err, HZL_ERR_SECWARN_INVALID_TAG);  // Tag is wrong, but other checks are passing
+
+    hzl_ServerFree(&ctx);
+}
+
+static void
+hzlServerTest_ServerNewFileWithHeaderPlacementIsAccepted(void)
+{
+    hzl_Err_t err;
+    hzl_ServerCtx_t* ctx = NULL;
+
+    // Same configuration as ServerBitmap256.hzl in the newer format with the header placement
+    err = hzl_ServerNew(&ctx, "serverconfigfiles/ServerHeaderInCanId.hzl");
+
+    atto_eq(err, HZL_OK);
+    atto_eq(ctx->serverConfig->amountOfGroups, 2);
+    atto_eq(ctx->serverConfig->amountOfClients, 70);
+    atto_eq(ctx->serverConfig->headerType, 0);
+    atto_eq(ctx->serverConfig->headerPlacement, HZL_HEADER_IN_CAN_ID);
+    atto_eq(ctx->clientConfigs[69].sid, 70);
+    atto_eq(ctx->groupConfigs[1].clientSidsInGroupBitmap.words[1], 0x22U);
+    atto_eq(ctx->header.canIdMask, 0xFFFFFFU);
+
+    // The whole header is read from the CAN ID
+    hzl_CbsPduMsg_t msgToTx = {0};
+    hzl_RxSduMsg_t unpackedMsg = {0};
+    uint8_t rxPdu[64] = {
+            8, 9, 10, 11, 12, 13, 14, 15,  // Reqnonce
+            20, 21, 22, 23, 24, 25, 26, 27,  // tag (incorrect)
+            28, 29, 30, 31, 32, 33, 34, 35,  // tag (incorrect)
+    };
+    // Header 0: GID, SID which does NOT belong into Group with GID==1, PTY == REQ
+    const hzl_CanId_t userCanIdBits = 0x1A000000U;
+    hzl_CanId_t canId = userCanIdBits | 1U << 16U | 67U << 8U | 2U;
+    err = hzl_ServerProcessReceived(&msgToTx, &unpackedMsg, ctx, rxPdu, sizeof(rxPdu), canId);
+    atto_eq(err, HZL_ERR_SECWARN_NOT_IN_GROUP);
+    canId = userCanIdBits | 1U << 16U | 66U << 8U | 2U;
+    err = hzl_ServerProcessReceived(&msgToTx, &unpackedMsg, ctx, rxPdu, sizeof(rxPdu), canId);
+    atto_eq(err, HZL_ERR_SECWARN_INVALID_TAG);  // Tag is wrong, but other checks are passing
+
+    hzl_ServerFree(&ctx);
+}
+
+static void
+hzlServerTest_ServerNewCurrentTimeIsMonotonic(void)
+{
+    hzl_Err_t err;
+    hzl_ServerCtx_t* ctx;
+    err = hzl_ServerNew(&ctx, "serverconfigfiles/Server.hzl");
+    atto_eq(err, HZL_OK);
+    hzl_Timestamp_t before = 0;
+    hzl_Timestamp_t after = 0;
+
+    err = ctx->io.currentTime(&before);
+    atto_eq(err, HZL_OK);
+    err = ctx->io.currentTime(&after);
+    atto_eq(err, HZL_OK);
+    atto_lt((hzl_Timestamp_t) (after - before), 1000U);
+
+    atto_eq(hzl_ServerCurrentTimeCoarse(NULL), HZL_ERR_CANNOT_GET_CURRENT_TIME);
+    ctx->io.currentTime = hzl_ServerCurrentTimeCoarse;
+    err = ctx->io.currentTime(&before);
+    atto_eq(err, HZL_OK);
+    err = ctx->io.currentTime(&after);
+    atto_eq(err, HZL_OK);
+    atto_lt((hzl_Timestamp_t) (after - before), 1000U);
+    hzl_ServerFree(&ctx);
+}
+
 #endif  /* HZL_OS_AVAILABLE */
 
 void hzlServerTest_ServerNew(void)
@@ -235,6 +357,9 @@ void hzlServerTest_ServerNew(void)
     hzlServerTest_ServerNewFileMustHaveProperLength();
     hzlServerTest_ServerNewFileMustHaveValidConfig();
     hzlServerTest_ServerNewFileValidIsAccepted();
+    hzlServerTest_ServerNewFileWithWideBitmapIsAccepted();
+    hzlServerTest_ServerNewFileWithHeaderPlacementIsAccepted();
+    hzlServerTest_ServerNewCurrentTimeIsMonotonic();
     HZL_TEST_PARTIAL_REPORT();
 #endif  /* HZL_OS_AVAILABLE */
 }
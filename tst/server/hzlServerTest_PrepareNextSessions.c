@@ -0,0 +1,183 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Tests of the hzl_ServerPrepareNextSessions() function and of the use of the
+ * pre-generated STKs by the Session renewal.
+ */
+
+#include "hzlTest.h"
+
+static const uint8_t HZL_TEST_ZERO_STK[16] = {0};
+
+static void
+hzlServerTest_ServerPrepareNextSessionsCtxMustBeNotNull(void)
+{
+    hzl_Err_t err;
+
+    err = hzl_ServerPrepareNextSessions(NULL);
+
+    atto_eq(err, HZL_ERR_NULL_CTX);
+}
+
+static void
+hzlServerTest_ServerPrepareNextSessionsGroupTimersMustBeNotNull(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+
+    err = hzl_ServerPrepareNextSessions(&ctx);
+
+    atto_eq(err, HZL_ERR_NULL_GROUP_TIMERS);
+}
+
+static void
+hzlServerTest_ServerPrepareNextSessionsInitGeneratesAll(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerGroupTimer_t groupTimers[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    memset(groupTimers, 0, sizeof(groupTimers));
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .groupTimers = groupTimers,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+
+    err = hzl_ServerInit(&ctx);
+
+    atto_eq(err, HZL_OK);
+    for (size_t i = 0U; i < HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS; i++)
+    {
+        atto_neq(memcmp(groupTimers[i].nextStk, HZL_TEST_ZERO_STK, 16), 0);
+    }
+}
+
+static void
+hzlServerTest_ServerPrepareNextSessionsRenewalTakesNextStkWithoutTrng(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerGroupTimer_t groupTimers[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .groupTimers = groupTimers,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    hzl_CbsPduMsg_t msgToTx = {0};
+    // Dummy next STK, distinguishable from the TRNG mockup output
+    memset(groupTimers[1].nextStk, 0xAA, 16);
+    // Assume at least one Client Requested the state already:
+    // the last RX message was after the start of the session.
+    hzl_Timestamp_t now;
+    hzlTest_IoMockupCurrentTimeSucceeding(&now);
+    groupStates[1].currentRxLastMessageInstant = now;
+    ctx.io.trng = hzlTest_IoMockupTrngFailing;
+
+    err = hzl_ServerForceSessionRenewal(&msgToTx, &ctx, 1);
+
+    atto_eq(err, HZL_OK);
+    atto_eq(msgToTx.dataLen, 3 + 19);
+    const uint8_t expectedStk[16] = {
+            0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+            0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    };
+    atto_memeq(groupStates[1].currentStk, expectedStk, 16);
+    atto_zeros(groupTimers[1].nextStk, 16);
+    uint8_t untouchedStk[16];
+    memcpy(untouchedStk, groupTimers[2].nextStk, 16);
+
+    // The TRNG failure is reported and retried at the next call
+    err = hzl_ServerPrepareNextSessions(&ctx);
+    atto_eq(err, HZL_ERR_CANNOT_GENERATE_RANDOM);
+    atto_zeros(groupTimers[1].nextStk, 16);
+
+    ctx.io.trng = hzlTest_IoMockupTrngSucceeding;
+    err = hzl_ServerPrepareNextSessions(&ctx);
+    atto_eq(err, HZL_OK);
+    atto_neq(memcmp(groupTimers[1].nextStk, HZL_TEST_ZERO_STK, 16), 0);
+    // Only the taken one is generated again
+    atto_memeq(groupTimers[2].nextStk, untouchedStk, 16);
+}
+
+static void
+hzlServerTest_ServerPrepareNextSessionsRenewalWithoutNextStkUsesTrng(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerGroupTimer_t groupTimers[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .groupTimers = groupTimers,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    hzl_CbsPduMsg_t msgToTx = {0};
+    memset(groupTimers[1].nextStk, 0, 16);  // Not available
+    hzl_Timestamp_t now;
+    hzlTest_IoMockupCurrentTimeSucceeding(&now);
+    groupStates[1].currentRxLastMessageInstant = now;
+    ctx.io.trng = hzlTest_IoMockupTrngFailing;
+
+    err = hzl_ServerForceSessionRenewal(&msgToTx, &ctx, 1);
+
+    atto_eq(err, HZL_ERR_CANNOT_GENERATE_RANDOM);
+}
+
+void hzlServerTest_ServerPrepareNextSessions(void)
+{
+    hzlServerTest_ServerPrepareNextSessionsCtxMustBeNotNull();
+    hzlServerTest_ServerPrepareNextSessionsGroupTimersMustBeNotNull();
+    hzlServerTest_ServerPrepareNextSessionsInitGeneratesAll();
+    hzlServerTest_ServerPrepareNextSessionsRenewalTakesNextStkWithoutTrng();
+    hzlServerTest_ServerPrepareNextSessionsRenewalWithoutNextStkUsesTrng();
+    HZL_TEST_PARTIAL_REPORT();
+}
@@ -137,6 +137,7 @@ hzlServerTest_ServerProcessReceivedMsgMustHaveEnoughDataLenForCbsHeader0(void)
 static void
 hzlServerTest_ServerProcessReceivedMsgMustHaveEnoughDataLenForCbsHeader4(void)
 {
+    if (!HZL_TEST_IS_HEADER_TYPE_BUILT(HZL_HEADER_4)) { return; }
     hzl_Err_t err;
     hzl_ServerConfig_t serverConfigWithNewHeaderType =
             HZL_TEST_CORRECT_SERVER_CONFIG;
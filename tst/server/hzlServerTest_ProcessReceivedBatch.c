@@ -0,0 +1,266 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Tests of the hzl_ServerProcessReceivedBatch() function.
+ *
+ * @warning
+ * REDUCING COVERAGE ON PURPOSE. NOT implementing all the testcases for every message type,
+ * because each message of the batch is dispatched to the same internal functions used by
+ * hzl_ServerProcessReceived(), which are already tested.
+ */
+
+#include "hzlTest.h"
+
+#define HZL_TEST_BATCH_LEN 4U
+
+/** SADFD message from SID 1 in GID 0 with Counter Nonce 0x010203, carrying "ABCDE". */
+static const uint8_t HZL_TEST_BATCH_VALID_SADFD[64] = {
+        // Header 0
+        0,  // GID
+        1,  // SID
+        4,  // PTY == SADFD
+        0x03, 0x02, 0x01,  // Ctrnonce
+        5,  // ptlen
+        0x1D, 0x5A, 0x14, 0x41, 0x8F,  // ctext: "ABCDE" in ASCII encoding
+        0xFA, 0x4F, 0x11, 0x4C, 0xF3, 0x33, 0x99, 0xD7,  // Tag (correct)
+};
+
+static void
+hzlServerTest_ServerProcessReceivedBatchMustHaveNonNullArgs(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    hzl_CbsPduMsg_t reactionPdus[1];
+    hzl_RxSduMsg_t unpackedMsgs[1];
+    hzl_Err_t results[1];
+    const uint8_t* rxPdus[1] = {HZL_TEST_BATCH_VALID_SADFD};
+    const size_t rxPduLens[1] = {64};
+    const hzl_CanId_t rxCanIds[1] = {0xABC};
+
+    err = hzl_ServerProcessReceivedBatch(NULL, unpackedMsgs, results, &ctx,
+                                         rxPdus, rxPduLens, rxCanIds, NULL, 1);
+    atto_eq(err, HZL_ERR_NULL_PDU);
+    err = hzl_ServerProcessReceivedBatch(reactionPdus, NULL, results, &ctx,
+                                         rxPdus, rxPduLens, rxCanIds, NULL, 1);
+    atto_eq(err, HZL_ERR_NULL_SDU);
+    err = hzl_ServerProcessReceivedBatch(reactionPdus, unpackedMsgs, NULL, &ctx,
+                                         rxPdus, rxPduLens, rxCanIds, NULL, 1);
+    atto_eq(err, HZL_ERR_NULL_RESULTS);
+    err = hzl_ServerProcessReceivedBatch(reactionPdus, unpackedMsgs, results, NULL,
+                                         rxPdus, rxPduLens, rxCanIds, NULL, 1);
+    atto_eq(err, HZL_ERR_NULL_CTX);
+    err = hzl_ServerProcessReceivedBatch(reactionPdus, unpackedMsgs, results, &ctx,
+                                         NULL, rxPduLens, rxCanIds, NULL, 1);
+    atto_eq(err, HZL_ERR_NULL_PDU);
+    err = hzl_ServerProcessReceivedBatch(reactionPdus, unpackedMsgs, results, &ctx,
+                                         rxPdus, NULL, rxCanIds, NULL, 1);
+    atto_eq(err, HZL_ERR_NULL_PDU);
+    err = hzl_ServerProcessReceivedBatch(reactionPdus, unpackedMsgs, results, &ctx,
+                                         rxPdus, rxPduLens, NULL, NULL, 1);
+    atto_eq(err, HZL_ERR_NULL_PDU);
+}
+
+static void
+hzlServerTest_ServerProcessReceivedBatchEmptyBatchIsAccepted(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    hzl_CbsPduMsg_t reactionPdus[1];
+    hzl_RxSduMsg_t unpackedMsgs[1];
+    hzl_Err_t results[1];
+    const uint8_t* rxPdus[1] = {HZL_TEST_BATCH_VALID_SADFD};
+    const size_t rxPduLens[1] = {64};
+    const hzl_CanId_t rxCanIds[1] = {0xABC};
+
+    err = hzl_ServerProcessReceivedBatch(reactionPdus, unpackedMsgs, results, &ctx,
+                                         rxPdus, rxPduLens, rxCanIds, NULL, 0);
+    atto_eq(err, HZL_OK);
+}
+
+static void
+hzlServerTest_ServerProcessReceivedBatchCurrentTimeFailureClearsOutputs(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    ctx.io.currentTime = hzlTest_IoMockupCurrentTimeFailing;
+    hzl_CbsPduMsg_t reactionPdus[2];
+    hzl_RxSduMsg_t unpackedMsgs[2];
+    memset(reactionPdus, 0xAA, sizeof(reactionPdus));
+    memset(unpackedMsgs, 0xAA, sizeof(unpackedMsgs));
+    hzl_Err_t results[2];
+    const uint8_t* rxPdus[2] = {HZL_TEST_BATCH_VALID_SADFD, HZL_TEST_BATCH_VALID_SADFD};
+    const size_t rxPduLens[2] = {64, 64};
+    const hzl_CanId_t rxCanIds[2] = {0xABC, 0xABC};
+
+    err = hzl_ServerProcessReceivedBatch(reactionPdus, unpackedMsgs, results, &ctx,
+                                         rxPdus, rxPduLens, rxCanIds, NULL, 2);
+
+    atto_eq(err, HZL_ERR_CANNOT_GET_CURRENT_TIME);
+    atto_zeros(reactionPdus, sizeof(reactionPdus));
+    atto_zeros(unpackedMsgs, sizeof(unpackedMsgs));
+}
+
+static void
+hzlServerTest_ServerProcessReceivedBatchReportsResultPerMessage(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    // Dummy established-session state
+    groupStates[0].currentCtrNonce = 20;
+    groupStates[0].currentStk[0] = 99;
+    memset(&groupStates[0].currentStk[1], 0, 15);  // The rest is zeros
+    hzl_CbsPduMsg_t reactionPdus[HZL_TEST_BATCH_LEN];
+    hzl_RxSduMsg_t unpackedMsgs[HZL_TEST_BATCH_LEN];
+    memset(unpackedMsgs, 0xAA, sizeof(unpackedMsgs));
+    hzl_Err_t results[HZL_TEST_BATCH_LEN];
+    uint8_t oldSadfd[64];
+    memcpy(oldSadfd, HZL_TEST_BATCH_VALID_SADFD, 64);
+    oldSadfd[3] = 0;  // Ctrnonce way older than the one of the previous message
+    oldSadfd[4] = 0;
+    oldSadfd[5] = 0;
+    uint8_t invalidTagSadfd[64];
+    memcpy(invalidTagSadfd, HZL_TEST_BATCH_VALID_SADFD, 64);
+    invalidTagSadfd[3] = 0x10;  // Fresh ctrnonce, but the tag does not match anymore
+    const uint8_t* rxPdus[HZL_TEST_BATCH_LEN] = {
+            HZL_TEST_BATCH_VALID_SADFD,
+            oldSadfd,
+            HZL_TEST_BATCH_VALID_SADFD,  // Too short to contain the header
+            invalidTagSadfd,
+    };
+    const size_t rxPduLens[HZL_TEST_BATCH_LEN] = {64, 64, 2, 64};
+    const hzl_CanId_t rxCanIds[HZL_TEST_BATCH_LEN] = {0xA, 0xB, 0xC, 0xD};
+
+    err = hzl_ServerProcessReceivedBatch(reactionPdus, unpackedMsgs, results, &ctx,
+                                         rxPdus, rxPduLens, rxCanIds, NULL,
+                                         HZL_TEST_BATCH_LEN);
+
+    atto_eq(err, HZL_OK);
+    atto_eq(results[0], HZL_OK);
+    atto_eq(unpackedMsgs[0].canId, 0xA);
+    atto_eq(unpackedMsgs[0].dataLen, 5);
+    atto_eq(unpackedMsgs[0].gid, 0);
+    atto_eq(unpackedMsgs[0].sid, 1);
+    atto_true(unpackedMsgs[0].wasSecured);
+    atto_true(unpackedMsgs[0].isForUser);
+    atto_memeq(unpackedMsgs[0].data, "ABCDE", unpackedMsgs[0].dataLen);
+    atto_zeros(&unpackedMsgs[0].data[5], 64 - 5);
+    atto_eq(results[1], HZL_ERR_SECWARN_OLD_MESSAGE);
+    atto_false(unpackedMsgs[1].isForUser);
+    atto_eq(results[2], HZL_ERR_TOO_SHORT_PDU_TO_CONTAIN_HEADER);
+    atto_zeros(&unpackedMsgs[2], sizeof(hzl_RxSduMsg_t));
+    atto_eq(results[3], HZL_ERR_SECWARN_INVALID_TAG);
+    atto_zeros(unpackedMsgs[3].data, 64);
+    atto_zeros(reactionPdus, sizeof(reactionPdus)); // No msg to transmit
+    // Only the first message updated the state
+    atto_eq(groupStates[0].currentCtrNonce, 0x010203 + 1);
+}
+
+static void
+hzlServerTest_ServerProcessReceivedBatchUsesCallerTimestamps(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    // Dummy established-session state
+    groupStates[0].currentCtrNonce = 20;
+    groupStates[0].currentStk[0] = 99;
+    memset(&groupStates[0].currentStk[1], 0, 15);  // The rest is zeros
+    // The IO clock must not be needed at all when the timestamps are provided
+    ctx.io.currentTime = hzlTest_IoMockupCurrentTimeFailing;
+    hzl_CbsPduMsg_t reactionPdus[1];
+    hzl_RxSduMsg_t unpackedMsgs[1];
+    hzl_Err_t results[1];
+    const uint8_t* rxPdus[1] = {HZL_TEST_BATCH_VALID_SADFD};
+    const size_t rxPduLens[1] = {64};
+    const hzl_CanId_t rxCanIds[1] = {0xABC};
+    const hzl_Timestamp_t rxTimestamps[1] = {groupStates[0].sessionStartInstant + 10U};
+
+    err = hzl_ServerProcessReceivedBatch(reactionPdus, unpackedMsgs, results, &ctx,
+                                         rxPdus, rxPduLens, rxCanIds, rxTimestamps, 1);
+
+    atto_eq(err, HZL_OK);
+    atto_eq(results[0], HZL_OK);
+    atto_memeq(unpackedMsgs[0].data, "ABCDE", unpackedMsgs[0].dataLen);
+}
+
+void hzlServerTest_ServerProcessReceivedBatch(void)
+{
+    hzlServerTest_ServerProcessReceivedBatchMustHaveNonNullArgs();
+    hzlServerTest_ServerProcessReceivedBatchEmptyBatchIsAccepted();
+    hzlServerTest_ServerProcessReceivedBatchCurrentTimeFailureClearsOutputs();
+    hzlServerTest_ServerProcessReceivedBatchReportsResultPerMessage();
+    hzlServerTest_ServerProcessReceivedBatchUsesCallerTimestamps();
+    HZL_TEST_PARTIAL_REPORT();
+}
@@ -0,0 +1,229 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Tests of the hzl_ServerProcessReceivedInPlace() function.
+ *
+ * @warning
+ * REDUCING COVERAGE ON PURPOSE. NOT implementing all the testcases for every message type,
+ * because the validation of each message is performed by the same internal functions used by
+ * hzl_ServerProcessReceived(), which are already tested.
+ */
+
+#include "hzlTest.h"
+
+/** SADFD message from SID 1 in GID 0 with Counter Nonce 0x010203, carrying "ABCDE". */
+static const uint8_t HZL_TEST_IN_PLACE_VALID_SADFD[64] = {
+        // Header 0
+        0,  // GID
+        1,  // SID
+        4,  // PTY == SADFD
+        0x03, 0x02, 0x01,  // Ctrnonce
+        5,  // ptlen
+        0x1D, 0x5A, 0x14, 0x41, 0x8F,  // ctext: "ABCDE" in ASCII encoding
+        0xFA, 0x4F, 0x11, 0x4C, 0xF3, 0x33, 0x99, 0xD7,  // Tag (correct)
+};
+
+static void
+hzlServerTest_ServerProcessReceivedInPlaceMustHaveNonNullArgs(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    hzl_CbsPduMsg_t msgToTx;
+    hzl_RxSduView_t view;
+    uint8_t rxPdu[64];
+    memcpy(rxPdu, HZL_TEST_IN_PLACE_VALID_SADFD, sizeof(rxPdu));
+
+    err = hzl_ServerProcessReceivedInPlace(NULL, &view, &ctx, rxPdu, 64, 0xABC);
+    atto_eq(err, HZL_ERR_NULL_PDU);
+    err = hzl_ServerProcessReceivedInPlace(&msgToTx, NULL, &ctx, rxPdu, 64, 0xABC);
+    atto_eq(err, HZL_ERR_NULL_SDU);
+    err = hzl_ServerProcessReceivedInPlace(&msgToTx, &view, NULL, rxPdu, 64, 0xABC);
+    atto_eq(err, HZL_ERR_NULL_CTX);
+    err = hzl_ServerProcessReceivedInPlace(&msgToTx, &view, &ctx, NULL, 64, 0xABC);
+    atto_eq(err, HZL_ERR_NULL_PDU);
+}
+
+static void
+hzlServerTest_ServerProcessReceivedInPlaceSadfdMsgSuccessfully(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    // Dummy established-session state
+    groupStates[0].currentCtrNonce = 20;
+    groupStates[0].currentStk[0] = 99;
+    memset(&groupStates[0].currentStk[1], 0, 15);  // The rest is zeros
+    hzl_CbsPduMsg_t msgToTx;
+    hzl_RxSduView_t view;
+    uint8_t rxPdu[64];
+    memcpy(rxPdu, HZL_TEST_IN_PLACE_VALID_SADFD, sizeof(rxPdu));
+
+    err = hzl_ServerProcessReceivedInPlace(&msgToTx, &view, &ctx, rxPdu, 64, 0xABC);
+
+    atto_eq(err, HZL_OK);
+    atto_eq(view.canId, 0xABC);
+    atto_eq(view.dataLen, 5);
+    atto_eq(view.gid, 0);
+    atto_eq(view.sid, 1);
+    atto_true(view.wasSecured);
+    atto_true(view.isForUser);
+    // Decrypted over the ciphertext, no copy
+    atto_eq(view.data, &rxPdu[7]);
+    atto_memeq(view.data, "ABCDE", view.dataLen);
+    atto_memeq(&rxPdu[12], &HZL_TEST_IN_PLACE_VALID_SADFD[12], 64 - 12);  // Tag untouched
+    atto_zeros(&msgToTx, sizeof(hzl_CbsPduMsg_t)); // No msg to transmit
+    atto_eq(groupStates[0].currentCtrNonce, 0x010203 + 1);
+}
+
+static void
+hzlServerTest_ServerProcessReceivedInPlaceSadfdMsgWithInvalidTagIsCleared(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    // Dummy established-session state
+    groupStates[0].currentCtrNonce = 20;
+    groupStates[0].currentStk[0] = 99;
+    memset(&groupStates[0].currentStk[1], 0, 15);  // The rest is zeros
+    hzl_CbsPduMsg_t msgToTx;
+    hzl_RxSduView_t view;
+    uint8_t rxPdu[64];
+    memcpy(rxPdu, HZL_TEST_IN_PLACE_VALID_SADFD, sizeof(rxPdu));
+    rxPdu[19] ^= 0x01;  // Tampered tag
+
+    err = hzl_ServerProcessReceivedInPlace(&msgToTx, &view, &ctx, rxPdu, 64, 0xABC);
+
+    atto_eq(err, HZL_ERR_SECWARN_INVALID_TAG);
+    atto_eq(view.canId, 0xABC);
+    atto_eq(view.dataLen, 0);
+    atto_false(view.isForUser);
+    atto_eq(view.data, NULL);
+    // The unauthenticated plaintext does not linger in the PDU
+    atto_zeros(&rxPdu[7], 5);
+    atto_eq(groupStates[0].currentCtrNonce, 20);
+}
+
+static void
+hzlServerTest_ServerProcessReceivedInPlaceUadMsgSuccessfully(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    hzl_CbsPduMsg_t msgToTx;
+    hzl_RxSduView_t view;
+    uint8_t rxPdu[64] = {0, 42, 5, 11, 22, 33, 44};  // Unsecured Application Data msg
+
+    err = hzl_ServerProcessReceivedInPlace(&msgToTx, &view, &ctx, rxPdu, 7, 0xABC);
+
+    atto_eq(err, HZL_OK);
+    atto_eq(view.canId, 0xABC);
+    atto_eq(view.dataLen, 4);
+    atto_eq(view.gid, 0);
+    atto_eq(view.sid, 42);
+    atto_false(view.wasSecured);
+    atto_true(view.isForUser);
+    atto_eq(view.data, &rxPdu[3]);
+    atto_zeros(&msgToTx, sizeof(hzl_CbsPduMsg_t)); // No msg to transmit
+}
+
+static void
+hzlServerTest_ServerProcessReceivedInPlaceNonUserMsgHasNoData(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    hzl_CbsPduMsg_t msgToTx;
+    hzl_RxSduView_t view;
+    uint8_t rxPdu[64] = {
+            // Header 0
+            30,  // GID
+            1,  // SID
+            1,  // PTY == RES, only the Server sends it
+    };
+
+    err = hzl_ServerProcessReceivedInPlace(&msgToTx, &view, &ctx, rxPdu, 64, 0xABC);
+
+    atto_eq(err, HZL_ERR_SECWARN_SERVER_ONLY_MESSAGE);
+    atto_eq(view.canId, 0xABC);
+    atto_false(view.isForUser);
+    atto_eq(view.data, NULL);
+}
+
+void hzlServerTest_ServerProcessReceivedInPlace(void)
+{
+    hzlServerTest_ServerProcessReceivedInPlaceMustHaveNonNullArgs();
+    hzlServerTest_ServerProcessReceivedInPlaceSadfdMsgSuccessfully();
+    hzlServerTest_ServerProcessReceivedInPlaceSadfdMsgWithInvalidTagIsCleared();
+    hzlServerTest_ServerProcessReceivedInPlaceUadMsgSuccessfully();
+    hzlServerTest_ServerProcessReceivedInPlaceNonUserMsgHasNoData();
+    HZL_TEST_PARTIAL_REPORT();
+}
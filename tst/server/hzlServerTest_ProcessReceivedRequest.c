@@ -343,6 +343,69 @@ hzlServerTest_ServerProcessReceivedRequestMsgWithValidTagGeneratesResponse(void)
     atto_memeq(&msgToTx.data[7 + 8 + 16], expectedTag, 16);
 }
 
+static void
+hzlServerTest_ServerProcessReceivedRequestMsgWithPrecomputedClientStates(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerClientState_t clientStates[HZL_MAX_TEST_AMOUNT_OF_CLIENTS];
+    memset(clientStates, 0, sizeof(clientStates));
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+            .clientStates = clientStates,
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    // Each Client has its own precomputed state, as the LTKs differ
+    const uint64_t noState[HZL_HASH_STATE_WORDS] = {0};
+    atto_memneq(clientStates[0].reqHashMidstate, noState, sizeof(noState));
+    atto_memneq(clientStates[0].reqHashMidstate, clientStates[1].reqHashMidstate,
+                sizeof(noState));
+    hzl_CbsPduMsg_t msgToTx = {0};
+    hzl_RxSduMsg_t unpackedMsg = {0};
+    size_t rxPduLen = 64;
+    uint8_t rxPdu[64] = {
+            // Header 0
+            0,  // GID
+            1,  // SID != server
+            2,  // PTY == REQ
+            8, 9, 10, 11, 12, 13, 14, 15,  // Reqnonce
+            // Assuming the LTK being [1, 0, 0, ..., 0]
+            0xC7, 0x70, 0xFE, 0x35, 0x67, 0x85, 0x78, 0xD8,
+            0x2E, 0x78, 0x57, 0x90, 0xCD, 0x76, 0xC1, 0x1F,  // Tag (valid)
+    };
+
+    // Same Response as computing the hash from the LTK
+    err = hzl_ServerProcessReceived(&msgToTx, &unpackedMsg, &ctx, rxPdu, rxPduLen, 0xABC);
+    atto_eq(err, HZL_OK);
+    atto_eq(msgToTx.dataLen, 3 + 44);
+    const uint8_t expectedTag[] = {
+            0x3B, 0x51, 0x51, 0x7A, 0x01, 0x7E, 0x4F, 0x59,
+            0x35, 0xE1, 0xA9, 0x8C, 0x80, 0xF9, 0xFB, 0x34,
+    };
+    atto_memeq(&msgToTx.data[7 + 8 + 16], expectedTag, 16);
+
+    // The precomputed state is not consumed by the validation
+    hzl_Timestamp_t now;
+    hzlTest_IoMockupCurrentTimeSucceeding(&now);
+    groupStates[0].currentRxLastMessageInstant = now;
+    err = hzl_ServerProcessReceived(&msgToTx, &unpackedMsg, &ctx, rxPdu, rxPduLen, 0xABC);
+    atto_eq(err, HZL_OK);
+
+    // Tag is still verified
+    rxPdu[3 + 8] ^= 1U;
+    err = hzl_ServerProcessReceived(&msgToTx, &unpackedMsg, &ctx, rxPdu, rxPduLen, 0xABC);
+    atto_eq(err, HZL_ERR_SECWARN_INVALID_TAG);
+
+    err = hzl_ServerDeInit(&ctx);
+    atto_eq(err, HZL_OK);
+    atto_zeros(clientStates, sizeof(clientStates));
+}
+
 void hzlServerTest_ServerProcessReceivedRequest(void)
 {
     hzlServerTest_ServerProcessReceivedRequestMsgMustHaveKnownGid();
@@ -352,5 +415,6 @@ void hzlServerTest_ServerProcessReceivedRequest(void)
     hzlServerTest_ServerProcessReceivedRequestMsgSidMustBelongToGidGroup();
     hzlServerTest_ServerProcessReceivedRequestMsgWithValidTagSuccessfully();
     hzlServerTest_ServerProcessReceivedRequestMsgWithValidTagGeneratesResponse();
+    hzlServerTest_ServerProcessReceivedRequestMsgWithPrecomputedClientStates();
     HZL_TEST_PARTIAL_REPORT();
 }
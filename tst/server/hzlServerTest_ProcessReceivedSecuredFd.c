@@ -86,6 +86,7 @@ hzlServerTest_ServerProcessReceivedSadfdMsgMustNotHaveTooLongPlaintextHeader0(vo
 static void
 hzlServerTest_ServerProcessReceivedSadfdMsgMustNotHaveTooLongPlaintextHeader6(void)
 {
+    if (!HZL_TEST_IS_HEADER_TYPE_BUILT(HZL_HEADER_6)) { return; }
     hzl_Err_t err;
     hzl_ServerConfig_t serverConfigWithNewHeaderType =
             HZL_TEST_CORRECT_SERVER_CONFIG;
@@ -549,6 +550,7 @@ hzlServerTest_ServerProcessReceivedSadfdCurrentSessionAcceptedDuringRenewal(void
     groupStates[0].previousCtrNonce = 0xF11111;
     groupStates[0].previousStk[0] = 222;
     memset(&groupStates[0].previousStk[1], 0, 15);  // The rest is zeros
+    groupStates[0].isRenewalPhaseActive = true;
     // Dummy new session state
     groupStates[0].currentCtrNonce = 0x010200;
     groupStates[0].currentStk[0] = 99;
@@ -601,6 +603,7 @@ hzlServerTest_ServerProcessReceivedSadfdPreviousSessionAcceptedDuringRenewal(voi
     groupStates[0].previousCtrNonce = 0x010200;
     groupStates[0].previousStk[0] = 99;
     memset(&groupStates[0].previousStk[1], 0, 15);  // The rest is zeros
+    groupStates[0].isRenewalPhaseActive = true;
     // Dummy new session state
     groupStates[0].currentCtrNonce = 3;
     groupStates[0].currentStk[0] = 100;
@@ -653,6 +656,7 @@ hzlServerTest_ServerProcessReceivedSadfdPreviousSessionRejectedAfterTooManyMsgs(
     groupStates[0].previousCtrNonce = 0x010202;
     groupStates[0].previousStk[0] = 99;
     memset(&groupStates[0].previousStk[1], 0, 15);  // The rest is zeros
+    groupStates[0].isRenewalPhaseActive = true;
     // Dummy new session state
     groupStates[0].currentCtrNonce = 3;
     groupStates[0].currentStk[0] = 100;
@@ -683,6 +687,7 @@ hzlServerTest_ServerProcessReceivedSadfdPreviousSessionRejectedAfterTooManyMsgs(
     // session is deleted.
     atto_eq(groupStates[0].previousCtrNonce, 0);
     atto_zeros(groupStates[0].previousStk, HZL_STK_LEN);
+    atto_false(groupStates[0].isRenewalPhaseActive);
 }
 
 static void
@@ -704,6 +709,7 @@ hzlServerTest_ServerProcessReceivedSadfdPreviousSessionRejectedAfterTooMuchTime(
     groupStates[0].previousCtrNonce = 0x010200;
     groupStates[0].previousStk[0] = 99;
     memset(&groupStates[0].previousStk[1], 0, 15);  // The rest is zeros
+    groupStates[0].isRenewalPhaseActive = true;
     // Dummy new session state
     groupStates[0].currentCtrNonce = 3;
     groupStates[0].currentStk[0] = 100;
@@ -738,6 +744,7 @@ hzlServerTest_ServerProcessReceivedSadfdPreviousSessionRejectedAfterTooMuchTime(
     // session is deleted.
     atto_eq(groupStates[0].previousCtrNonce, 0);
     atto_zeros(groupStates[0].previousStk, HZL_STK_LEN);
+    atto_false(groupStates[0].isRenewalPhaseActive);
 }
 
 static void
@@ -778,6 +785,7 @@ hzlServerTest_ServerProcessReceivedSadfdTriggersRenewalWhenCtrNonceHitsLimit(voi
     // Session was renewed
     atto_neq(groupStates[0].currentStk[0], 99);
     atto_eq(groupStates[0].previousStk[0], 99);
+    atto_true(groupStates[0].isRenewalPhaseActive);
     // Greater by 1 because it was incremented after building the REN
     atto_eq(groupStates[0].previousCtrNonce, 0xFF0001);
     atto_eq(groupStates[0].currentCtrNonce, 0);
@@ -864,6 +872,7 @@ hzlServerTest_ServerProcessReceivedSadfdTriggersRenewalWhenTooMuchTimePassed(voi
     // Session was renewed
     atto_neq(groupStates[0].currentStk[0], 99);
     atto_eq(groupStates[0].previousStk[0], 99);
+    atto_true(groupStates[0].isRenewalPhaseActive);
     // Greater by 1 because it was incremented after building the REN
     atto_eq(groupStates[0].previousCtrNonce, 0x010206);
     atto_eq(groupStates[0].currentCtrNonce, 0);
@@ -0,0 +1,241 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Tests of the hzl_ServerShardsNew() and hzl_ServerShardsFree() functions.
+ */
+
+#include "hzlTest.h"
+
+#if HZL_OS_AVAILABLE_NIX
+
+static void
+hzlServerTest_ShardsNewIgnoreProcessed(void* const userData,
+                                       const size_t shardIndex,
+                                       const hzl_Err_t result,
+                                       const hzl_Header_t* const receivedHeader,
+                                       const hzl_CbsPduMsg_t* const reactionPdu,
+                                       const hzl_RxSduMsg_t* const receivedUserData)
+{
+    (void) userData;
+    (void) shardIndex;
+    (void) result;
+    (void) receivedHeader;
+    (void) reactionPdu;
+    (void) receivedUserData;
+}
+
+static const hzl_ServerShardsConfig_t HZL_TEST_CORRECT_SHARDS_CONFIG = {
+        .amountOfShards = 2,
+        .ringCapacity = 8,
+        .onProcessed = hzlServerTest_ShardsNewIgnoreProcessed,
+};
+
+static void
+hzlServerTest_ServerShardsNewMustHaveNonNullArgs(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    hzl_ServerShards_t* shards = NULL;
+
+    err = hzl_ServerShardsNew(NULL, &ctx, &HZL_TEST_CORRECT_SHARDS_CONFIG);
+    atto_eq(err, HZL_ERR_NULL_CTX);
+    err = hzl_ServerShardsNew(&shards, NULL, &HZL_TEST_CORRECT_SHARDS_CONFIG);
+    atto_eq(err, HZL_ERR_NULL_CTX);
+    atto_eq(shards, NULL);
+    err = hzl_ServerShardsNew(&shards, &ctx, NULL);
+    atto_eq(err, HZL_ERR_NULL_CONFIG_SERVER);
+    atto_eq(shards, NULL);
+}
+
+static void
+hzlServerTest_ServerShardsNewCtxMustBeInitialised(void)
+{
+    hzl_Err_t err;
+    hzl_ServerCtx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    hzl_ServerShards_t* shards = NULL;
+
+    err = hzl_ServerShardsNew(&shards, &ctx, &HZL_TEST_CORRECT_SHARDS_CONFIG);
+    atto_eq(err, HZL_ERR_CTX_NOT_INITIALISED);
+    atto_eq(shards, NULL);
+}
+
+static void
+hzlServerTest_ServerShardsNewConfigMustBeValid(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    hzl_ServerShards_t* shards = NULL;
+    hzl_ServerShardsConfig_t config = HZL_TEST_CORRECT_SHARDS_CONFIG;
+
+    config.amountOfShards = 0;
+    err = hzl_ServerShardsNew(&shards, &ctx, &config);
+    atto_eq(err, HZL_ERR_INVALID_AMOUNT_OF_SHARDS);
+    config.amountOfShards = HZL_SERVER_MAX_AMOUNT_OF_SHARDS + 1U;
+    err = hzl_ServerShardsNew(&shards, &ctx, &config);
+    atto_eq(err, HZL_ERR_INVALID_AMOUNT_OF_SHARDS);
+    config.amountOfShards = 1;
+    const size_t invalidCapacities[] = {0, 1, 3, 6, 100};
+    for (size_t i = 0; i < sizeof(invalidCapacities) / sizeof(invalidCapacities[0]); i++)
+    {
+        config.ringCapacity = invalidCapacities[i];
+        err = hzl_ServerShardsNew(&shards, &ctx, &config);
+        atto_eq(err, HZL_ERR_INVALID_RING_CAPACITY);
+    }
+    config.ringCapacity = 2;
+    // Each shard owning Groups needs a SADTP reception buffer, if there are any, while
+    // the idle ones beyond the amount of Groups do not
+    uint8_t sadtpRxData[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS][10];
+    hzl_SadtpRxBuffer_t sadtpRxBuffers[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    memset(sadtpRxBuffers, 0, sizeof(sadtpRxBuffers));
+    for (size_t i = 0; i < HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS; i++)
+    {
+        sadtpRxBuffers[i].data = sadtpRxData[i];
+        sadtpRxBuffers[i].capacity = sizeof(sadtpRxData[i]);
+    }
+    ctx.sadtpRxBuffers = sadtpRxBuffers;
+    ctx.amountOfSadtpRxBuffers = 1;
+    config.amountOfShards = 2;
+    err = hzl_ServerShardsNew(&shards, &ctx, &config);
+    atto_eq(err, HZL_ERR_INVALID_AMOUNT_OF_SHARDS);
+    atto_eq(shards, NULL);
+    ctx.amountOfSadtpRxBuffers = HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS;
+    config.amountOfShards = HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS + 2U;
+    err = hzl_ServerShardsNew(&shards, &ctx, &config);
+    atto_eq(err, HZL_OK);
+    hzl_ServerShardsFree(&shards);
+    ctx.sadtpRxBuffers = NULL;
+    ctx.amountOfSadtpRxBuffers = 0;
+    config.amountOfShards = 1;
+    config.onProcessed = NULL;
+    err = hzl_ServerShardsNew(&shards, &ctx, &config);
+    atto_eq(err, HZL_ERR_NULL_SHARDS_CALLBACK);
+    atto_eq(shards, NULL);
+}
+
+static void
+hzlServerTest_ServerShardsNewMustGetTimeToScheduleGroupTimers(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerGroupTimer_t groupTimers[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .groupTimers = groupTimers,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    hzl_ServerShards_t* shards = NULL;
+    ctx.io.currentTime = hzlTest_IoMockupCurrentTimeFailing;
+
+    err = hzl_ServerShardsNew(&shards, &ctx, &HZL_TEST_CORRECT_SHARDS_CONFIG);
+    atto_eq(err, HZL_ERR_CANNOT_GET_CURRENT_TIME);
+    atto_eq(shards, NULL);
+    // Without Group timers there is nothing to schedule
+    ctx.groupTimers = NULL;
+    err = hzl_ServerShardsNew(&shards, &ctx, &HZL_TEST_CORRECT_SHARDS_CONFIG);
+    atto_eq(err, HZL_OK);
+    hzl_ServerShardsFree(&shards);
+}
+
+static void
+hzlServerTest_ServerShardsNewStartsAndFreeStops(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    hzl_ServerShards_t* shards = NULL;
+    hzl_ServerShardsConfig_t config = HZL_TEST_CORRECT_SHARDS_CONFIG;
+
+    // Including more shards than Groups, some staying idle
+    const size_t amounts[] = {1, 2, HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS + 2U};
+    for (size_t i = 0; i < sizeof(amounts) / sizeof(amounts[0]); i++)
+    {
+        config.amountOfShards = amounts[i];
+        err = hzl_ServerShardsNew(&shards, &ctx, &config);
+        atto_eq(err, HZL_OK);
+        atto_neq(shards, NULL);
+        hzl_ServerShardsFree(&shards);
+        atto_eq(shards, NULL);
+    }
+    // Freeing nothing does nothing
+    hzl_ServerShardsFree(&shards);
+    atto_eq(shards, NULL);
+    hzl_ServerShardsFree(NULL);
+    // The context is usable again after the shards are freed
+    hzl_CbsPduMsg_t unsecuredPdu;
+    err = hzl_ServerBuildUnsecured(&unsecuredPdu, &ctx, (const uint8_t*) "A", 1, 0);
+    atto_eq(err, HZL_OK);
+}
+
+#endif  /* HZL_OS_AVAILABLE_NIX */
+
+void hzlServerTest_ServerShardsNew(void)
+{
+#if HZL_OS_AVAILABLE_NIX
+    hzlServerTest_ServerShardsNewMustHaveNonNullArgs();
+    hzlServerTest_ServerShardsNewCtxMustBeInitialised();
+    hzlServerTest_ServerShardsNewConfigMustBeValid();
+    hzlServerTest_ServerShardsNewMustGetTimeToScheduleGroupTimers();
+    hzlServerTest_ServerShardsNewStartsAndFreeStops();
+    HZL_TEST_PARTIAL_REPORT();
+#endif  /* HZL_OS_AVAILABLE_NIX */
+}
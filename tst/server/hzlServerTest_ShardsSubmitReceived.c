@@ -0,0 +1,249 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Tests of the hzl_ServerShardsSubmitReceived() function.
+ */
+
+#include "hzlTest.h"
+
+#if HZL_OS_AVAILABLE_NIX
+
+#include <sched.h>
+#include <stdatomic.h>
+
+/** Amount of Unsecured messages submitted per Group. */
+#define HZL_TEST_SHARDS_MSGS_PER_GROUP 100U
+
+/**
+ * What the shards processed. Each Group is processed by one shard only and the records are
+ * read after hzl_ServerShardsFree() joined the worker threads, so no further sync is needed.
+ */
+typedef struct hzlServerTest_ShardsRecord
+{
+    size_t amountPerGid[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    bool isShardOfGidCorrect[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    bool isOrderOfGidCorrect[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    bool areResultsOfGidOk[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    size_t amountOfShards;
+    /** Blocks the workers in the handler until cleared, to fill their rings. */
+    atomic_bool isBlocking;
+} hzlServerTest_ShardsRecord_t;
+
+static void
+hzlServerTest_ShardsRecordProcessed(void* const userData,
+                                    const size_t shardIndex,
+                                    const hzl_Err_t result,
+                                    const hzl_Header_t* const receivedHeader,
+                                    const hzl_CbsPduMsg_t* const reactionPdu,
+                                    const hzl_RxSduMsg_t* const receivedUserData)
+{
+    hzlServerTest_ShardsRecord_t* const record = userData;
+    while (atomic_load(&record->isBlocking)) { sched_yield(); }
+    const hzl_Gid_t gid = receivedHeader->gid;
+    if (gid >= HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS) { return; }
+    if (shardIndex != gid % record->amountOfShards) { record->isShardOfGidCorrect[gid] = false; }
+    if (result != HZL_OK || reactionPdu->dataLen != 0U || !receivedUserData->isForUser
+        || receivedUserData->gid != gid || receivedHeader->sid != 42U
+        || receivedHeader->pty != 5U)
+    {
+        record->areResultsOfGidOk[gid] = false;
+    }
+    // The user data is the index of the message within its Group
+    if (receivedUserData->dataLen != 1U
+        || receivedUserData->data[0] != (uint8_t) record->amountPerGid[gid])
+    {
+        record->isOrderOfGidCorrect[gid] = false;
+    }
+    record->amountPerGid[gid]++;
+}
+
+static void
+hzlServerTest_ShardsRecordInit(hzlServerTest_ShardsRecord_t* const record,
+                               const size_t amountOfShards)
+{
+    memset(record, 0, sizeof(hzlServerTest_ShardsRecord_t));
+    for (size_t gid = 0; gid < HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS; gid++)
+    {
+        record->isShardOfGidCorrect[gid] = true;
+        record->isOrderOfGidCorrect[gid] = true;
+        record->areResultsOfGidOk[gid] = true;
+    }
+    record->amountOfShards = amountOfShards;
+    atomic_init(&record->isBlocking, false);
+}
+
+static void
+hzlServerTest_ServerShardsSubmitReceivedMustHaveValidArgs(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    hzlServerTest_ShardsRecord_t record;
+    hzlServerTest_ShardsRecordInit(&record, 2);
+    const hzl_ServerShardsConfig_t config = {
+            .amountOfShards = 2,
+            .ringCapacity = 4,
+            .onProcessed = hzlServerTest_ShardsRecordProcessed,
+            .userData = &record,
+    };
+    hzl_ServerShards_t* shards = NULL;
+    err = hzl_ServerShardsNew(&shards, &ctx, &config);
+    atto_eq(err, HZL_OK);
+    uint8_t rxPdu[HZL_MAX_CAN_FD_DATA_LEN + 1U] = {0, 42, 5, 0};
+
+    err = hzl_ServerShardsSubmitReceived(NULL, rxPdu, 4, 0xABC);
+    atto_eq(err, HZL_ERR_NULL_CTX);
+    err = hzl_ServerShardsSubmitReceived(shards, NULL, 4, 0xABC);
+    atto_eq(err, HZL_ERR_NULL_PDU);
+    err = hzl_ServerShardsSubmitReceived(shards, rxPdu, 2, 0xABC);
+    atto_eq(err, HZL_ERR_TOO_SHORT_PDU_TO_CONTAIN_HEADER);
+    err = hzl_ServerShardsSubmitReceived(shards, rxPdu, sizeof(rxPdu), 0xABC);
+    atto_eq(err, HZL_ERR_TOO_LONG_CIPHERTEXT);
+    hzl_ServerShardsFree(&shards);
+    // Nothing was queued
+    atto_eq(record.amountPerGid[0], 0);
+}
+
+static void
+hzlServerTest_ServerShardsSubmitReceivedProcessesInOwningShard(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    hzlServerTest_ShardsRecord_t record;
+    hzlServerTest_ShardsRecordInit(&record, 2);
+    const hzl_ServerShardsConfig_t config = {
+            .amountOfShards = 2,
+            .ringCapacity = 16,
+            .onProcessed = hzlServerTest_ShardsRecordProcessed,
+            .userData = &record,
+    };
+    hzl_ServerShards_t* shards = NULL;
+    err = hzl_ServerShardsNew(&shards, &ctx, &config);
+    atto_eq(err, HZL_OK);
+
+    // Unsecured messages from SID 42, interleaving the Groups
+    for (size_t i = 0; i < HZL_TEST_SHARDS_MSGS_PER_GROUP; i++)
+    {
+        for (hzl_Gid_t gid = 0; gid < HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS; gid++)
+        {
+            const uint8_t rxPdu[4] = {gid, 42, 5, (uint8_t) i};
+            do
+            {
+                err = hzl_ServerShardsSubmitReceived(shards, rxPdu, sizeof(rxPdu), 0xABC);
+                if (err == HZL_ERR_SHARD_RING_FULL) { sched_yield(); }
+            }
+            while (err == HZL_ERR_SHARD_RING_FULL);
+            atto_eq(err, HZL_OK);
+        }
+    }
+    hzl_ServerShardsFree(&shards);
+
+    for (hzl_Gid_t gid = 0; gid < HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS; gid++)
+    {
+        atto_eq(record.amountPerGid[gid], HZL_TEST_SHARDS_MSGS_PER_GROUP);
+        atto_true(record.isShardOfGidCorrect[gid]);
+        atto_true(record.isOrderOfGidCorrect[gid]);
+        atto_true(record.areResultsOfGidOk[gid]);
+    }
+}
+
+static void
+hzlServerTest_ServerShardsSubmitReceivedFailsOnFullRing(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    hzlServerTest_ShardsRecord_t record;
+    hzlServerTest_ShardsRecordInit(&record, 1);
+    atomic_store(&record.isBlocking, true);
+    const hzl_ServerShardsConfig_t config = {
+            .amountOfShards = 1,
+            .ringCapacity = 2,
+            .onProcessed = hzlServerTest_ShardsRecordProcessed,
+            .userData = &record,
+    };
+    hzl_ServerShards_t* shards = NULL;
+    err = hzl_ServerShardsNew(&shards, &ctx, &config);
+    atto_eq(err, HZL_OK);
+
+    // The slots stay taken until the blocked worker is done with them
+    const uint8_t rxPdu0[4] = {0, 42, 5, 0};
+    const uint8_t rxPdu1[4] = {0, 42, 5, 1};
+    err = hzl_ServerShardsSubmitReceived(shards, rxPdu0, sizeof(rxPdu0), 0xABC);
+    atto_eq(err, HZL_OK);
+    err = hzl_ServerShardsSubmitReceived(shards, rxPdu1, sizeof(rxPdu1), 0xABC);
+    atto_eq(err, HZL_OK);
+    err = hzl_ServerShardsSubmitReceived(shards, rxPdu1, sizeof(rxPdu1), 0xABC);
+    atto_eq(err, HZL_ERR_SHARD_RING_FULL);
+    atomic_store(&record.isBlocking, false);
+    hzl_ServerShardsFree(&shards);
+
+    atto_eq(record.amountPerGid[0], 2);
+    atto_true(record.isOrderOfGidCorrect[0]);
+    atto_true(record.areResultsOfGidOk[0]);
+}
+
+#endif  /* HZL_OS_AVAILABLE_NIX */
+
+void hzlServerTest_ServerShardsSubmitReceived(void)
+{
+#if HZL_OS_AVAILABLE_NIX
+    hzlServerTest_ServerShardsSubmitReceivedMustHaveValidArgs();
+    hzlServerTest_ServerShardsSubmitReceivedProcessesInOwningShard();
+    hzlServerTest_ServerShardsSubmitReceivedFailsOnFullRing();
+    HZL_TEST_PARTIAL_REPORT();
+#endif  /* HZL_OS_AVAILABLE_NIX */
+}
@@ -0,0 +1,241 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Tests of the hzl_ServerShardsSubmitSecuredFd() function.
+ */
+
+#include "hzlTest.h"
+
+#if HZL_OS_AVAILABLE_NIX
+
+#include <sched.h>
+
+/** Amount of SADFD messages submitted per Group. */
+#define HZL_TEST_SHARDS_MSGS_PER_GROUP 50U
+
+/**
+ * What the shards built. Each Group is handled by one shard only and the records are
+ * read after hzl_ServerShardsFree() joined the worker threads, so no further sync is needed.
+ * One more Group than configured, to record the failures of the unknown one.
+ */
+typedef struct hzlServerTest_ShardsTxRecord
+{
+    size_t amountPerGid[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS + 1U];
+    bool isShardOfGidCorrect[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS + 1U];
+    bool areCtrNoncesOfGidIncreasing[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS + 1U];
+    hzl_CtrNonce_t lastCtrNonceOfGid[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS + 1U];
+    size_t amountOfUnknownGroupErrors;
+    size_t amountOfShards;
+} hzlServerTest_ShardsTxRecord_t;
+
+static void
+hzlServerTest_ShardsIgnoreProcessed(void* const userData,
+                                    const size_t shardIndex,
+                                    const hzl_Err_t result,
+                                    const hzl_Header_t* const receivedHeader,
+                                    const hzl_CbsPduMsg_t* const reactionPdu,
+                                    const hzl_RxSduMsg_t* const receivedUserData)
+{
+    (void) userData;
+    (void) shardIndex;
+    (void) result;
+    (void) receivedHeader;
+    (void) reactionPdu;
+    (void) receivedUserData;
+}
+
+static void
+hzlServerTest_ShardsRecordBuilt(void* const userData,
+                                const size_t shardIndex,
+                                const hzl_Err_t result,
+                                const hzl_CbsPduMsg_t* const securedPdu)
+{
+    hzlServerTest_ShardsTxRecord_t* const record = userData;
+    if (result == HZL_ERR_UNKNOWN_GROUP)
+    {
+        // Only the unknown Group is routed to the last shard in the test
+        if (shardIndex == HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS % record->amountOfShards)
+        {
+            record->amountOfUnknownGroupErrors++;
+        }
+        return;
+    }
+    if (result != HZL_OK) { return; }
+    // Header type 0: GID, SID, PTY, then the Counter Nonce in little Endian
+    const hzl_Gid_t gid = securedPdu->data[0];
+    if (gid >= HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS) { return; }
+    if (shardIndex != gid % record->amountOfShards) { record->isShardOfGidCorrect[gid] = false; }
+    const hzl_CtrNonce_t ctrNonce = (hzl_CtrNonce_t) securedPdu->data[3]
+                                    | ((hzl_CtrNonce_t) securedPdu->data[4] << 8U)
+                                    | ((hzl_CtrNonce_t) securedPdu->data[5] << 16U);
+    if (record->amountPerGid[gid] != 0U && ctrNonce != record->lastCtrNonceOfGid[gid] + 1U)
+    {
+        record->areCtrNoncesOfGidIncreasing[gid] = false;
+    }
+    record->lastCtrNonceOfGid[gid] = ctrNonce;
+    record->amountPerGid[gid]++;
+}
+
+static void
+hzlServerTest_ShardsTxRecordInit(hzlServerTest_ShardsTxRecord_t* const record,
+                                 const size_t amountOfShards)
+{
+    memset(record, 0, sizeof(hzlServerTest_ShardsTxRecord_t));
+    for (size_t gid = 0; gid <= HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS; gid++)
+    {
+        record->isShardOfGidCorrect[gid] = true;
+        record->areCtrNoncesOfGidIncreasing[gid] = true;
+    }
+    record->amountOfShards = amountOfShards;
+}
+
+static void
+hzlServerTest_ServerShardsSubmitSecuredFdMustHaveValidArgs(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    hzlServerTest_ShardsTxRecord_t record;
+    hzlServerTest_ShardsTxRecordInit(&record, 2);
+    hzl_ServerShardsConfig_t config = {
+            .amountOfShards = 2,
+            .ringCapacity = 4,
+            .onProcessed = hzlServerTest_ShardsIgnoreProcessed,
+            .userData = &record,
+    };
+    hzl_ServerShards_t* shards = NULL;
+    err = hzl_ServerShardsNew(&shards, &ctx, &config);
+    atto_eq(err, HZL_OK);
+    const uint8_t userData[HZL_MAX_CAN_FD_DATA_LEN + 1U] = {0};
+
+    // No handler for the built messages
+    err = hzl_ServerShardsSubmitSecuredFd(shards, userData, 1, 0);
+    atto_eq(err, HZL_ERR_NULL_SHARDS_CALLBACK);
+    hzl_ServerShardsFree(&shards);
+    config.onBuilt = hzlServerTest_ShardsRecordBuilt;
+    err = hzl_ServerShardsNew(&shards, &ctx, &config);
+    atto_eq(err, HZL_OK);
+
+    err = hzl_ServerShardsSubmitSecuredFd(NULL, userData, 1, 0);
+    atto_eq(err, HZL_ERR_NULL_CTX);
+    err = hzl_ServerShardsSubmitSecuredFd(shards, NULL, 1, 0);
+    atto_eq(err, HZL_ERR_NULL_SDU);
+    err = hzl_ServerShardsSubmitSecuredFd(shards, userData, sizeof(userData), 0);
+    atto_eq(err, HZL_ERR_TOO_LONG_SDU);
+    hzl_ServerShardsFree(&shards);
+    // Nothing was queued
+    atto_eq(record.amountPerGid[0], 0);
+}
+
+static void
+hzlServerTest_ServerShardsSubmitSecuredFdBuildsInOwningShard(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_CORRECT_IO,
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    for (hzl_Gid_t gid = 0; gid < HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS; gid++)
+    {
+        // Fake a Request received in the Session, so there are potential receivers
+        groupStates[gid].currentRxLastMessageInstant = groupStates[gid].sessionStartInstant + 1U;
+    }
+    hzlServerTest_ShardsTxRecord_t record;
+    hzlServerTest_ShardsTxRecordInit(&record, 2);
+    const hzl_ServerShardsConfig_t config = {
+            .amountOfShards = 2,
+            .ringCapacity = 8,
+            .onProcessed = hzlServerTest_ShardsIgnoreProcessed,
+            .onBuilt = hzlServerTest_ShardsRecordBuilt,
+            .userData = &record,
+    };
+    hzl_ServerShards_t* shards = NULL;
+    err = hzl_ServerShardsNew(&shards, &ctx, &config);
+    atto_eq(err, HZL_OK);
+    const uint8_t userData[] = "ABCDE";
+
+    // Interleaving the Groups, including an unknown one
+    for (size_t i = 0; i < HZL_TEST_SHARDS_MSGS_PER_GROUP; i++)
+    {
+        for (hzl_Gid_t gid = 0; gid <= HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS; gid++)
+        {
+            do
+            {
+                err = hzl_ServerShardsSubmitSecuredFd(shards, userData, sizeof(userData), gid);
+                if (err == HZL_ERR_SHARD_RING_FULL) { sched_yield(); }
+            }
+            while (err == HZL_ERR_SHARD_RING_FULL);
+            atto_eq(err, HZL_OK);
+        }
+    }
+    hzl_ServerShardsFree(&shards);
+
+    for (hzl_Gid_t gid = 0; gid < HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS; gid++)
+    {
+        atto_eq(record.amountPerGid[gid], HZL_TEST_SHARDS_MSGS_PER_GROUP);
+        atto_true(record.isShardOfGidCorrect[gid]);
+        atto_true(record.areCtrNoncesOfGidIncreasing[gid]);
+    }
+    atto_eq(record.amountOfUnknownGroupErrors, HZL_TEST_SHARDS_MSGS_PER_GROUP);
+    // The shards updated the Group states of the context
+    hzl_CbsPduMsg_t securedPdu;
+    err = hzl_ServerBuildSecuredFd(&securedPdu, &ctx, userData, sizeof(userData), 1);
+    atto_eq(err, HZL_OK);
+    const hzl_CtrNonce_t ctrNonce = (hzl_CtrNonce_t) securedPdu.data[3]
+                                    | ((hzl_CtrNonce_t) securedPdu.data[4] << 8U)
+                                    | ((hzl_CtrNonce_t) securedPdu.data[5] << 16U);
+    atto_eq(ctrNonce, record.lastCtrNonceOfGid[1] + 1U);
+}
+
+#endif  /* HZL_OS_AVAILABLE_NIX */
+
+void hzlServerTest_ServerShardsSubmitSecuredFd(void)
+{
+#if HZL_OS_AVAILABLE_NIX
+    hzlServerTest_ServerShardsSubmitSecuredFdMustHaveValidArgs();
+    hzlServerTest_ServerShardsSubmitSecuredFdBuildsInOwningShard();
+    HZL_TEST_PARTIAL_REPORT();
+#endif  /* HZL_OS_AVAILABLE_NIX */
+}
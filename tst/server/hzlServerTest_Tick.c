@@ -0,0 +1,415 @@
+/*
+ * Copyright © 2020-2022, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS “AS IS”
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @internal
+ * Tests of the hzl_ServerTick() function.
+ *
+ * @warning
+ * REDUCING COVERAGE ON PURPOSE. NOT implementing all the testcases for all possible incorrect
+ * content of the context, because they have already been checked for the hzl_ServerInit()
+ * function and the inner checks are exactly the same, performed by the same internal
+ * function hzl_ServerCheckCtxPointers().
+ */
+
+#include "hzlTest.h"
+
+/** Time returned by hzlServerTest_TickCurrentTime(), set by each test. */
+static hzl_Timestamp_t hzlServerTest_TickClock;
+
+/** Clock standing still, so the Session start instants are known exactly. */
+static hzl_Err_t
+hzlServerTest_TickCurrentTime(hzl_Timestamp_t* const timestamp)
+{
+    *timestamp = hzlServerTest_TickClock;
+    return HZL_OK;
+}
+
+static const hzl_Io_t HZL_TEST_TICK_IO = {
+        .currentTime = hzlServerTest_TickCurrentTime,
+        .trng = hzlTest_IoMockupTrngSucceeding,
+};
+
+/** Group 0 has the shortest Session in the test configuration. */
+#define HZL_TEST_TICK_GID 0U
+#define HZL_TEST_TICK_SESSION_DURATION 50000U
+#define HZL_TEST_TICK_REN_DELAY 4000U
+
+static void
+hzlServerTest_ServerTickPdusMustBeNotNull(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerGroupTimer_t groupTimers[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .groupTimers = groupTimers,
+            .io = HZL_TEST_TICK_IO,
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    hzl_CbsPduMsg_t pdus[2] = {0};
+    size_t amountOfPdus = 2U;
+
+    err = hzl_ServerTick(NULL, &amountOfPdus, &ctx, 0);
+    atto_eq(err, HZL_ERR_NULL_PDU);
+    err = hzl_ServerTick(pdus, NULL, &ctx, 0);
+    atto_eq(err, HZL_ERR_NULL_PDU);
+}
+
+static void
+hzlServerTest_ServerTickCtxMustBeNotNull(void)
+{
+    hzl_Err_t err;
+    hzl_CbsPduMsg_t pdus[2] = {0};
+    size_t amountOfPdus = 2U;
+
+    err = hzl_ServerTick(pdus, &amountOfPdus, NULL, 0);
+
+    atto_eq(err, HZL_ERR_NULL_CTX);
+    atto_eq(amountOfPdus, 0);
+}
+
+static void
+hzlServerTest_ServerTickGroupTimersMustBeNotNull(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .io = HZL_TEST_TICK_IO,
+    };
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    hzl_CbsPduMsg_t pdus[2] = {0};
+    size_t amountOfPdus = 2U;
+
+    err = hzl_ServerTick(pdus, &amountOfPdus, &ctx, 0);
+
+    atto_eq(err, HZL_ERR_NULL_GROUP_TIMERS);
+    atto_eq(amountOfPdus, 0);
+}
+
+static void
+hzlServerTest_ServerTickNothingDueBeforeExpiration(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerGroupTimer_t groupTimers[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .groupTimers = groupTimers,
+            .io = HZL_TEST_TICK_IO,
+    };
+    hzlServerTest_TickClock = 1000;
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    hzl_CbsPduMsg_t pdus[2] = {0};
+    size_t amountOfPdus = 2U;
+    groupStates[HZL_TEST_TICK_GID].currentStk[0] = 99;
+
+    for (hzl_Timestamp_t now = 1000; now <= 1000 + HZL_TEST_TICK_SESSION_DURATION; now += 999)
+    {
+        amountOfPdus = 2U;
+        err = hzl_ServerTick(pdus, &amountOfPdus, &ctx, now);
+        atto_eq(err, HZL_OK);
+        atto_eq(amountOfPdus, 0);
+    }
+    err = hzl_ServerTick(pdus, &amountOfPdus, &ctx, 1000 + HZL_TEST_TICK_SESSION_DURATION);
+    atto_eq(err, HZL_OK);
+    atto_eq(amountOfPdus, 0);
+    // Session not renewed
+    atto_eq(groupStates[HZL_TEST_TICK_GID].currentStk[0], 99);
+    atto_eq(groupStates[HZL_TEST_TICK_GID].sessionStartInstant, 1000);
+    atto_false(groupStates[HZL_TEST_TICK_GID].isRenewalPhaseActive);
+}
+
+static void
+hzlServerTest_ServerTickRenewsExpiredSessionWithoutRenIfNoReceiver(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerGroupTimer_t groupTimers[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .groupTimers = groupTimers,
+            .io = HZL_TEST_TICK_IO,
+    };
+    hzlServerTest_TickClock = 1000;
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    hzl_CbsPduMsg_t pdus[2] = {0};
+    size_t amountOfPdus = 2U;
+    groupStates[HZL_TEST_TICK_GID].currentStk[0] = 99;
+    hzlServerTest_TickClock = 1000 + HZL_TEST_TICK_SESSION_DURATION + 1U;
+
+    err = hzl_ServerTick(pdus, &amountOfPdus, &ctx, hzlServerTest_TickClock);
+
+    atto_eq(err, HZL_OK);
+    atto_eq(amountOfPdus, 0);
+    // Session renewed without keeping the previous one, as no Client knew it
+    atto_neq(groupStates[HZL_TEST_TICK_GID].currentStk[0], 99);
+    atto_eq(groupStates[HZL_TEST_TICK_GID].sessionStartInstant, hzlServerTest_TickClock);
+    atto_false(groupStates[HZL_TEST_TICK_GID].isRenewalPhaseActive);
+    atto_zeros(groupStates[HZL_TEST_TICK_GID].previousStk, 16);
+    // The pre-generated STK used for the new Session was replaced
+    atto_neq(groupTimers[HZL_TEST_TICK_GID].nextStk[1], 0);  // TRNG mockup bytes 0, 1, 2...
+    // The other Groups are not expired yet
+    atto_eq(groupStates[1].sessionStartInstant, 1000);
+    atto_eq(groupStates[2].sessionStartInstant, 1000);
+}
+
+static void
+hzlServerTest_ServerTickBuildsRenMsgsDuringRenewalPhase(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerGroupTimer_t groupTimers[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .groupTimers = groupTimers,
+            .io = HZL_TEST_TICK_IO,
+    };
+    hzlServerTest_TickClock = 1000;
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    hzl_CbsPduMsg_t pdus[2] = {0};
+    size_t amountOfPdus = 2U;
+    groupStates[HZL_TEST_TICK_GID].currentStk[0] = 99;
+    groupStates[HZL_TEST_TICK_GID].currentCtrNonce = 0x110022;
+    // Assume at least one Client Requested the state already:
+    // the last RX message was after the start of the session.
+    groupStates[HZL_TEST_TICK_GID].currentRxLastMessageInstant = 1001;
+    const hzl_Timestamp_t renewalStart = 1000 + HZL_TEST_TICK_SESSION_DURATION + 1U;
+    hzlServerTest_TickClock = renewalStart;
+
+    err = hzl_ServerTick(pdus, &amountOfPdus, &ctx, renewalStart);
+
+    atto_eq(err, HZL_OK);
+    atto_eq(amountOfPdus, 1);
+    atto_true(groupStates[HZL_TEST_TICK_GID].isRenewalPhaseActive);
+    atto_eq(groupStates[HZL_TEST_TICK_GID].previousStk[0], 99);
+    atto_eq(groupStates[HZL_TEST_TICK_GID].currentCtrNonce, 0);
+    atto_eq(groupStates[HZL_TEST_TICK_GID].previousCtrNonce, 0x110023);
+    // REN message of the Group with the previous Session's Counter Nonce
+    atto_eq(pdus[0].dataLen, 3 + 19);
+    atto_eq(pdus[0].data[0], HZL_TEST_TICK_GID);  // GID
+    atto_eq(pdus[0].data[1], 0);  // SID from server
+    atto_eq(pdus[0].data[2], 0);  // PTY REN
+    atto_eq(pdus[0].data[3], 0x22);  // Ctrnonce low
+    atto_eq(pdus[0].data[4], 0x00);  // Ctrnonce mid
+    atto_eq(pdus[0].data[5], 0x11);  // Ctrnonce high
+
+    // Nothing until the next notification
+    amountOfPdus = 2U;
+    err = hzl_ServerTick(pdus, &amountOfPdus, &ctx,
+                         renewalStart + HZL_TEST_TICK_REN_DELAY - 1U);
+    atto_eq(err, HZL_OK);
+    atto_eq(amountOfPdus, 0);
+    amountOfPdus = 2U;
+    err = hzl_ServerTick(pdus, &amountOfPdus, &ctx, renewalStart + HZL_TEST_TICK_REN_DELAY);
+    atto_eq(err, HZL_OK);
+    atto_eq(amountOfPdus, 1);
+    atto_eq(pdus[0].dataLen, 3 + 19);
+    atto_eq(pdus[0].data[3], 0x23);  // Ctrnonce low
+    atto_eq(groupStates[HZL_TEST_TICK_GID].previousCtrNonce, 0x110024);
+
+    // Late tick: the missed notifications are not sent in a burst
+    amountOfPdus = 2U;
+    err = hzl_ServerTick(pdus, &amountOfPdus, &ctx,
+                         renewalStart + 3U * HZL_TEST_TICK_REN_DELAY + 10U);
+    atto_eq(err, HZL_OK);
+    atto_eq(amountOfPdus, 1);
+    atto_eq(pdus[0].data[3], 0x24);  // Ctrnonce low
+    atto_true(groupStates[HZL_TEST_TICK_GID].isRenewalPhaseActive);
+
+    // Renewal phase over after 6 delays
+    amountOfPdus = 2U;
+    err = hzl_ServerTick(pdus, &amountOfPdus, &ctx,
+                         renewalStart + 6U * HZL_TEST_TICK_REN_DELAY);
+    atto_eq(err, HZL_OK);
+    atto_eq(amountOfPdus, 1);  // Again only the latest one, at 6 delays
+    atto_eq(pdus[0].data[3], 0x25);  // Ctrnonce low
+    atto_true(groupStates[HZL_TEST_TICK_GID].isRenewalPhaseActive);
+    amountOfPdus = 2U;
+    err = hzl_ServerTick(pdus, &amountOfPdus, &ctx,
+                         renewalStart + 6U * HZL_TEST_TICK_REN_DELAY + 1U);
+    atto_eq(err, HZL_OK);
+    atto_eq(amountOfPdus, 0);
+    atto_false(groupStates[HZL_TEST_TICK_GID].isRenewalPhaseActive);
+    atto_zeros(groupStates[HZL_TEST_TICK_GID].previousStk, 16);
+}
+
+static void
+hzlServerTest_ServerTickKeepsRenMsgDueWithoutSpace(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerGroupTimer_t groupTimers[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .groupTimers = groupTimers,
+            .io = HZL_TEST_TICK_IO,
+    };
+    hzlServerTest_TickClock = 1000;
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    hzl_CbsPduMsg_t pdus[2] = {0};
+    size_t amountOfPdus = 0U;
+    groupStates[HZL_TEST_TICK_GID].currentStk[0] = 99;
+    groupStates[HZL_TEST_TICK_GID].currentRxLastMessageInstant = 1001;
+    const hzl_Timestamp_t expiration = 1000 + HZL_TEST_TICK_SESSION_DURATION + 1U;
+    hzlServerTest_TickClock = expiration;
+
+    err = hzl_ServerTick(pdus, &amountOfPdus, &ctx, expiration);
+
+    atto_eq(err, HZL_OK);
+    atto_eq(amountOfPdus, 0);
+    // Not renewed, as the REN message could not be built
+    atto_eq(groupStates[HZL_TEST_TICK_GID].currentStk[0], 99);
+    atto_false(groupStates[HZL_TEST_TICK_GID].isRenewalPhaseActive);
+
+    amountOfPdus = 1U;
+    err = hzl_ServerTick(pdus, &amountOfPdus, &ctx, expiration + 1U);
+
+    atto_eq(err, HZL_OK);
+    atto_eq(amountOfPdus, 1);
+    atto_eq(pdus[0].dataLen, 3 + 19);
+    atto_true(groupStates[HZL_TEST_TICK_GID].isRenewalPhaseActive);
+    atto_eq(groupStates[HZL_TEST_TICK_GID].previousStk[0], 99);
+}
+
+static void
+hzlServerTest_ServerTickContinuesForcedRenewal(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerGroupTimer_t groupTimers[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .groupTimers = groupTimers,
+            .io = HZL_TEST_TICK_IO,
+    };
+    hzlServerTest_TickClock = 1000;
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    hzl_CbsPduMsg_t pdus[2] = {0};
+    size_t amountOfPdus = 2U;
+    groupStates[2].currentCtrNonce = 0x110022;
+    groupStates[2].currentRxLastMessageInstant = 1001;
+    hzlServerTest_TickClock = 2000;
+    err = hzl_ServerForceSessionRenewal(&pdus[0], &ctx, 2);
+    atto_eq(err, HZL_OK);
+    atto_eq(groupStates[2].previousCtrNonce, 0x110023);
+
+    err = hzl_ServerTick(pdus, &amountOfPdus, &ctx, 2000 + HZL_TEST_TICK_REN_DELAY);
+
+    atto_eq(err, HZL_OK);
+    atto_eq(amountOfPdus, 1);
+    atto_eq(pdus[0].data[0], 2);  // GID
+    atto_eq(pdus[0].data[3], 0x23);  // Ctrnonce low
+    atto_eq(groupStates[2].previousCtrNonce, 0x110024);
+}
+
+static void
+hzlServerTest_ServerTickAcrossTimestampWrapAround(void)
+{
+    hzl_Err_t err;
+    hzl_ServerGroupState_t groupStates[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerGroupTimer_t groupTimers[HZL_DEFAULT_TEST_AMOUNT_OF_GROUPS];
+    hzl_ServerCtx_t ctx = {
+            .serverConfig = &HZL_TEST_CORRECT_SERVER_CONFIG,
+            .clientConfigs = HZL_TEST_SERVER_CORRECT_CLIENT_CONFIGS,
+            .groupConfigs = HZL_TEST_SERVER_CORRECT_GROUP_CONFIGS,
+            .groupStates = groupStates,
+            .groupTimers = groupTimers,
+            .io = HZL_TEST_TICK_IO,
+    };
+    const hzl_Timestamp_t start = UINT32_MAX - 20000U;
+    hzlServerTest_TickClock = start;
+    err = hzl_ServerInit(&ctx);
+    atto_eq(err, HZL_OK);
+    hzl_CbsPduMsg_t pdus[2] = {0};
+    size_t amountOfPdus = 2U;
+
+    hzl_Timestamp_t now = start;
+    // Group 0 expires every 50 s, with the renewal immediately over (no receivers),
+    // the other Groups after 20 min. Ticking every 7 s for 30 min.
+    size_t renewalsOfGroup0 = 0U;
+    for (size_t i = 0U; i < 30U * 60U / 7U; i++)
+    {
+        now += 7000U;
+        hzlServerTest_TickClock = now;
+        const hzl_Timestamp_t previousStart = groupStates[0].sessionStartInstant;
+        amountOfPdus = 2U;
+        err = hzl_ServerTick(pdus, &amountOfPdus, &ctx, now);
+        atto_eq(err, HZL_OK);
+        atto_eq(amountOfPdus, 0);
+        if (groupStates[0].sessionStartInstant != previousStart) { renewalsOfGroup0++; }
+    }
+    // Renewed at 56, 112, 168 ... s: every 8 ticks
+    atto_eq(renewalsOfGroup0, 30U * 60U / 7U / 8U);
+    atto_neq(groupStates[1].sessionStartInstant, start);
+    atto_neq(groupStates[2].sessionStartInstant, start);
+}
+
+void hzlServerTest_ServerTick(void)
+{
+    hzlServerTest_ServerTickPdusMustBeNotNull();
+    hzlServerTest_ServerTickCtxMustBeNotNull();
+    hzlServerTest_ServerTickGroupTimersMustBeNotNull();
+    hzlServerTest_ServerTickNothingDueBeforeExpiration();
+    hzlServerTest_ServerTickRenewsExpiredSessionWithoutRenIfNoReceiver();
+    hzlServerTest_ServerTickBuildsRenMsgsDuringRenewalPhase();
+    hzlServerTest_ServerTickKeepsRenMsgDueWithoutSpace();
+    hzlServerTest_ServerTickContinuesForcedRenewal();
+    hzlServerTest_ServerTickAcrossTimestampWrapAround();
+    HZL_TEST_PARTIAL_REPORT();
+}